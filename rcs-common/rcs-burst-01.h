@@ -0,0 +1,69 @@
+// @file rcs-burst-01.h
+// @date 2026.10.17
+// @info transmit burst timing shared by the pio program (rcs-burst-01.pio) and the host emulation
+// @info one carrier cycle is BURST_SLOTS pio clocks; the pio clock divider (16.8 fixed point) is
+// @info the only carrier setting, so the carrier error is the divider quantization (<10ppm at 40KHz)
+// @info coded bursts: beacons sharing one receiver send a bpsk code each, BURST_CODE_CHIPS chips of
+// @info BURST_CHIP_CYCLES carrier cycles, a set code bit inverts its chip. the codes are barker 13 and
+// @info three 13 chip codes picked by search for the lowest aperiodic cross correlation with it and
+// @info with each other: 5/13 at worst (-8.3dB), autocorrelation sidelobes <= 2/13. code 0 is the
+// @info plain (uncoded) burst. the receiver side is rcs-coded-01.
+
+#ifndef RCS_BURST_01_H
+#define RCS_BURST_01_H
+
+#include <stdint.h>
+#include <sys/types.h> // uint
+
+#define BURST_SLOTS_HIGH   7    // pio clocks per phase high; rcs-burst-01.pio [6] + 1
+#define BURST_SLOTS_DEAD   1    // pio clocks between phases; non-overlap for the h-bridge
+#define BURST_SLOTS        (2 * (BURST_SLOTS_HIGH + BURST_SLOTS_DEAD))
+#define BURST_CARRIER_HZ   40000 // rcs-detect-01 DETECT_CARRIER_HZ
+#define BURST_CYCLES       8     // rcs-detect-01 DETECT_BURST_CYCLES
+#define BURST_CYCLES_MAX   128   // pattern words are dma fed to the pio; no fifo depth limit
+#define BURST_HALF_BITS    2     // pattern bits per half cycle; bit 0 phase a pin, bit 1 phase b pin
+#define BURST_WORD_CYCLES  (32 / (2 * BURST_HALF_BITS))
+#define BURST_WORDS_MAX    (BURST_CYCLES_MAX / BURST_WORD_CYCLES)
+#define BURST_CODES        4     // beacon codes 1..BURST_CODES
+#define BURST_CODE_CHIPS   13
+#define BURST_CHIP_CYCLES  4     // carrier cycles per chip; (* 13 4 25) 1.3ms burst
+
+static inline uint32_t burst_clkdiv_q8(uint32_t uSysHz, uint32_t uCarrierHz) {
+  // pio clock divider for a carrier, Q8 (int 16 bits, frac 8 bits); 195.3125 for 40KHz at 125MHz
+  uint64_t uDen = (uint64_t)uCarrierHz * BURST_SLOTS;
+  return (uint32_t)((((uint64_t)uSysHz << 8) + uDen / 2) / uDen);
+}
+
+static inline uint64_t burst_slot_ns(uint32_t uSysHz, uint32_t uDivQ8, uint64_t uSlots) {
+  // time of uSlots pio clocks, ns
+  return (uSlots * uDivQ8 * 1000000000ull) / ((uint64_t)uSysHz << 8);
+}
+
+static inline uint32_t burst_code(uint uCode) {
+  // chip inversions of beacon code uCode (1..BURST_CODES), bit k chip k (sent first); 0 plain
+  switch (uCode) {
+    case 1:  return 0x0a60; // barker 13, ++++ +--+ +-+-+
+    case 2:  return 0x00ca;
+    case 3:  return 0x0234;
+    case 4:  return 0x089e;
+    default: return 0;
+  }
+}
+
+static inline uint burst_pattern(uint32_t *pWords, uint32_t uInvert, uint uChips, uint uChipCycles) {
+  // pio pin patterns for a burst of uChips chips of uChipCycles cycles, chip k inverted (phase b
+  // half first) when bit k of uInvert is set; a plain burst is one chip. pWords holds
+  // BURST_WORDS_MAX; the burst is cut at BURST_CYCLES_MAX cycles. returns the word count, the last
+  // word padded with idle (pins low) half cycles.
+  uint uCycles = uChips * uChipCycles;
+  if (uCycles > BURST_CYCLES_MAX) uCycles = BURST_CYCLES_MAX;
+  uint uWords = (uCycles + BURST_WORD_CYCLES - 1) / BURST_WORD_CYCLES;
+  for (uint w = 0; w < uWords; w++) pWords[w] = 0;
+  for (uint c = 0; c < uCycles; c++) {
+    uint32_t uCycle = ((uInvert >> (c / uChipCycles)) & 1) ? 0x6 : 0x9; // b,a : a,b; first half low bits
+    pWords[c / BURST_WORD_CYCLES] |= uCycle << (2 * BURST_HALF_BITS * (c % BURST_WORD_CYCLES));
+  }
+  return uWords;
+} // end static inline uint burst_pattern(...)
+
+#endif // RCS_BURST_01_H
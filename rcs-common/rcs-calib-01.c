@@ -0,0 +1,79 @@
+// @file rcs-calib-01.c
+// @date 2026.10.17
+// @info receiver calibration record in flash
+// @info slots are HAL_FLASH_PAGE apart, numbered through the sectors; a save programs the slot after
+// @info the newest valid record, erasing its sector first when it is the sector's first slot; a slot
+// @info left part written by a power loss moves the save on to the next sector. each sector is erased
+// @info once per (/ 4096 256) 16 saves, so the 100k cycle flash endurance is (* 16 2 100000) 3.2M saves.
+// @info reads are xip and cheap; a save stalls the other core for the erase (~50ms) or program (~1ms)
+
+#include <stddef.h> // offsetof
+#include <string.h>
+#include "rcs-calib-01.h"
+#include "rcs-hal-01.h"
+#include "rcs-telemetry-01.h" // telemetry_crc16
+
+#define CALIB_SLOTS_PER_SECTOR (HAL_FLASH_SECTOR / HAL_FLASH_PAGE)
+#define CALIB_SLOTS            (CALIB_SECTORS * CALIB_SLOTS_PER_SECTOR)
+#define CALIB_OFFSET           (HAL_FLASH_SIZE - CALIB_SECTORS * HAL_FLASH_SECTOR) // top of flash
+
+static uint32_t calib_slot_offset(uint uSlot) {
+  return CALIB_OFFSET + uSlot * HAL_FLASH_PAGE;
+}
+
+static uint16_t calib_crc(const calib_t *pC) {
+  return telemetry_crc16((const uint8_t *)pC, offsetof(calib_t, uCrc));
+}
+
+static bool calib_valid(const calib_t *pC) {
+  return pC->uMagic == CALIB_MAGIC && pC->uCrc == calib_crc(pC);
+}
+
+static bool calib_blank(uint uSlot) {
+  calib_t c;
+  hal_flash_read(calib_slot_offset(uSlot), &c, sizeof(c));
+  const uint8_t *p = (const uint8_t *)&c;
+  for (uint i = 0; i < sizeof(c); i++) {
+    if (p[i] != 0xff) return false;
+  }
+  return true;
+}
+
+static int calib_newest(calib_t *pC) {
+  // slot of the valid record with the highest sequence (into pC), -1 if there is none
+  int iSlot = -1;
+  calib_t c;
+  for (uint s = 0; s < CALIB_SLOTS; s++) {
+    hal_flash_read(calib_slot_offset(s), &c, sizeof(c));
+    if (!calib_valid(&c) || (iSlot >= 0 && c.uSeq <= pC->uSeq)) continue;
+    *pC = c;
+    iSlot = s;
+  }
+  return iSlot;
+}
+
+bool calib_load(calib_t *pC) {
+  // current record into pC; false (pC untouched) if flash holds none
+  calib_t c;
+  if (calib_newest(&c) < 0) return false;
+  *pC = c;
+  return true;
+}
+
+bool calib_save(calib_t *pC) {
+  // append pC as the current record; sets its magic, sequence and crc
+  calib_t last;
+  int iLast = calib_newest(&last);
+  uint uSlot = (iLast < 0) ? 0 : (iLast + 1) % CALIB_SLOTS;
+  if (uSlot % CALIB_SLOTS_PER_SECTOR && !calib_blank(uSlot)) { // torn save; on to the next sector
+    uSlot = (uSlot / CALIB_SLOTS_PER_SECTOR + 1) % CALIB_SECTORS * CALIB_SLOTS_PER_SECTOR;
+  }
+  if (uSlot % CALIB_SLOTS_PER_SECTOR == 0 && !hal_flash_erase(calib_slot_offset(uSlot))) return false;
+  pC->uMagic = CALIB_MAGIC;
+  pC->uSeq = (iLast < 0) ? 1 : last.uSeq + 1;
+  pC->uCrc = calib_crc(pC);
+  uint8_t uPage[HAL_FLASH_PAGE];
+  memset(uPage, 0xff, sizeof(uPage));
+  memcpy(uPage, pC, sizeof(*pC));
+  return hal_flash_program(calib_slot_offset(uSlot), uPage, sizeof(uPage));
+} // end bool calib_save(...)
@@ -0,0 +1,35 @@
+// @file rcs-calib-01.h
+// @date 2026.10.17
+// @info receiver calibration record in flash header
+// @info what the receiver learns at a calibration (trigger levels, tx/rx clock offset, the distance
+// @info the first pulse after a sync is taken at) kept across power cycles in a wear-levelled
+// @info log: one record per flash page, appended through CALIB_SECTORS sectors at the top of flash
+// @info and wrapping; the newest valid record (sequence, crc) is the current one. a sector is only
+// @info erased when the log moves into it, so a power loss mid save leaves the previous record.
+
+#ifndef RCS_CALIB_01_H
+#define RCS_CALIB_01_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <sys/types.h> // uint
+
+#define CALIB_MAGIC   0x31435243 // "RCC1"; a new layout gets a new magic
+#define CALIB_DRIFT   0x0001     // uFlags: iDriftPpmQ8 was measured (drift tracker acquired)
+#define CALIB_SECTORS 2          // log sectors at the top of flash; a sector is erased once per (* 2 16) 32 saves
+
+typedef struct {
+  uint32_t uMagic;
+  uint32_t uSeq;          // save count; set by calib_save()
+  uint16_t uBaseline;     // adc counts; quiet level, checked against the boot measurement
+  uint16_t uThreshold;    // adc counts over/under the baseline; cfar level at the save
+  int32_t  iDriftPpmQ8;   // tx clock against rx clock, ppm Q8 (drift_ppm_q8)
+  int32_t  iRefFlightUs;  // flight time of the first pulse after a sync; its distance
+  uint16_t uFlags;        // CALIB_DRIFT
+  uint16_t uCrc;          // ccitt over the fields above
+} calib_t;
+
+bool calib_load(calib_t *pC);
+bool calib_save(calib_t *pC);
+
+#endif // RCS_CALIB_01_H
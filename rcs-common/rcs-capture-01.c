@@ -0,0 +1,199 @@
+// @file rcs-capture-01.c
+// @date 2026.10.17
+// @info free-running adc capture ring
+// @info the adc free-runs at 500ksps into G_uCaptureRing via dma; the cpu only scans completed
+// @info blocks. arrival time is the absolute sample index times CAPTURE_SAMPLE_NS, so it carries
+// @info no loop overhead or time_us_64() jitter.
+
+// @require raspi pico (2020); hardware_dma, hardware_adc
+// @info RCS_HOST builds only the portable scanner; the host stand-in supplies capture_init/start/stop
+// @info and the sample counters (../rcs-host/rcs-capture-host-01.c)
+
+// dma layout:
+//   data channel: DREQ_ADC paced, 16 bit adc fifo -> G_uCaptureRing, write ring wrap CAPTURE_RING_BITS,
+//                 transfer count CAPTURE_EPOCH_LEN, chains to the control channel on completion
+//   ctrl channel: rewrites the data channel transfer count (trigger alias), restarting it in place
+// the data channel transfer count is a hardware sample counter; no irq is needed: the scanner polls
+// it from the core 1 loop (capture_samples_done()) between blocks.
+// round robin changes nothing in the dma: the adc moves to the next input in its mask after every
+// conversion and the fifo carries them in order, so the ring simply holds the channels interleaved.
+// sleep: the adc (usb pll, 48MHz) and the timer (clk_ref, 1MHz tick) both run off the crystal, so
+// the index can be carried across a sleep on the timer. the restart is held to the timer tick of its
+// index, +-1us (half a sample) per wake; the data channel resumes at that index's ring position.
+
+#if !defined(RCS_HOST)
+#include "pico/stdlib.h"
+#include "hardware/adc.h"
+#include "hardware/dma.h"
+#endif
+#include "rcs-capture-01.h"
+
+// globals
+uint16_t G_uCaptureRing[CAPTURE_RING_LEN] __attribute__((aligned(CAPTURE_RING_LEN * sizeof(uint16_t))));
+uint     G_uCaptureChannels = 1;
+
+#if !defined(RCS_HOST)
+// samples per dma epoch; a multiple of CAPTURE_RING_LEN so index & mask stays the ring position
+#define CAPTURE_EPOCH_LEN (0xFFFFFFFFu & ~(uint32_t)(CAPTURE_RING_LEN - 1))
+#define ADC_POWER_UP_US   20 // cs.en to cs.ready and the sleep_until() wake, margin; rp2040 datasheet ~1us
+
+static int      S_iDataChan = -1;
+static int      S_iCtrlChan = -1;
+static uint32_t S_uEpochReload = CAPTURE_EPOCH_LEN; // ctrl channel source
+static uint32_t S_uLastDone32 = 0;  // epoch roll over detection
+static uint64_t S_uEpochBase = 0;   // samples in completed epochs
+static uint     S_uFirstInput = 0;  // input converted at sample index 0
+static bool     S_bAsleep = false;
+static uint64_t S_uSleepIdx = 0;    // sample index at the last sleep
+static uint64_t S_uSleepUs = 0;     // and the timer then
+
+void capture_init(uint uAdcInput) {
+  // configure adc free-running into the fifo and claim the two dma channels; adc_init() and
+  // adc_gpio_init() are assumed done by the caller (bias network owns the pin setup)
+  S_uFirstInput = uAdcInput;
+  G_uCaptureChannels = 1;
+  adc_set_round_robin(0);
+  adc_select_input(uAdcInput);
+  adc_fifo_setup(true,   // write conversions to the fifo
+                 true,   // dreq when at least 1 sample present
+                 1,      // dreq threshold
+                 false,  // no error bit; keep samples 12 bit clean
+                 false); // no byte shift; 16 bit transfers
+  adc_set_clkdiv(0);     // 48MHz / 96 cycles per conversion -> 500ksps
+
+  S_iDataChan = dma_claim_unused_channel(true);
+  S_iCtrlChan = dma_claim_unused_channel(true);
+
+  dma_channel_config c = dma_channel_get_default_config(S_iDataChan);
+  channel_config_set_transfer_data_size(&c, DMA_SIZE_16);
+  channel_config_set_read_increment(&c, false);
+  channel_config_set_write_increment(&c, true);
+  channel_config_set_ring(&c, true, CAPTURE_RING_BITS); // wrap write address
+  channel_config_set_dreq(&c, DREQ_ADC);
+  channel_config_set_chain_to(&c, S_iCtrlChan);
+  dma_channel_configure(S_iDataChan, &c, G_uCaptureRing, &adc_hw->fifo, CAPTURE_EPOCH_LEN, false);
+
+  dma_channel_config k = dma_channel_get_default_config(S_iCtrlChan);
+  channel_config_set_transfer_data_size(&k, DMA_SIZE_32);
+  channel_config_set_read_increment(&k, false);
+  channel_config_set_write_increment(&k, false);
+  dma_channel_configure(S_iCtrlChan, &k, &dma_hw->ch[S_iDataChan].al1_transfer_count_trig,
+                        &S_uEpochReload, 1, false);
+} // end void capture_init(uint uAdcInput)
+
+void capture_init_round_robin(uint uInputMask) {
+  // interleave the inputs in uInputMask (bits 0-2) into the ring; the adc converts them in
+  // ascending order from the lowest, one per 2us slot, so channel k is the k-th set bit.
+  // adc_gpio_init() for every input is the caller's, as for capture_init().
+  uInputMask &= (1u << CAPTURE_CHANNELS_MAX) - 1;
+  if (!uInputMask) uInputMask = 1;
+  capture_init(__builtin_ctz(uInputMask));
+  G_uCaptureChannels = __builtin_popcount(uInputMask);
+  if (G_uCaptureChannels > 1) adc_set_round_robin(uInputMask);
+} // end void capture_init_round_robin(uint uInputMask)
+
+void capture_start(void) {
+  // start the data channel, then the adc; sample index 0 is the first conversion
+  S_uLastDone32 = 0;
+  S_uEpochBase = 0;
+  adc_fifo_drain();
+  adc_select_input(S_uFirstInput); // round robin left off wherever the last capture stopped
+  dma_channel_set_write_addr(S_iDataChan, G_uCaptureRing, false);
+  dma_channel_set_trans_count(S_iDataChan, CAPTURE_EPOCH_LEN, true);
+  adc_run(true);
+}
+
+void capture_stop(void) {
+  adc_run(false);
+  dma_channel_abort(S_iDataChan);
+  adc_fifo_drain();
+}
+
+static uint64_t capture_index_us(uint64_t uIdx) {
+  // timer time of sample index uIdx, from the last sleep's index/time pair
+  return S_uSleepUs + (uIdx - S_uSleepIdx) * CAPTURE_SAMPLE_NS / 1000;
+}
+
+uint64_t capture_sleep_until(uint64_t uWakeIdx) {
+  // power the adc down and sleep (wfe, sleep_until()) until the timer reaches sample index
+  // uWakeIdx, then power up and resume capture there; rounded up to a whole round robin cycle so
+  // channel 0 stays at multiples of G_uCaptureChannels. returns the first index captured
+  const uint n = G_uCaptureChannels;
+  S_uSleepIdx = capture_samples_now();
+  S_uSleepUs = time_us_64();
+  if (uWakeIdx < S_uSleepIdx + 1) uWakeIdx = S_uSleepIdx + 1;
+  uWakeIdx += (n - uWakeIdx % n) % n;
+  capture_stop();
+  hw_clear_bits(&adc_hw->cs, ADC_CS_EN_BITS); // analog off; ~0.5mA at 500ksps
+  S_bAsleep = true;
+  uint64_t uWakeUs = capture_index_us(uWakeIdx);
+  if (uWakeUs > time_us_64() + ADC_POWER_UP_US) sleep_until(from_us_since_boot(uWakeUs - ADC_POWER_UP_US));
+  hw_set_bits(&adc_hw->cs, ADC_CS_EN_BITS);
+  while (!(adc_hw->cs & ADC_CS_READY_BITS)) tight_loop_contents();
+  uint64_t uLate = capture_samples_now() + 2; // timer derived; a late wake resumes later, not off time
+  if (uWakeIdx < uLate) {
+    uWakeIdx = uLate + (n - uLate % n) % n;
+    uWakeUs = capture_index_us(uWakeIdx);
+  }
+  adc_fifo_drain();
+  adc_select_input(S_uFirstInput);
+  S_uEpochBase = uWakeIdx;
+  S_uLastDone32 = 0;
+  dma_channel_set_write_addr(S_iDataChan, &G_uCaptureRing[uWakeIdx & (CAPTURE_RING_LEN - 1)], false);
+  dma_channel_set_trans_count(S_iDataChan, CAPTURE_EPOCH_LEN, true);
+  busy_wait_until(from_us_since_boot(uWakeUs));
+  adc_run(true);
+  S_bAsleep = false;
+  return uWakeIdx;
+} // end uint64_t capture_sleep_until(...)
+
+uint64_t capture_samples_now(void) {
+  // absolute samples written; the transfer count counts down from CAPTURE_EPOCH_LEN, and a larger
+  // remaining count than last call means the ctrl channel reloaded it. must be called at least
+  // once per epoch (2.4 hours); called every ping by the scanner so this always holds.
+  if (S_bAsleep) return S_uSleepIdx + (time_us_64() - S_uSleepUs) * 1000 / CAPTURE_SAMPLE_NS;
+  uint32_t uDone32 = CAPTURE_EPOCH_LEN - dma_channel_hw_addr(S_iDataChan)->transfer_count;
+  if (uDone32 < S_uLastDone32) S_uEpochBase += CAPTURE_EPOCH_LEN;
+  S_uLastDone32 = uDone32;
+  return S_uEpochBase + uDone32;
+}
+
+uint64_t capture_samples_done(void) {
+  // samples in completed blocks
+  return capture_samples_now() & ~(uint64_t)(CAPTURE_BLOCK_LEN - 1);
+}
+#endif // end #if !defined(RCS_HOST)
+
+bool capture_overrun(uint64_t uFrom, uint64_t uDone) {
+  // true if samples at uFrom have been (or are about to be) overwritten by the dma; one block of
+  // margin is kept for the block being written
+  return (uDone - uFrom) > (CAPTURE_RING_LEN - CAPTURE_BLOCK_LEN);
+}
+
+uint64_t capture_scan(uint64_t uFrom, uint64_t uTo, uint16_t uTrigPos, uint16_t uTrigNeg) {
+  // scan absolute sample range [uFrom, uTo) for the first sample >= uTrigPos or <= uTrigNeg.
+  // returns its absolute index, or CAPTURE_NONE. the range is split at the ring wrap so the
+  // inner loop is a plain pointer walk.
+  while (uFrom < uTo) {
+    uint uPos = uFrom & (CAPTURE_RING_LEN - 1);
+    uint uLen = CAPTURE_RING_LEN - uPos;
+    if (uTo - uFrom < uLen) uLen = uTo - uFrom;
+    const uint16_t *p = &G_uCaptureRing[uPos];
+    for (uint i = 0; i < uLen; i++) {
+      uint16_t uSample = p[i];
+      if ((uSample >= uTrigPos) || (uSample <= uTrigNeg)) {
+        return uFrom + i;
+      }
+    }
+    uFrom += uLen;
+  } // end while (uFrom < uTo)
+  return CAPTURE_NONE;
+} // end uint64_t capture_scan(...)
+
+void capture_channel_copy(uint uChannel, uint64_t uChanIdx, uint16_t *pDst, uint uN) {
+  // de-interleave uN samples of one round robin channel, from channel index uChanIdx, into pDst;
+  // the caller keeps the range inside the ring as for capture_scan()
+  const uint n = G_uCaptureChannels;
+  uint64_t uIdx = uChanIdx * n + uChannel;
+  for (uint i = 0; i < uN; i++, uIdx += n) pDst[i] = G_uCaptureRing[uIdx & (CAPTURE_RING_LEN - 1)];
+}
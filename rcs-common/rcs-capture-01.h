@@ -0,0 +1,71 @@
+// @file rcs-capture-01.h
+// @date 2026.10.17
+// @info free-running adc capture ring header
+// @info adc runs at full rate into a dma ring; arrival times are sample indices, not wall clock
+// @info round robin: up to CAPTURE_CHANNELS_MAX inputs interleave into the same ring, channel k of n at
+// @info absolute indices i*n + k; each channel runs at CAPTURE_SAMPLE_HZ / n and lags channel 0 by k slots
+// @info sleep: capture_sleep_until() powers the adc down and sleeps the calling core; the index runs on
+// @info from the timer meanwhile, so indices on both sides of a sleep compare directly. samples in
+// @info between are never written; the ring below the wake index is stale
+
+// @require raspi pico (2020); or RCS_HOST defined for the linux stand-in (../rcs-host)
+
+#ifndef RCS_CAPTURE_01_H
+#define RCS_CAPTURE_01_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <sys/types.h> // uint
+
+#define CAPTURE_SAMPLE_HZ   500000   // adc free-running rate; clkdiv 0 -> 48MHz/96
+#define CAPTURE_SAMPLE_NS   2000     // (/ 1.0 500e3) 2e-06 2us adc sample interval
+#define CAPTURE_BLOCK_LEN   256      // samples per completed block; scan granularity
+#define CAPTURE_RING_BLOCKS 8        // blocks in ring
+#define CAPTURE_RING_LEN    (CAPTURE_BLOCK_LEN * CAPTURE_RING_BLOCKS) // 2048 samples, 4.1ms
+#define CAPTURE_RING_BITS   12       // log2(ring bytes); dma write address wrap
+#define CAPTURE_NONE        UINT64_MAX // no sample index; scan miss or overrun
+#define CAPTURE_CHANNELS_MAX 3       // round robin over adc inputs 0-2 (GP26-28); input 3 (GP29) is vsys/3
+
+// globals
+extern uint16_t G_uCaptureRing[CAPTURE_RING_LEN]; // dma target; aligned to ring size
+extern uint     G_uCaptureChannels;               // interleaved channels in the ring; 1 after capture_init()
+
+// capture control
+void capture_init(uint uAdcInput);
+void capture_init_round_robin(uint uInputMask);
+void capture_start(void);
+void capture_stop(void);
+uint64_t capture_sleep_until(uint64_t uWakeIdx); // returns the first index captured after it
+// sample counters; absolute indices since capture_start()
+uint64_t capture_samples_now(void);  // exact; use to timestamp events (timer ticks)
+uint64_t capture_samples_done(void); // completed blocks only; safe to scan below this index
+// scanning
+uint64_t capture_scan(uint64_t uFrom, uint64_t uTo, uint16_t uTrigPos, uint16_t uTrigNeg);
+bool capture_overrun(uint64_t uFrom, uint64_t uDone);
+// round robin channels; channel sample indices count that channel's samples only
+void capture_channel_copy(uint uChannel, uint64_t uChanIdx, uint16_t *pDst, uint uN);
+
+static inline uint16_t capture_sample_at(uint64_t uIdx) {
+  // sample at absolute index uIdx; caller ensures uIdx is still in the ring
+  return G_uCaptureRing[uIdx & (CAPTURE_RING_LEN - 1)];
+}
+
+static inline int64_t capture_samples_to_us(int64_t iSamples) {
+  // convert a sample count to microseconds
+  return (iSamples * CAPTURE_SAMPLE_NS) / 1000;
+}
+
+static inline uint64_t capture_channel_samples(uint uChannel, uint64_t uIdx) {
+  // channel samples below absolute index uIdx; also the channel index of the first one at or after it
+  uint n = G_uCaptureChannels;
+  return (uIdx > uChannel) ? (uIdx - uChannel + n - 1) / n : 0;
+}
+
+static inline int64_t capture_channel_to_q8(uint uChannel, int64_t iChanQ8) {
+  // channel sample time (Q8) to absolute ring time (Q8); adds the channel's conversion slot, so
+  // arrivals on different channels compare directly
+  return iChanQ8 * (int64_t)G_uCaptureChannels + ((int64_t)uChannel << 8);
+}
+
+#endif // RCS_CAPTURE_01_H
@@ -0,0 +1,98 @@
+// @file rcs-cfar-01.c
+// @date 2026.10.17
+// @info adaptive baseline and cfar threshold
+// @info mean and variance are exponential moving averages (shift, no divide), so the per sample
+// @info cost is a few adds and one multiply on the M0+. samples outside the current threshold are
+// @info censored: pulses and their echoes do not pull the baseline or inflate the noise estimate.
+// @info a long run of censored samples can only be a baseline step (bias drift, power change), not
+// @info a burst, which rings through the baseline every half cycle. the run is scored, +1 per censored
+// @info sample and -CFAR_RUN_DECAY per sample inside, so noise dipping back inside now and then does
+// @info not end it; at CFAR_LOCKOUT the mean is re-seeded at the mean of the run's censored samples,
+// @info in one step. the variance keeps its noise estimate; the step itself is not noise. a long strong
+// @info burst (clipped, close range) can reach the score too, but its censored samples straddle the
+// @info baseline and average to it, so that re-seed barely moves the mean.
+// @info threshold = max(uFloor, uScaleQ4 * sigma). 5 sigma from the replay bench sweep (-k) over the
+// @info b*.dat baselines: no recorded quiet sample reaches it (sigma ~9-12 counts, peaks ~2.5 sigma),
+// @info and unlike 6 sigma it keeps the weak dist15 echoes at 4-5 ft
+
+#include "rcs-cfar-01.h"
+#include "rcs-capture-01.h" // G_uCaptureRing, ring geometry
+#include "rcs-dsp-01.h"     // dsp_isqrt32
+
+uint16_t cfar_sigma_q4(const cfar_t *pC) {
+  // standard deviation, counts Q4; sqrt(var Q14) is Q7
+  return dsp_isqrt32(pC->iVarQ14 > 0 ? pC->iVarQ14 : 0) >> 3;
+}
+
+static void cfar_refresh(cfar_t *pC) {
+  uint32_t uThreshold = ((uint32_t)pC->uScaleQ4 * cfar_sigma_q4(pC)) >> 8;
+  pC->uThreshold = (uThreshold > pC->uFloor) ? uThreshold : pC->uFloor;
+}
+
+void cfar_init(cfar_t *pC, uint16_t uMean, uint16_t uThreshold) {
+  // seed from the boot baseline and threshold; the seed sigma reproduces uThreshold, so tracking
+  // starts where the fixed threshold was and moves from there
+  pC->uShift = CFAR_SHIFT;
+  pC->uScaleQ4 = CFAR_SCALE_Q4;
+  pC->uFloor = CFAR_FLOOR;
+  pC->iMeanQ16 = (int32_t)uMean << 16;
+  uint32_t uSigmaQ4 = ((uint32_t)uThreshold << 8) / pC->uScaleQ4;
+  pC->iVarQ14 = (uSigmaQ4 * uSigmaQ4) << 6;
+  pC->uCensorRun = 0;
+  pC->uRunCensored = 0;
+  pC->iRunSum = 0;
+  pC->uSamples = 0;
+  pC->uCensored = 0;
+  cfar_refresh(pC);
+} // end void cfar_init(...)
+
+void cfar_update(cfar_t *pC, const uint16_t *pSamples, uint uN) {
+  // feed uN consecutive samples; the threshold is refreshed once at the end
+  int32_t iMeanQ16 = pC->iMeanQ16;
+  int32_t iVarQ14 = pC->iVarQ14;
+  const uint uShift = pC->uShift;
+  const int32_t iThreshold = pC->uThreshold;
+  uint32_t uCensorRun = pC->uCensorRun;
+  for (uint i = 0; i < uN; i++) {
+    int32_t iDev = (int32_t)pSamples[i] - ((iMeanQ16 + (1 << 15)) >> 16);
+    if (iDev > iThreshold || iDev < -iThreshold) {
+      pC->uCensored++;
+      pC->uRunCensored++;
+      pC->iRunSum += iDev;
+      if (++uCensorRun < CFAR_LOCKOUT) continue;
+      // baseline step: the run's level is the new mean; one divide per lockout
+      iMeanQ16 += (int32_t)((pC->iRunSum * 65536) / pC->uRunCensored);
+      uCensorRun = 0;
+      pC->uRunCensored = 0;
+      pC->iRunSum = 0;
+      continue;
+    }
+    if (uCensorRun) {
+      uCensorRun = (uCensorRun > CFAR_RUN_DECAY) ? uCensorRun - CFAR_RUN_DECAY : 0;
+      if (!uCensorRun) {
+        pC->uRunCensored = 0;
+        pC->iRunSum = 0;
+      }
+    }
+    iMeanQ16 += (iDev * 65536) >> uShift;
+    if (iDev > CFAR_DEV_MAX) iDev = CFAR_DEV_MAX; // thresholds over CFAR_DEV_MAX only
+    if (iDev < -CFAR_DEV_MAX) iDev = -CFAR_DEV_MAX;
+    iVarQ14 += ((iDev * iDev << 14) - iVarQ14) >> uShift;
+  }
+  pC->iMeanQ16 = iMeanQ16;
+  pC->iVarQ14 = iVarQ14;
+  pC->uCensorRun = uCensorRun;
+  pC->uSamples += uN;
+  cfar_refresh(pC);
+} // end void cfar_update(...)
+
+void cfar_update_ring(cfar_t *pC, uint64_t uFrom, uint64_t uTo) {
+  // feed absolute capture ring range [uFrom, uTo); split at the ring wrap like capture_scan()
+  while (uFrom < uTo) {
+    uint uPos = uFrom & (CAPTURE_RING_LEN - 1);
+    uint uLen = CAPTURE_RING_LEN - uPos;
+    if (uTo - uFrom < uLen) uLen = uTo - uFrom;
+    cfar_update(pC, &G_uCaptureRing[uPos], uLen);
+    uFrom += uLen;
+  }
+} // end void cfar_update_ring(...)
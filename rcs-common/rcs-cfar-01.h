@@ -0,0 +1,47 @@
+// @file rcs-cfar-01.h
+// @date 2026.10.17
+// @info adaptive baseline and constant false alarm rate (cfar) threshold header
+// @info running mean and variance of the adc stream, fixed point, updated per sample from quiet
+// @info samples; the trigger threshold is a fixed number of standard deviations over the mean, so
+// @info the false alarm rate stays put when bias drifts or ambient 40KHz noise changes
+
+#ifndef RCS_CFAR_01_H
+#define RCS_CFAR_01_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <sys/types.h> // uint
+
+#define CFAR_SHIFT      12   // estimator time constant 2^12 samples; (* 4096 2e-6) 8ms at 500ksps
+#define CFAR_SCALE_Q4   80   // threshold in standard deviations, Q4; 5.0 sigma
+#define CFAR_FLOOR      8    // minimum threshold, adc counts; a few lsb of quantization noise
+#define CFAR_LOCKOUT    256  // censored run score that re-seeds the mean (baseline step); +1 per censored sample,
+                             // (* 256 2e-6) 0.5ms, 2.5 burst lengths of false crossings after a step
+#define CFAR_RUN_DECAY  4    // run score lost per sample inside the threshold
+#define CFAR_DEV_MAX    255  // deviation clamp for the variance; keeps dev^2 Q14 in int32
+
+typedef struct {
+  int32_t  iMeanQ16;    // running mean, adc counts Q16; resolves 1 count deviations at CFAR_SHIFT
+  int32_t  iVarQ14;     // running variance, counts^2 Q14
+  uint     uShift;      // time constant, log2 samples
+  uint     uScaleQ4;    // threshold in standard deviations, Q4
+  uint16_t uFloor;      // minimum threshold, counts
+  uint16_t uThreshold;  // counts over/under the mean; refreshed at the end of each update
+  uint32_t uCensorRun;  // censored run score, 0..CFAR_LOCKOUT
+  uint32_t uRunCensored; // samples censored since the score was last 0
+  int64_t  iRunSum;     // their deviation sum, counts; the mean does not move on censored samples
+  uint64_t uSamples;    // samples seen
+  uint64_t uCensored;   // samples excluded as signal
+} cfar_t;
+
+void cfar_init(cfar_t *pC, uint16_t uMean, uint16_t uThreshold);
+void cfar_update(cfar_t *pC, const uint16_t *pSamples, uint uN);
+void cfar_update_ring(cfar_t *pC, uint64_t uFrom, uint64_t uTo);
+uint16_t cfar_sigma_q4(const cfar_t *pC);
+
+static inline uint16_t cfar_mean(const cfar_t *pC) {
+  // baseline, adc counts
+  return (pC->iMeanQ16 + (1 << 15)) >> 16;
+}
+
+#endif // RCS_CFAR_01_H
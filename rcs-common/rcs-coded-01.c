@@ -0,0 +1,204 @@
+// @file rcs-coded-01.c
+// @date 2026.10.17
+// @info coded burst correlator bank
+// @info a bpsk coded burst is BURST_CODE_CHIPS chips of a constant envelope carrier, each chip
+// @info inverted or not. its matched filter splits like rcs-detect-01's: a quadrature mix with the
+// @info carrier, a boxcar sum over one chip (running sum, constant cost per sample), then per code
+// @info the signed sum of the chip sums one chip apart. the first two stages do not depend on the
+// @info code, so the bank shares them; a beacon adds 2 * chips adds per step. the chip sums are
+// @info smooth over a chip (a 50 sample boxcar), so the code sums run every CODED_DECIM samples and
+// @info the peak is interpolated with a parabola through the step and its neighbours.
+// @info the window is searched for each code's maximum, not for a first crossing: a strong beacon's
+// @info cross correlation (<= 5/13 of its peak, rcs-burst-01.h) shows in the other correlators, and
+// @info only the maximum tells it from the real arrival. through resonant transducers the isolation
+// @info falls to 1-5dB, so no level tells a cross correlation from a beacon; its time does: a cross
+// @info correlation lies within a code span of the sender's peak, and a maximum within
+// @info CODED_CROSS_SPAN_Q8 of a stronger found beacon's is not reported (nor is a real arrival that
+// @info close to a stronger one; the two cannot be told apart there). the carrier phase is unknown
+// @info per beacon, so the magnitude is I^2 + Q^2 in 64 bits (a software multiply on the M0+, once
+// @info per step per beacon).
+// @info limits (../rcs-host/rcs-coded-bench-01): the piezo resonance smears the chips, so the
+// @info isolation between codes falls from 8.3dB (ideal) to 4-6dB at transducer q 8; longer
+// @info chips lengthen the burst more than they help. no equalizer: undoing the resonance restores
+// @info the isolation but the noise it adds costs more arrivals than it saves.
+
+#include "rcs-coded-01.h"
+#include "rcs-detect-01.h"  // carrier lut, DETECT_LUT_*
+#include "rcs-dsp-01.h"     // dsp_parabola_q8
+#include "rcs-capture-01.h" // G_uCaptureRing, ring geometry, CAPTURE_SAMPLE_HZ
+
+uint64_t coded_mag_for_amplitude(const coded_t *pB, uint uCounts) {
+  // code correlation magnitude of an aligned burst with peak amplitude uCounts; a chip sum is
+  // A * 1024 * chip / 2 and all chips add
+  int64_t iSum = (((int64_t)uCounts * (1 << DETECT_LUT_Q) * (pB->uChipLen / 2)) >> CODED_SUM_SHIFT) * BURST_CODE_CHIPS;
+  return (uint64_t)(iSum * iSum);
+}
+
+void coded_set_rate(coded_t *pB, uint32_t uSampleHz, uint32_t uCarrierHz) {
+  // carrier phase step and chip length for a sample rate; the chip is rounded to whole steps
+  pB->uPhaseStep = (uint32_t)(((uint64_t)uCarrierHz << 32) / uSampleHz);
+  uint uChip = ((uint64_t)BURST_CHIP_CYCLES * uSampleHz + uCarrierHz / 2) / uCarrierHz;
+  pB->uChipSteps = (uChip + CODED_DECIM / 2) / CODED_DECIM;
+  if (pB->uChipSteps < 1) pB->uChipSteps = 1;
+  if (pB->uChipSteps * CODED_DECIM > CODED_CHIP_HIST) pB->uChipSteps = CODED_CHIP_HIST / CODED_DECIM;
+  if (pB->uChipSteps * BURST_CODE_CHIPS >= CODED_STEP_HIST) pB->uChipSteps = (CODED_STEP_HIST - 1) / BURST_CODE_CHIPS;
+  pB->uChipLen = pB->uChipSteps * CODED_DECIM;
+}
+
+void coded_init(coded_t *pB, uint uBeacons, uint16_t uBaseline, uint64_t uMagTrigger, uint64_t uStartIdx) {
+  // reset the bank for a window; beacon k correlates code k+1. uStartIdx is the absolute index of
+  // the first sample passed to coded_run(). the rate defaults to the capture ring until
+  // coded_set_rate() is called.
+  if (pB->uPhaseStep == 0) coded_set_rate(pB, CAPTURE_SAMPLE_HZ, BURST_CARRIER_HZ);
+  for (uint i = 0; i < CODED_CHIP_HIST; i++) {
+    pB->iProdI[i] = 0;
+    pB->iProdQ[i] = 0;
+  }
+  pB->iChipI = 0;
+  pB->iChipQ = 0;
+  pB->uIdx = uStartIdx;
+  pB->uPhase = (uint32_t)uStartIdx * pB->uPhaseStep;
+  pB->uDecim = CODED_DECIM;
+  pB->uSteps = 0;
+  pB->uValidSteps = 0;
+  pB->uBaseline = uBaseline;
+  pB->uMagTrigger = uMagTrigger;
+  pB->uBeacons = (uBeacons < CODED_BEACONS_MAX) ? uBeacons : CODED_BEACONS_MAX;
+  for (uint b = 0; b < pB->uBeacons; b++) {
+    coded_beacon_t *pC = &pB->beacon[b];
+    pC->uCode = burst_code(b + 1);
+    pC->uPeak = 0;
+    pC->uPeakPrev = 0;
+    pC->uPeakNext = 0;
+    pC->uPeakIdx = 0;
+    pC->uMagLast = 0;
+    pC->uMagSum = 0;
+    pC->bNeedNext = false;
+  }
+} // end void coded_init(...)
+
+static void coded_step(coded_t *pB, uint64_t uIdx) {
+  // one code sum step per beacon at sample uIdx (the last sample of the code span)
+  uint s = pB->uSteps++;
+  pB->iStepI[s & (CODED_STEP_HIST - 1)] = pB->iChipI >> CODED_SUM_SHIFT;
+  pB->iStepQ[s & (CODED_STEP_HIST - 1)] = pB->iChipQ >> CODED_SUM_SHIFT;
+  if (pB->uSteps < pB->uChipSteps * BURST_CODE_CHIPS) return; // first chip not yet in the window
+  pB->uValidSteps++;
+  for (uint b = 0; b < pB->uBeacons; b++) {
+    coded_beacon_t *pC = &pB->beacon[b];
+    int32_t iI = 0, iQ = 0;
+    uint h = s - (BURST_CODE_CHIPS - 1) * pB->uChipSteps; // chip 0, sent first
+    for (uint k = 0; k < BURST_CODE_CHIPS; k++, h += pB->uChipSteps) {
+      uint hh = h & (CODED_STEP_HIST - 1);
+      if ((pC->uCode >> k) & 1) {
+        iI -= pB->iStepI[hh];
+        iQ -= pB->iStepQ[hh];
+      } else {
+        iI += pB->iStepI[hh];
+        iQ += pB->iStepQ[hh];
+      }
+    }
+    uint64_t uMag = (uint64_t)((int64_t)iI * iI) + (uint64_t)((int64_t)iQ * iQ);
+    pC->uMagSum += uMag >> 8; // no overflow over 50000 full scale steps (0.5s); windows are shorter
+    if (uMag > pC->uPeak) {
+      pC->uPeakPrev = pC->uMagLast;
+      pC->uPeak = uMag;
+      pC->uPeakIdx = uIdx;
+      pC->bNeedNext = true;
+    } else if (pC->bNeedNext) {
+      pC->uPeakNext = uMag;
+      pC->bNeedNext = false;
+    }
+    pC->uMagLast = uMag;
+  } // end for (uint b...)
+} // end static void coded_step(...)
+
+void coded_run(coded_t *pB, const uint16_t *pSamples, uint uN) {
+  // push uN consecutive samples; the window maxima are read with coded_results()
+  int32_t iChipI = pB->iChipI;
+  int32_t iChipQ = pB->iChipQ;
+  uint32_t uPhase = pB->uPhase;
+  const uint32_t uStep = pB->uPhaseStep;
+  const uint uChipLen = pB->uChipLen;
+  uint64_t uIdx = pB->uIdx;
+  for (uint i = 0; i < uN; i++, uIdx++) {
+    int32_t x = (int32_t)pSamples[i] - pB->uBaseline;
+    uint h = uIdx & (CODED_CHIP_HIST - 1);
+    uint hOld = (uIdx - uChipLen) & (CODED_CHIP_HIST - 1);
+    uint k = uPhase >> (32 - DETECT_LUT_BITS);
+    int32_t iPi = x * G_iDetectLutSin[(k + (1 << (DETECT_LUT_BITS - 2))) & ((1 << DETECT_LUT_BITS) - 1)];
+    int32_t iPq = x * G_iDetectLutSin[k];
+    iChipI += iPi - pB->iProdI[hOld];
+    iChipQ += iPq - pB->iProdQ[hOld];
+    pB->iProdI[h] = iPi;
+    pB->iProdQ[h] = iPq;
+    uPhase += uStep;
+    if (--pB->uDecim == 0) {
+      pB->uDecim = CODED_DECIM;
+      pB->iChipI = iChipI;
+      pB->iChipQ = iChipQ;
+      coded_step(pB, uIdx);
+    }
+  } // end for (uint i...)
+  pB->iChipI = iChipI;
+  pB->iChipQ = iChipQ;
+  pB->uPhase = uPhase;
+  pB->uIdx = uIdx;
+} // end void coded_run(...)
+
+void coded_scan_ring(coded_t *pB, uint64_t uFrom, uint64_t uTo) {
+  // run the bank over absolute capture ring range [uFrom, uTo); uFrom must equal pB->uIdx.
+  // split at the ring wrap like capture_scan().
+  while (uFrom < uTo) {
+    uint uPos = uFrom & (CAPTURE_RING_LEN - 1);
+    uint uLen = CAPTURE_RING_LEN - uPos;
+    if (uTo - uFrom < uLen) uLen = uTo - uFrom;
+    coded_run(pB, &G_uCaptureRing[uPos], uLen);
+    uFrom += uLen;
+  }
+} // end void coded_scan_ring(...)
+
+uint coded_results(const coded_t *pB, coded_result_t *pResults) {
+  // per beacon window maximum so far: arrival (parabolic interpolation through the peak step and
+  // its neighbours, in samples), magnitude, confidence. returns the number of beacons found.
+  const uint64_t uSpan = (uint64_t)BURST_CODE_CHIPS * pB->uChipLen;
+  const uint64_t uCross = (uSpan * CODED_CROSS_SPAN_Q8) >> 8;
+  for (uint b = 0; b < pB->uBeacons; b++) {
+    const coded_beacon_t *pC = &pB->beacon[b];
+    coded_result_t *pR = &pResults[b];
+    int64_t a = pC->uPeakPrev >> 8, c = pC->uPeakNext >> 8, p = pC->uPeak >> 8; // fit int64 products
+    int64_t iDeltaQ8 = pC->bNeedNext ? 0 : dsp_parabola_q8(a, p, c); // CODED_FRAC_BITS is DSP_PEAK_Q
+    // the code sum peaks on the last burst sample; arrival is the first
+    pR->iArrivalQ8 = (((int64_t)pC->uPeakIdx + 1 - (int64_t)uSpan) << CODED_FRAC_BITS) + iDeltaQ8 * CODED_DECIM;
+    pR->uPeakMag = pC->uPeak;
+    uint64_t uMean = pB->uValidSteps ? (pC->uMagSum / pB->uValidSteps) << 8 : 0;
+    if (uMean > pC->uPeak) uMean = pC->uPeak;
+    pR->uConfidence = pC->uPeak ? 255 - (uint8_t)((255 * (uMean >> 8)) / ((pC->uPeak >> 8) + 1)) : 0;
+    pR->bFound = false;
+  } // end for (uint b...)
+  // presence, strongest first: a peak over the trigger, unless within uCross of a stronger found
+  // beacon's, where this correlator's maximum is that beacon's cross correlation
+  uint uFound = 0;
+  uint32_t uDone = 0;
+  for (uint n = 0; n < pB->uBeacons; n++) {
+    uint b = 0;
+    bool bAny = false;
+    for (uint k = 0; k < pB->uBeacons; k++) {
+      if (uDone & (1u << k)) continue;
+      if (!bAny || pB->beacon[k].uPeak > pB->beacon[b].uPeak) b = k;
+      bAny = true;
+    }
+    uDone |= 1u << b;
+    const coded_beacon_t *pC = &pB->beacon[b];
+    bool bFound = pB->uValidSteps && pC->uPeak >= pB->uMagTrigger;
+    for (uint k = 0; k < pB->uBeacons && bFound; k++) {
+      if (!pResults[k].bFound) continue;
+      uint64_t uOther = pB->beacon[k].uPeakIdx;
+      uint64_t uApart = (pC->uPeakIdx > uOther) ? pC->uPeakIdx - uOther : uOther - pC->uPeakIdx;
+      if (uApart < uCross) bFound = false;
+    }
+    pResults[b].bFound = bFound;
+    if (bFound) uFound++;
+  } // end for (uint n...)
+  return uFound;
+} // end uint coded_results(...)
@@ -0,0 +1,72 @@
+// @file rcs-coded-01.h
+// @date 2026.10.17
+// @info coded burst correlator bank header
+// @info one receiver, several beacons each sending its bpsk code (rcs-burst-01.h burst_code());
+// @info a correlator per code over the same samples gives a flight time per beacon from one window.
+// @info the carrier mix and the chip boxcar are shared by the bank; only the code sums are per
+// @info beacon, and those run every CODED_DECIM samples.
+
+#ifndef RCS_CODED_01_H
+#define RCS_CODED_01_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <sys/types.h> // uint
+#include "rcs-burst-01.h" // codes, chips
+
+#define CODED_BEACONS_MAX  BURST_CODES
+#define CODED_DECIM        5    // samples per code sum step; 10 steps per chip at 500ksps, 4 cycle chips
+#define CODED_CHIP_HIST    128  // chip boxcar product ring; power of 2 >= chip length in samples
+#define CODED_STEP_HIST    256  // chip sum ring, steps; power of 2 > chips * steps per chip
+#define CODED_SUM_SHIFT    4    // chip sums shifted before the code sums; 2048 * 1024 * 100 * 13 >> 4 fits int32
+#define CODED_CROSS_SPAN_Q8 256 // a peak within this many code spans (Q8) of a stronger found beacon's is
+                                 // its cross correlation, not found; two codes correlate over +-1 span
+#define CODED_FRAC_BITS    8    // arrival time fraction bits; Q8 samples (rcs-detect-01 DETECT_FRAC_BITS)
+
+typedef struct {
+  int64_t  iArrivalQ8;  // absolute sample index of burst start, Q8
+  uint64_t uPeakMag;    // code correlation magnitude at the peak
+  uint8_t  uConfidence; // 0-255; 255 * (1 - mean/peak) over the window
+  bool     bFound;      // peak over the trigger, and not within a stronger beacon's cross correlation
+} coded_result_t;
+
+typedef struct {
+  uint32_t uCode;       // chip inversions, bit k chip k
+  uint64_t uPeak;       // window maximum, with its neighbour steps for interpolation
+  uint64_t uPeakPrev;
+  uint64_t uPeakNext;
+  uint64_t uPeakIdx;    // sample index of the peak step
+  uint64_t uMagLast;
+  uint64_t uMagSum;     // over the window steps; floor for the confidence
+  bool     bNeedNext;
+} coded_beacon_t;
+
+typedef struct {
+  int32_t  iProdI[CODED_CHIP_HIST]; // mixed sample history for the chip boxcar
+  int32_t  iProdQ[CODED_CHIP_HIST];
+  int32_t  iChipI;                  // chip boxcar sums
+  int32_t  iChipQ;
+  int32_t  iStepI[CODED_STEP_HIST]; // chip sums at each step, >> CODED_SUM_SHIFT
+  int32_t  iStepQ[CODED_STEP_HIST];
+  uint64_t uIdx;                    // absolute index of the next sample
+  uint32_t uPhase;                  // carrier phase of the next sample; 2^32 per cycle
+  uint32_t uPhaseStep;              // carrier phase per sample
+  uint     uChipLen;                // chip length, samples; CODED_DECIM * uChipSteps
+  uint     uChipSteps;              // chip length, steps
+  uint     uDecim;                  // samples to the next step
+  uint32_t uSteps;                  // steps since init
+  uint32_t uValidSteps;             // steps with the whole code span inside the window
+  uint16_t uBaseline;               // adc quiescent level
+  uint64_t uMagTrigger;             // peak magnitude for a beacon to count as found
+  uint     uBeacons;
+  coded_beacon_t beacon[CODED_BEACONS_MAX];
+} coded_t;
+
+void coded_set_rate(coded_t *pB, uint32_t uSampleHz, uint32_t uCarrierHz);
+void coded_init(coded_t *pB, uint uBeacons, uint16_t uBaseline, uint64_t uMagTrigger, uint64_t uStartIdx);
+void coded_run(coded_t *pB, const uint16_t *pSamples, uint uN);
+void coded_scan_ring(coded_t *pB, uint64_t uFrom, uint64_t uTo);
+uint coded_results(const coded_t *pB, coded_result_t *pResults);
+uint64_t coded_mag_for_amplitude(const coded_t *pB, uint uCounts);
+
+#endif // RCS_CODED_01_H
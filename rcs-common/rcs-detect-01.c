@@ -0,0 +1,195 @@
+// @file rcs-detect-01.c
+// @date 2026.10.17
+// @info matched filter burst detector
+// @info the tx burst is a constant envelope 40KHz tone 8 cycles long, so its
+// @info matched filter is a quadrature mix with the carrier followed by a boxcar sum over the burst
+// @info length. the boxcar is a running sum (add new product, subtract the one leaving), which makes
+// @info the cost per sample constant (2 multiplies, 2 squares) instead of one multiply per template tap.
+// @info the magnitude peak is interpolated with a parabola through the peak and its neighbours.
+// @info detection continues after a peak (rcs-echo-01 takes every arrival in a window): the falling
+// @info side of the boxcar triangle would read as a new arrival, so re-arming waits for the
+// @info magnitude to drop under the trigger, or to rise out of a valley by DETECT_VALLEY_SHIFT where
+// @info a second arrival overlaps the first (noise ripple on the falling side does not). arrivals
+// @info closer than about half a burst merge into one, wider.
+
+// @info (/ 500e3 40e3) 12.5 samples per carrier cycle, not an integer, so the carrier is generated
+// @info with a 32 bit phase accumulator into a 64 entry sine lut; this also lets the host replay
+// @info legacy .dat captures taken at the slower adc_read() loop rate (../rcs-host/rcs-dat-01.h)
+// @info sum sizes: 2048 counts * 1024 lut * 128 taps = 2^28; fits int32
+
+#include "rcs-detect-01.h"
+#include "rcs-capture-01.h" // G_uCaptureRing, ring geometry, CAPTURE_SAMPLE_HZ
+#include "rcs-dsp-01.h"     // dsp_parabola_q8
+
+// carrier sine, Q10; round(1024*sin(2*pi*k/64)); cos is a quarter cycle (16 entries) ahead
+const int16_t G_iDetectLutSin[1 << DETECT_LUT_BITS] = {
+      0,   100,   200,   297,   392,   483,   569,   650,   724,   792,   851,   903,   946,   980,  1004,  1019,
+   1024,  1019,  1004,   980,   946,   903,   851,   792,   724,   650,   569,   483,   392,   297,   200,   100,
+      0,  -100,  -200,  -297,  -392,  -483,  -569,  -650,  -724,  -792,  -851,  -903,  -946,  -980, -1004, -1019,
+  -1024, -1019, -1004,  -980,  -946,  -903,  -851,  -792,  -724,  -650,  -569,  -483,  -392,  -297,  -200,  -100 };
+
+uint32_t detect_mag_for_amplitude(const detect_t *pD, uint uCounts) {
+  // correlation magnitude of an aligned burst with peak amplitude uCounts; sum = A * 1024 * N / 2
+  uint32_t uSum = ((uint32_t)uCounts * (1 << DETECT_LUT_Q) * (pD->uTemplateLen / 2)) >> DETECT_MAG_SHIFT;
+  return uSum * uSum;
+}
+
+uint16_t detect_amplitude_for_mag(const detect_t *pD, uint32_t uMag) {
+  // inverse of detect_mag_for_amplitude(); burst amplitude in counts, e.g. of a peak magnitude
+  return (dsp_isqrt32(uMag) << DETECT_MAG_SHIFT) / ((1 << DETECT_LUT_Q) * (pD->uTemplateLen / 2));
+}
+
+uint32_t detect_mag_for_threshold(const detect_t *pD, uint uCounts) {
+  // magnitude trigger for a threshold crossing level (the receivers' cfar or boot threshold): a real
+  // burst peaking over uCounts correlates as a constant one DETECT_TRIGGER_Q8 as large
+  return detect_mag_for_amplitude(pD, (uCounts * DETECT_TRIGGER_Q8) >> 8);
+}
+
+void detect_set_rate(detect_t *pD, uint32_t uSampleHz, uint32_t uCarrierHz) {
+  // carrier phase step and burst length for a sample rate; detect_init() does not change these
+  pD->uPhaseStep = (uint32_t)(((uint64_t)uCarrierHz << 32) / uSampleHz);
+  pD->uTemplateLen = ((uint64_t)DETECT_BURST_CYCLES * uSampleHz + uCarrierHz / 2) / uCarrierHz;
+  if (pD->uTemplateLen > DETECT_HIST_LEN) pD->uTemplateLen = DETECT_HIST_LEN;
+}
+
+void detect_init(detect_t *pD, uint16_t uBaseline, uint32_t uMagTrigger, uint64_t uStartIdx) {
+  // reset filter state; uStartIdx is the absolute index of the first sample passed to detect_run().
+  // the rate defaults to the capture ring (CAPTURE_SAMPLE_HZ, DETECT_CARRIER_HZ) until
+  // detect_set_rate() is called.
+  if (pD->uPhaseStep == 0) detect_set_rate(pD, CAPTURE_SAMPLE_HZ, DETECT_CARRIER_HZ);
+  for (uint i = 0; i < DETECT_HIST_LEN; i++) {
+    pD->iHistI[i] = 0;
+    pD->iHistQ[i] = 0;
+    pD->uMagHist[i] = 0;
+  }
+  pD->iSumI = 0;
+  pD->iSumQ = 0;
+  pD->uIdx = uStartIdx;
+  pD->uPhase = (uint32_t)uStartIdx * pD->uPhaseStep;
+  pD->uBaseline = uBaseline;
+  pD->uMagTrigger = uMagTrigger;
+  pD->uNoise = 0;
+  pD->uMagLast = 0;
+  pD->bArmed = false;
+  pD->bHold = false;
+  pD->bNeedNext = false;
+  pD->uPeak = 0;
+} // end void detect_init(...)
+
+static void detect_finish(detect_t *pD, detect_result_t *pResult, uint64_t uIdx) {
+  // parabolic interpolation through (peak-1, peak, peak+1); DETECT_FRAC_BITS is DSP_PEAK_Q
+  int64_t iDeltaQ8 = dsp_parabola_q8(pD->uPeakPrev, pD->uPeak, pD->uPeakNext);
+  // the boxcar peaks on the last burst sample; arrival is the first
+  pResult->iArrivalQ8 = (((int64_t)pD->uPeakIdx - (pD->uTemplateLen - 1)) << DETECT_FRAC_BITS) + iDeltaQ8;
+  pResult->uPeakMag = pD->uPeak;
+  uint32_t uNoise = (pD->uNoise < pD->uPeak) ? pD->uNoise : pD->uPeak;
+  pResult->uConfidence = pD->uPeak ? 255 - (uint8_t)(((uint64_t)255 * uNoise) / pD->uPeak) : 0;
+  // half amplitude is a quarter of the magnitude; back from the peak on the rising side, forward on
+  // the falling side as far as it has run (to uIdx, the sample that finished the peak). a falling side
+  // still over half is taken as the mirror of the rising one
+  const uint32_t uHalf = pD->uPeak / 4;
+  const uint uMask = DETECT_HIST_LEN - 1;
+  uint uRise = 1, uFall = 1;
+  while (pD->uPeakIdx - uRise + DETECT_HIST_LEN > uIdx && pD->uMagHist[(pD->uPeakIdx - uRise) & uMask] > uHalf) uRise++;
+  while (pD->uPeakIdx + uFall <= uIdx && pD->uMagHist[(pD->uPeakIdx + uFall) & uMask] > uHalf) uFall++;
+  if (pD->uPeakIdx + uFall > uIdx) uFall = uRise;
+  pResult->uWidth = uRise + uFall - 1;
+  pD->bArmed = false;
+  pD->bHold = true;
+  pD->uValley = UINT32_MAX;
+} // end static void detect_finish(...)
+
+bool detect_run(detect_t *pD, const uint16_t *pSamples, uint uN, detect_result_t *pResult) {
+  // push uN consecutive samples; returns true and fills pResult when a burst peak completes.
+  // samples after a completed detection in the same call are not consumed; pD->uIdx tells where
+  // processing stopped.
+  int32_t iSumI = pD->iSumI;
+  int32_t iSumQ = pD->iSumQ;
+  uint32_t uPhase = pD->uPhase;
+  const uint32_t uStep = pD->uPhaseStep;
+  const uint uTemplateLen = pD->uTemplateLen;
+  uint64_t uIdx = pD->uIdx;
+  bool bDone = false;
+  for (uint i = 0; i < uN && !bDone; i++, uIdx++) {
+    int32_t x = (int32_t)pSamples[i] - pD->uBaseline;
+    uint h = uIdx & (DETECT_HIST_LEN - 1);
+    uint hOld = (uIdx - uTemplateLen) & (DETECT_HIST_LEN - 1);
+    uint k = uPhase >> (32 - DETECT_LUT_BITS);
+    int32_t iPi = x * G_iDetectLutSin[(k + (1 << (DETECT_LUT_BITS - 2))) & ((1 << DETECT_LUT_BITS) - 1)];
+    int32_t iPq = x * G_iDetectLutSin[k];
+    iSumI += iPi - pD->iHistI[hOld];
+    iSumQ += iPq - pD->iHistQ[hOld];
+    pD->iHistI[h] = iPi;
+    pD->iHistQ[h] = iPq;
+    uPhase += uStep;
+
+    int32_t iI = iSumI >> DETECT_MAG_SHIFT;
+    int32_t iQ = iSumQ >> DETECT_MAG_SHIFT;
+    uint32_t uMag = (uint32_t)(iI * iI) + (uint32_t)(iQ * iQ);
+    pD->uMagHist[h] = uMag;
+
+    if (pD->bHold) {
+      if (uMag < pD->uValley) pD->uValley = uMag;
+      if (uMag < pD->uMagTrigger || uMag >> DETECT_VALLEY_SHIFT > pD->uValley) pD->bHold = false;
+    }
+    if (!pD->bArmed && !pD->bHold) {
+      if (uMag >= pD->uMagTrigger) {
+        pD->bArmed = true;
+        pD->uPeak = 0;
+      } else {
+        // ~64 sample running average of the magnitude floor
+        if (uMag > pD->uNoise) pD->uNoise += (uMag - pD->uNoise) >> 6;
+        else pD->uNoise -= (pD->uNoise - uMag) >> 6;
+      }
+    }
+    if (pD->bArmed) {
+      if (uMag > pD->uPeak) {
+        pD->uPeakPrev = pD->uMagLast;
+        pD->uPeak = uMag;
+        pD->uPeakIdx = uIdx;
+        pD->bNeedNext = true;
+      } else if (pD->bNeedNext) {
+        pD->uPeakNext = uMag;
+        pD->bNeedNext = false;
+      } else if (uIdx - pD->uPeakIdx >= uTemplateLen / 2) {
+        // half a burst past the peak without a higher value; the peak is final
+        detect_finish(pD, pResult, uIdx);
+        bDone = true;
+      }
+    }
+    pD->uMagLast = uMag;
+  } // end for (uint i...)
+  pD->iSumI = iSumI;
+  pD->iSumQ = iSumQ;
+  pD->uPhase = uPhase;
+  pD->uIdx = uIdx;
+  return bDone;
+} // end bool detect_run(...)
+
+void detect_blank(detect_t *pD, uint64_t uFrom, uint64_t uTo) {
+  // run the filter over ring range [uFrom, uTo), uFrom == pD->uIdx, without arming, then hold as after
+  // a peak: for a window that opens on the tail of a strong signal (the transmit ring-down of a
+  // board that also sends). the boxcar is full at uTo; what is left of the tail must fall under the
+  // trigger, or an arrival rise out of it, before the detector arms
+  detect_result_t result;
+  uint32_t uMagTrigger = pD->uMagTrigger;
+  pD->uMagTrigger = UINT32_MAX;
+  detect_scan_ring(pD, uFrom, uTo, &result);
+  pD->uMagTrigger = uMagTrigger;
+  pD->uNoise = 0;
+  pD->bHold = true;
+  pD->uValley = UINT32_MAX;
+} // end void detect_blank(...)
+
+bool detect_scan_ring(detect_t *pD, uint64_t uFrom, uint64_t uTo, detect_result_t *pResult) {
+  // run the detector over absolute capture ring range [uFrom, uTo); uFrom must equal pD->uIdx.
+  // split at the ring wrap like capture_scan().
+  while (uFrom < uTo) {
+    uint uPos = uFrom & (CAPTURE_RING_LEN - 1);
+    uint uLen = CAPTURE_RING_LEN - uPos;
+    if (uTo - uFrom < uLen) uLen = uTo - uFrom;
+    if (detect_run(pD, &G_uCaptureRing[uPos], uLen, pResult)) return true;
+    uFrom += uLen;
+  }
+  return false;
+} // end bool detect_scan_ring(...)
@@ -0,0 +1,72 @@
+// @file rcs-detect-01.h
+// @date 2026.10.17
+// @info matched filter burst detector header
+// @info fixed point correlation against the rcs-tx01-02 burst (8 cycles, 40KHz) with sub-sample
+// @info peak interpolation; no floats, sized for the M0+ at 500ksps
+
+#ifndef RCS_DETECT_01_H
+#define RCS_DETECT_01_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <sys/types.h> // uint
+
+#define DETECT_CARRIER_HZ    40000  // tx burst carrier; rcs-tx01-02 G_GP10/G_GP11 clocks
+#define DETECT_BURST_CYCLES  8      // tx burst length in carrier cycles
+#define DETECT_LUT_BITS      6      // carrier sine lut, 64 entries per cycle
+#define DETECT_HIST_LEN      128    // product history ring; power of 2 >= template length
+#define DETECT_LUT_Q         10     // template coefficient format; +-1024
+#define DETECT_MAG_SHIFT     14     // correlation sums shifted before squaring; keeps mag in uint32
+#define DETECT_FRAC_BITS     8      // arrival time fraction bits; Q8 samples
+#define DETECT_CYCLE_BUDGET  250    // M0+ cycles per sample at 125MHz / 500ksps
+#define DETECT_VALLEY_SHIFT  1      // re-arm after a peak once the magnitude doubles off its valley (3dB)
+#define DETECT_TRIGGER_Q8    128    // matched trigger over a threshold crossing level, Q8; a received burst
+                                    // rings up through the transducer and averages ~1/2 its peak over the
+                                    // template (recorded captures: 256 misses dist15 #4..#6, 128 only #4)
+
+typedef struct {
+  int64_t  iArrivalQ8;   // absolute sample index of burst start, Q8
+  uint32_t uPeakMag;     // correlation magnitude at the peak
+  uint8_t  uConfidence;  // 0-255; 255 * (1 - noise/peak)
+  uint16_t uWidth;       // samples the correlation stays over half its peak amplitude; a clean burst is
+                         // about uTemplateLen, overlapping arrivals or a smeared path are wider
+} detect_result_t;
+
+typedef struct {
+  int32_t  iHistI[DETECT_HIST_LEN]; // in phase product history
+  int32_t  iHistQ[DETECT_HIST_LEN]; // quadrature product history
+  uint32_t uMagHist[DETECT_HIST_LEN]; // magnitude history; burst width at the peak
+  int32_t  iSumI;                   // boxcar correlation sums over uTemplateLen
+  int32_t  iSumQ;
+  uint64_t uIdx;                    // absolute index of the next sample
+  uint32_t uPhase;                  // carrier phase of the next sample; 2^32 per cycle
+  uint32_t uPhaseStep;              // carrier phase per sample
+  uint     uTemplateLen;            // burst length in samples; (* 8 12.5) 100 at 500ksps
+  uint16_t uBaseline;               // adc quiescent level
+  uint32_t uMagTrigger;             // magnitude that arms peak search
+  uint32_t uNoise;                  // running magnitude average while unarmed
+  uint32_t uMagLast;                // previous magnitude
+  // peak search
+  bool     bArmed;
+  bool     bHold;                   // after a peak: no re-arm until the magnitude falls under the
+                                    // trigger or rises out of a valley (an overlapping arrival)
+  uint32_t uValley;                 // lowest magnitude since the peak, while holding
+  bool     bNeedNext;               // waiting for the sample after the peak
+  uint32_t uPeakPrev;
+  uint32_t uPeak;
+  uint32_t uPeakNext;
+  uint64_t uPeakIdx;
+} detect_t;
+
+extern const int16_t G_iDetectLutSin[1 << DETECT_LUT_BITS]; // carrier sine, Q10; shared with rcs-coded-01
+
+void detect_set_rate(detect_t *pD, uint32_t uSampleHz, uint32_t uCarrierHz);
+void detect_init(detect_t *pD, uint16_t uBaseline, uint32_t uMagTrigger, uint64_t uStartIdx);
+bool detect_run(detect_t *pD, const uint16_t *pSamples, uint uN, detect_result_t *pResult);
+void detect_blank(detect_t *pD, uint64_t uFrom, uint64_t uTo);
+bool detect_scan_ring(detect_t *pD, uint64_t uFrom, uint64_t uTo, detect_result_t *pResult);
+uint32_t detect_mag_for_amplitude(const detect_t *pD, uint uCounts);
+uint16_t detect_amplitude_for_mag(const detect_t *pD, uint32_t uMag);
+uint32_t detect_mag_for_threshold(const detect_t *pD, uint uCounts);
+
+#endif // RCS_DETECT_01_H
@@ -0,0 +1,102 @@
+// @file rcs-drift-01.c
+// @date 2026.10.17
+// @info tx/rx clock drift tracker
+// @info one way ranging cannot tell a clock drift from a target move, so the tracker leans on how
+// @info they differ: drift is a slow change of the interval between arrivals, a move is a jump in
+// @info it. the period estimate is a moving average (gain 1/16) of the per period arrival interval;
+// @info intervals that differ from it by more than DRIFT_GATE samples are motion and are skipped.
+// @info the phase is never corrected by the arrivals (that would absorb real distance changes);
+// @info it is the reference arrival plus the summed period estimates. the residual is then
+// @info   r[k] = r[k-1] + e[k],  P[k] = P[k-1] + e[k]/16   (e: period innovation)
+// @info so r[k] - r[0] = 16 * (P[k] - P[0]): the ranging error is bounded by the period estimate
+// @info error, and does not grow with run length like a fixed TX_RX_SKEW per period.
+// @info limits: motion slower than DRIFT_GATE per period reads as drift while it lasts; a tx period
+// @info change of d samples offsets the range by 16*d samples ((* 16 2) 32us at 1ppm, TX_PERIOD 2000).
+// @info acquisition starts from a prior (rcs-rx04-03 TX_RX_SKEW) and averages it with the first
+// @info DRIFT_ACQUIRE intervals under a wide gate; like the reference capture, it expects the target
+// @info to hold still (moves over DRIFT_GATE_ACQUIRE per period are still seen). drift_seed() skips it
+// @info with a period from an earlier run.
+// @info short ping periods: drift per period shrinks with the period, motion per period with the
+// @info ping rate, so a per period gate would take a slow walk for drift at tens of Hz. with a
+// @info stride of S periods (about TX_PERIOD of them) only arrivals S or more periods apart update
+// @info the period, against the gates over that interval; the pings in between get residuals only.
+
+#include "rcs-drift-01.h"
+
+void drift_init(drift_t *pT, uint32_t uNominalSamples, int32_t iPriorQ8, uint32_t uStride) {
+  // uNominalSamples: ping period in rx samples. iPriorQ8: expected period offset for this tx/rx
+  // pair, samples Q8 (0 if unknown); acquisition averages it with the first DRIFT_ACQUIRE intervals.
+  // uStride: periods per period update (1 at TX_PERIOD)
+  pT->iNominalQ = (int64_t)uNominalSamples << DRIFT_Q;
+  pT->iPeriodQ = pT->iNominalQ + ((int64_t)iPriorQ8 << (DRIFT_Q - 8));
+  pT->iPhaseQ = 0;
+  pT->iRefQ = 0;
+  pT->iLastQ = 0;
+  pT->uPeriods = 0;
+  pT->uLastPeriods = 0;
+  pT->uIntervals = 0;
+  pT->uGated = 0;
+  pT->uStride = uStride ? uStride : 1;
+  pT->bReferenced = false;
+}
+
+void drift_seed(drift_t *pT, int32_t iPpmQ8) {
+  // after drift_init(): start from a period learned before (drift_ppm_q8 of an earlier run, kept in
+  // flash) instead of acquiring one. tracking starts at 1/16 with the motion gate, so the target
+  // need not hold still after a sync
+  pT->iPeriodQ = pT->iNominalQ + pT->iNominalQ * iPpmQ8 / (256 * 1000000);
+  pT->uIntervals = DRIFT_ACQUIRE;
+}
+
+bool drift_update(drift_t *pT, bool bValid, int64_t iArrivalQ8, int64_t *piResidualQ8, bool *pbReference) {
+  // call once per tx period, in order; bValid false for a missed pulse. iArrivalQ8 is the absolute
+  // arrival sample, Q8. returns true with the flight time change (samples, Q8) against the
+  // reference when there is an arrival; the first valid arrival is the reference (residual 0).
+  int64_t iZ = iArrivalQ8 << (DRIFT_Q - 8);
+  *pbReference = false;
+  if (!pT->bReferenced) {
+    if (!bValid) return false;
+    pT->iRefQ = pT->iLastQ = pT->iPhaseQ = iZ;
+    pT->bReferenced = true;
+    *pbReference = true;
+    *piResidualQ8 = 0;
+    return true;
+  }
+  pT->uPeriods++;
+  pT->iPhaseQ += pT->iPeriodQ; // predict
+  if (!bValid) return false;
+
+  // period innovation over the interval since the last arrival (misses in between); inside a
+  // stride the arrival is only measured against the prediction
+  uint32_t uN = pT->uPeriods - pT->uLastPeriods;
+  if (uN < pT->uStride) {
+    *piResidualQ8 = (iZ - pT->iPhaseQ) / (1 << (DRIFT_Q - 8));
+    return true;
+  }
+  int64_t iInnovQ = (iZ - pT->iLastQ) / (int64_t)uN - pT->iPeriodQ;
+  bool bAcquire = pT->uIntervals < DRIFT_ACQUIRE;
+  int64_t iGateQ = (int64_t)(bAcquire ? DRIFT_GATE_ACQUIRE : DRIFT_GATE) << DRIFT_Q;
+  int64_t iStrideQ = iInnovQ * (int64_t)pT->uStride; // interval change over a stride
+  if (iStrideQ <= iGateQ && iStrideQ >= -iGateQ) {
+    if (bAcquire) {
+      // running mean of the prior and the intervals so far; the phase is re-laid from the reference
+      // with it, so a poor prior leaves no offset. motion inside the wide gate is absorbed here.
+      pT->iPeriodQ += iInnovQ / (int64_t)(pT->uIntervals + 2);
+      pT->iPhaseQ = pT->iRefQ + pT->iPeriodQ * pT->uPeriods;
+    } else {
+      pT->iPeriodQ += iInnovQ / (1 << DRIFT_GAIN_SHIFT);
+    }
+    pT->uIntervals++;
+  } else {
+    pT->uGated++;
+  }
+  pT->iLastQ = iZ;
+  pT->uLastPeriods = pT->uPeriods;
+  *piResidualQ8 = (iZ - pT->iPhaseQ) / (1 << (DRIFT_Q - 8));
+  return true;
+} // end bool drift_update(...)
+
+int64_t drift_next_arrival_q8(const drift_t *pT) {
+  // predicted reference distance arrival next period, absolute sample Q8; window placement
+  return (pT->iPhaseQ + pT->iPeriodQ) / (1 << (DRIFT_Q - 8));
+}
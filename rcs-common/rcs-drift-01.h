@@ -0,0 +1,45 @@
+// @file rcs-drift-01.h
+// @date 2026.10.17
+// @info tx/rx clock drift tracker header
+// @info learns the transmitter period, in receiver samples, from the pulse arrivals and predicts
+// @info when the reference distance pulse would arrive each period; the flight time change is the
+// @info arrival minus that prediction. replaces the fixed TX_RX_SKEW per period correction.
+
+#ifndef RCS_DRIFT_01_H
+#define RCS_DRIFT_01_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <sys/types.h> // uint
+
+#define DRIFT_Q             16  // phase and period fraction bits, samples
+#define DRIFT_ACQUIRE       14  // intervals averaged with the prior (gain 1/(n+2)) before tracking at 1/16
+#define DRIFT_GAIN_SHIFT    4   // period tracking gain 1/16
+#define DRIFT_GATE          8   // samples per stride; larger period innovations are motion, not drift. (* 8 2) 16us
+#define DRIFT_GATE_ACQUIRE  64  // samples; acquisition gate, a period prior up to 64ppm off at TX_PERIOD 2000
+
+typedef struct {
+  int64_t  iPhaseQ;      // predicted reference arrival this period, samples Q16
+  int64_t  iPeriodQ;     // tx period estimate, samples Q16
+  int64_t  iNominalQ;    // nominal period (rx samples per ping period), samples Q16
+  int64_t  iRefQ;        // reference (first valid) arrival, samples Q16
+  int64_t  iLastQ;       // last valid arrival
+  uint32_t uPeriods;     // periods since the reference
+  uint32_t uLastPeriods; // uPeriods at iLastQ
+  uint32_t uIntervals;   // valid intervals seen; acquisition until DRIFT_ACQUIRE
+  uint32_t uGated;       // intervals rejected as motion
+  uint32_t uStride;      // periods per period update; short ping periods
+  bool     bReferenced;
+} drift_t;
+
+void drift_init(drift_t *pT, uint32_t uNominalSamples, int32_t iPriorQ8, uint32_t uStride);
+void drift_seed(drift_t *pT, int32_t iPpmQ8);
+bool drift_update(drift_t *pT, bool bValid, int64_t iArrivalQ8, int64_t *piResidualQ8, bool *pbReference);
+int64_t drift_next_arrival_q8(const drift_t *pT);
+
+static inline int32_t drift_ppm_q8(const drift_t *pT) {
+  // tx clock against rx clock, ppm Q8; positive when the transmitter period is long
+  return ((pT->iPeriodQ - pT->iNominalQ) * 256 * 1000000) / pT->iNominalQ;
+}
+
+#endif // RCS_DRIFT_01_H
@@ -0,0 +1,62 @@
+// @file rcs-dsp-01.c
+// @date 2026.10.17
+// @info fixed point dsp primitives
+// @info everything here is integer and bit-exact between the pico and the host build, so host replays
+// @info and benches reproduce the receiver's numbers exactly; ../rcs-host/rcs-dsp-check-01 checks each
+// @info primitive against its exact (rational) definition and times it.
+// @info the square roots and the peak interpolation were private copies in rcs-cfar-01, rcs-locate-01
+// @info and rcs-detect-01; they live here now.
+
+// @require raspi pico (2020)
+
+#include "rcs-dsp-01.h"
+
+uint16_t dsp_mean_u16(const uint16_t *pX, uint uN) {
+  // rounded mean; uN < 2^20 keeps the 12 bit sum in uint32
+  uint32_t uSum = 0;
+  for (uint i = 0; i < uN; i++) uSum += pX[i];
+  return uN ? (uSum + uN / 2) / uN : 0;
+}
+
+uint32_t dsp_isqrt32(uint32_t x) {
+  // floor(sqrt(x)), bitwise
+  uint32_t uRoot = 0, uBit = 1u << 30;
+  while (uBit > x) uBit >>= 2;
+  while (uBit) {
+    if (x >= uRoot + uBit) {
+      x -= uRoot + uBit;
+      uRoot = (uRoot >> 1) + uBit;
+    } else {
+      uRoot >>= 1;
+    }
+    uBit >>= 2;
+  }
+  return uRoot;
+}
+
+uint32_t dsp_isqrt64(uint64_t x) {
+  // floor(sqrt(x)), bitwise
+  uint64_t uRoot = 0, uBit = 1ull << 62;
+  while (uBit > x) uBit >>= 2;
+  while (uBit) {
+    if (x >= uRoot + uBit) {
+      x -= uRoot + uBit;
+      uRoot = (uRoot >> 1) + uBit;
+    } else {
+      uRoot >>= 1;
+    }
+    uBit >>= 2;
+  }
+  return (uint32_t)uRoot;
+}
+
+int32_t dsp_parabola_q8(int64_t a, int64_t b, int64_t c) {
+  // vertex of the parabola through (-1, a), (0, b), (1, c) relative to the middle sample, Q8:
+  // (a - c) / (2 (a - 2b + c)), truncated toward zero and clamped to +-1/2. 0 when b is not a peak.
+  int64_t iDen = 2 * (a - 2 * b + c);   // < 0 at a true peak
+  if (iDen >= 0) return 0;
+  int64_t iDeltaQ8 = ((a - c) << DSP_PEAK_Q) / iDen;
+  if (iDeltaQ8 > (1 << (DSP_PEAK_Q - 1))) iDeltaQ8 = 1 << (DSP_PEAK_Q - 1);
+  if (iDeltaQ8 < -(1 << (DSP_PEAK_Q - 1))) iDeltaQ8 = -(1 << (DSP_PEAK_Q - 1));
+  return (int32_t)iDeltaQ8;
+}
@@ -0,0 +1,53 @@
+// @file rcs-dsp-01.h
+// @date 2026.10.17
+// @info fixed point dsp primitives header; the receive path from adc counts to arrivals without floats
+// @info the M0+ has no fpu: every float op is a soft-float library call of tens to hundreds of cycles,
+// @info while the single cycle multiplier and the sio divider (8 cycles) make the integer forms below a
+// @info few cycles each. formats are named in the function: _q8 is 8 fraction bits.
+// @info only what the receive path calls lives here; a primitive comes in with its first caller.
+// @info scaling:       dsp_mv_to_counts, dsp_div_round
+// @info averaging:     dsp_mean_u16 (adc_avg_n)
+// @info correlation:   dsp_mag2, dsp_isqrt32, dsp_isqrt64
+// @info interpolation: dsp_parabola_q8 (peak)
+
+#ifndef RCS_DSP_01_H
+#define RCS_DSP_01_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <sys/types.h> // uint
+
+#define DSP_ADC_BITS     12
+#define DSP_ADC_VREF_MV  3300     // adc full scale; G_adc_cf is the same (/ 3.3 4096) as a float
+#define DSP_SOUND_MM_S   343000   // speed of sound at 20C
+#define DSP_PEAK_Q       8        // dsp_parabola_q8() fraction bits
+
+// scaling
+static inline int32_t dsp_div_round(int32_t iNum, int32_t iDen) {
+  // iNum / iDen rounded half away from zero; iDen > 0. one sio divide on the rp2040
+  return (iNum >= 0) ? (iNum + iDen / 2) / iDen : -((-iNum + iDen / 2) / iDen);
+}
+
+static inline uint16_t dsp_mv_to_counts(uint32_t uMv) {
+  // millivolts to adc counts, truncated like the float threshold it replaces (fAdcThreshold / G_adc_cf)
+  return (uint16_t)((uMv << DSP_ADC_BITS) / DSP_ADC_VREF_MV);
+}
+
+// averaging
+uint16_t dsp_mean_u16(const uint16_t *pX, uint uN);
+
+// correlation
+uint32_t dsp_isqrt32(uint32_t x);
+uint32_t dsp_isqrt64(uint64_t x);
+
+static inline uint32_t dsp_mag2(int32_t iI, int32_t iQ, uint uShift) {
+  // squared magnitude of a quadrature pair after a shift; |sum >> uShift| < 2^15 keeps it in uint32
+  iI >>= uShift;
+  iQ >>= uShift;
+  return (uint32_t)(iI * iI) + (uint32_t)(iQ * iQ);
+}
+
+// interpolation
+int32_t dsp_parabola_q8(int64_t a, int64_t b, int64_t c);
+
+#endif // RCS_DSP_01_H
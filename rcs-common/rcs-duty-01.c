@@ -0,0 +1,55 @@
+// @file rcs-duty-01.c
+// @date 2026.10.17
+// @info duty cycle accounting (see rcs-duty-01.h)
+
+#include "rcs-duty-01.h"
+
+static void duty_span(duty_t *pD, uint64_t uNowUs) {
+  // close the span since uMarkUs into the ping tally and the totals
+  uint32_t uUs = (uint32_t)(uNowUs - pD->uMarkUs);
+  pD->uMarkUs = uNowUs;
+  if (pD->bAsleep) {
+    pD->uPingAsleepUs += uUs;
+    pD->uAsleepRemUs += uUs;
+    pD->uAsleepMs += pD->uAsleepRemUs / 1000;
+    pD->uAsleepRemUs %= 1000;
+  } else {
+    pD->uPingAwakeUs += uUs;
+    pD->uAwakeRemUs += uUs;
+    pD->uAwakeMs += pD->uAwakeRemUs / 1000;
+    pD->uAwakeRemUs %= 1000;
+  }
+}
+
+void duty_init(duty_t *pD, uint64_t uNowUs) {
+  // also the reset, done by the writer; awake from uNowUs
+  pD->uPings = pD->uSleeps = 0;
+  pD->uAwakeMs = pD->uAsleepMs = 0;
+  pD->uLastAwakeUs = pD->uLastAsleepUs = 0;
+  pD->uAwakeRemUs = pD->uAsleepRemUs = 0;
+  pD->uPingAwakeUs = pD->uPingAsleepUs = 0;
+  pD->uMarkUs = uNowUs;
+  pD->bAsleep = false;
+}
+
+void duty_sleep(duty_t *pD, uint64_t uNowUs) {
+  if (pD->bAsleep) return;
+  duty_span(pD, uNowUs);
+  pD->bAsleep = true;
+  pD->uSleeps++;
+}
+
+void duty_wake(duty_t *pD, uint64_t uNowUs) {
+  if (!pD->bAsleep) return;
+  duty_span(pD, uNowUs);
+  pD->bAsleep = false;
+}
+
+void duty_ping(duty_t *pD, uint64_t uNowUs) {
+  // once per window, after it; the ping's tally runs from the previous call
+  duty_span(pD, uNowUs);
+  pD->uLastAwakeUs = pD->uPingAwakeUs;
+  pD->uLastAsleepUs = pD->uPingAsleepUs;
+  pD->uPingAwakeUs = pD->uPingAsleepUs = 0;
+  pD->uPings++;
+}
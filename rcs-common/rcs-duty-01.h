@@ -0,0 +1,43 @@
+// @file rcs-duty-01.h
+// @date 2026.10.17
+// @info duty cycle accounting header; time core 1 spends awake (adc on, scanning) against asleep
+// @info (adc powered down, core in wfe, capture_sleep_until()) per ping, for a battery powered base.
+// @info the writer (core 1) closes a span at every transition and a tally at every ping; totals
+// @info are 32 bit words in ms with the us remainder kept aside, so the reader (core 0, serial
+// @info query) never sees a torn value. cycles are at DUTY_SYS_MHZ, the rp2040 default clk_sys.
+
+#ifndef RCS_DUTY_01_H
+#define RCS_DUTY_01_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <sys/types.h> // uint
+
+#define DUTY_SYS_MHZ 125 // clk_sys; cycles per us
+
+typedef struct {
+  volatile uint32_t uPings;      // pings tallied
+  volatile uint32_t uSleeps;     // times asleep
+  volatile uint32_t uAwakeMs;    // totals
+  volatile uint32_t uAsleepMs;
+  volatile uint32_t uLastAwakeUs;  // the last ping's
+  volatile uint32_t uLastAsleepUs;
+  // writer only
+  uint32_t uAwakeRemUs, uAsleepRemUs; // under a ms, not yet in the totals
+  uint32_t uPingAwakeUs, uPingAsleepUs;
+  uint64_t uMarkUs;              // start of the current span
+  bool     bAsleep;
+} duty_t;
+
+void duty_init(duty_t *pD, uint64_t uNowUs);
+void duty_sleep(duty_t *pD, uint64_t uNowUs);
+void duty_wake(duty_t *pD, uint64_t uNowUs);
+void duty_ping(duty_t *pD, uint64_t uNowUs);
+
+static inline uint32_t duty_awake_permille(const duty_t *pD) {
+  // reader side; awake share of the tallied time
+  uint64_t uAwake = pD->uAwakeMs, uTotal = uAwake + pD->uAsleepMs;
+  return uTotal ? (uint32_t)(uAwake * 1000 / uTotal) : 1000;
+}
+
+#endif // RCS_DUTY_01_H
@@ -0,0 +1,61 @@
+// @file rcs-echo-01.c
+// @date 2026.10.17
+// @info multi-echo list
+// @info detect_run() returns at each finished peak with the rest of its chunk unconsumed, so the
+// @info ring range is fed again from pD->uIdx until it is used up; no sample is processed twice.
+// @info the list is kept sorted on insert (at most ECHO_MAX moves), so it is ranked when the window
+// @info ends without a sort pass.
+
+#include "rcs-echo-01.h"
+#include "rcs-capture-01.h" // G_uCaptureRing, ring geometry
+
+void echo_init(echo_list_t *pE) {
+  // empty list; the detector is set up for the window separately (detect_init)
+  pE->uCount = 0;
+  pE->uFound = 0;
+}
+
+static void echo_add(echo_list_t *pE, const detect_t *pD, const detect_result_t *pR) {
+  // insert by magnitude; a full list drops its weakest
+  uint i = (pE->uCount < ECHO_MAX) ? pE->uCount++ : ECHO_MAX;
+  for (; i > 0 && pE->echo[i - 1].uPeakMag < pR->uPeakMag; i--) {
+    if (i < ECHO_MAX) pE->echo[i] = pE->echo[i - 1];
+  }
+  pE->uFound++;
+  if (i >= ECHO_MAX) return;
+  echo_t *p = &pE->echo[i];
+  p->iArrivalQ8 = pR->iArrivalQ8;
+  p->uPeakMag = pR->uPeakMag;
+  p->uAmplitude = detect_amplitude_for_mag(pD, pR->uPeakMag);
+  p->uWidth = pR->uWidth;
+  p->uConfidence = pR->uConfidence;
+} // end static void echo_add(...)
+
+uint echo_scan_ring(echo_list_t *pE, detect_t *pD, uint64_t uFrom, uint64_t uTo) {
+  // run the detector over absolute capture ring range [uFrom, uTo), uFrom == pD->uIdx, keeping every
+  // arrival; returns the arrivals found in this range
+  detect_result_t result;
+  uint uFound = pE->uFound;
+  while (uFrom < uTo) {
+    uint uPos = uFrom & (CAPTURE_RING_LEN - 1);
+    uint uLen = CAPTURE_RING_LEN - uPos;
+    if (uTo - uFrom < uLen) uLen = uTo - uFrom;
+    if (detect_run(pD, &G_uCaptureRing[uPos], uLen, &result)) echo_add(pE, pD, &result);
+    uFrom = pD->uIdx;
+  }
+  return pE->uFound - uFound;
+} // end uint echo_scan_ring(...)
+
+int echo_direct(const echo_list_t *pE) {
+  // index of the direct path: the earliest arrival with at least ECHO_DIRECT_Q8 of the strongest
+  // amplitude (magnitude is amplitude squared). a late echo stronger than the direct path (a
+  // reflector nearer the receiver) does not take the range, nor does a weak noise peak ahead of it.
+  // -1 if the list is empty
+  if (!pE->uCount) return -1;
+  uint64_t uMin = ((uint64_t)pE->echo[0].uPeakMag * ECHO_DIRECT_Q8 * ECHO_DIRECT_Q8) >> 16;
+  int iDirect = 0;
+  for (uint i = 1; i < pE->uCount; i++) {
+    if (pE->echo[i].uPeakMag >= uMin && pE->echo[i].iArrivalQ8 < pE->echo[iDirect].iArrivalQ8) iDirect = i;
+  }
+  return iDirect;
+} // end int echo_direct(...)
@@ -0,0 +1,39 @@
+// @file rcs-echo-01.h
+// @date 2026.10.17
+// @info multi-echo list header
+// @info every arrival in a window instead of the first one: the matched filter (rcs-detect-01) runs
+// @info on through the window and each burst peak it finishes is kept with its time, amplitude and
+// @info width, strongest first. one pass over the samples, the same per sample cost as the first
+// @info arrival scan; the window just is not cut short. the direct path is the earliest arrival that
+// @info is not much weaker than the strongest (echo_direct); the others are ground bounce, obstacles.
+
+#ifndef RCS_ECHO_01_H
+#define RCS_ECHO_01_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <sys/types.h> // uint
+#include "rcs-detect-01.h"
+
+#define ECHO_MAX        8   // arrivals kept per window; weaker ones beyond this are counted, not kept
+#define ECHO_DIRECT_Q8  64  // direct path: earliest arrival with at least (/ 64 256.0) 1/4 the strongest amplitude
+
+typedef struct {
+  int64_t  iArrivalQ8;   // absolute sample index of the burst start, Q8
+  uint32_t uPeakMag;     // correlation magnitude; the ranking key
+  uint16_t uAmplitude;   // burst amplitude, adc counts (detect_amplitude_for_mag)
+  uint16_t uWidth;       // samples over half amplitude (detect_result_t)
+  uint8_t  uConfidence;
+} echo_t;
+
+typedef struct {
+  echo_t   echo[ECHO_MAX]; // strongest first
+  uint     uCount;
+  uint     uFound;         // arrivals seen, including any past ECHO_MAX
+} echo_list_t;
+
+void echo_init(echo_list_t *pE);
+uint echo_scan_ring(echo_list_t *pE, detect_t *pD, uint64_t uFrom, uint64_t uTo);
+int echo_direct(const echo_list_t *pE);
+
+#endif // RCS_ECHO_01_H
@@ -0,0 +1,45 @@
+// @file rcs-hal-01.h
+// @date 2026.10.17
+// @info hardware abstraction layer header; selects the pico or linux host backend
+// @info the rx/tx firmware and rcs-utils call hal_* instead of the pico sdk, so the same timing
+// @info logic builds on target and as a native executable (../rcs-host)
+
+// @info backends
+//   rcs-hal-pico-01.h  static inline wrappers around the pico sdk; no call overhead on target
+//   rcs-hal-pico-01.c  pico backend state and callbacks (burst, flash writes); built by the pico targets
+//   rcs-hal-host-01.h  virtual clock, sample file driven adc, logged gpio (../rcs-host/rcs-hal-host-01.c)
+// @info build with RCS_HOST defined to select the host backend
+
+// api (both backends)
+//   time:   hal_time_us, hal_busy_wait_us, hal_busy_wait_ms, hal_sleep_ms, hal_sleep_until_us (low power
+//           wait to an absolute hal_time_us; pico sleep_until(), wfe between timer alarms)
+//   gpio:   hal_gpio_init, hal_gpio_set_dir, hal_gpio_put, hal_gpio_get, hal_gpio_put_masked,
+//           hal_gpio_pull_up, hal_gpio_pull_down
+//   adc:    hal_adc_init, hal_adc_gpio_init, hal_adc_select_input, hal_adc_read
+//   pwm:    hal_pwm_init, hal_pwm_set_enabled, hal_pwm_set_level (channel a; 0 holds the output low; pico:
+//           targets linking hardware_pwm)
+//   timer:  hal_add_repeating_timer_ms (pico add_repeating_timer_ms semantics, incl. negative period),
+//           hal_timer_set_period_ms (from the callback; takes effect for the next period),
+//           hal_add_alarm_in_us (one-shot, irq context like the timer; the callback returns 0)
+//   burst:  hal_burst_init, hal_burst_set_carrier, hal_burst_fire (pio carrier burst of burst_pattern()
+//           words, plain or coded, rcs-burst-01.*; pico: RCS_BURST_PIO targets)
+//   stdio:  hal_stdio_init, hal_usb_connected, hal_getchar_timeout_us (HAL_NO_CHAR on timeout),
+//           hal_stdio_write (raw bytes, no crlf translation)
+//   core:   hal_multicore_launch_core1 (pico: targets linking pico_multicore)
+//   flash:  hal_flash_read, hal_flash_erase (one HAL_FLASH_SECTOR), hal_flash_program (HAL_FLASH_PAGE
+//           multiples), offsets from the start of flash; hal_flash_core_init on the other core lets
+//           it be paused while flash is written (pico: targets linking hardware_flash and pico_flash)
+
+#ifndef RCS_HAL_01_H
+#define RCS_HAL_01_H
+
+#define HAL_GPIO_OUT true
+#define HAL_GPIO_IN  false
+
+#if defined(RCS_HOST)
+#include "rcs-hal-host-01.h"
+#else
+#include "rcs-hal-pico-01.h"
+#endif
+
+#endif // RCS_HAL_01_H
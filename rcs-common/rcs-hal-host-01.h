@@ -0,0 +1,105 @@
+// @file rcs-hal-host-01.h
+// @date 2026.10.17
+// @info hal linux host backend header (see rcs-hal-01.h); implemented in ../rcs-host/rcs-hal-host-01.c
+// @info time is virtual: it advances only through hal calls (adc conversions, busy waits, sleeps,
+// @info polls), and repeating timer callbacks fire from inside those calls like an irq would
+// @info the pio burst is emulated: its gpio edges land at the exact virtual times of the pio program
+// @info (rcs-burst-01.*) and cost no cpu time
+
+// @info environment
+//   RCS_HOST_ADC=<file.dat>      adc sample stream (ascii volts); run ends when it is exhausted
+//   RCS_HOST_ADC_HZ=<hz>         sample rate of RCS_HOST_ADC (default 500000)
+//   RCS_HOST_RUN_MS=<ms>         run length limit in virtual ms (default 60000)
+//   RCS_HOST_PRESS=<gp>,<ms>,<ms> pull gpio gp low at virtual time, for a duration (switch press)
+//   RCS_HOST_GPIO_TRACE=<file>   log '<ns> <gp> <value>' for every gpio output change
+//   RCS_HOST_INPUT=<text>        serial input, one char per hal_getchar_timeout_us() call (e.g. $'p40\r');
+//                                '{<ms>}' holds the rest until that virtual time (e.g. $'p40\r{9000}s\r')
+//   RCS_HOST_FLASH=<file>        flash image, HAL_FLASH_SIZE bytes; read at start (missing: erased) and
+//                                written back after every erase/program, so records outlive the run
+//   RCS_HOST_ECHO=<us>:<counts>[,...] every pio burst comes back into the adc stream after us, at counts
+//                                amplitude, each tap a copy on the burst's carrier and chip polarity with
+//                                a HAL_HOST_ECHO_RING_US linear ring-down; 0 us is the transducer ring-down
+//                                of a board that sends and receives (rcs-mono01-01)
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <sys/types.h> // uint
+
+#define PICO_DEFAULT_LED_PIN 25
+#define HAL_NO_CHAR          (-1)
+#define HAL_PWM_GPIO_BASE    0x100  // gpio trace id offset for pwm events; 1 switching, 0 output low
+#define HAL_HOST_SYS_HZ      125000000 // clk_sys; pio clock divider
+#define HAL_FLASH_SIZE       (2 * 1024 * 1024) // pico w25q16
+#define HAL_FLASH_SECTOR     4096
+#define HAL_FLASH_PAGE       256
+
+typedef struct hal_timer hal_timer_t;
+typedef bool (*hal_timer_cb_t)(hal_timer_t *t);
+typedef int64_t (*hal_alarm_cb_t)(int32_t iId, void *pUser);
+struct hal_timer {
+  int64_t        iPeriodUs;  // pico semantics; negative: period start to start; 0: the callback sets uNextNs
+  uint64_t       uNextNs;    // virtual time of next callback
+  hal_timer_cb_t cb;
+  void          *pUser;
+  hal_timer_t   *pNext;
+  bool           bHw;        // emulated hardware (pio), not a cpu callback; not in the callback statistics
+};
+
+// time
+uint64_t hal_time_us(void);
+void hal_busy_wait_us(uint32_t uUs);
+void hal_busy_wait_ms(uint32_t uMs);
+void hal_sleep_ms(uint32_t uMs);
+void hal_sleep_until_us(uint64_t uUs);
+
+// gpio
+void hal_gpio_init(uint gp);
+void hal_gpio_set_dir(uint gp, bool bOut);
+void hal_gpio_put(uint gp, bool bValue);
+bool hal_gpio_get(uint gp);
+void hal_gpio_put_masked(uint32_t uMask, uint32_t uValue);
+void hal_gpio_pull_up(uint gp);
+void hal_gpio_pull_down(uint gp);
+
+// adc
+void hal_adc_init(void);
+void hal_adc_gpio_init(uint gp);
+void hal_adc_select_input(uint uInput);
+uint16_t hal_adc_read(void);
+
+// pwm
+uint hal_pwm_init(uint gp, float fClkDiv, uint16_t uWrap, uint16_t uChanLevel);
+void hal_pwm_set_enabled(uint uSliceNum, bool bEnabled);
+void hal_pwm_set_level(uint uSliceNum, uint16_t uLevel);
+
+// repeating timer
+bool hal_add_repeating_timer_ms(int32_t iMs, hal_timer_cb_t cb, void *pUser, hal_timer_t *pTimer);
+void hal_timer_set_period_ms(hal_timer_t *pTimer, int32_t iMs);
+bool hal_add_alarm_in_us(uint32_t uUs, hal_alarm_cb_t cb, void *pUser);
+
+// transmit burst
+bool hal_burst_init(uint gpBase, uint32_t uCarrierHz);
+void hal_burst_set_carrier(uint32_t uCarrierHz);
+void hal_burst_fire(const uint32_t *pWords, uint uWords);
+
+// stdio
+void hal_stdio_init(void);
+bool hal_usb_connected(void);
+int hal_getchar_timeout_us(uint32_t uUs);
+void hal_stdio_write(const void *p, uint uN);
+
+// multicore
+void hal_multicore_launch_core1(void (*fnEntry)(void));
+
+// flash
+void hal_flash_core_init(void);
+void hal_flash_read(uint32_t uOffset, void *p, uint uN);
+bool hal_flash_erase(uint32_t uOffset);
+bool hal_flash_program(uint32_t uOffset, const void *p, uint uN);
+
+// host only; virtual clock and adc stream access for host stand-ins (capture ring)
+uint64_t hal_host_time_ns(void);
+void hal_host_tick(uint32_t uNs);
+uint16_t hal_host_adc_at(uint64_t uNs);
+void hal_host_adc_power(bool bOn); // capture ring on/off; adc on time in the summary
@@ -0,0 +1,94 @@
+// @file rcs-hal-pico-01.c
+// @date 2026.10.17
+// @info hal pico backend, the parts with state or callbacks (see rcs-hal-pico-01.h); one copy per target
+// @info burst: pio0 state machine and dma channel claimed once by hal_burst_init() (RCS_BURST_PIO targets)
+// @info flash: erase and program through flash_safe_execute() (targets linking pico_flash)
+
+// @require raspi pico (2020); not built by ../rcs-host
+
+#include "rcs-hal-01.h"
+#if defined(RCS_BURST_PIO)
+#include "hardware/pio.h"
+#include "hardware/clocks.h"
+#include "hardware/dma.h"
+#include "rcs-burst-01.h"
+#include "rcs-burst-01.pio.h" // pico_generate_pio_header()
+#endif
+
+// transmit burst; pio0 state machine running rcs-burst-01.pio on pins gpBase, gpBase+1, fed the
+// burst pattern words by a dma channel (tx, mono)
+#if defined(RCS_BURST_PIO)
+static uint S_uBurstSm;
+static int  S_iBurstDma = -1;
+
+bool hal_burst_init(uint gpBase, uint32_t uCarrierHz) {
+  // once; false, with nothing left claimed, if pio0 has no free state machine or program space, or no
+  // dma channel is free
+  int iSm = pio_claim_unused_sm(pio0, false);
+  int iDma = dma_claim_unused_channel(false);
+  if (iSm < 0 || iDma < 0 || !pio_can_add_program(pio0, &rcs_burst_program)) {
+    if (iSm >= 0) pio_sm_unclaim(pio0, iSm);
+    if (iDma >= 0) dma_channel_unclaim(iDma);
+    return false;
+  }
+  uint uOffset = pio_add_program(pio0, &rcs_burst_program);
+  S_uBurstSm = iSm;
+  S_iBurstDma = iDma;
+  pio_gpio_init(pio0, gpBase);
+  pio_gpio_init(pio0, gpBase + 1);
+  pio_sm_set_pins_with_mask(pio0, iSm, 0, 3u << gpBase);
+  pio_sm_set_consistent_pindirs(pio0, iSm, gpBase, 2, true);
+  pio_sm_config c = rcs_burst_program_get_default_config(uOffset);
+  sm_config_set_out_pins(&c, gpBase, 2);
+  sm_config_set_set_pins(&c, gpBase, 2);
+  sm_config_set_out_shift(&c, true, true, 32); // lsb (first half cycle) first, autopull
+  sm_config_set_fifo_join(&c, PIO_FIFO_JOIN_TX);
+  uint32_t uDivQ8 = burst_clkdiv_q8(clock_get_hz(clk_sys), uCarrierHz);
+  sm_config_set_clkdiv_int_frac(&c, uDivQ8 >> 8, uDivQ8 & 0xff);
+  pio_sm_init(pio0, iSm, uOffset, &c);
+  dma_channel_config d = dma_channel_get_default_config(iDma);
+  channel_config_set_transfer_data_size(&d, DMA_SIZE_32);
+  channel_config_set_read_increment(&d, true);
+  channel_config_set_write_increment(&d, false);
+  channel_config_set_dreq(&d, pio_get_dreq(pio0, iSm, true));
+  dma_channel_configure(iDma, &d, &pio0->txf[iSm], NULL, 0, false);
+  pio_sm_set_enabled(pio0, iSm, true);
+  return true;
+} // end bool hal_burst_init(...)
+
+void hal_burst_set_carrier(uint32_t uCarrierHz) {
+  // between bursts
+  uint32_t uDivQ8 = burst_clkdiv_q8(clock_get_hz(clk_sys), uCarrierHz);
+  pio_sm_set_clkdiv_int_frac(pio0, S_uBurstSm, uDivQ8 >> 8, uDivQ8 & 0xff);
+}
+
+void hal_burst_fire(const uint32_t *pWords, uint uWords) {
+  // never blocks; pWords (burst_pattern()) must stay unchanged until the burst is out
+  dma_channel_transfer_from_buffer_now(S_iBurstDma, pWords, uWords);
+}
+#endif
+
+// flash erase and program; the operation runs from flash_safe_execute() with the other core paused
+#if defined(LIB_PICO_FLASH)
+typedef struct {
+  uint32_t    uOffset;
+  const void *p;   // NULL: erase a sector
+  uint        uN;
+} hal_flash_op_t;
+
+static void hal_flash_op(void *pParam) {
+  const hal_flash_op_t *pOp = pParam;
+  if (pOp->p) flash_range_program(pOp->uOffset, pOp->p, pOp->uN);
+  else flash_range_erase(pOp->uOffset, FLASH_SECTOR_SIZE);
+}
+
+bool hal_flash_erase(uint32_t uOffset) {
+  hal_flash_op_t op = { uOffset, NULL, 0 };
+  return flash_safe_execute(hal_flash_op, &op, UINT32_MAX) == PICO_OK;
+}
+
+bool hal_flash_program(uint32_t uOffset, const void *p, uint uN) {
+  hal_flash_op_t op = { uOffset, p, uN };
+  return flash_safe_execute(hal_flash_op, &op, UINT32_MAX) == PICO_OK;
+}
+#endif
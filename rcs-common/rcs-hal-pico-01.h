@@ -0,0 +1,115 @@
+// @file rcs-hal-pico-01.h
+// @date 2026.10.17
+// @info hal pico backend; static inline wrappers around the pico sdk (see rcs-hal-01.h); the parts
+// @info with state or callbacks (burst, flash writes) are in rcs-hal-pico-01.c, which pico targets using them build
+
+// @require raspi pico (2020); pico_stdlib, hardware_adc, hardware_pwm (tx, mono), hardware_pio, hardware_dma and
+//          the rcs-burst-01.pio header with RCS_BURST_PIO defined (tx, mono), hardware_flash and pico_flash (rx)
+
+#include "pico/stdlib.h"
+#include "hardware/gpio.h"
+#include "hardware/adc.h"
+#include "tusb.h"  // tud_cdc_connected()
+#if defined(LIB_HARDWARE_PWM)
+#include "hardware/pwm.h"
+#endif
+#if defined(LIB_PICO_MULTICORE)
+#include "pico/multicore.h"
+#endif
+#if defined(LIB_PICO_FLASH)
+#include <string.h> // memcpy
+#include "hardware/flash.h"
+#include "pico/flash.h"
+#endif
+
+#define HAL_NO_CHAR PICO_ERROR_TIMEOUT
+
+typedef struct repeating_timer hal_timer_t;
+typedef bool (*hal_timer_cb_t)(hal_timer_t *t);
+typedef alarm_callback_t hal_alarm_cb_t;
+
+// time
+static inline uint64_t hal_time_us(void) { return time_us_64(); }
+static inline void hal_busy_wait_us(uint32_t uUs) { busy_wait_us_32(uUs); }
+static inline void hal_busy_wait_ms(uint32_t uMs) { busy_wait_ms(uMs); }
+static inline void hal_sleep_ms(uint32_t uMs) { sleep_ms(uMs); }
+static inline void hal_sleep_until_us(uint64_t uUs) { sleep_until(from_us_since_boot(uUs)); }
+
+// gpio
+static inline void hal_gpio_init(uint gp) { gpio_init(gp); }
+static inline void hal_gpio_set_dir(uint gp, bool bOut) { gpio_set_dir(gp, bOut); }
+static inline void hal_gpio_put(uint gp, bool bValue) { gpio_put(gp, bValue); }
+static inline bool hal_gpio_get(uint gp) { return gpio_get(gp); }
+static inline void hal_gpio_put_masked(uint32_t uMask, uint32_t uValue) { gpio_put_masked(uMask, uValue); }
+static inline void hal_gpio_pull_up(uint gp) { gpio_pull_up(gp); }
+static inline void hal_gpio_pull_down(uint gp) { gpio_pull_down(gp); }
+
+// adc
+static inline void hal_adc_init(void) { adc_init(); }
+static inline void hal_adc_gpio_init(uint gp) { adc_gpio_init(gp); }
+static inline void hal_adc_select_input(uint uInput) { adc_select_input(uInput); }
+static inline uint16_t hal_adc_read(void) { return adc_read(); }
+
+// pwm; targets linking hardware_pwm only. channel A of the gpio slice, returns the slice number
+#if defined(LIB_HARDWARE_PWM)
+static inline uint hal_pwm_init(uint gp, float fClkDiv, uint16_t uWrap, uint16_t uChanLevel) {
+  gpio_set_function(gp, GPIO_FUNC_PWM);
+  uint uSliceNum = pwm_gpio_to_slice_num(gp);
+  pwm_set_clkdiv(uSliceNum, fClkDiv);
+  pwm_set_wrap(uSliceNum, uWrap);
+  pwm_set_chan_level(uSliceNum, PWM_CHAN_A, uChanLevel);
+  return uSliceNum;
+}
+static inline void hal_pwm_set_enabled(uint uSliceNum, bool bEnabled) { pwm_set_enabled(uSliceNum, bEnabled); }
+static inline void hal_pwm_set_level(uint uSliceNum, uint16_t uLevel) { pwm_set_chan_level(uSliceNum, PWM_CHAN_A, uLevel); }
+#endif
+
+// repeating timer
+static inline bool hal_add_repeating_timer_ms(int32_t iMs, hal_timer_cb_t cb, void *pUser, hal_timer_t *pTimer) {
+  return add_repeating_timer_ms(iMs, cb, pUser, pTimer);
+}
+static inline void hal_timer_set_period_ms(hal_timer_t *pTimer, int32_t iMs) { pTimer->delay_us = (int64_t)iMs * 1000; }
+
+// one-shot alarm; the callback returns 0
+static inline bool hal_add_alarm_in_us(uint32_t uUs, hal_alarm_cb_t cb, void *pUser) {
+  return add_alarm_in_us(uUs, cb, pUser, true) >= 0;
+}
+
+// transmit burst; pio0 state machine running rcs-burst-01.pio on pins gpBase, gpBase+1, fed the
+// burst pattern words by a dma channel (tx, mono)
+#if defined(RCS_BURST_PIO)
+bool hal_burst_init(uint gpBase, uint32_t uCarrierHz);
+void hal_burst_set_carrier(uint32_t uCarrierHz);
+void hal_burst_fire(const uint32_t *pWords, uint uWords);
+#endif
+
+// stdio
+static inline void hal_stdio_init(void) { stdio_init_all(); }
+static inline bool hal_usb_connected(void) { return tud_cdc_connected(); }
+static inline int hal_getchar_timeout_us(uint32_t uUs) { return getchar_timeout_us(uUs); }
+static inline void hal_stdio_write(const void *p, uint uN) {
+  // binary safe; putchar_raw skips stdio crlf translation
+  const uint8_t *pB = p;
+  while (uN--) putchar_raw(*pB++);
+  stdio_flush();
+}
+
+// multicore; targets linking pico_multicore only
+#if defined(LIB_PICO_MULTICORE)
+static inline void hal_multicore_launch_core1(void (*fnEntry)(void)) { multicore_launch_core1(fnEntry); }
+#endif
+
+// flash; targets linking pico_flash only. xip reads; erase and program run through
+// flash_safe_execute(), which pauses the other core (it must have called hal_flash_core_init())
+// and masks irqs while flash is off the bus. dma keeps running, so the capture ring does too
+#if defined(LIB_PICO_FLASH)
+#define HAL_FLASH_SIZE   PICO_FLASH_SIZE_BYTES
+#define HAL_FLASH_SECTOR FLASH_SECTOR_SIZE // 4096
+#define HAL_FLASH_PAGE   FLASH_PAGE_SIZE   // 256
+static inline void hal_flash_core_init(void) { flash_safe_execute_core_init(); }
+static inline void hal_flash_read(uint32_t uOffset, void *p, uint uN) {
+  memcpy(p, (const void *)(XIP_BASE + uOffset), uN);
+}
+bool hal_flash_erase(uint32_t uOffset);
+bool hal_flash_program(uint32_t uOffset, const void *p, uint uN);
+#endif
@@ -0,0 +1,45 @@
+// @file rcs-instr-01.c
+// @date 2026.10.17
+// @info hot path instrumentation; histogram reset and the text dump (core 0 side)
+// @info dump format (tsv; the binary telemetry decoder skips it as noise between frames):
+//   # instr name count max last p50 p99 |bins: <lower edge of each bin>
+//   instr <name> <count> <max> <last> <p50> <p99> | <count per bin, from bin 0>
+// @info percentiles are the upper edge of the bin they fall in (p99 = 2048 means < 2048), or the max if lower
+
+#include <stdio.h>
+#include <inttypes.h> // printf("%" PRIu64/d64/x64 "\n", t)
+#include "rcs-instr-01.h"
+
+void instr_hist_reset(instr_hist_t *pH) {
+  // writer side
+  for (uint k = 0; k < INSTR_BINS; k++) pH->uBin[k] = 0;
+  pH->uCount = 0;
+  pH->uMax = 0;
+  pH->uLast = 0;
+}
+
+uint32_t instr_hist_percentile(const instr_hist_t *pH, uint uPct) {
+  // upper edge of the bin holding the uPct-th percentile, capped at the max (the open last bin)
+  uint32_t uCount = pH->uCount;
+  if (!uCount) return 0;
+  uint64_t uNeed = ((uint64_t)uCount * uPct + 99) / 100;
+  uint64_t uSeen = 0;
+  for (uint k = 0; k < INSTR_BINS - 1; k++) {
+    uSeen += pH->uBin[k];
+    if (uSeen >= uNeed) return (k && (1u << k) < pH->uMax) ? 1u << k : (k ? pH->uMax : 0);
+  }
+  return pH->uMax;
+}
+
+void instr_hist_print_header(void) {
+  printf("# instr\tname\tcount\tmax\tlast\tp50\tp99\t|bins: 0");
+  for (uint k = 1; k < INSTR_BINS; k++) printf(" %" PRIu32 "%s", instr_bin_floor(k), k == INSTR_BINS - 1 ? "+" : "");
+  printf("\n");
+}
+
+void instr_hist_print(const char *sName, const instr_hist_t *pH) {
+  printf("instr\t%s\t%" PRIu32 "\t%" PRIu32 "\t%" PRIu32 "\t%" PRIu32 "\t%" PRIu32 "\t|", sName, pH->uCount,
+         pH->uMax, pH->uLast, instr_hist_percentile(pH, 50), instr_hist_percentile(pH, 99));
+  for (uint k = 0; k < INSTR_BINS; k++) printf(" %" PRIu32, pH->uBin[k]);
+  printf("\n");
+}
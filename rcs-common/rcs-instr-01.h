@@ -0,0 +1,46 @@
+// @file rcs-instr-01.h
+// @date 2026.10.17
+// @info hot path instrumentation header; log2 histograms and counters cheap enough for core 1
+// @info the writer (core 1) only adds: a count leading zeros and two increments per value, no lock.
+// @info the reader (core 0, serial query) copies words that may be mid-update, so a dump can be off
+// @info by the values added while it printed; never torn, every field is one 32 bit word.
+// @info a reset is requested by the reader and done by the writer (instr_reset_pending()), so the
+// @info two cores never write the same word.
+
+#ifndef RCS_INSTR_01_H
+#define RCS_INSTR_01_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <sys/types.h> // uint
+
+#define INSTR_BINS 16   // bin 0 holds 0, bin k holds [2^(k-1), 2^k), the last bin is open ended
+
+typedef struct {
+  volatile uint32_t uBin[INSTR_BINS];
+  volatile uint32_t uCount;
+  volatile uint32_t uMax;
+  volatile uint32_t uLast;
+} instr_hist_t;
+
+static inline void instr_hist_add(instr_hist_t *pH, uint32_t uValue) {
+  // writer side; one value
+  uint k = uValue ? 32 - __builtin_clz(uValue) : 0;
+  if (k >= INSTR_BINS) k = INSTR_BINS - 1;
+  pH->uBin[k]++;
+  pH->uCount++;
+  pH->uLast = uValue;
+  if (uValue > pH->uMax) pH->uMax = uValue;
+}
+
+static inline uint32_t instr_bin_floor(uint k) {
+  // smallest value in bin k
+  return k ? 1u << (k - 1) : 0;
+}
+
+void instr_hist_reset(instr_hist_t *pH);
+uint32_t instr_hist_percentile(const instr_hist_t *pH, uint uPct);
+void instr_hist_print(const char *sName, const instr_hist_t *pH);
+void instr_hist_print_header(void);
+
+#endif // RCS_INSTR_01_H
@@ -0,0 +1,176 @@
+// @file rcs-locate-01.c
+// @date 2026.10.17
+// @info 2d position from beacon ranges; fixed point extended kalman filter
+// @info constant velocity model: x += v * dt, with white acceleration noise (LOCATE_ACCEL_PSD) that
+// @info lets the velocity follow turns. a range to beacon b is |p - b|; it is linearized at the
+// @info predicted position, whose gradient is the unit vector from the beacon. one range is one
+// @info scalar update, no matrix inverse: S = H P H' + R, K = P H' / S, P in joseph form. ranges
+// @info from different beacons, at different times, in any order, all update the same state.
+// @info units are chosen so nothing needs more than int64 (64 bit products are software on the
+// @info M0+; an update is about a hundred of them): state mm and mm/s Q8 (int32, +-8km), covariance
+// @info the state units squared Q8 (position variance to (30m)^2 times a Q16 gain in int64).
+// @info the gate is one sided: an echo only ever makes a range long (the direct path is the
+// @info shortest), so a range over LOCATE_GATE variances long is skipped, while one as far short
+// @info can only be the state that is wrong (a turn the velocity missed) and is taken. a two sided
+// @info gate let a turn gate every beacon that saw the mower move away; widening it after misses
+// @info let the echoes in. LOCATE_LOST gated in a row from one beacon mean a wrong state the other
+// @info beacons agree with (a mirror position), and the state is re-opened at the beacon centroid.
+// @info limits: one range cannot tell along-track from cross-track; the position is only defined
+// @info by ranges from beacons in different directions (covariance shows it). two beacons leave
+// @info a mirror position across the line through them; start on the right side of it.
+
+#include "rcs-locate-01.h"
+#include "rcs-dsp-01.h" // dsp_isqrt64
+
+static void locate_open(locate_t *pL) {
+  // covariance back to the init values, correlations cleared
+  for (uint i = 0; i < LOCATE_N; i++) {
+    for (uint j = 0; j < LOCATE_N; j++) pL->iCov[i][j] = 0;
+  }
+  pL->iCov[LOCATE_X][LOCATE_X] = pL->iPosVar0;
+  pL->iCov[LOCATE_Y][LOCATE_Y] = pL->iPosVar0;
+  pL->iCov[LOCATE_VX][LOCATE_VX] = ((int64_t)LOCATE_SPEED_SIGMA * LOCATE_SPEED_SIGMA) << LOCATE_Q;
+  pL->iCov[LOCATE_VY][LOCATE_VY] = pL->iCov[LOCATE_VX][LOCATE_VX];
+  for (uint b = 0; b < LOCATE_BEACONS_MAX; b++) pL->uGatedRun[b] = 0;
+}
+
+static void locate_reopen(locate_t *pL) {
+  // lost: restart from the beacon centroid, at rest
+  int64_t iX = 0, iY = 0;
+  for (uint b = 0; b < pL->uBeacons; b++) {
+    iX += pL->beacon[b].iX;
+    iY += pL->beacon[b].iY;
+  }
+  pL->iState[LOCATE_X] = (iX / (int64_t)pL->uBeacons) * (1 << LOCATE_Q);
+  pL->iState[LOCATE_Y] = (iY / (int64_t)pL->uBeacons) * (1 << LOCATE_Q);
+  pL->iState[LOCATE_VX] = 0;
+  pL->iState[LOCATE_VY] = 0;
+  locate_open(pL);
+  pL->uOpened++;
+}
+
+void locate_init(locate_t *pL, const locate_beacon_t *pBeacons, uint uBeacons, int32_t iX, int32_t iY,
+                 uint32_t uSigma, uint64_t uTimeUs) {
+  // beacons in mm; start at (iX, iY) mm, give or take uSigma mm (the dock, or the beacon centroid
+  // and the yard size), at rest give or take LOCATE_SPEED_SIGMA
+  pL->uBeacons = (uBeacons < LOCATE_BEACONS_MAX) ? uBeacons : LOCATE_BEACONS_MAX;
+  for (uint b = 0; b < pL->uBeacons; b++) pL->beacon[b] = pBeacons[b];
+  pL->iState[LOCATE_X] = iX * (1 << LOCATE_Q);
+  pL->iState[LOCATE_Y] = iY * (1 << LOCATE_Q);
+  pL->iState[LOCATE_VX] = 0;
+  pL->iState[LOCATE_VY] = 0;
+  pL->iPosVar0 = ((int64_t)uSigma * uSigma) << LOCATE_Q;
+  locate_open(pL);
+  pL->uTimeUs = uTimeUs;
+  pL->uAccelPsd = LOCATE_ACCEL_PSD;
+  pL->uUpdates = 0;
+  pL->uGated = 0;
+  pL->uOpened = 0;
+} // end void locate_init(...)
+
+void locate_predict(locate_t *pL, uint64_t uTimeUs) {
+  // move the state to uTimeUs; P = F P F' + Q with F = [I dt*I; 0 I]. no-op for ranges at the
+  // state's time (several beacons from one window)
+  if (uTimeUs <= pL->uTimeUs) return;
+  uint64_t uDtUs = uTimeUs - pL->uTimeUs;
+  pL->uTimeUs = uTimeUs;
+  if (uDtUs > LOCATE_DT_MAX_US) uDtUs = LOCATE_DT_MAX_US;
+  int64_t iDt = (int64_t)((uDtUs << 16) / 1000000); // s Q16
+  pL->iState[LOCATE_X] += ((int64_t)pL->iState[LOCATE_VX] * iDt) >> 16;
+  pL->iState[LOCATE_Y] += ((int64_t)pL->iState[LOCATE_VY] * iDt) >> 16;
+
+  int64_t P[LOCATE_N][LOCATE_N];
+  for (uint i = 0; i < LOCATE_N; i++) {
+    for (uint j = i; j < LOCATE_N; j++) {
+      int64_t a = pL->iCov[i][j];
+      if (i < LOCATE_VX) a += (pL->iCov[i + 2][j] * iDt) >> 16;
+      if (j < LOCATE_VX) a += (pL->iCov[i][j + 2] * iDt) >> 16;
+      if (j < LOCATE_VX) a += (((pL->iCov[i + 2][j + 2] * iDt) >> 16) * iDt) >> 16; // i <= j
+      P[i][j] = P[j][i] = a;
+    }
+  }
+  // white acceleration q over dt: position q dt^3/3, position-velocity q dt^2/2, velocity q dt
+  int64_t iQv = ((int64_t)pL->uAccelPsd << LOCATE_Q) * iDt >> 16;
+  int64_t iQpv = ((iQv * iDt) >> 16) / 2;
+  int64_t iQp = ((iQpv * iDt) >> 16) * 2 / 3;
+  for (uint a = 0; a < 2; a++) {
+    P[a][a] += iQp;
+    P[a][a + 2] += iQpv;
+    P[a + 2][a] += iQpv;
+    P[a + 2][a + 2] += iQv;
+  }
+  for (uint i = 0; i < LOCATE_N; i++) {
+    for (uint j = 0; j < LOCATE_N; j++) pL->iCov[i][j] = P[i][j];
+  }
+} // end void locate_predict(...)
+
+bool locate_update(locate_t *pL, uint uBeacon, int32_t iRangeQ8, uint32_t uVarQ8, uint64_t uTimeUs) {
+  // one range to beacon uBeacon, mm Q8, measured at uTimeUs with variance uVarQ8 (mm^2 Q8).
+  // returns false if the range was gated (or unusable) and left the state alone
+  if (uBeacon >= pL->uBeacons) return false;
+  locate_predict(pL, uTimeUs);
+  int32_t iDx = pL->iState[LOCATE_X] - pL->beacon[uBeacon].iX * (1 << LOCATE_Q);
+  int32_t iDy = pL->iState[LOCATE_Y] - pL->beacon[uBeacon].iY * (1 << LOCATE_Q);
+  int64_t iR = dsp_isqrt64((uint64_t)((int64_t)iDx * iDx + (int64_t)iDy * iDy)); // mm Q8
+  if (iR < LOCATE_RANGE_MIN) return false;
+  int64_t iHx = ((int64_t)iDx << LOCATE_DIR_Q) / iR; // d range / d x, Q14
+  int64_t iHy = ((int64_t)iDy << LOCATE_DIR_Q) / iR;
+
+  int64_t iPH[LOCATE_N]; // P H'
+  for (uint i = 0; i < LOCATE_N; i++) {
+    iPH[i] = (pL->iCov[i][LOCATE_X] * iHx + pL->iCov[i][LOCATE_Y] * iHy) >> LOCATE_DIR_Q;
+  }
+  int64_t iS = ((iHx * iPH[LOCATE_X] + iHy * iPH[LOCATE_Y]) >> LOCATE_DIR_Q) + uVarQ8;
+  if (iS <= 0) return false;
+  int64_t iNu = (int64_t)iRangeQ8 - iR; // innovation, mm Q8
+  if (iNu > 0 && ((iNu * iNu) >> LOCATE_Q) > LOCATE_GATE * iS) {
+    pL->uGated++;
+    if (++pL->uGatedRun[uBeacon] >= LOCATE_LOST) locate_reopen(pL);
+    return false;
+  }
+  pL->uGatedRun[uBeacon] = 0;
+
+  int64_t iK[LOCATE_N]; // gain, Q16
+  for (uint i = 0; i < LOCATE_N; i++) iK[i] = (iPH[i] << LOCATE_GAIN_Q) / iS;
+  for (uint i = 0; i < LOCATE_N; i++) pL->iState[i] += (iK[i] * iNu) >> LOCATE_GAIN_Q;
+  // joseph form, P = (I - K H) P (I - K H)' + K R K': positive whatever the gain rounding. the
+  // short form P -= K (P H')' takes the difference of two nearly equal large numbers when the
+  // position is open (P/R ~ 1e6) and the Q16 gain error leaves a negative variance
+  int64_t iA[LOCATE_N][2]; // I - K H, H only has x, y; Q16 (the other columns are identity)
+  for (uint i = 0; i < LOCATE_N; i++) {
+    iA[i][LOCATE_X] = ((i == LOCATE_X) << LOCATE_GAIN_Q) - ((iK[i] * iHx) >> LOCATE_DIR_Q);
+    iA[i][LOCATE_Y] = ((i == LOCATE_Y) << LOCATE_GAIN_Q) - ((iK[i] * iHy) >> LOCATE_DIR_Q);
+  }
+  int64_t T[LOCATE_N][LOCATE_N]; // A P
+  for (uint i = 0; i < LOCATE_N; i++) {
+    for (uint j = 0; j < LOCATE_N; j++) {
+      int64_t a = (iA[i][LOCATE_X] * pL->iCov[LOCATE_X][j] + iA[i][LOCATE_Y] * pL->iCov[LOCATE_Y][j]) >> LOCATE_GAIN_Q;
+      T[i][j] = (i < LOCATE_VX) ? a : a + pL->iCov[i][j];
+    }
+  }
+  for (uint i = 0; i < LOCATE_N; i++) {
+    for (uint j = i; j < LOCATE_N; j++) { // (A P) A' + K R K'
+      int64_t a = (T[i][LOCATE_X] * iA[j][LOCATE_X] + T[i][LOCATE_Y] * iA[j][LOCATE_Y]) >> LOCATE_GAIN_Q;
+      if (j >= LOCATE_VX) a += T[i][j];
+      a += (((iK[i] * iK[j]) >> LOCATE_GAIN_Q) * uVarQ8) >> LOCATE_GAIN_Q;
+      pL->iCov[i][j] = pL->iCov[j][i] = a;
+    }
+    if (pL->iCov[i][i] < LOCATE_VAR_MIN) pL->iCov[i][i] = LOCATE_VAR_MIN;
+  }
+  pL->uUpdates++;
+  return true;
+} // end bool locate_update(...)
+
+void locate_fix(const locate_t *pL, locate_fix_t *pFix) {
+  // current estimate; the covariance says how far to trust it (and in which direction)
+  pFix->iXQ8 = pL->iState[LOCATE_X];
+  pFix->iYQ8 = pL->iState[LOCATE_Y];
+  pFix->iVxQ8 = pL->iState[LOCATE_VX];
+  pFix->iVyQ8 = pL->iState[LOCATE_VY];
+  pFix->iCovXX = pL->iCov[LOCATE_X][LOCATE_X];
+  pFix->iCovXY = pL->iCov[LOCATE_X][LOCATE_Y];
+  pFix->iCovYY = pL->iCov[LOCATE_Y][LOCATE_Y];
+  pFix->uUpdates = pL->uUpdates;
+  pFix->uGated = pL->uGated;
+  pFix->uOpened = pL->uOpened;
+}
@@ -0,0 +1,62 @@
+// @file rcs-locate-01.h
+// @date 2026.10.17
+// @info 2d position from ranges to beacons at known coordinates; fixed point ekf header
+// @info state is position and velocity in the yard plane, one range measurement per update, so a
+// @info new range costs the same whether it is the first or the thousandth and whichever beacon
+// @info it is from; nothing is re-solved. positions mm, Q8; covariance in the same units squared, Q8.
+
+#ifndef RCS_LOCATE_01_H
+#define RCS_LOCATE_01_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <sys/types.h> // uint
+
+#define LOCATE_Q           8        // state fraction bits; mm and mm/s Q8, covariance mm^2 Q8
+#define LOCATE_BEACONS_MAX 8
+#define LOCATE_GAIN_Q      16       // kalman gain fraction bits
+#define LOCATE_DIR_Q       14       // range gradient (unit vector) fraction bits
+#define LOCATE_DT_MAX_US   10000000 // longer gaps predict over this; the covariance still opens up
+#define LOCATE_SPEED_SIGMA 1000    // mm/s; velocity uncertainty at init, about a mower's top speed
+#define LOCATE_ACCEL_PSD   40000    // process noise, mm^2/s^3; (sqrt 40000) 200mm/s^2 over 1s, a mower turning
+#define LOCATE_GATE        16       // innovation^2 over variance; a range 4 sigma long is an echo, not the beacon
+#define LOCATE_LOST        12       // consecutive gated ranges from one beacon that re-open the state
+#define LOCATE_RANGE_MIN   256      // mm Q8; closer than 1mm to a beacon the range gradient is undefined
+#define LOCATE_VAR_MIN     1        // covariance diagonal floor, Q8; fixed point rounding keeps it positive
+
+enum { LOCATE_X, LOCATE_Y, LOCATE_VX, LOCATE_VY, LOCATE_N };
+
+typedef struct {
+  int32_t  iX, iY;      // beacon position, mm
+} locate_beacon_t;
+
+typedef struct {
+  int32_t  iXQ8, iYQ8;         // position, mm Q8
+  int32_t  iVxQ8, iVyQ8;       // velocity, mm/s Q8
+  int64_t  iCovXX, iCovXY, iCovYY; // position covariance, mm^2 Q8
+  uint32_t uUpdates;           // ranges used
+  uint32_t uGated;             // ranges rejected by the innovation gate
+  uint32_t uOpened;            // state re-opened (lost)
+} locate_fix_t;
+
+typedef struct {
+  int32_t  iState[LOCATE_N];            // x, y mm Q8; vx, vy mm/s Q8
+  int64_t  iCov[LOCATE_N][LOCATE_N];    // covariance, state units^2 Q8; kept exactly symmetric
+  locate_beacon_t beacon[LOCATE_BEACONS_MAX];
+  uint     uBeacons;
+  uint64_t uTimeUs;                     // time of the state
+  uint32_t uAccelPsd;                   // process noise, mm^2/s^3
+  int64_t  iPosVar0;                    // position variance at init and on a re-open, mm^2 Q8
+  uint32_t uUpdates;
+  uint32_t uGated;
+  uint32_t uGatedRun[LOCATE_BEACONS_MAX]; // consecutive gated ranges per beacon
+  uint32_t uOpened;                     // re-opens after LOCATE_LOST
+} locate_t;
+
+void locate_init(locate_t *pL, const locate_beacon_t *pBeacons, uint uBeacons, int32_t iX, int32_t iY,
+                 uint32_t uSigma, uint64_t uTimeUs);
+void locate_predict(locate_t *pL, uint64_t uTimeUs);
+bool locate_update(locate_t *pL, uint uBeacon, int32_t iRangeQ8, uint32_t uVarQ8, uint64_t uTimeUs);
+void locate_fix(const locate_t *pL, locate_fix_t *pFix);
+
+#endif // RCS_LOCATE_01_H
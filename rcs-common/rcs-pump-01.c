@@ -0,0 +1,79 @@
+// @file rcs-pump-01.c
+// @date 2026.10.17
+// @info transmit switch pump and pio burst (from rcs-tx01-02)
+// @info the pwm slice is set up once and held at level 0 between pings (disabling the slice could stop
+// @info its output high, with the switcher fet on); the pio is idle between pings, so the carrier
+// @info and pattern are only changed there (pump_set_burst)
+
+#include "rcs-pump-01.h"
+#include "rcs-hal-01.h"
+
+// --warning-- disconnect inductor pin(40) when debuging; stuck faults will overheat switcher fet
+
+static void pump_led(pump_t *pP, bool bOn) {
+  if (pP->gpLed != PUMP_NO_LED) hal_gpio_put(pP->gpLed, bOn);
+}
+
+bool pump_init(pump_t *pP, uint gpPwm, uint gpBurst, uint gpLed) {
+  // burst phases on pio pins gpBurst, gpBurst+1 (consecutive), idle low; pump pwm on gpPwm,
+  // 125MHz/PUMP_CLKDIV/(PUMP_WRAP+1), PUMP_LEVEL high clocks while charging. false if no pio
+  // state machine is free
+  pP->gpLed = gpLed;
+  pP->uCarrierHz = BURST_CARRIER_HZ;
+  pP->uWordCt = pP->uCycleCt = 0;
+  pP->uPatternCycles = pP->uPatternCode = 0;
+  if (!hal_burst_init(gpBurst, pP->uCarrierHz)) return false;
+  pP->uSlice = hal_pwm_init(gpPwm, PUMP_CLKDIV, PUMP_WRAP, PUMP_LEVEL);
+  hal_pwm_set_level(pP->uSlice, 0);
+  hal_pwm_set_enabled(pP->uSlice, true);
+  return true;
+} // end bool pump_init(...)
+
+void pump_set_burst(pump_t *pP, uint32_t uCarrierHz, uint uCycles, uint uCode) {
+  // carrier, plain burst of uCycles or beacon code uCode (1..BURST_CODES, BURST_CODE_CHIPS chips of
+  // BURST_CHIP_CYCLES); only between pings, the last burst must be out. rebuilt on a change only
+  if (uCarrierHz != pP->uCarrierHz) {
+    pP->uCarrierHz = uCarrierHz;
+    hal_burst_set_carrier(uCarrierHz);
+  }
+  if (uCycles == pP->uPatternCycles && uCode == pP->uPatternCode && pP->uWordCt) return;
+  pP->uPatternCycles = uCycles;
+  pP->uPatternCode = uCode;
+  uint uChips = uCode ? BURST_CODE_CHIPS : 1, uChipCycles = uCode ? BURST_CHIP_CYCLES : uCycles;
+  pP->uWordCt = burst_pattern(pP->uWords, burst_code(uCode), uChips, uChipCycles);
+  pP->uCycleCt = uChips * uChipCycles;
+} // end void pump_set_burst(...)
+
+void pump_charge(pump_t *pP, bool bOn) {
+  // pump switching on (charge) or held low
+  if (bOn) pump_led(pP, true);
+  hal_pwm_set_level(pP->uSlice, bOn ? PUMP_LEVEL : 0);
+  if (!bOn) pump_led(pP, false);
+}
+
+uint32_t pump_fire(pump_t *pP) {
+  // start the burst; the pio sends it on its own. returns its length, us; keep the pump on
+  // PUMP_BURST_TAIL_US past it
+  hal_burst_fire(pP->uWords, pP->uWordCt);
+  return (pP->uCycleCt * 1000000ull + pP->uCarrierHz - 1) / pP->uCarrierHz;
+}
+
+static int64_t pump_off_alarm_callback(int32_t iId, void *pUser) {
+  // burst done; hold the pump pwm low until the next ping
+  pump_charge((pump_t *)pUser, false);
+  return 0;
+}
+
+static int64_t pump_burst_alarm_callback(int32_t iId, void *pUser) {
+  // end of pre-charge: burst out, then stop the pump
+  uint32_t uBurstUs = pump_fire((pump_t *)pUser);
+  hal_add_alarm_in_us(uBurstUs + PUMP_BURST_TAIL_US, pump_off_alarm_callback, pUser);
+  return 0;
+}
+
+void pump_ping(pump_t *pP, uint32_t uChargeUs) {
+  // alarm sequenced ping: pump on now, burst after uChargeUs, pump off after the burst. the cpu is
+  // free between the edges; callable from the ping timer's irq
+  pump_charge(pP, true);
+  hal_add_alarm_in_us(uChargeUs, pump_burst_alarm_callback, pP);
+}
@@ -0,0 +1,40 @@
+// @file rcs-pump-01.h
+// @date 2026.10.17
+// @info transmit switch pump and pio burst header
+// @info the tx-01 circuit: the pwm clocked boost converter (switch pump) charges the driver supply,
+// @info then the pio sends the carrier burst (rcs-burst-01.*) through the level shifter and driver.
+// @info moved out of rcs-tx01-02 so a board that both sends and receives (rcs-mono01-01) drives the
+// @info same circuit. pump_ping() is the alarm sequenced ping of the transmitter (charge on, burst,
+// @info charge off; irq context); pump_charge()/pump_fire() are the same steps for a caller that
+// @info sequences them itself against its own clock.
+
+#ifndef RCS_PUMP_01_H
+#define RCS_PUMP_01_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <sys/types.h> // uint
+#include "rcs-burst-01.h"
+
+#define PUMP_CLKDIV       2    // pwm clock divider; 125MHz/2/(949+1) -> 65.8KHz
+#define PUMP_WRAP         949  // --rcs-- org pwm 50%: wrap 999, level 499
+#define PUMP_LEVEL        549  // new pwm 2021.10.12; duty (/ 549.0 949) 0.578
+#define PUMP_BURST_TAIL_US 10  // pump stays on past the nominal burst length; pio start, alarm latency
+#define PUMP_NO_LED       (~0u) // gpLed: no charge indicator
+
+typedef struct {
+  uint     uSlice;                   // pump pwm slice; level 0 holds its output low between pings
+  uint     gpLed;                    // lit from charge on to charge off; PUMP_NO_LED
+  uint32_t uCarrierHz;               // carrier the pio runs at
+  uint32_t uWords[BURST_WORDS_MAX];  // pio pattern of the next burst
+  uint     uWordCt, uCycleCt;        // pattern length; padding after the last cycle is idle
+  uint     uPatternCycles, uPatternCode; // pattern built for
+} pump_t;
+
+bool pump_init(pump_t *pP, uint gpPwm, uint gpBurst, uint gpLed);
+void pump_set_burst(pump_t *pP, uint32_t uCarrierHz, uint uCycles, uint uCode);
+void pump_charge(pump_t *pP, bool bOn);
+uint32_t pump_fire(pump_t *pP);
+void pump_ping(pump_t *pP, uint32_t uChargeUs);
+
+#endif // RCS_PUMP_01_H
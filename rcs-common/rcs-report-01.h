@@ -0,0 +1,68 @@
+// @file rcs-report-01.h
+// @date 2026.10.17
+// @info range report record and lock-free single producer/single consumer queue
+// @info core 1 (capture, detection) produces one report per measurement window; core 0 (leds,
+// @info serial) consumes them. head is written only by the producer, tail only by the consumer,
+// @info so no lock is needed; a full queue drops the new report and counts it.
+
+#ifndef RCS_REPORT_01_H
+#define RCS_REPORT_01_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define REPORT_QUEUE_LEN  16      // power of 2; 32 s of reports at TX_PERIOD 2000, 0.4 s at 25ms
+#define REPORT_MISS       0x01    // no pulse in the window; iFlightUs is MISSED_PULSE
+#define REPORT_REFERENCE  0x02    // reference capture (first valid pulse)
+#define REPORT_SYNC       0x04    // first tx pulse found; window timing established
+#define REPORT_ECHOES     4       // arrivals besides the direct path carried per report (rcs-echo-01)
+
+typedef struct {
+  int32_t  iDelayUs;     // arrival after the direct path (negative: a weak one before it)
+  uint16_t uAmplitude;   // adc counts
+  uint16_t uWidth;       // samples over half amplitude
+} report_echo_t;
+
+typedef struct {
+  uint32_t uSeq;         // window sequence number
+  uint64_t uTimeUs;      // window start, capture sample clock in us
+  int64_t  iFlightUs;    // flight time relative to reference, skew corrected
+  uint16_t uBaseline;    // adc baseline used for the window
+  uint8_t  uConfidence;  // detector confidence 0-255
+  uint8_t  uFlags;       // REPORT_*
+  uint8_t  uEchoes;      // valid entries in echo[], strongest first; 0 unless multi-echo
+  report_echo_t echo[REPORT_ECHOES];
+} report_t;
+
+typedef struct {
+  volatile uint32_t uHead;     // next write; producer only
+  volatile uint32_t uTail;     // next read; consumer only
+  volatile uint32_t uDropped;  // reports lost to a full queue; producer only
+  report_t items[REPORT_QUEUE_LEN];
+} report_queue_t;
+
+static inline bool report_queue_push(report_queue_t *pQ, const report_t *pR) {
+  // producer side; returns false (and counts a drop) if the queue is full
+  uint32_t uHead = pQ->uHead;
+  if (uHead - pQ->uTail == REPORT_QUEUE_LEN) {
+    pQ->uDropped++;
+    return false;
+  }
+  pQ->items[uHead & (REPORT_QUEUE_LEN - 1)] = *pR;
+  __atomic_thread_fence(__ATOMIC_RELEASE); // item visible before head; dmb on the M0+
+  pQ->uHead = uHead + 1;
+  return true;
+}
+
+static inline bool report_queue_pop(report_queue_t *pQ, report_t *pR) {
+  // consumer side; returns false if the queue is empty
+  uint32_t uTail = pQ->uTail;
+  if (uTail == pQ->uHead) return false;
+  __atomic_thread_fence(__ATOMIC_ACQUIRE); // head read before item
+  *pR = pQ->items[uTail & (REPORT_QUEUE_LEN - 1)];
+  __atomic_thread_fence(__ATOMIC_RELEASE); // item copied before the slot is released
+  pQ->uTail = uTail + 1;
+  return true;
+}
+
+#endif // RCS_REPORT_01_H
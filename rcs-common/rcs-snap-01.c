@@ -0,0 +1,204 @@
+// @file rcs-snap-01.c
+// @date 2026.10.17
+// @info triggered waveform snapshots (see rcs-snap-01.h for the frame layout)
+// @info the history copy is a few memcpy runs per scanned block, split at the two ring wraps;
+// @info fields are packed byte by byte like rcs-telemetry-01, and share its crc
+
+#include <string.h>
+#include "rcs-snap-01.h"
+#include "rcs-capture-01.h"
+#include "rcs-telemetry-01.h" // telemetry_crc16
+
+static void put_le(uint8_t *p, uint64_t uValue, uint uBytes) {
+  for (uint i = 0; i < uBytes; i++) p[i] = uValue >> (8 * i);
+}
+
+static uint64_t get_le(const uint8_t *p, uint uBytes) {
+  uint64_t uValue = 0;
+  for (uint i = 0; i < uBytes; i++) uValue |= (uint64_t)p[i] << (8 * i);
+  return uValue;
+}
+
+void snap_init(snap_t *pS, uint32_t uPre, uint32_t uPost) {
+  memset(pS, 0, sizeof(*pS));
+  pS->uPre = uPre;
+  pS->uPost = uPost;
+}
+
+static void snap_freeze(snap_t *pS) {
+  // core 1; history stops here until core 0 has sent [uStart, uEnd)
+  pS->uSent = pS->uStart;
+  __atomic_thread_fence(__ATOMIC_RELEASE); // samples and fields visible before the state; dmb on the M0+
+  pS->uState = SNAP_READY;
+}
+
+void snap_feed_ring(snap_t *pS, uint64_t uFrom, uint64_t uTo) {
+  // core 1; capture ring range [uFrom, uTo) into history, beside the estimator. ranges fed twice
+  // (a window re-opened behind the scan) are skipped; a range past uFed leaves a gap. a gap while
+  // filling ends the snapshot at it, short: history past uFed would be a ring lap stale
+  if (pS->uState == SNAP_READY) return;
+  if (uTo <= pS->uFed) return;
+  if (uFrom < pS->uFed) uFrom = pS->uFed;
+  else if (uFrom > pS->uFed) { // overrun skip, low power sleep, or feeding again after a freeze
+    if (pS->uState == SNAP_FILLING) {
+      if (pS->uFed > pS->uStart) { // what was fed is contiguous
+        pS->uEnd = pS->uFed;
+        snap_freeze(pS);
+        return;
+      }
+      pS->uState = SNAP_IDLE; // nothing of it in history
+      pS->uDropped++;
+    }
+    pS->uValid = uFrom;
+  }
+  if (pS->uState == SNAP_FILLING && uTo > pS->uEnd) uTo = pS->uEnd; // keeps the snapshot's start
+  while (uFrom < uTo) {
+    uint uCap = uFrom & (CAPTURE_RING_LEN - 1);
+    uint uHist = uFrom & (SNAP_RING_LEN - 1);
+    uint uLen = CAPTURE_RING_LEN - uCap;
+    if (SNAP_RING_LEN - uHist < uLen) uLen = SNAP_RING_LEN - uHist;
+    if (uTo - uFrom < uLen) uLen = uTo - uFrom;
+    memcpy(&pS->uHist[uHist], &G_uCaptureRing[uCap], uLen * sizeof(uint16_t));
+    uFrom += uLen;
+  }
+  pS->uFed = uFrom;
+  if (pS->uState == SNAP_FILLING && pS->uFed >= pS->uEnd) snap_freeze(pS);
+} // end void snap_feed_ring(...)
+
+bool snap_trigger(snap_t *pS, uint64_t uTrigger, uint8_t uReason) {
+  // core 1; snapshot [uTrigger - uPre, uTrigger + uPost), trimmed to what history still holds
+  // (and to SNAP_RING_LEN). false, counted in uDropped, while one is in progress or if nothing is left
+  if (pS->uState != SNAP_IDLE) {
+    pS->uDropped++;
+    return false;
+  }
+  uint64_t uOldest = (pS->uFed > SNAP_RING_LEN) ? pS->uFed - SNAP_RING_LEN : 0;
+  if (pS->uValid > uOldest) uOldest = pS->uValid;
+  uint64_t uStart = (uTrigger > pS->uPre) ? uTrigger - pS->uPre : 0;
+  uint64_t uEnd = uTrigger + pS->uPost;
+  if (uStart < uOldest) uStart = uOldest;
+  if (uEnd <= uStart) {
+    pS->uDropped++;
+    return false;
+  }
+  if (uEnd - uStart > SNAP_RING_LEN) uEnd = uStart + SNAP_RING_LEN;
+  pS->uSeq++;
+  pS->uReason = uReason;
+  pS->uTrigger = uTrigger;
+  pS->uStart = uStart;
+  pS->uEnd = uEnd;
+  if (pS->uFed >= uEnd) snap_freeze(pS);
+  else pS->uState = SNAP_FILLING;
+  return true;
+} // end bool snap_trigger(...)
+
+uint snap_frame(snap_t *pS, uint8_t *pBuf) {
+  // core 0; next frame of the frozen snapshot, returns its length, 0 if none is ready. the last
+  // frame releases the history to core 1
+  if (pS->uState != SNAP_READY) return 0;
+  __atomic_thread_fence(__ATOMIC_ACQUIRE); // state read before samples
+  uint n = (pS->uEnd - pS->uSent < SNAP_FRAME_SAMPLES) ? pS->uEnd - pS->uSent : SNAP_FRAME_SAMPLES;
+  pBuf[0] = SNAP_SYNC0;
+  pBuf[1] = SNAP_SYNC1;
+  pBuf[2] = SNAP_VERSION;
+  pBuf[3] = pS->uReason;
+  put_le(pBuf + 4, pS->uSeq, 4);
+  put_le(pBuf + 8, pS->uTrigger, 8);
+  put_le(pBuf + 16, pS->uStart, 8);
+  put_le(pBuf + 24, pS->uEnd - pS->uStart, 2);
+  put_le(pBuf + 26, pS->uSent - pS->uStart, 2);
+  pBuf[28] = n;
+  uint8_t *p = pBuf + SNAP_HEADER_LEN;
+  for (uint i = 0; i < n; i += 2, p += 3) {
+    uint a = pS->uHist[(pS->uSent + i) & (SNAP_RING_LEN - 1)] & 0xFFF;
+    uint b = (i + 1 < n) ? pS->uHist[(pS->uSent + i + 1) & (SNAP_RING_LEN - 1)] & 0xFFF : 0;
+    p[0] = a;
+    p[1] = (a >> 8) | (b << 4);
+    p[2] = b >> 4;
+  }
+  uint uLen = p - pBuf;
+  put_le(p, telemetry_crc16(pBuf + 2, uLen - 2), 2);
+  pS->uSent += n;
+  if (pS->uSent == pS->uEnd) {
+    __atomic_thread_fence(__ATOMIC_RELEASE); // samples read before the history is released
+    pS->uState = SNAP_IDLE;
+  }
+  return uLen + 2;
+} // end uint snap_frame(...)
+
+void snap_decoder_init(snap_decoder_t *pD) {
+  memset(pD, 0, sizeof(*pD));
+}
+
+static void snap_emit(snap_decoder_t *pD, snap_cb_t cb, void *pUser) {
+  // valid frame in uBuf; append it to the snapshot being assembled
+  snap_header_t h;
+  h.uReason = pD->uBuf[3];
+  h.uSeq = get_le(pD->uBuf + 4, 4);
+  h.uTrigger = get_le(pD->uBuf + 8, 8);
+  h.uStart = get_le(pD->uBuf + 16, 8);
+  h.uTotal = get_le(pD->uBuf + 24, 2);
+  uint uOffset = get_le(pD->uBuf + 26, 2);
+  uint n = pD->uBuf[28];
+  pD->uFrames++;
+  if (uOffset == 0) { // first frame
+    if (pD->uHave) pD->uBroken++;
+    pD->head = h;
+    pD->uHave = 0;
+  } else if (!pD->uHave || h.uSeq != pD->head.uSeq || uOffset != pD->uHave) { // a frame went missing
+    if (pD->uHave) pD->uBroken++;
+    pD->uHave = 0;
+    return;
+  }
+  if (h.uTotal > SNAP_RING_LEN || uOffset + n > h.uTotal) {
+    pD->uBroken++;
+    pD->uHave = 0;
+    return;
+  }
+  const uint8_t *p = pD->uBuf + SNAP_HEADER_LEN;
+  for (uint i = 0; i < n; i += 2, p += 3) {
+    pD->uSamples[uOffset + i] = p[0] | ((p[1] & 0x0F) << 8);
+    if (i + 1 < n) pD->uSamples[uOffset + i + 1] = (p[1] >> 4) | (p[2] << 4);
+  }
+  pD->uHave = uOffset + n;
+  if (pD->uHave == h.uTotal) {
+    pD->uSnaps++;
+    pD->uHave = 0;
+    if (cb) cb(&pD->head, pD->uSamples, pUser);
+  }
+} // end static void snap_emit(...)
+
+void snap_decode(snap_decoder_t *pD, const uint8_t *pBytes, uint uN, snap_cb_t cb, void *pUser) {
+  // byte at a time state machine; uLen is the position within the current frame
+  for (uint k = 0; k < uN; k++) {
+    uint8_t b = pBytes[k];
+    switch (pD->uLen) {
+    case 0:
+      if (b == SNAP_SYNC0) pD->uBuf[pD->uLen++] = b;
+      else pD->uSkipped++;
+      continue;
+    case 1:
+      if (b == SNAP_SYNC1) pD->uBuf[pD->uLen++] = b;
+      else if (b == SNAP_SYNC0) pD->uSkipped++;           // 'RRS'; stay at 1
+      else { pD->uSkipped += 2; pD->uLen = 0; }
+      continue;
+    case 2:
+      if (b != SNAP_VERSION) { pD->uSkipped += 2; pD->uLen = 0; k--; continue; }
+      break;
+    case 28:
+      if (b == 0 || b > SNAP_FRAME_SAMPLES) { pD->uSkipped += 28; pD->uLen = 0; k--; continue; }
+      break;
+    }
+    pD->uBuf[pD->uLen++] = b;
+    if (pD->uLen < SNAP_HEADER_LEN) continue;
+    uint uFrameLen = SNAP_HEADER_LEN + (pD->uBuf[28] + 1) / 2 * 3 + 2;
+    if (pD->uLen < uFrameLen) continue;
+    uint16_t uCrc = get_le(pD->uBuf + uFrameLen - 2, 2);
+    if (uCrc == telemetry_crc16(pD->uBuf + 2, uFrameLen - 4)) {
+      snap_emit(pD, cb, pUser);
+    } else {
+      pD->uBadCrc++;
+    }
+    pD->uLen = 0;
+  } // end for (uint k = 0; k < uN; k++)
+} // end void snap_decode(...)
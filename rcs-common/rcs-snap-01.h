@@ -0,0 +1,104 @@
+// @file rcs-snap-01.h
+// @date 2026.10.17
+// @info triggered waveform snapshots; recorder (core 1), framer (core 0) and streaming decoder (host)
+// @info replaces hand captured minicom text dumps (../rcs-rx04-03/mfiles, 128-256 samples of volts
+// @info per file) with full rate raw adc windows around a detection, a miss or a serial request.
+// @info core 1 copies every sample it scans into a history ring (snap_feed_ring), SNAP_RING_LEN
+// @info samples back from the scan position; the capture ring holds only 4ms. a trigger names an
+// @info absolute sample index: what of [trigger - pre, trigger + post) is still in history is
+// @info kept, the rest is fed, then the ring is frozen in place (no copy) and handed to core 0,
+// @info which sends it a frame at a time between reports. feeding resumes when the last frame is
+// @info out; triggers in the meantime are dropped and counted. detection never waits on usb.
+// @info samples lost to a capture overrun or a low power sleep are not in history; a snapshot starts
+// @info after such a gap, and one filling when it comes ends there (total is then short of pre + post).
+
+// @info frame (little endian)
+//   0  'R' 'S'           sync
+//   2  version           SNAP_VERSION
+//   3  reason            SNAP_PULSE, SNAP_MISS, SNAP_MANUAL
+//   4  seq       u32     snapshot number; gaps are snapshots dropped on device
+//   8  trigger   u64     trigger, absolute capture sample index
+//   16 start     u64     first sample of the snapshot, absolute capture sample index
+//   24 total     u16     samples in the snapshot
+//   26 offset    u16     index of this frame's first sample within the snapshot
+//   28 n         u8      samples in this frame, 1..SNAP_FRAME_SAMPLES
+//   29 samples           12 bit adc counts packed in pairs, 3 bytes per pair (a0-7, a8-11|b0-3, b4-11);
+//                        (n + 1) / 2 * 3 bytes, an odd last sample padded with 0
+//   .  crc16             ccitt (telemetry_crc16) over version..last sample byte
+
+#ifndef RCS_SNAP_01_H
+#define RCS_SNAP_01_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <sys/types.h> // uint
+
+#define SNAP_SYNC0          'R'
+#define SNAP_SYNC1          'S'
+#define SNAP_VERSION        1
+#define SNAP_RING_BITS      14
+#define SNAP_RING_LEN       (1 << SNAP_RING_BITS) // history, samples; (* 16384 2) 32KB, 32.8ms at 500ksps
+#define SNAP_FRAME_SAMPLES  128   // per frame; (+ 29 (* 64 3) 2) 223 bytes fits the 256 byte cdc tx fifo
+#define SNAP_HEADER_LEN     29
+#define SNAP_FRAME_MAX      (SNAP_HEADER_LEN + SNAP_FRAME_SAMPLES / 2 * 3 + 2)
+#define SNAP_PRE_US         2000  // defaults; 'wl<pre_us>,<post_us>' on the receiver's serial
+#define SNAP_POST_US        6000
+
+#define SNAP_PULSE          1     // trigger reasons; also the receiver's trigger mode bits
+#define SNAP_MISS           2
+#define SNAP_MANUAL         4
+
+#define SNAP_IDLE           0     // snap_t.uState; recording history, no trigger
+#define SNAP_FILLING        1     // triggered, feeding the post trigger samples (core 1)
+#define SNAP_READY          2     // frozen, frames going out (core 0)
+
+typedef struct {
+  uint16_t uHist[SNAP_RING_LEN];  // sample at absolute index i is uHist[i & (SNAP_RING_LEN - 1)]
+  uint64_t uFed;                  // next absolute index to feed
+  uint64_t uValid;                // oldest index in history since the last gap or freeze
+  uint32_t uPre, uPost;           // trigger window, samples; set from core 0, read at a trigger
+  // snapshot in progress or frozen
+  volatile uint8_t uState;        // SNAP_*; core 1 moves IDLE->FILLING->READY, core 0 READY->IDLE
+  uint8_t  uReason;
+  uint32_t uSeq;
+  uint64_t uTrigger;
+  uint64_t uStart;
+  uint64_t uEnd;                  // one past the last sample
+  uint64_t uSent;                 // core 0: next sample to frame
+  volatile uint32_t uDropped;     // triggers while a snapshot was in progress, snapshots lost to a gap; core 1 only
+} snap_t;
+
+// recorder, core 1
+void snap_init(snap_t *pS, uint32_t uPre, uint32_t uPost);
+void snap_feed_ring(snap_t *pS, uint64_t uFrom, uint64_t uTo);
+bool snap_trigger(snap_t *pS, uint64_t uTrigger, uint8_t uReason);
+// framer, core 0; fills pBuf (SNAP_FRAME_MAX) with the next frame of a frozen snapshot
+uint snap_frame(snap_t *pS, uint8_t *pBuf);
+
+// decoder; byte stream in, one callback per complete snapshot. resyncs on the sync bytes after
+// other output (text, telemetry frames) or a crc failure; a snapshot missing a frame is dropped
+typedef struct {
+  uint8_t  uReason;
+  uint32_t uSeq;
+  uint64_t uTrigger;
+  uint64_t uStart;
+  uint16_t uTotal;
+} snap_header_t;
+typedef void (*snap_cb_t)(const snap_header_t *pH, const uint16_t *pSamples, void *pUser);
+typedef struct {
+  uint8_t  uBuf[SNAP_FRAME_MAX];
+  uint     uLen;         // bytes of the current frame held in uBuf
+  snap_header_t head;    // snapshot being assembled
+  uint     uHave;        // samples of it received
+  uint16_t uSamples[SNAP_RING_LEN];
+  uint32_t uSnaps;       // complete snapshots
+  uint32_t uFrames;      // valid frames
+  uint32_t uBadCrc;      // frames dropped on crc
+  uint32_t uBroken;      // snapshots dropped on a missing frame
+  uint32_t uSkipped;     // bytes discarded while hunting for sync
+} snap_decoder_t;
+
+void snap_decoder_init(snap_decoder_t *pD);
+void snap_decode(snap_decoder_t *pD, const uint8_t *pBytes, uint uN, snap_cb_t cb, void *pUser);
+
+#endif // RCS_SNAP_01_H
@@ -0,0 +1,97 @@
+// @file rcs-stack-01.c
+// @date 2026.10.17
+// @info coherent multi-ping stacking (see rcs-stack-01.h)
+// @info   acc += d - round(acc/N),  d = x - baseline;  out = baseline + acc * gain / N
+// @info steady state acc = N * mean(d); the variance of acc/N is sigma^2 / (2N - 1) for white d, hence
+// @info the gain. per sample: a subtract, a shift, two adds, a multiply (single cycle on the M0+), a clamp
+
+#include <string.h>
+#include "rcs-stack-01.h"
+#include "rcs-capture-01.h"
+
+#define STACK_ADC_MAX 4095 // 12 bit adc; the detector takes counts
+
+static const uint32_t S_uGainQ8[STACK_SHIFT_MAX + 1] = {
+  256, 443, 677, 991, 1425, 2032 // (* 256 (sqrt (- (* 2 N) 1))) for N 1 2 4 8 16 32
+};
+
+void stack_init(stack_acc_t *pS, uint uShift, uint32_t uLen) {
+  // at every sync and N change; the sums restart from zero
+  if (uShift > STACK_SHIFT_MAX) uShift = STACK_SHIFT_MAX;
+  if (uLen > STACK_LEN_MAX) uLen = STACK_LEN_MAX;
+  memset(pS->iAcc, 0, sizeof(pS->iAcc));
+  pS->uLen = uLen;
+  pS->uShift = uShift;
+  pS->uGainQ8 = S_uGainQ8[uShift];
+  pS->uStart = 0;
+  pS->uBaseline = 0;
+  pS->uPings = 0;
+}
+
+void stack_window(stack_acc_t *pS, uint64_t uStart, uint16_t uBaseline) {
+  // at each window, before its first sample; position 0 is uStart (the window placed on the tx clock,
+  // not the scan start), uBaseline the detector's dc reference for the window
+  pS->uStart = uStart;
+  pS->uBaseline = uBaseline;
+  pS->uPings++;
+}
+
+void stack_add(stack_acc_t *pS, uint64_t uIdx, const uint16_t *pIn, uint16_t *pOut, uint uN) {
+  // add samples [uIdx, uIdx + uN) of the current window into the stack, stacked samples to pOut.
+  // positions outside the window, and everything with the stack off, pass through
+  const uint uShift = pS->uShift;
+  const int32_t iRound = uShift ? 1 << (uShift - 1) : 0;
+  const int32_t iBase = pS->uBaseline;
+  const uint32_t uGain = pS->uGainQ8;
+  uint64_t uPos = uIdx - pS->uStart;
+  for (uint i = 0; i < uN; i++, uPos++) {
+    if (!uShift || uIdx + i < pS->uStart || uPos >= pS->uLen) {
+      pOut[i] = pIn[i];
+      continue;
+    }
+    int32_t *pAcc = &pS->iAcc[uPos];
+    int32_t iAcc = *pAcc + (int32_t)pIn[i] - iBase - ((*pAcc + iRound) >> uShift);
+    *pAcc = iAcc;
+    int32_t iOut = iBase + ((iAcc * (int32_t)uGain) >> (uShift + 8));
+    pOut[i] = iOut < 0 ? 0 : iOut > STACK_ADC_MAX ? STACK_ADC_MAX : iOut;
+  }
+} // end void stack_add(...)
+
+bool stack_scan_ring(stack_acc_t *pS, detect_t *pD, uint64_t uFrom, uint64_t uTo, detect_result_t *pResult) {
+  // add absolute capture ring range [uFrom, uTo) into the stack and run the detector over the stacked
+  // samples, uFrom == pD->uIdx. the whole range is always added; the detector stops at its first pulse
+  // (true), and pD NULL adds only (the rest of a window after its pulse)
+  uint16_t uStacked[STACK_CHUNK];
+  bool bHit = false;
+  while (uFrom < uTo) {
+    uint uPos = uFrom & (CAPTURE_RING_LEN - 1);
+    uint uLen = CAPTURE_RING_LEN - uPos;
+    if (uTo - uFrom < uLen) uLen = uTo - uFrom;
+    if (uLen > STACK_CHUNK) uLen = STACK_CHUNK;
+    stack_add(pS, uFrom, &G_uCaptureRing[uPos], uStacked, uLen);
+    if (pD && !bHit) bHit = detect_run(pD, uStacked, uLen, pResult);
+    uFrom += uLen;
+  }
+  return bHit;
+} // end bool stack_scan_ring(...)
+
+uint64_t stack_scan_threshold(stack_acc_t *pS, bool bScan, uint64_t uFrom, uint64_t uTo, uint16_t uTrigPos,
+                              uint16_t uTrigNeg) {
+  // add absolute capture ring range [uFrom, uTo) into the stack and return the first stacked sample
+  // >= uTrigPos or <= uTrigNeg, as capture_scan(); CAPTURE_NONE if none or !bScan (adds only). the
+  // whole range is always added
+  uint16_t uStacked[STACK_CHUNK];
+  uint64_t uHit = CAPTURE_NONE;
+  while (uFrom < uTo) {
+    uint uPos = uFrom & (CAPTURE_RING_LEN - 1);
+    uint uLen = CAPTURE_RING_LEN - uPos;
+    if (uTo - uFrom < uLen) uLen = uTo - uFrom;
+    if (uLen > STACK_CHUNK) uLen = STACK_CHUNK;
+    stack_add(pS, uFrom, &G_uCaptureRing[uPos], uStacked, uLen);
+    for (uint i = 0; bScan && uHit == CAPTURE_NONE && i < uLen; i++) {
+      if ((uStacked[i] >= uTrigPos) || (uStacked[i] <= uTrigNeg)) uHit = uFrom + i;
+    }
+    uFrom += uLen;
+  }
+  return uHit;
+} // end uint64_t stack_scan_threshold(...)
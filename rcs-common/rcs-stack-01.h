@@ -0,0 +1,54 @@
+// @file rcs-stack-01.h
+// @date 2026.10.17
+// @info coherent multi-ping stacking header
+// @info the transmitter is periodic and the windows are placed on its clock (rcs-drift-01), so sample j
+// @info of every window is the same flight time; a stationary or slow target's pulse adds up ping after
+// @info ping and the noise does not. each window is added into a per position accumulator, a leaky
+// @info (exponential) sum over the last N = 2^uShift pings, baseline removed:
+// @info   acc += x - baseline - acc/N
+// @info one add per sample, no re-summing and no window history (a boxcar of N windows would keep N
+// @info windows of samples; (* 16 10750 2) 344KB at N 16). its noise is that of (- (* 2 N) 1) pings
+// @info averaged, so the output, baseline + acc/N scaled by sqrt(2N-1) (uGainQ8), has one ping's noise
+// @info and the pulse sqrt(2N-1) larger: the detector, or the threshold scan, and its cfar trigger run on
+// @info it unchanged.
+// @info the output is the stack once its N pings are in; from a reset the gain builds up over ~N pings.
+// @info a target moving more than ~1/4 carrier cycle ((* 0.25 8.6) 2mm at 40KHz) per N pings
+// @info smears; stacking is for stationary or slow targets
+
+#ifndef RCS_STACK_01_H
+#define RCS_STACK_01_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <sys/types.h> // uint
+#include "rcs-detect-01.h"
+
+#define STACK_LEN_MAX   11008 // window samples; (* 43 256) covers (+ 750 10000) at 500ksps
+#define STACK_SHIFT_MAX 5     // N up to 32 pings; (* 32 2048) acc bound, times the gain fits int32
+#define STACK_CHUNK     256   // stacked samples per detector pass; a buffer on the caller's stack
+#define STACK_WARM      2     // windows per N from a reset before the stack is in; (expt 0.5 2) 1/4 of the gain short
+
+typedef struct {
+  int32_t  iAcc[STACK_LEN_MAX]; // per window position; N times the mean deviation from the baseline
+  uint32_t uLen;                // window positions stacked
+  uint     uShift;              // log2 N; 0 off (the output is the input)
+  uint32_t uGainQ8;             // output scale, sqrt(2N - 1) Q8
+  uint64_t uStart;              // absolute index of position 0 of the current window
+  uint16_t uBaseline;           // the current window's dc reference; the detector's
+  uint32_t uPings;              // windows added since the reset
+} stack_acc_t;
+
+void stack_init(stack_acc_t *pS, uint uShift, uint32_t uLen);
+void stack_window(stack_acc_t *pS, uint64_t uStart, uint16_t uBaseline);
+void stack_add(stack_acc_t *pS, uint64_t uIdx, const uint16_t *pIn, uint16_t *pOut, uint uN);
+bool stack_scan_ring(stack_acc_t *pS, detect_t *pD, uint64_t uFrom, uint64_t uTo, detect_result_t *pResult);
+uint64_t stack_scan_threshold(stack_acc_t *pS, bool bScan, uint64_t uFrom, uint64_t uTo, uint16_t uTrigPos,
+                              uint16_t uTrigNeg);
+
+static inline bool stack_warm(const stack_acc_t *pS) {
+  // STACK_WARM * N windows added since the reset; before that the gain still builds from window to
+  // window, and a pulse's threshold crossing moves earlier in its ring-up with it
+  return pS->uPings > ((uint32_t)STACK_WARM << pS->uShift);
+}
+
+#endif // RCS_STACK_01_H
@@ -0,0 +1,61 @@
+// @file rcs-tdoa-01.c
+// @date 2026.10.17
+// @info per channel burst detection over a round robin capture ring (rcs-capture-01.h)
+// @info channel k of n is every n-th ring sample from k, so each channel is de-interleaved a chunk at a
+// @info time into a stack buffer and run through its own detector at CAPTURE_SAMPLE_HZ / n. the detector
+// @info returns channel sample times; capture_channel_to_q8() scales them back to ring samples and adds
+// @info the k slot (2us each) the channel converts after channel 0, which is the per channel sample time
+// @info offset. left in, 3 channels would read 4us (1.4mm of path) between the outer pair.
+// @info cost per ring sample is the same as one detector at the full rate: n detectors at 1/n the rate.
+
+#include "rcs-tdoa-01.h"
+
+void tdoa_init(tdoa_t *pT, const uint16_t *pBaseline, uint uTriggerCounts, uint64_t uStartIdx) {
+  // arm one detector per ring channel from absolute index uStartIdx; pBaseline holds each channel's
+  // quiescent level (separate bias networks), uTriggerCounts the burst amplitude that arms them
+  pT->uChannels = G_uCaptureChannels;
+  pT->uFound = 0;
+  for (uint c = 0; c < pT->uChannels; c++) {
+    detect_t *pD = &pT->detect[c];
+    detect_set_rate(pD, CAPTURE_SAMPLE_HZ / pT->uChannels, DETECT_CARRIER_HZ);
+    detect_init(pD, pBaseline[c], detect_mag_for_amplitude(pD, uTriggerCounts),
+                capture_channel_samples(c, uStartIdx));
+  }
+} // end void tdoa_init(...)
+
+uint tdoa_scan_ring(tdoa_t *pT, uint64_t uTo) {
+  // run every channel without a result up to absolute ring index uTo; returns the found bits.
+  // a channel stops at its first burst, as the single channel window does.
+  uint16_t uChunk[TDOA_CHUNK];
+  for (uint c = 0; c < pT->uChannels; c++) {
+    if (pT->uFound & (1u << c)) continue;
+    detect_t *pD = &pT->detect[c];
+    uint64_t uChanTo = capture_channel_samples(c, uTo);
+    while (pD->uIdx < uChanTo) {
+      uint uN = (uChanTo - pD->uIdx < TDOA_CHUNK) ? (uint)(uChanTo - pD->uIdx) : TDOA_CHUNK;
+      capture_channel_copy(c, pD->uIdx, uChunk, uN);
+      if (detect_run(pD, uChunk, uN, &pT->result[c])) {
+        pT->result[c].iArrivalQ8 = capture_channel_to_q8(c, pT->result[c].iArrivalQ8);
+        pT->uFound |= 1u << c;
+        break;
+      }
+    }
+  } // end for (uint c...)
+  return pT->uFound;
+} // end uint tdoa_scan_ring(...)
+
+int32_t tdoa_path_q8(const tdoa_t *pT, uint uA, uint uB) {
+  // extra path to channel uB over channel uA, mm Q8; both must be found
+  int64_t iDeltaQ8 = pT->result[uB].iArrivalQ8 - pT->result[uA].iArrivalQ8;
+  return (int32_t)((iDeltaQ8 * CAPTURE_SAMPLE_NS * TDOA_SOUND_MM_S) / 1000000000);
+}
+
+int32_t tdoa_sin_q14(int32_t iPathQ8, uint32_t uSpacingMm) {
+  // far field bearing sine, Q14, for receivers uSpacingMm apart; 0 is broadside, positive towards
+  // uA when iPathQ8 is tdoa_path_q8(pT, uA, uB). clamped: noise can push the path past the spacing
+  // end on.
+  int64_t iSin = ((int64_t)iPathQ8 << TDOA_SIN_Q) / ((int64_t)uSpacingMm << 8);
+  if (iSin > (1 << TDOA_SIN_Q)) iSin = 1 << TDOA_SIN_Q;
+  if (iSin < -(1 << TDOA_SIN_Q)) iSin = -(1 << TDOA_SIN_Q);
+  return (int32_t)iSin;
+}
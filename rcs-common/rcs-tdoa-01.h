@@ -0,0 +1,35 @@
+// @file rcs-tdoa-01.h
+// @date 2026.10.17
+// @info per channel burst detection over a round robin capture ring and time difference of arrival
+// @info between the channels; two or three receivers on one board give the transmitter bearing from a
+// @info single ping. one matched filter (rcs-detect-01) per channel at the channel rate, arrivals
+// @info moved back onto the absolute ring clock so the conversion slot between channels cancels.
+
+#ifndef RCS_TDOA_01_H
+#define RCS_TDOA_01_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <sys/types.h> // uint
+#include "rcs-capture-01.h" // CAPTURE_CHANNELS_MAX, round robin geometry
+#include "rcs-detect-01.h"
+#include "rcs-dsp-01.h"     // DSP_SOUND_MM_S
+
+#define TDOA_CHANNELS_MAX CAPTURE_CHANNELS_MAX
+#define TDOA_CHUNK        64      // channel samples de-interleaved per detect_run(); stack buffer
+#define TDOA_SOUND_MM_S   DSP_SOUND_MM_S // the ranging display still uses 1ms/ft
+#define TDOA_SIN_Q        14      // bearing sine fraction bits
+
+typedef struct {
+  detect_t        detect[TDOA_CHANNELS_MAX];
+  detect_result_t result[TDOA_CHANNELS_MAX]; // arrival on the absolute ring clock, Q8 samples
+  uint            uChannels;                 // G_uCaptureChannels at tdoa_init()
+  uint            uFound;                    // bit per channel with a result
+} tdoa_t;
+
+void tdoa_init(tdoa_t *pT, const uint16_t *pBaseline, uint uTriggerCounts, uint64_t uStartIdx);
+uint tdoa_scan_ring(tdoa_t *pT, uint64_t uTo);
+int32_t tdoa_path_q8(const tdoa_t *pT, uint uA, uint uB);
+int32_t tdoa_sin_q14(int32_t iPathQ8, uint32_t uSpacingMm);
+
+#endif // RCS_TDOA_01_H
@@ -0,0 +1,131 @@
+// @file rcs-telemetry-01.c
+// @date 2026.10.17
+// @info framed binary range telemetry (see rcs-telemetry-01.h for the frame layout)
+// @info fields are packed byte by byte, so the encoding does not depend on struct layout or
+// @info endianness of either side; the decoder builds on the host from the same source
+
+#include <string.h>
+#include "rcs-telemetry-01.h"
+
+static void put_le(uint8_t *p, uint64_t uValue, uint uBytes) {
+  for (uint i = 0; i < uBytes; i++) p[i] = uValue >> (8 * i);
+}
+
+static uint64_t get_le(const uint8_t *p, uint uBytes) {
+  uint64_t uValue = 0;
+  for (uint i = 0; i < uBytes; i++) uValue |= (uint64_t)p[i] << (8 * i);
+  return uValue;
+}
+
+uint16_t telemetry_crc16(const uint8_t *p, uint uN) {
+  // crc16 ccitt, bitwise; ~20 bytes per ping does not justify a table
+  uint16_t uCrc = 0xFFFF;
+  while (uN--) {
+    uCrc ^= (uint16_t)*p++ << 8;
+    for (int i = 0; i < 8; i++) uCrc = (uCrc & 0x8000) ? (uCrc << 1) ^ 0x1021 : uCrc << 1;
+  }
+  return uCrc;
+} // end uint16_t telemetry_crc16(...)
+
+void telemetry_frame_reset(telemetry_frame_t *pF, int32_t iRefFlightUs) {
+  // empty frame; its records range from iRefFlightUs (the reference distance when they were sent)
+  pF->uBuf[0] = TELEMETRY_SYNC0;
+  pF->uBuf[1] = TELEMETRY_SYNC1;
+  pF->uBuf[2] = TELEMETRY_VERSION;
+  pF->uBuf[3] = 0;
+  put_le(pF->uBuf + 4, (uint32_t)iRefFlightUs, 4);
+  pF->uCount = 0;
+}
+
+bool telemetry_frame_add(telemetry_frame_t *pF, const report_t *pR) {
+  // append one record; the caller sends the frame when this returns true
+  uint8_t *p = pF->uBuf + TELEMETRY_HEADER_LEN + pF->uCount * TELEMETRY_RECORD_LEN;
+  put_le(p + 0, pR->uSeq, 4);
+  put_le(p + 4, pR->uTimeUs, 8);
+  put_le(p + 12, (uint32_t)(int32_t)pR->iFlightUs, 4);
+  put_le(p + 16, pR->uBaseline, 2);
+  p[18] = pR->uConfidence;
+  p[19] = pR->uFlags;
+  pF->uCount++;
+  return pF->uCount == TELEMETRY_BATCH;
+} // end bool telemetry_frame_add(...)
+
+uint telemetry_frame_finish(telemetry_frame_t *pF) {
+  if (pF->uCount == 0) return 0;
+  uint uLen = TELEMETRY_HEADER_LEN + pF->uCount * TELEMETRY_RECORD_LEN;
+  pF->uBuf[3] = pF->uCount;
+  put_le(pF->uBuf + uLen, telemetry_crc16(pF->uBuf + 2, uLen - 2), 2);
+  return uLen + 2;
+} // end uint telemetry_frame_finish(...)
+
+void telemetry_decoder_init(telemetry_decoder_t *pD) {
+  memset(pD, 0, sizeof(*pD));
+}
+
+static void telemetry_emit(telemetry_decoder_t *pD, telemetry_record_cb_t cb, void *pUser) {
+  // valid frame in uBuf; unpack its records
+  uint uCount = pD->uBuf[3];
+  pD->uFrames++;
+  pD->iRefFlightUs = (int32_t)(uint32_t)get_le(pD->uBuf + 4, 4);
+  for (uint i = 0; i < uCount; i++) {
+    const uint8_t *p = pD->uBuf + TELEMETRY_HEADER_LEN + i * TELEMETRY_RECORD_LEN;
+    report_t r;
+    r.uSeq = get_le(p + 0, 4);
+    r.uTimeUs = get_le(p + 4, 8);
+    r.iFlightUs = (int32_t)(uint32_t)get_le(p + 12, 4);
+    r.uBaseline = get_le(p + 16, 2);
+    r.uConfidence = p[18];
+    r.uFlags = p[19];
+    pD->uRecords++;
+    if (cb) cb(&r, pUser);
+  }
+} // end static void telemetry_emit(...)
+
+void telemetry_decode(telemetry_decoder_t *pD, const uint8_t *pBytes, uint uN,
+                      telemetry_record_cb_t cb, void *pUser) {
+  // byte at a time state machine; uLen is the position within the current frame. a crc failure
+  // rescans the frame from its second byte (uPend, ahead of the rest of pBytes): the sync may have
+  // been payload, or a short or corrupted frame may hide the start of the next one. a frame found
+  // in uPend ends inside it or after it is used up, so uPend never holds more than one frame.
+  uint8_t uPend[TELEMETRY_FRAME_MAX];
+  uint uPendLen = 0, uPendPos = 0;
+  uint k = 0;
+  while (uPendPos < uPendLen || k < uN) {
+    bool bPend = uPendPos < uPendLen;
+    uint8_t b = bPend ? uPend[uPendPos++] : pBytes[k++];
+    switch (pD->uLen) {
+    case 0:
+      if (b == TELEMETRY_SYNC0) pD->uBuf[pD->uLen++] = b;
+      else pD->uSkipped++;
+      continue;
+    case 1:
+      if (b == TELEMETRY_SYNC1) pD->uBuf[pD->uLen++] = b;
+      else if (b == TELEMETRY_SYNC0) pD->uSkipped++;        // 'RRC'; stay at 1
+      else { pD->uSkipped += 2; pD->uLen = 0; }
+      continue;
+    case 2:
+      if (b != TELEMETRY_VERSION) { pD->uSkipped += 2; pD->uLen = 0; if (bPend) uPendPos--; else k--; continue; }
+      break;
+    case 3:
+      if (b == 0 || b > TELEMETRY_BATCH) { pD->uSkipped += 3; pD->uLen = 0; if (bPend) uPendPos--; else k--; continue; }
+      break;
+    }
+    pD->uBuf[pD->uLen++] = b;
+    if (pD->uLen < TELEMETRY_HEADER_LEN) continue;
+    uint uFrameLen = TELEMETRY_HEADER_LEN + pD->uBuf[3] * TELEMETRY_RECORD_LEN + 2;
+    if (pD->uLen < uFrameLen) continue;
+    pD->uLen = 0;
+    uint16_t uCrc = get_le(pD->uBuf + uFrameLen - 2, 2);
+    if (uCrc == telemetry_crc16(pD->uBuf + 2, uFrameLen - 4)) {
+      telemetry_emit(pD, cb, pUser);
+      continue;
+    }
+    pD->uBadCrc++;
+    pD->uSkipped++; // the first sync byte; the rest go back in front of the unread bytes
+    uint uRest = uPendLen - uPendPos;
+    memmove(uPend + uFrameLen - 1, uPend + uPendPos, uRest);
+    memcpy(uPend, pD->uBuf + 1, uFrameLen - 1);
+    uPendLen = uFrameLen - 1 + uRest;
+    uPendPos = 0;
+  } // end while (uPendPos < uPendLen || k < uN)
+} // end void telemetry_decode(...)
@@ -0,0 +1,68 @@
+// @file rcs-telemetry-01.h
+// @date 2026.10.17
+// @info framed binary range telemetry; encoder (firmware) and streaming decoder (host)
+// @info replaces the per ping printf text: no float formatting on the M0+, and reports are batched
+// @info so one usb transfer carries several of them when they arrive faster than the host polls
+
+// @info frame (little endian)
+//   0  'R' 'C'           sync
+//   2  version           TELEMETRY_VERSION
+//   3  n                 records in frame, 1..TELEMETRY_BATCH
+//   4  ref_us    i32     reference flight time, the receiver's reference distance; flight_us + ref_us
+//                        is the flight time from the transmitter (version 2)
+//   8  n * record        TELEMETRY_RECORD_LEN bytes each
+//   .  crc16             ccitt (0x1021, init 0xffff) over version..last record
+// @info record
+//   0  seq       u32     window sequence number; gaps are reports dropped on device
+//   4  time_us   u64     window start, capture sample clock
+//   12 flight_us i32     flight time relative to reference; MISSED_PULSE with REPORT_MISS
+//   16 baseline  u16     adc counts
+//   18 conf      u8      detector confidence 0-255
+//   19 flags     u8      REPORT_*
+
+#ifndef RCS_TELEMETRY_01_H
+#define RCS_TELEMETRY_01_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <sys/types.h> // uint
+#include "rcs-report-01.h"
+
+#define TELEMETRY_SYNC0       'R'
+#define TELEMETRY_SYNC1       'C'
+#define TELEMETRY_VERSION     2    // 2: ref_us in the header
+#define TELEMETRY_RECORD_LEN  20
+#define TELEMETRY_BATCH       12   // records per frame; frame fits the 256 byte cdc tx fifo
+#define TELEMETRY_HEADER_LEN  8
+#define TELEMETRY_FRAME_MAX   (TELEMETRY_HEADER_LEN + TELEMETRY_BATCH * TELEMETRY_RECORD_LEN + 2)
+
+// encoder; records accumulate until the batch is full or the caller flushes
+typedef struct {
+  uint8_t uBuf[TELEMETRY_FRAME_MAX];
+  uint    uCount;  // records in uBuf
+} telemetry_frame_t;
+
+void telemetry_frame_reset(telemetry_frame_t *pF, int32_t iRefFlightUs);
+bool telemetry_frame_add(telemetry_frame_t *pF, const report_t *pR); // true when the frame is full
+uint telemetry_frame_finish(telemetry_frame_t *pF); // appends crc; returns frame length, 0 if empty
+
+// decoder; byte stream in, one callback per valid record. resyncs on the sync bytes after noise
+// (e.g. MC text output); after a crc failure it rescans from the failed frame's second byte
+typedef void (*telemetry_record_cb_t)(const report_t *pR, void *pUser);
+typedef struct {
+  uint8_t  uBuf[TELEMETRY_FRAME_MAX];
+  uint     uLen;       // bytes of the current frame held in uBuf
+  uint32_t uFrames;    // valid frames
+  uint32_t uRecords;   // valid records
+  uint32_t uBadCrc;    // frames dropped on crc
+  uint32_t uSkipped;   // bytes discarded while hunting for sync
+  int32_t  iRefFlightUs; // ref_us of the frame whose records are being called back
+} telemetry_decoder_t;
+
+void telemetry_decoder_init(telemetry_decoder_t *pD);
+void telemetry_decode(telemetry_decoder_t *pD, const uint8_t *pBytes, uint uN,
+                      telemetry_record_cb_t cb, void *pUser);
+
+uint16_t telemetry_crc16(const uint8_t *p, uint uN);
+
+#endif // RCS_TELEMETRY_01_H
@@ -0,0 +1,61 @@
+// @file rcs-track-01.c
+// @date 2026.10.17
+// @info alpha-beta range tracker (see rcs-track-01.h)
+// @info   e = z - r,  r += e/2,  v += e/8,  |e| averaged at 1/2, then r += v for the next ping; a miss
+// @info only predicts.
+// @info the rate term carries a steady walk (a mower at 1m/s is (/ 1.0 343) 2.9ms of flight per s),
+// @info so the gate need only cover the change of speed between pings, not the speed
+
+#include "rcs-track-01.h"
+
+void track_init(track_t *pT, uint32_t uGateMin, uint32_t uGateMax) {
+  // at every sync; gates in samples
+  pT->iRangeQ8 = 0;
+  pT->iRateQ8 = 0;
+  pT->iErrQ8 = 0;
+  pT->uGateMin = uGateMin;
+  pT->uGateMax = uGateMax;
+  pT->uHits = 0;
+  pT->uMisses = 0;
+  pT->bInit = false;
+  pT->bLocked = false;
+  pT->uOutliers = 0;
+}
+
+bool track_update(track_t *pT, bool bValid, int32_t iResidualQ8) {
+  // once per ping, after its window; bValid false for a miss. returns true if the arrival is taken,
+  // false for a miss or an outlier
+  int32_t iGateQ8 = (int32_t)track_gate(pT) << 8;
+  if (bValid && pT->bInit) {
+    int32_t iInnovQ8 = iResidualQ8 - pT->iRangeQ8;
+    if (iInnovQ8 > iGateQ8 || iInnovQ8 < -iGateQ8) {
+      pT->uOutliers++;
+      if (pT->bLocked) bValid = false; // rejected; a miss
+      else pT->bInit = false;          // acquiring: restart from this arrival
+    } else {
+      pT->iRangeQ8 += iInnovQ8 >> TRACK_ALPHA_SHIFT;
+      pT->iRateQ8 += iInnovQ8 >> TRACK_BETA_SHIFT;
+      pT->iErrQ8 += ((iInnovQ8 < 0 ? -iInnovQ8 : iInnovQ8) - pT->iErrQ8) >> TRACK_ERR_SHIFT;
+      pT->uMisses = 0;
+      if (++pT->uHits >= TRACK_LOCK) pT->bLocked = true;
+      pT->iRangeQ8 += pT->iRateQ8;
+      return true;
+    }
+  }
+  if (bValid) { // first arrival, or acquisition restarted
+    pT->iRangeQ8 = iResidualQ8;
+    pT->iRateQ8 = 0;
+    pT->iErrQ8 = 0;
+    pT->uHits = 1;
+    pT->uMisses = 0;
+    pT->bInit = true;
+    return true;
+  }
+  pT->uMisses++;
+  if (pT->uMisses >= TRACK_LOST) {
+    pT->bLocked = false;
+    pT->uHits = 0;
+  }
+  pT->iRangeQ8 += pT->iRateQ8; // coast
+  return false;
+} // end bool track_update(...)
@@ -0,0 +1,52 @@
+// @file rcs-track-01.h
+// @date 2026.10.17
+// @info alpha-beta range tracker header; predicts the next ping's arrival so the detector searches
+// @info a gate around it instead of the whole window
+// @info works on the flight residual, the arrival against the predicted reference distance arrival
+// @info (rcs-drift-01), in samples Q8: position gain 1/2, rate gain 1/8, shifts only, no floats.
+// @info acquiring, every arrival is searched for over the full window and checked against the
+// @info prediction; TRACK_LOCK consistent ones in a row lock the track, an inconsistent one restarts
+// @info it there. locked, the gate is the search range: half width uGateMin, plus twice the tracked
+// @info rate (the target may turn round) and twice the mean innovation (it is turning: the alpha-beta
+// @info lags a change of speed), doubled per consecutive miss up to uGateMax; TRACK_LOST misses in a
+// @info row drop the lock (full window again).
+// @info an arrival outside the gate while locked is an outlier: rejected, counted, taken as a miss.
+
+#ifndef RCS_TRACK_01_H
+#define RCS_TRACK_01_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <sys/types.h> // uint
+
+#define TRACK_ALPHA_SHIFT  1  // position gain 1/2
+#define TRACK_BETA_SHIFT   3  // rate gain 1/8; benedict-bordner for alpha 1/2 is (/ (* .5 .5) 1.5) 0.167
+#define TRACK_LOCK         3  // consistent arrivals in a row to lock
+#define TRACK_LOST         4  // misses in a row to drop the lock
+#define TRACK_ERR_SHIFT    1  // mean innovation gain 1/2; a turn opens the gate within a ping
+
+typedef struct {
+  int32_t  iRangeQ8;   // predicted residual for the next ping, samples Q8
+  int32_t  iRateQ8;    // residual change per ping, samples Q8
+  int32_t  iErrQ8;     // mean absolute innovation, samples Q8
+  uint32_t uGateMin;   // gate half width when locked, samples
+  uint32_t uGateMax;   // gate half width cap, samples; the window
+  uint     uHits;      // consistent arrivals in a row
+  uint     uMisses;    // misses in a row
+  bool     bInit;      // iRangeQ8 holds an estimate
+  bool     bLocked;
+  uint32_t uOutliers;  // arrivals rejected, locked or restarting acquisition
+} track_t;
+
+void track_init(track_t *pT, uint32_t uGateMin, uint32_t uGateMax);
+bool track_update(track_t *pT, bool bValid, int32_t iResidualQ8);
+
+static inline uint32_t track_gate(const track_t *pT) {
+  // gate half width for the next ping, samples; widens per consecutive miss
+  uint uShift = pT->uMisses < 16 ? pT->uMisses : 16;
+  uint32_t uRate = (pT->iRateQ8 < 0 ? -pT->iRateQ8 : pT->iRateQ8) >> 8;
+  uint64_t uGate = ((uint64_t)pT->uGateMin + 2 * uRate + 2 * (pT->iErrQ8 >> 8)) << uShift;
+  return uGate < pT->uGateMax ? (uint32_t)uGate : pT->uGateMax;
+}
+
+#endif // RCS_TRACK_01_H
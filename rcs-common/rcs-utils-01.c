@@ -9,27 +9,33 @@
 
 // #define MC // mincom support; enables stdio; gates program start prior to mc connection
 
-#include "pico/stdlib.h"
 #include <stdio.h>
 #include <stdlib.h>
-#include "tusb.h"  // tusb_wait_for_connection()
-#include "hardware/gpio.h"
-#include "hardware/adc.h"
 #include <inttypes.h> // printf("%" PRIu64/d64/x64 "\n", t)
+#include "rcs-hal-01.h" // pico sdk or host backend; gpio, adc, usb
+#include "rcs-dsp-01.h" // dsp_mean_u16()
+
+#define ADC_AVG_MAX 256 // adc_avg_n() samples; (* 256 2) 512B of stack
 
 // globals
 // - hardware
 const uint   G_LED_PIN = PICO_DEFAULT_LED_PIN;
 const float  G_adc_cf = 3.3f / (1 << 12); // 12 bit adc conversion factor
+// - rx-04 gpio binary led distance display 0-15 -> (0000 - 1111)
+const uint G_GP2_BIT0    =  2; // pin 4
+const uint G_GP3_BIT1    =  3; // pin 5
+const uint G_GP4_BIT2    =  4; // pin 6
+const uint G_GP5_BIT3    =  5; // pin 7
+const uint32_t G_uBin4Mask = 0xF << 2; // GP2..GP5; bit0 on GP2
 // - serial comms
 uint8_t  G_uBuf[1025]; // global serial data buffer 
 uint     G_uBufCt=0;   
 
 void tusb_wait_for_connection(void) {
   // blocks until minicom connection; MC is assumed defined before call
-  while (!tud_cdc_connected()) {
+  while (!hal_usb_connected()) {
     printf(".");
-    sleep_ms(300);
+    hal_sleep_ms(300);
   }
   printf("\ntusb connection established\n");
   printf("c-a x exits minicom\n");
@@ -41,8 +47,8 @@ int get_serial_char() {
   // return received char; globals G_uBuf* updated
   // MC is assumed defined before call
   const uint newline = 13;
-  int ch = getchar_timeout_us(0);
-  if (ch != PICO_ERROR_TIMEOUT) {
+  int ch = hal_getchar_timeout_us(0);
+  if (ch != HAL_NO_CHAR) {
     printf("%c", ch);
     if (ch != newline  && G_uBufCt < 1024 ) { // newline and not char limit
       G_uBuf[G_uBufCt]=ch;
@@ -55,40 +61,96 @@ int get_serial_char() {
   } else {
     // 'timeout' suppressed; happens each loop pass with no input
     // printf("--debug-- get_serial_char() timeout\n", G_uBuf);
-  } // end if (ch != PICO_ERROR_TIMEOUT)
+  } // end if (ch != HAL_NO_CHAR)
   return ch;
 } // end get_serial_char()
 
+const char *get_serial_line() {
+  // non-blocking, no echo: drain available serial chars into global G_uBuf*; return the line
+  // (without the cr/lf) when one completes, else NULL. safe with binary output on the same usb
+  // (get_serial_char() echoes). the returned line is valid until the next call
+  int ch;
+  while ((ch = hal_getchar_timeout_us(0)) != HAL_NO_CHAR) {
+    if (ch == '\r' || ch == '\n') {
+      if (G_uBufCt == 0) continue; // empty line, or lf of a cr/lf pair
+      G_uBuf[G_uBufCt] = 0;
+      G_uBufCt = 0;
+      return (const char *)G_uBuf;
+    }
+    if (G_uBufCt < 1024) G_uBuf[G_uBufCt++] = ch;
+  }
+  return NULL;
+} // end get_serial_line()
+
 void flash_led_16hz() {
   // flash the on board LED; 31ms for 50% duty cycle 16Hz flashes;
   for (uint i=0; i<3; i++) { // 4 pulses/flashes
-    gpio_put(G_LED_PIN, 1); 
-    busy_wait_ms(31);
-    gpio_put(G_LED_PIN, 0);
-    busy_wait_ms(31);
+    hal_gpio_put(G_LED_PIN, 1); 
+    hal_busy_wait_ms(31);
+    hal_gpio_put(G_LED_PIN, 0);
+    hal_busy_wait_ms(31);
   } // end for
 } // end void flash_led_16hz() 
 
 void config_gpio_pullup(uint gp) {
   // configure pin 'gp' as input with 50K pull up
-  gpio_init(gp);
-  gpio_set_dir(gp, GPIO_IN);
-  gpio_pull_up(gp);
+  hal_gpio_init(gp);
+  hal_gpio_set_dir(gp, HAL_GPIO_IN);
+  hal_gpio_pull_up(gp);
 }
 
 void config_gpio_pulldown(uint gp) {
   // configure pin 'gp' as input with 50K pull down
-  gpio_init(gp);
-  gpio_set_dir(gp, GPIO_IN);
-  gpio_pull_down(gp);
+  hal_gpio_init(gp);
+  hal_gpio_set_dir(gp, HAL_GPIO_IN);
+  hal_gpio_pull_down(gp);
 }
 
+void config_rx04_bias(void) {
+  // rx-04 amplifier: the transistor bias network is the gpio pull up/down resistors (from
+  // rcs-rx04-03; also rcs-mono01-01, same amplifier)
+  const uint GP21_IREF   = 21; // iref mirror master pullup
+  const uint GP19_INP    = 19; // diff pair in plus pull up
+  const uint GP12_INM    = 12; // diff pair in minus pull up
+  const uint GP18_LOADP  = 18; // diff pair plus leg load pull up
+  const uint GP13_LOADM  = 13; // diff pair minus leg load  pull up
+  const uint GP20_INPLO  = 20; // diff pair in plus low res pull down
+  const uint GP11_INMLO  = 11; // diff pair in minus low res pull down
+  config_gpio_pullup(GP21_IREF); // pull up
+  config_gpio_pullup(GP19_INP);
+  config_gpio_pullup(GP12_INM);
+  config_gpio_pullup(GP18_LOADP);
+  config_gpio_pullup(GP13_LOADM);
+  config_gpio_pulldown(GP20_INPLO); // pull down
+  config_gpio_pulldown(GP11_INMLO);
+} // end void config_rx04_bias()
+
+void gpio_led_bin4_init(void) {
+  // configure the 4 bit led display once; updates are a single masked write (from rcs-rx04-03;
+  // also rcs-mono01-01, same board)
+  for (uint gp = G_GP2_BIT0; gp <= G_GP5_BIT3; gp++) {
+    hal_gpio_init(gp);
+    hal_gpio_set_dir(gp, HAL_GPIO_OUT);
+  }
+  hal_gpio_put_masked(G_uBin4Mask, 0);
+} // end void gpio_led_bin4_init()
+
+void gpio_led_int_to_bin4(int iValue) {
+  // display the low 4 bits of iValue as binary on 4 led display
+  // GP2..GP5 are contiguous, bit0 on GP2
+  hal_gpio_put_masked(G_uBin4Mask, ((uint)iValue & 0xF) << G_GP2_BIT0);
+} // end void gpio_led_int_to_bin4(int iValue)
+
 uint16_t adc_avg_n ( uint uN ) {
-  // take uN adc samples and return average.
-  uint16_t adc_avg = adc_read(); // init average
-  for (size_t i=0; i<uN; i++) {
-    adc_avg = (adc_avg + adc_read())/2.0;
+  // take uN adc samples and return their rounded mean (dsp_mean_u16()); uN is capped at ADC_AVG_MAX,
+  // the samples are held on the stack. (was a decaying pairwise average that weighted the last few
+  // samples; a true mean seeds the adaptive baseline)
+  uint16_t uX[ADC_AVG_MAX];
+  if (uN == 0) return hal_adc_read();
+  if (uN > ADC_AVG_MAX) uN = ADC_AVG_MAX;
+  for (uint i=0; i<uN; i++) {
+    uX[i] = hal_adc_read();
   }
-  return adc_avg;
+  return dsp_mean_u16(uX, uN);
 } // end uint16_t adc_avg_n ( uint uN )
 
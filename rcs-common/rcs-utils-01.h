@@ -14,12 +14,19 @@ extern uint G_uBufCt;
 // - hardware
 extern const uint G_LED_PIN;
 extern const float  G_adc_cf; // 12 bit adc conversion factor
+extern const uint G_GP2_BIT0; // rx-04 4 bit led display, GP2..GP5
+extern const uint G_GP5_BIT3;
+extern const uint32_t G_uBin4Mask;
 
 // serial comms
 void tusb_wait_for_connection(void);
 int get_serial_char();
+const char *get_serial_line();
 // hardware
 void flash_led_16hz();
 void config_gpio_pullup(uint gp);
 void config_gpio_pulldown(uint gp);
-uint16_t adc_avg_n ( uint uN );
+void config_rx04_bias(void);
+void gpio_led_bin4_init(void);
+void gpio_led_int_to_bin4(int iValue);
+uint16_t adc_avg_n ( uint uN ); // uN <= 256 (ADC_AVG_MAX)
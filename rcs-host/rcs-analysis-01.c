@@ -0,0 +1,144 @@
+// @file rcs-analysis-01.c
+// @date 2026.10.17
+// @info capture analysis kernels; statistics and power spectrum over blocks of adc counts (rcs-analysis-01.h)
+// @info the spectrum is welch style: mean removed hann frames of ANALYSIS_FFT_LEN, no overlap, |X|^2
+// @info summed per bin. a tail shorter than a frame is left out
+
+#include <string.h>
+#include <math.h>
+#include "rcs-analysis-01.h"
+
+static float    S_fWindow[ANALYSIS_FFT_LEN];
+static float    S_fCos[ANALYSIS_FFT_LEN / 2];
+static float    S_fSin[ANALYSIS_FFT_LEN / 2];
+static uint16_t S_uRev[ANALYSIS_FFT_LEN];
+
+void analysis_init(void) {
+  for (uint i = 0; i < ANALYSIS_FFT_LEN; i++) {
+    S_fWindow[i] = 0.5f - 0.5f * cosf(2 * M_PI * i / ANALYSIS_FFT_LEN);
+    uint r = 0;
+    for (uint b = 0; b < ANALYSIS_FFT_BITS; b++) r |= ((i >> b) & 1) << (ANALYSIS_FFT_BITS - 1 - b);
+    S_uRev[i] = r;
+  }
+  for (uint i = 0; i < ANALYSIS_FFT_LEN / 2; i++) {
+    S_fCos[i] = cosf(2 * M_PI * i / ANALYSIS_FFT_LEN);
+    S_fSin[i] = -sinf(2 * M_PI * i / ANALYSIS_FFT_LEN);
+  }
+} // end void analysis_init(...)
+
+void analysis_stats_clear(analysis_stats_t *pS) {
+  memset(pS, 0, sizeof(*pS));
+  pS->uMin = UINT16_MAX;
+}
+
+void analysis_stats(analysis_stats_t *pS, const uint16_t *restrict pSamples, size_t uN) {
+  // accumulate uN samples; the inner loop has no branches and 32 bit partial sums
+  for (size_t i = 0; i < uN; i += ANALYSIS_STATS_BLOCK) {
+    size_t uLen = (uN - i < ANALYSIS_STATS_BLOCK) ? uN - i : ANALYSIS_STATS_BLOCK;
+    const uint16_t *restrict p = pSamples + i;
+    uint32_t uSum = 0, uClipped = 0;
+    uint64_t uSumSq = 0;
+    uint16_t uMin = pS->uMin, uMax = pS->uMax;
+    for (size_t k = 0; k < uLen; k++) {
+      uint32_t x = p[k];
+      uSum += x;
+      uSumSq += x * x;
+      uMin = (x < uMin) ? x : uMin;
+      uMax = (x > uMax) ? x : uMax;
+      uClipped += (x == 0) | (x >= ANALYSIS_FULL_SCALE);
+    }
+    pS->uSum += uSum;
+    pS->uSumSq += uSumSq;
+    pS->uClipped += uClipped;
+    pS->uMin = uMin;
+    pS->uMax = uMax;
+  }
+  pS->uSamples += uN;
+} // end void analysis_stats(...)
+
+void analysis_stats_merge(analysis_stats_t *pTo, const analysis_stats_t *pFrom) {
+  pTo->uSamples += pFrom->uSamples;
+  pTo->uSum += pFrom->uSum;
+  pTo->uSumSq += pFrom->uSumSq;
+  pTo->uClipped += pFrom->uClipped;
+  if (pFrom->uMin < pTo->uMin) pTo->uMin = pFrom->uMin;
+  if (pFrom->uMax > pTo->uMax) pTo->uMax = pFrom->uMax;
+}
+
+double analysis_mean(const analysis_stats_t *pS) {
+  return pS->uSamples ? (double)pS->uSum / pS->uSamples : 0;
+}
+
+double analysis_std(const analysis_stats_t *pS) {
+  // population standard deviation, counts
+  if (!pS->uSamples) return 0;
+  double fMean = analysis_mean(pS);
+  double fVar = (double)pS->uSumSq / pS->uSamples - fMean * fMean;
+  return fVar > 0 ? sqrt(fVar) : 0;
+}
+
+static void analysis_fft(float *restrict pRe, float *restrict pIm) {
+  // in place radix 2, input already in bit reversed order
+  for (uint uHalf = 1, uStride = ANALYSIS_FFT_LEN / 2; uHalf < ANALYSIS_FFT_LEN; uHalf <<= 1, uStride >>= 1) {
+    for (uint i = 0; i < ANALYSIS_FFT_LEN; i += uHalf << 1) {
+      for (uint k = 0; k < uHalf; k++) {
+        float c = S_fCos[k * uStride], s = S_fSin[k * uStride];
+        uint a = i + k, b = a + uHalf;
+        float tr = pRe[b] * c - pIm[b] * s;
+        float ti = pRe[b] * s + pIm[b] * c;
+        pRe[b] = pRe[a] - tr;
+        pIm[b] = pIm[a] - ti;
+        pRe[a] += tr;
+        pIm[a] += ti;
+      }
+    }
+  }
+} // end static void analysis_fft(...)
+
+void analysis_psd_clear(analysis_psd_t *pP) {
+  memset(pP, 0, sizeof(*pP));
+}
+
+void analysis_psd(analysis_psd_t *pP, const uint16_t *pSamples, size_t uN, float fMean) {
+  // whole frames of uN samples; fMean (counts) removed before the window
+  float fRe[ANALYSIS_FFT_LEN], fIm[ANALYSIS_FFT_LEN], fX[ANALYSIS_FFT_LEN];
+  float fPower[ANALYSIS_BINS] = { 0 };
+  for (size_t f = 0; f + ANALYSIS_FFT_LEN <= uN; f += ANALYSIS_FFT_LEN) {
+    const uint16_t *p = pSamples + f;
+    for (uint i = 0; i < ANALYSIS_FFT_LEN; i++) fX[i] = ((float)p[i] - fMean) * S_fWindow[i];
+    for (uint i = 0; i < ANALYSIS_FFT_LEN; i++) {
+      fRe[i] = fX[S_uRev[i]];
+      fIm[i] = 0;
+    }
+    analysis_fft(fRe, fIm);
+    for (uint i = 0; i < ANALYSIS_BINS; i++) fPower[i] += fRe[i] * fRe[i] + fIm[i] * fIm[i];
+    pP->uFrames++;
+  }
+  for (uint i = 0; i < ANALYSIS_BINS; i++) pP->fPower[i] += fPower[i];
+} // end void analysis_psd(...)
+
+void analysis_psd_merge(analysis_psd_t *pTo, const analysis_psd_t *pFrom) {
+  pTo->uFrames += pFrom->uFrames;
+  for (uint i = 0; i < ANALYSIS_BINS; i++) pTo->fPower[i] += pFrom->fPower[i];
+}
+
+uint analysis_psd_peak(const analysis_psd_t *pP) {
+  // strongest bin above the dc lobe
+  uint uPeak = ANALYSIS_DC_BINS;
+  for (uint i = ANALYSIS_DC_BINS; i < ANALYSIS_BINS; i++) {
+    if (pP->fPower[i] > pP->fPower[uPeak]) uPeak = i;
+  }
+  return uPeak;
+}
+
+double analysis_band_db(const analysis_psd_t *pP, uint32_t uSampleHz, uint32_t uCenterHz, uint32_t uHalfHz) {
+  // power within uCenterHz +- uHalfHz against the rest of the spectrum above the dc lobe, dB
+  double fIn = 0, fOut = 0;
+  for (uint i = ANALYSIS_DC_BINS; i < ANALYSIS_BINS; i++) {
+    double fHz = (double)i * uSampleHz / ANALYSIS_FFT_LEN;
+    if (fabs(fHz - uCenterHz) <= uHalfHz) fIn += pP->fPower[i];
+    else fOut += pP->fPower[i];
+  }
+  if (fIn <= 0 || fOut <= 0) return 0;
+  return 10 * log10(fIn / fOut);
+} // end double analysis_band_db(...)
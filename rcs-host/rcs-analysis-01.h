@@ -0,0 +1,49 @@
+// @file rcs-analysis-01.h
+// @date 2026.10.17
+// @info capture analysis kernels header; statistics and power spectrum over blocks of adc counts
+// @info the kernels keep no state outside their accumulator, so threads run them on separate blocks
+// @info of one archive and merge the accumulators after. inner loops are flat loops over uint16/float
+// @info arrays that the compiler vectorizes (-O3; rcs-host/CMakeLists.txt)
+// @info analysis_init() fills the shared window and twiddle tables; call it once before any thread starts
+
+#ifndef RCS_ANALYSIS_01_H
+#define RCS_ANALYSIS_01_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <sys/types.h> // uint
+
+#define ANALYSIS_FFT_BITS    8
+#define ANALYSIS_FFT_LEN     (1 << ANALYSIS_FFT_BITS) // hann frame; (/ 380000 256.0) 1484Hz bins at DAT_SAMPLE_HZ
+#define ANALYSIS_BINS        (ANALYSIS_FFT_LEN / 2 + 1)
+#define ANALYSIS_STATS_BLOCK 4096  // samples per uint32 partial sum; (* 4096 4095) < 2^32
+#define ANALYSIS_FULL_SCALE  4095  // 12 bit adc; samples at 0 or here count as clipped
+#define ANALYSIS_DC_BINS     2     // bins under the hann main lobe of dc; left out of peak and band ratios
+
+typedef struct {
+  uint64_t uSamples;
+  uint64_t uSum;      // counts
+  uint64_t uSumSq;    // counts^2; (* 4095 4095 1.8e9) an hour at 500ksps fits in 2^64
+  uint16_t uMin;
+  uint16_t uMax;
+  uint64_t uClipped;
+} analysis_stats_t;
+
+typedef struct {
+  uint64_t uFrames;
+  double   fPower[ANALYSIS_BINS]; // |X|^2 summed over frames, counts^2
+} analysis_psd_t;
+
+void   analysis_init(void);
+void   analysis_stats_clear(analysis_stats_t *pS);
+void   analysis_stats(analysis_stats_t *pS, const uint16_t *pSamples, size_t uN);
+void   analysis_stats_merge(analysis_stats_t *pTo, const analysis_stats_t *pFrom);
+double analysis_mean(const analysis_stats_t *pS);
+double analysis_std(const analysis_stats_t *pS);
+void   analysis_psd_clear(analysis_psd_t *pP);
+void   analysis_psd(analysis_psd_t *pP, const uint16_t *pSamples, size_t uN, float fMean);
+void   analysis_psd_merge(analysis_psd_t *pTo, const analysis_psd_t *pFrom);
+uint   analysis_psd_peak(const analysis_psd_t *pP);
+double analysis_band_db(const analysis_psd_t *pP, uint32_t uSampleHz, uint32_t uCenterHz, uint32_t uHalfHz);
+
+#endif // RCS_ANALYSIS_01_H
@@ -0,0 +1,334 @@
+// @file rcs-analyze-01.c
+// @date 2026.10.17
+// @info capture analysis over many archives at once; replaces the load-and-plot mfiles
+// @info (../rcs-rx04-03/mfiles/exp_dist_0N/exp_dist_0N.m) with summary tables
+// @info every input (.dat or .rcb, rcs-archive-01.h) is cut at its sections, and sections longer than
+// @info ANALYZE_UNIT into units; a pool of threads (-j, default one per cpu) works through the units
+// @info of all files: statistics, power spectrum (rcs-analysis-01) and matched filter detection
+// @info (rcs-detect-01, the receiver's detector at the archive's rate). a section is one capture, so
+// @info the detector does not run across sections: it starts at the section, and a peak still open
+// @info at the section end is finished on baseline padding. inside a section a unit's detector starts
+// @info ANALYZE_WARM burst lengths early and runs that far past the unit's end, keeping only bursts
+// @info that start inside it, so the counts do not depend on -j. units are merged per file in order.
+// @info summary (tsv, stdout or -o): per file samples, seconds, mean/std/min/max (mV), clipped samples,
+// @info bursts and burst rate, mean/max burst amplitude (mV), spectral peak (Hz) and the carrier band
+// @info against the rest of the spectrum (dB). throughput goes to stderr.
+// @info -a arrivals.tsv lists every burst (file, section, sample, us, amplitude, width, confidence);
+// @info -p psd.tsv writes the mean spectrum per file (dB); -b dir writes each input to dir as .rcb
+
+// @usage ./rcs-analyze-01 [-j threads] [-t volts] [-r dat_hz] [-o summary.tsv] [-a arrivals.tsv] [-p psd.tsv] [-b rcb_dir] files...
+// @usage e.g. ./rcs-analyze-01 -a arrivals.tsv ../../rcs-rx04-03/mfiles/exp_dist_0?/*.dat
+// @usage (tx_rx_timing_skew_01/rx.dat is a skew series in us, not a capture)
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <math.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <inttypes.h> // printf("%" PRIu64/d64/x64 "\n", t)
+#include "rcs-dat-01.h"
+#include "rcs-archive-01.h"
+#include "rcs-analysis-01.h"
+#include "../rcs-common/rcs-detect-01.h"
+
+#define ANALYZE_UNIT      (1 << 20) // samples per work unit; (/ (expt 2 20) 500000.0) 2.1s at the capture rate
+#define ANALYZE_WARM      4         // burst lengths scanned before and after a unit
+#define ANALYZE_BAND_HZ   5000      // carrier band half width; an 8 cycle burst is (/ 40000 8) 5KHz wide
+#define ANALYZE_THREADS_MAX 256
+
+typedef struct {
+  uint64_t uIdx;        // burst start, samples
+  uint16_t uAmp;        // counts
+  uint16_t uWidth;
+  uint8_t  uConfidence;
+} analyze_arrival_t;
+
+typedef struct {
+  uint              uFile;
+  size_t            uFrom, uTo;
+  size_t            uSecFrom, uSecTo; // section holding the unit
+  analysis_stats_t  stats;
+  analysis_psd_t    psd;
+  uint64_t          uBursts;
+  uint64_t          uAmpSum;
+  uint16_t          uAmpMax;
+  analyze_arrival_t *pArrivals; // kept with -a
+  size_t            uArrivals, uArrivalCap;
+} analyze_unit_t;
+
+typedef struct {
+  const char       *sPath;
+  archive_t         archive;
+  bool              bOk;
+  analysis_stats_t  stats;
+  analysis_psd_t    psd;
+  uint64_t          uBursts;
+  uint64_t          uAmpSum;
+  uint16_t          uAmpMax;
+} analyze_file_t;
+
+static analyze_file_t *S_pFiles;
+static uint            S_uFiles;
+static analyze_unit_t *S_pUnits;
+static size_t          S_uUnits;
+static size_t          S_uNext;       // next file (open) or unit (analysis); taken atomically
+static uint16_t        S_uThreshold;  // counts over the baseline
+static uint32_t        S_uDatHz;
+static bool            S_bArrivals;
+
+static double now_s(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void *open_worker(void *pArg) {
+  // ascii parsing is the slow part of a .dat; files are opened in parallel too
+  (void)pArg;
+  for (size_t f; (f = __atomic_fetch_add(&S_uNext, 1, __ATOMIC_RELAXED)) < S_uFiles;) {
+    S_pFiles[f].bOk = archive_open(&S_pFiles[f].archive, S_pFiles[f].sPath, S_uDatHz);
+  }
+  return NULL;
+}
+
+static void unit_detect(analyze_unit_t *pU, const archive_t *pA, uint16_t uBaseline) {
+  // bursts starting in [uFrom, uTo); the detector sees ANALYZE_WARM burst lengths either side,
+  // within the section
+  detect_t detect;
+  detect_result_t result;
+  uint16_t uPad[DETECT_HIST_LEN];
+  memset(&detect, 0, sizeof(detect));
+  detect_set_rate(&detect, pA->uSampleHz, DETECT_CARRIER_HZ);
+  size_t uWarm = (size_t)ANALYZE_WARM * detect.uTemplateLen;
+  size_t uStart = (pU->uFrom - pU->uSecFrom > uWarm) ? pU->uFrom - uWarm : pU->uSecFrom;
+  size_t uEnd = (pU->uSecTo - pU->uTo > uWarm) ? pU->uTo + uWarm : pU->uSecTo;
+  for (uint i = 0; i < DETECT_HIST_LEN; i++) uPad[i] = uBaseline;
+  detect_init(&detect, uBaseline, detect_mag_for_threshold(&detect, S_uThreshold), uStart);
+  for (;;) {
+    bool bHit;
+    if (detect.uIdx < uEnd) bHit = detect_run(&detect, pA->pSamples + detect.uIdx, uEnd - detect.uIdx, &result);
+    else if (uEnd == pU->uSecTo && detect.bArmed) bHit = detect_run(&detect, uPad, DETECT_HIST_LEN, &result);
+    else break;
+    if (!bHit) continue;
+    // a capture triggered inside a burst puts its start before the section; it starts the section
+    int64_t iIdx = result.iArrivalQ8 >> DETECT_FRAC_BITS;
+    uint64_t uIdx = (iIdx < (int64_t)pU->uSecFrom) ? pU->uSecFrom : (uint64_t)iIdx;
+    if (uIdx < pU->uFrom || uIdx >= pU->uTo) continue;
+    uint16_t uAmp = detect_amplitude_for_mag(&detect, result.uPeakMag);
+    pU->uBursts++;
+    pU->uAmpSum += uAmp;
+    if (uAmp > pU->uAmpMax) pU->uAmpMax = uAmp;
+    if (!S_bArrivals) continue;
+    if (pU->uArrivals == pU->uArrivalCap) {
+      pU->uArrivalCap = pU->uArrivalCap ? pU->uArrivalCap * 2 : 64;
+      pU->pArrivals = realloc(pU->pArrivals, pU->uArrivalCap * sizeof(analyze_arrival_t));
+    }
+    pU->pArrivals[pU->uArrivals++] = (analyze_arrival_t){ uIdx, uAmp, result.uWidth, result.uConfidence };
+  }
+} // end static void unit_detect(...)
+
+static void *unit_worker(void *pArg) {
+  (void)pArg;
+  for (size_t u; (u = __atomic_fetch_add(&S_uNext, 1, __ATOMIC_RELAXED)) < S_uUnits;) {
+    analyze_unit_t *pU = &S_pUnits[u];
+    const archive_t *pA = &S_pFiles[pU->uFile].archive;
+    const uint16_t *p = pA->pSamples + pU->uFrom;
+    size_t uN = pU->uTo - pU->uFrom;
+    analysis_stats_clear(&pU->stats);
+    analysis_stats(&pU->stats, p, uN);
+    double fMean = analysis_mean(&pU->stats);
+    analysis_psd_clear(&pU->psd);
+    analysis_psd(&pU->psd, p, uN, fMean);
+    unit_detect(pU, pA, (uint16_t)(fMean + 0.5));
+  }
+  return NULL;
+} // end static void *unit_worker(...)
+
+static void run_pool(void *(*pWorker)(void *), uint uThreads) {
+  pthread_t threads[ANALYZE_THREADS_MAX];
+  S_uNext = 0;
+  for (uint t = 0; t < uThreads; t++) pthread_create(&threads[t], NULL, pWorker, NULL);
+  for (uint t = 0; t < uThreads; t++) pthread_join(threads[t], NULL);
+}
+
+static double counts_mv(double fCounts) {
+  return fCounts * DAT_ADC_CF * 1000;
+}
+
+static void write_summary(FILE *f) {
+  fprintf(f, "file\tformat\tsample_hz\tsamples\tseconds\tmean_mv\tstd_mv\tmin_mv\tmax_mv\tclipped\t"
+             "bursts\tbursts_per_s\tamp_mean_mv\tamp_max_mv\tpeak_hz\tband_db\n");
+  for (uint i = 0; i < S_uFiles; i++) {
+    const analyze_file_t *pF = &S_pFiles[i];
+    if (!pF->bOk) continue;
+    const archive_t *pA = &pF->archive;
+    double fSeconds = (double)pA->uSamples / pA->uSampleHz;
+    fprintf(f, "%s\t%s\t%u\t%zu\t%.4f\t%.2f\t%.3f\t%.1f\t%.1f\t%" PRIu64 "\t%" PRIu64 "\t%.2f\t%.1f\t%.1f\t%.0f\t%.1f\n",
+            pF->sPath, pA->bBinary ? "rcb" : "dat", pA->uSampleHz, pA->uSamples, fSeconds,
+            counts_mv(analysis_mean(&pF->stats)), counts_mv(analysis_std(&pF->stats)),
+            counts_mv(pF->stats.uMin), counts_mv(pF->stats.uMax), pF->stats.uClipped,
+            pF->uBursts, pF->uBursts / fSeconds,
+            counts_mv(pF->uBursts ? (double)pF->uAmpSum / pF->uBursts : 0), counts_mv(pF->uAmpMax),
+            pF->psd.uFrames ? (double)analysis_psd_peak(&pF->psd) * pA->uSampleHz / ANALYSIS_FFT_LEN : 0,
+            analysis_band_db(&pF->psd, pA->uSampleHz, DETECT_CARRIER_HZ, ANALYZE_BAND_HZ));
+  }
+} // end static void write_summary(...)
+
+static void write_arrivals(FILE *f) {
+  fprintf(f, "file\tsection\tsample\tus\tamp_mv\twidth\tconfidence\n");
+  for (size_t u = 0; u < S_uUnits; u++) {
+    const analyze_unit_t *pU = &S_pUnits[u];
+    const archive_t *pA = &S_pFiles[pU->uFile].archive;
+    for (size_t i = 0; i < pU->uArrivals; i++) {
+      const analyze_arrival_t *pR = &pU->pArrivals[i];
+      fprintf(f, "%s\t%u\t%" PRIu64 "\t%.1f\t%.1f\t%u\t%u\n", S_pFiles[pU->uFile].sPath,
+              archive_section_of(pA, pR->uIdx), pR->uIdx, pR->uIdx * 1e6 / pA->uSampleHz,
+              counts_mv(pR->uAmp), pR->uWidth, pR->uConfidence);
+    }
+  }
+} // end static void write_arrivals(...)
+
+static void write_psd(FILE *f) {
+  // one row per bin; frequency of the first good file's rate, a column per file
+  uint32_t uHz = 0;
+  fprintf(f, "bin\thz");
+  for (uint i = 0; i < S_uFiles; i++) {
+    if (!S_pFiles[i].bOk) continue;
+    if (!uHz) uHz = S_pFiles[i].archive.uSampleHz;
+    fprintf(f, "\t%s", S_pFiles[i].sPath);
+  }
+  fprintf(f, "\n");
+  for (uint b = 0; b < ANALYSIS_BINS; b++) {
+    fprintf(f, "%u\t%.0f", b, (double)b * uHz / ANALYSIS_FFT_LEN);
+    for (uint i = 0; i < S_uFiles; i++) {
+      const analyze_file_t *pF = &S_pFiles[i];
+      if (!pF->bOk) continue;
+      double fPower = pF->psd.uFrames ? pF->psd.fPower[b] / pF->psd.uFrames : 0;
+      fprintf(f, "\t%.2f", fPower > 0 ? 10 * log10(fPower) : -999.0);
+    }
+    fprintf(f, "\n");
+  }
+} // end static void write_psd(...)
+
+static FILE *open_out(const char *sPath) {
+  FILE *f = fopen(sPath, "w");
+  if (!f) fprintf(stderr, "cannot create %s\n", sPath);
+  return f;
+}
+
+static int usage(const char *sProg) {
+  fprintf(stderr, "usage: %s [-j threads] [-t volts] [-r dat_hz] [-o summary.tsv] [-a arrivals.tsv] [-p psd.tsv] [-b rcb_dir] files...\n", sProg);
+  return 1;
+}
+
+int main(int argc, char **argv) {
+  long lCpus = sysconf(_SC_NPROCESSORS_ONLN);
+  uint uThreads = lCpus > 0 ? lCpus : 1;
+  double fThreshold = 0.05; // matches rcs-rx04-03 uAdcThresholdMv, 50 mV through dsp_mv_to_counts()
+  const char *sSummary = NULL, *sArrivals = NULL, *sPsd = NULL, *sRcbDir = NULL;
+  int opt;
+  while ((opt = getopt(argc, argv, "j:t:r:o:a:p:b:")) != -1) {
+    switch (opt) {
+      case 'j': uThreads = atoi(optarg); break;
+      case 't': fThreshold = atof(optarg); break;
+      case 'r': S_uDatHz = atoi(optarg); break;
+      case 'o': sSummary = optarg; break;
+      case 'a': sArrivals = optarg; break;
+      case 'p': sPsd = optarg; break;
+      case 'b': sRcbDir = optarg; break;
+      default: return usage(argv[0]);
+    }
+  }
+  if (optind >= argc) return usage(argv[0]);
+  if (uThreads < 1) uThreads = 1;
+  if (uThreads > ANALYZE_THREADS_MAX) uThreads = ANALYZE_THREADS_MAX;
+  S_uThreshold = fThreshold / DAT_ADC_CF;
+  S_bArrivals = sArrivals != NULL;
+  analysis_init();
+
+  double t0 = now_s();
+  S_uFiles = argc - optind;
+  S_pFiles = calloc(S_uFiles, sizeof(analyze_file_t));
+  for (uint f = 0; f < S_uFiles; f++) S_pFiles[f].sPath = argv[optind + f];
+  run_pool(open_worker, uThreads);
+  double t1 = now_s();
+
+  size_t uTotal = 0;
+  for (uint f = 0; f < S_uFiles; f++) {
+    if (!S_pFiles[f].bOk) continue;
+    S_uUnits += (S_pFiles[f].archive.uSamples + ANALYZE_UNIT - 1) / ANALYZE_UNIT + S_pFiles[f].archive.uSections;
+    uTotal += S_pFiles[f].archive.uSamples;
+  }
+  S_pUnits = calloc(S_uUnits ? S_uUnits : 1, sizeof(analyze_unit_t));
+  S_uUnits = 0;
+  for (uint f = 0; f < S_uFiles; f++) {
+    const archive_t *pA = &S_pFiles[f].archive;
+    if (!S_pFiles[f].bOk) continue;
+    for (uint s = 0; s < (pA->uSections ? pA->uSections : 1); s++) {
+      size_t uSecFrom = pA->uSections ? pA->uStarts[s] : 0;
+      size_t uSecTo = (s + 1 < pA->uSections) ? pA->uStarts[s + 1] : pA->uSamples;
+      for (size_t i = uSecFrom; i < uSecTo; i += ANALYZE_UNIT) {
+        analyze_unit_t *pU = &S_pUnits[S_uUnits++];
+        pU->uFile = f;
+        pU->uFrom = i;
+        pU->uTo = (uSecTo - i > ANALYZE_UNIT) ? i + ANALYZE_UNIT : uSecTo;
+        pU->uSecFrom = uSecFrom;
+        pU->uSecTo = uSecTo;
+      }
+    }
+  }
+  run_pool(unit_worker, uThreads);
+  double t2 = now_s();
+
+  for (uint f = 0; f < S_uFiles; f++) {
+    analysis_stats_clear(&S_pFiles[f].stats);
+    analysis_psd_clear(&S_pFiles[f].psd);
+  }
+  for (size_t u = 0; u < S_uUnits; u++) {
+    const analyze_unit_t *pU = &S_pUnits[u];
+    analyze_file_t *pF = &S_pFiles[pU->uFile];
+    analysis_stats_merge(&pF->stats, &pU->stats);
+    analysis_psd_merge(&pF->psd, &pU->psd);
+    pF->uBursts += pU->uBursts;
+    pF->uAmpSum += pU->uAmpSum;
+    if (pU->uAmpMax > pF->uAmpMax) pF->uAmpMax = pU->uAmpMax;
+  }
+
+  FILE *f = sSummary ? open_out(sSummary) : stdout;
+  if (f) write_summary(f);
+  if (f && f != stdout) fclose(f);
+  if (sArrivals && (f = open_out(sArrivals))) {
+    write_arrivals(f);
+    fclose(f);
+  }
+  if (sPsd && (f = open_out(sPsd))) {
+    write_psd(f);
+    fclose(f);
+  }
+  if (sRcbDir) {
+    for (uint i = 0; i < S_uFiles; i++) {
+      if (!S_pFiles[i].bOk) continue;
+      const char *sBase = strrchr(S_pFiles[i].sPath, '/');
+      sBase = sBase ? sBase + 1 : S_pFiles[i].sPath;
+      char sOut[4096];
+      const char *sDot = strrchr(sBase, '.');
+      int iLen = sDot ? (int)(sDot - sBase) : (int)strlen(sBase);
+      snprintf(sOut, sizeof(sOut), "%s/%.*s.rcb", sRcbDir, iLen, sBase);
+      archive_write(sOut, &S_pFiles[i].archive);
+    }
+  }
+
+  uint uOk = 0;
+  for (uint i = 0; i < S_uFiles; i++) uOk += S_pFiles[i].bOk;
+  fprintf(stderr, "%u/%u files, %zu samples, %u threads: open %.3fs, analysis %.3fs (%.1f Msamples/s)\n",
+          uOk, S_uFiles, uTotal, uThreads, t1 - t0, t2 - t1, (t2 > t1) ? uTotal / (t2 - t1) / 1e6 : 0);
+  for (size_t u = 0; u < S_uUnits; u++) free(S_pUnits[u].pArrivals);
+  for (uint i = 0; i < S_uFiles; i++) {
+    if (S_pFiles[i].bOk) archive_close(&S_pFiles[i].archive);
+  }
+  free(S_pUnits);
+  free(S_pFiles);
+  return uOk == S_uFiles ? 0 : 1;
+} // end int main(...)
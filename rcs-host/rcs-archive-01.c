@@ -0,0 +1,103 @@
+// @file rcs-archive-01.c
+// @date 2026.10.17
+// @info capture archive access; legacy ascii .dat and the binary .rcb format (rcs-archive-01.h)
+// @info the format is told by the magic, not the name; anything else is read as ascii
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "rcs-archive-01.h"
+#include "rcs-dat-01.h"
+
+static bool archive_open_rcb(archive_t *pA, const char *sPath, int fd, size_t uLen) {
+  // map the file; the samples are used where they lie
+  void *pMap = mmap(NULL, uLen, PROT_READ, MAP_PRIVATE, fd, 0);
+  if (pMap == MAP_FAILED) return false;
+  const archive_header_t *pH = pMap;
+  size_t uData = sizeof(*pH) + (size_t)pH->uSections * sizeof(uint64_t);
+  if (uData > uLen || pH->uSamples > (uLen - uData) / sizeof(uint16_t)) {
+    fprintf(stderr, "archive_open: %s: truncated\n", sPath);
+    munmap(pMap, uLen);
+    return false;
+  }
+  madvise(pMap, uLen, MADV_SEQUENTIAL);
+  const uint64_t *pStarts = (const uint64_t *)(pH + 1);
+  pA->uSections = 0;
+  for (uint s = 0; s < pH->uSections && pA->uSections < ARCHIVE_SECTIONS_MAX; s++) {
+    if (pStarts[s] < pH->uSamples) pA->uStarts[pA->uSections++] = pStarts[s];
+  }
+  pA->pSamples = (const uint16_t *)((const uint8_t *)pMap + uData);
+  pA->uSamples = pH->uSamples;
+  pA->uSampleHz = pH->uSampleHz;
+  pA->bBinary = true;
+  pA->pMap = pMap;
+  pA->uMapLen = uLen;
+  return true;
+} // end static bool archive_open_rcb(...)
+
+bool archive_open(archive_t *pA, const char *sPath, uint32_t uDatHz) {
+  // open sPath, .rcb by its magic, else ascii .dat at uDatHz (0: DAT_SAMPLE_HZ). false on error
+  memset(pA, 0, sizeof(*pA));
+  int fd = open(sPath, O_RDONLY);
+  if (fd < 0) {
+    fprintf(stderr, "archive_open: cannot open %s\n", sPath);
+    return false;
+  }
+  struct stat st;
+  char sMagic[4] = { 0 };
+  bool bRcb = fstat(fd, &st) == 0 && (size_t)st.st_size >= sizeof(archive_header_t) &&
+              read(fd, sMagic, sizeof(sMagic)) == sizeof(sMagic) && memcmp(sMagic, ARCHIVE_MAGIC, 4) == 0;
+  bool bOk;
+  if (bRcb) {
+    bOk = archive_open_rcb(pA, sPath, fd, st.st_size);
+  } else {
+    uint16_t *p = NULL;
+    pA->uSamples = dat_load_sections(sPath, &p, pA->uStarts, ARCHIVE_SECTIONS_MAX, &pA->uSections);
+    pA->pSamples = p;
+    pA->uSampleHz = uDatHz ? uDatHz : DAT_SAMPLE_HZ;
+    bOk = pA->uSamples > 0;
+  }
+  close(fd);
+  return bOk;
+} // end bool archive_open(...)
+
+void archive_close(archive_t *pA) {
+  if (pA->pMap) munmap(pA->pMap, pA->uMapLen);
+  else free((void *)pA->pSamples);
+  memset(pA, 0, sizeof(*pA));
+}
+
+bool archive_write(const char *sPath, const archive_t *pA) {
+  // pA as .rcb; e.g. a .dat converted once, then mapped on every later run
+  FILE *f = fopen(sPath, "wb");
+  if (!f) {
+    fprintf(stderr, "archive_write: cannot create %s\n", sPath);
+    return false;
+  }
+  archive_header_t h = { .uSampleHz = pA->uSampleHz, .uSamples = pA->uSamples, .uSections = pA->uSections };
+  memcpy(h.sMagic, ARCHIVE_MAGIC, 4);
+  bool bOk = fwrite(&h, sizeof(h), 1, f) == 1;
+  for (uint s = 0; s < pA->uSections && bOk; s++) {
+    uint64_t uStart = pA->uStarts[s];
+    bOk = fwrite(&uStart, sizeof(uStart), 1, f) == 1;
+  }
+  if (bOk) bOk = fwrite(pA->pSamples, sizeof(uint16_t), pA->uSamples, f) == pA->uSamples;
+  if (fclose(f) != 0) bOk = false;
+  if (!bOk) fprintf(stderr, "archive_write: %s: write failed\n", sPath);
+  return bOk;
+} // end bool archive_write(...)
+
+uint archive_section_of(const archive_t *pA, size_t uIdx) {
+  // section holding sample uIdx; 0 if the archive has none
+  uint lo = 0, hi = pA->uSections;
+  while (hi - lo > 1) {
+    uint mid = (lo + hi) / 2;
+    if (pA->uStarts[mid] <= uIdx) lo = mid;
+    else hi = mid;
+  }
+  return lo;
+}
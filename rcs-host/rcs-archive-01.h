@@ -0,0 +1,44 @@
+// @file rcs-archive-01.h
+// @date 2026.10.17
+// @info capture archive access header; legacy ascii .dat and the binary .rcb format
+// @info .rcb: a 24 byte header, the section starts, then the samples as 12 bit adc counts in uint16,
+// @info little endian, so a file is used in place through mmap (no parse, no copy, any size).
+// @info sections are the runs a .dat splits into at text lines (baseline / triggered capture).
+// @info .dat files are parsed into memory (rcs-dat-01), sample rate DAT_SAMPLE_HZ unless given.
+
+#ifndef RCS_ARCHIVE_01_H
+#define RCS_ARCHIVE_01_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <sys/types.h> // uint
+
+#define ARCHIVE_MAGIC        "RCB1"
+#define ARCHIVE_SECTIONS_MAX 256  // section starts kept per archive; later ones merge into the last
+
+typedef struct {
+  char     sMagic[4];   // ARCHIVE_MAGIC
+  uint32_t uSampleHz;
+  uint64_t uSamples;
+  uint32_t uSections;   // uint64 section starts follow the header
+  uint32_t uFlags;      // 0
+} archive_header_t;
+
+typedef struct {
+  const uint16_t *pSamples; // adc counts; mapped (.rcb) or owned (.dat)
+  size_t   uSamples;
+  uint32_t uSampleHz;
+  size_t   uStarts[ARCHIVE_SECTIONS_MAX]; // sample index of each section start
+  uint     uSections;
+  bool     bBinary;
+  void    *pMap;            // .rcb mapping; NULL for .dat
+  size_t   uMapLen;
+} archive_t;
+
+bool archive_open(archive_t *pA, const char *sPath, uint32_t uDatHz);
+void archive_close(archive_t *pA);
+bool archive_write(const char *sPath, const archive_t *pA);
+uint archive_section_of(const archive_t *pA, size_t uIdx);
+
+#endif // RCS_ARCHIVE_01_H
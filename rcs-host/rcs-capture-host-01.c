@@ -0,0 +1,106 @@
+// @file rcs-capture-host-01.c
+// @date 2026.10.17
+// @info host stand-in for the adc/dma capture ring (../rcs-common/rcs-capture-01.c)
+// @info capture_host_advance() plays the role of the dma: it copies source samples into
+// @info G_uCaptureRing with the same wrap, so the portable block scanner runs unchanged
+// @info with no source attached (firmware host builds), the ring is clocked by the hal host
+// @info virtual clock instead: samples are taken from the RCS_HOST_ADC stream at the capture rate
+// @info as virtual time passes, and every counter read costs a poll
+// @info round robin: an attached source is taken as already interleaved (channel k at i*n + k); the
+// @info clocked hal stream is a single input, so every channel sees it at its own conversion slot
+// @info sleep: clocked, the virtual clock jumps to the wake index (hal_sleep_until_us) and the ring is
+// @info not written meanwhile; the adc on time goes to the hal summary. with a source, a no-op
+
+#include "rcs-capture-host-01.h"
+#include "../rcs-common/rcs-hal-01.h"
+
+#define CAPTURE_HOST_POLL_NS 200 // counter read + compare in the scanner poll loop
+
+static const uint16_t *S_pSource = NULL; // sample source; NULL -> idle level only
+static size_t   S_uSourceLen = 0;
+static uint16_t S_uIdle = 0;             // value written once the source is exhausted
+static uint64_t S_uWritten = 0;          // absolute samples written
+static bool     S_bRunning = false;
+static bool     S_bClocked = false;          // hal host clocked; no source attached
+static uint64_t S_uStartNs = 0;              // virtual time of sample index 0
+
+void capture_host_source(const uint16_t *pSamples, size_t uN, uint16_t uIdle) {
+  // attach a sample source; sample index 0 after capture_start() is pSamples[0]
+  S_pSource = pSamples;
+  S_uSourceLen = uN;
+  S_uIdle = uIdle;
+}
+
+uint capture_host_advance(uint uN) {
+  // 'dma' uN samples into the ring; returns samples taken from the source (0 when exhausted)
+  uint uFromSource = 0;
+  if (!S_bRunning) return 0;
+  for (uint i = 0; i < uN; i++) {
+    uint16_t uSample = S_uIdle;
+    if (S_uWritten < S_uSourceLen) {
+      uSample = S_pSource[S_uWritten];
+      uFromSource++;
+    }
+    G_uCaptureRing[S_uWritten & (CAPTURE_RING_LEN - 1)] = uSample;
+    S_uWritten++;
+  }
+  return uFromSource;
+} // end uint capture_host_advance(uint uN)
+
+void capture_init(uint uAdcInput) {
+  (void)uAdcInput;
+  S_uWritten = 0;
+  S_bClocked = (S_pSource == NULL);
+  G_uCaptureChannels = 1;
+}
+
+void capture_init_round_robin(uint uInputMask) {
+  uInputMask &= (1u << CAPTURE_CHANNELS_MAX) - 1;
+  capture_init(0);
+  G_uCaptureChannels = uInputMask ? __builtin_popcount(uInputMask) : 1;
+}
+
+void capture_start(void) {
+  S_uWritten = 0;
+  S_bRunning = true;
+  if (S_bClocked) {
+    S_uStartNs = hal_host_time_ns();
+    hal_host_adc_power(true);
+  }
+}
+
+static void capture_host_clock(void) {
+  // fill the ring up to the current virtual time; a scanner that falls more than a ring behind
+  // finds its samples overwritten, as with the dma
+  hal_host_tick(CAPTURE_HOST_POLL_NS);
+  uint64_t uNow = (hal_host_time_ns() - S_uStartNs) / CAPTURE_SAMPLE_NS;
+  if (uNow - S_uWritten > CAPTURE_RING_LEN) S_uWritten = uNow - CAPTURE_RING_LEN;
+  for (; S_uWritten < uNow; S_uWritten++) {
+    G_uCaptureRing[S_uWritten & (CAPTURE_RING_LEN - 1)] =
+      hal_host_adc_at(S_uStartNs + S_uWritten * CAPTURE_SAMPLE_NS);
+  }
+}
+
+void capture_stop(void) {
+  S_bRunning = false;
+  if (S_bClocked) hal_host_adc_power(false);
+}
+
+uint64_t capture_sleep_until(uint64_t uWakeIdx) {
+  uint64_t uNow = capture_samples_now();
+  if (!S_bClocked || !S_bRunning || uWakeIdx <= uNow) return uNow;
+  hal_host_adc_power(false);
+  hal_sleep_until_us((S_uStartNs + uWakeIdx * CAPTURE_SAMPLE_NS + 999) / 1000);
+  hal_host_adc_power(true);
+  S_uWritten = (hal_host_time_ns() - S_uStartNs) / CAPTURE_SAMPLE_NS; // nothing converted while asleep
+  return S_uWritten;
+} // end uint64_t capture_sleep_until(...)
+
+uint64_t capture_samples_now(void) {
+  if (S_bClocked && S_bRunning) capture_host_clock();
+  return S_uWritten;
+}
+
+uint64_t capture_samples_done(void) {
+  return capture_samples_now() & ~(uint64_t)(CAPTURE_BLOCK_LEN - 1);
+}
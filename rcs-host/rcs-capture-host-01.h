@@ -0,0 +1,8 @@
+// @file rcs-capture-host-01.h
+// @date 2026.10.17
+// @info host stand-in for the adc/dma capture ring; samples come from memory instead of the adc
+
+#include "../rcs-common/rcs-capture-01.h"
+
+void capture_host_source(const uint16_t *pSamples, size_t uN, uint16_t uIdle);
+uint capture_host_advance(uint uN);
@@ -0,0 +1,314 @@
+// @file rcs-chansim-01.c
+// @date 2026.10.17
+// @info acoustic channel simulator (see rcs-chansim-01.h)
+// @info speed of sound 331.3 * sqrt(1 + T/273.15) m/s; 343.2 at 20C against the receiver's fixed 1125ft/s
+// @info (342.9). pulse: the pin pattern at CHANSIM_OVERSAMPLE times the adc rate through two rbj
+// @info bandpass resonators (as rcs-coded-bench-01), unit peak, cut where the ring-down is under 1e-3,
+// @info kept per 1/16 sample phase so an arrival is a scaled copy of one row, no per sample delay filter.
+// @info white noise: box-muller on a splitmix64 hash of (seed, sample pair); tails to 6.6 sigma, so a
+// @info 5 sigma cfar sees its false alarms. ambient: a 40KHz carrier under a gaussian complex envelope
+// @info drawn every fs/fAmbientBwHz samples (hashed the same way) and interpolated between.
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "rcs-chansim-01.h"
+#include "../rcs-common/rcs-burst-01.h"
+
+#define CHANSIM_GOLDEN     0x9e3779b97f4a7c15ull
+#define CHANSIM_TAG_WHITE  (1ull << 60) // counter rng streams
+#define CHANSIM_TAG_AMBIENT (2ull << 60)
+#define CHANSIM_PULSE_CUT  1e-3         // ring-down under this of the peak is dropped
+#define CHANSIM_NEAR_M     0.1          // 1/r held below this
+
+static inline uint64_t chansim_mix(uint64_t x) {
+  // splitmix64 finalizer
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+  return x ^ (x >> 31);
+}
+
+static inline void chansim_gauss2(uint64_t h, float *pG0, float *pG1) {
+  // two unit gaussians from 64 hashed bits
+  float r = sqrtf(-2 * logf(((h >> 32) + 0.5f) * (1.0f / 4294967296.0f)));
+  float a = (float)(2 * M_PI / 4294967296.0) * (uint32_t)h;
+  *pG0 = r * cosf(a);
+  *pG1 = r * sinf(a);
+}
+
+static double chansim_gauss(chansim_t *pS) {
+  // sequential stream
+  float g0, g1;
+  pS->uRng += CHANSIM_GOLDEN;
+  chansim_gauss2(chansim_mix(pS->uRng), &g0, &g1);
+  return g0;
+}
+
+static double chansim_uniform(chansim_t *pS) {
+  pS->uRng += CHANSIM_GOLDEN;
+  return (chansim_mix(pS->uRng) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+double chansim_sound_mps(double fTempC) {
+  return 331.3 * sqrt(1 + fTempC / 273.15);
+}
+
+double chansim_distance_m(const chansim_config_t *pCfg, double fS) {
+  // fDistM through the hold, then out and back between fDistMinM and fDistMaxM at fSpeedMps
+  double fL = pCfg->fDistMaxM - pCfg->fDistMinM;
+  double fWalkS = fS - pCfg->fStartS - pCfg->fHoldS;
+  if (fWalkS <= 0 || pCfg->fSpeedMps <= 0 || fL <= 0) return pCfg->fDistM;
+  double w = fmod(pCfg->fDistM - pCfg->fDistMinM + fWalkS * pCfg->fSpeedMps, 2 * fL);
+  if (w < 0) w += 2 * fL;
+  return pCfg->fDistMinM + (w < fL ? w : 2 * fL - w);
+}
+
+void chansim_defaults(chansim_config_t *pCfg) {
+  // a lawn at 20C: both ends 0.3m up over grass, a quiet evening, a target standing 3m off
+  memset(pCfg, 0, sizeof(*pCfg));
+  pCfg->uSeed = 1;
+  pCfg->uSampleHz = 500000;
+  pCfg->fStartS = 0.5;
+  pCfg->fPeriodMs = 100;
+  pCfg->uCode = 0;
+  pCfg->fQ = 12;
+  pCfg->fDistM = 3;
+  pCfg->fDistMinM = 0.3;
+  pCfg->fDistMaxM = 6;
+  pCfg->fHeightM = 0.3;
+  pCfg->fGroundGain = 0.3;
+  pCfg->fTempC = 20;
+  pCfg->fTempPeriodS = 86400;
+  pCfg->fAbsorbDbPerM = 1.3;
+  pCfg->fAmpCounts = 400;
+  pCfg->fNoiseCounts = 8;
+  pCfg->fAmbientCounts = 2;
+  pCfg->fAmbientBwHz = 2000;
+  pCfg->uBaseline = 2892; // (/ 2.33 (/ 3.3 4096))
+} // end void chansim_defaults(...)
+
+static void chansim_resonate(float *pX, uint uN, double fW, double fQ) {
+  // 2nd order bandpass at normalized frequency fW, 0dB peak (rbj cookbook), in place
+  double alpha = sin(fW) / (2 * fQ), a0 = 1 + alpha;
+  double b0 = alpha / a0, a1 = -2 * cos(fW) / a0, a2 = (1 - alpha) / a0;
+  double x1 = 0, x2 = 0, y1 = 0, y2 = 0;
+  for (uint i = 0; i < uN; i++) {
+    double y = b0 * (pX[i] - x2) - a1 * y1 - a2 * y2;
+    x2 = x1;
+    x1 = pX[i];
+    y2 = y1;
+    y1 = y;
+    pX[i] = y;
+  }
+}
+
+static bool chansim_make_pulse(chansim_t *pS) {
+  // received pulse at CHANSIM_OVERSAMPLE x the adc rate, then split into the phase rows
+  const chansim_config_t *c = &pS->cfg;
+  const uint64_t uHiHz = (uint64_t)c->uSampleHz * CHANSIM_OVERSAMPLE;
+  uint32_t uWords[BURST_WORDS_MAX];
+  uint uCycles, uN;
+  if (c->uCode) {
+    uN = burst_pattern(uWords, burst_code(c->uCode), BURST_CODE_CHIPS, BURST_CHIP_CYCLES);
+    uCycles = BURST_CODE_CHIPS * BURST_CHIP_CYCLES;
+  } else {
+    uN = burst_pattern(uWords, 0, 1, BURST_CYCLES);
+    uCycles = BURST_CYCLES;
+  }
+  uint uHiMax = CHANSIM_PULSE_MAX * CHANSIM_OVERSAMPLE;
+  float *pHi = calloc(uHiMax, sizeof(float));
+  if (!pHi) return false;
+  uint uDrive = (uint)((uint64_t)uCycles * uHiHz / BURST_CARRIER_HZ);
+  for (uint i = 0; i < uDrive && i < uHiMax; i++) { // pio pins: +1 phase a, -1 phase b, 0 dead
+    uint64_t uSlot = (uint64_t)i * BURST_CARRIER_HZ * BURST_SLOTS / uHiHz;
+    uint uHalf = uSlot / (BURST_SLOTS / 2);
+    uint32_t uPins = 0;
+    if (uHalf < uN * 32 / BURST_HALF_BITS && uSlot % (BURST_SLOTS / 2) < BURST_SLOTS_HIGH) {
+      uPins = (uWords[uHalf / (32 / BURST_HALF_BITS)] >> (BURST_HALF_BITS * (uHalf % (32 / BURST_HALF_BITS)))) & 3;
+    }
+    pHi[i] = (uPins == 1) - (uPins == 2);
+  }
+  if (c->fQ > 0) {
+    double fW = 2 * M_PI * BURST_CARRIER_HZ / uHiHz;
+    chansim_resonate(pHi, uHiMax, fW, c->fQ);
+    chansim_resonate(pHi, uHiMax, fW, c->fQ);
+  }
+  float fMax = 0;
+  uint uLast = 0;
+  for (uint i = 0; i < uHiMax; i++) fMax = fabsf(pHi[i]) > fMax ? fabsf(pHi[i]) : fMax;
+  for (uint i = 0; i < uHiMax; i++) {
+    pHi[i] /= fMax;
+    if (fabsf(pHi[i]) >= CHANSIM_PULSE_CUT) uLast = i;
+  }
+  pS->uPulseLen = uLast / CHANSIM_OVERSAMPLE + 2;
+  if (pS->uPulseLen > CHANSIM_PULSE_MAX) pS->uPulseLen = CHANSIM_PULSE_MAX;
+  pS->pPulse = calloc((size_t)CHANSIM_OVERSAMPLE * pS->uPulseLen, sizeof(float));
+  if (!pS->pPulse) {
+    free(pHi);
+    return false;
+  }
+  for (uint p = 0; p < CHANSIM_OVERSAMPLE; p++) { // sample k of phase p is the pulse (k - p/16) samples in
+    float *pRow = pS->pPulse + (size_t)p * pS->uPulseLen;
+    for (uint k = 0; k < pS->uPulseLen; k++) {
+      int64_t j = (int64_t)k * CHANSIM_OVERSAMPLE - p;
+      pRow[k] = (j >= 0 && j < uHiMax) ? pHi[j] : 0;
+    }
+  }
+  free(pHi);
+  return true;
+} // end static bool chansim_make_pulse(...)
+
+bool chansim_init(chansim_t *pS, const chansim_config_t *pCfg) {
+  memset(pS, 0, sizeof(*pS));
+  pS->cfg = *pCfg;
+  if (pS->cfg.uCode > BURST_CODES || !pS->cfg.uSampleHz || pS->cfg.fPeriodMs <= 0) return false;
+  if (pS->cfg.uPaths > CHANSIM_PATHS_MAX) pS->cfg.uPaths = CHANSIM_PATHS_MAX;
+  if (!chansim_make_pulse(pS)) return false;
+  pS->uRng = chansim_mix(pCfg->uSeed ^ CHANSIM_GOLDEN);
+  pS->next.fTxS = pCfg->fStartS;
+  pS->next.fTxIdx = pCfg->fStartS * pCfg->uSampleHz * (1 + pCfg->fRxPpm * 1e-6);
+  return true;
+}
+
+void chansim_free(chansim_t *pS) {
+  free(pS->pPulse);
+  pS->pPulse = NULL;
+}
+
+static double chansim_amp(const chansim_config_t *c, double fPathM) {
+  // pulse peak after fPathM of spreading and absorption
+  double r = fPathM > CHANSIM_NEAR_M ? fPathM : CHANSIM_NEAR_M;
+  return c->fAmpCounts / r * pow(10, -c->fAbsorbDbPerM * fPathM / 20);
+}
+
+static void chansim_arrive(chansim_t *pS, const chansim_ping_t *p, double fPathM, double fGain) {
+  if (pS->uArrivals == CHANSIM_ARRIVALS_MAX || fGain == 0) return;
+  chansim_arrival_t *a = &pS->arrivals[pS->uArrivals++];
+  a->fIdx = p->fTxIdx + fPathM / p->fSoundMps * pS->cfg.uSampleHz * (1 + p->fRxPpm * 1e-6);
+  a->fAmp = fGain * chansim_amp(&pS->cfg, fPathM);
+}
+
+void chansim_ping(chansim_t *pS, chansim_ping_t *pPing) {
+  // take the next ping: fill in its truth, queue its arrivals, schedule the one after it
+  const chansim_config_t *c = &pS->cfg;
+  chansim_ping_t *p = &pS->next;
+  p->uSeq = pS->uPings++;
+  p->fTempC = c->fTempC + c->fTempSwingC * sin(2 * M_PI * p->fTxS / c->fTempPeriodS);
+  p->fSoundMps = chansim_sound_mps(p->fTempC);
+  p->fDistM = chansim_distance_m(c, p->fTxS);
+  p->fFlightUs = p->fDistM / p->fSoundMps * 1e6;
+  p->fAmpCounts = chansim_amp(c, p->fDistM);
+  p->fTxPpm = c->fTxPpm + c->fTxPpmPerC * (p->fTempC - c->fTempC) + pS->fTxPpmWalk;
+  p->fRxPpm = c->fRxPpm + pS->fRxPpmWalk;
+  p->bSent = c->fDropProb <= 0 || chansim_uniform(pS) >= c->fDropProb;
+  if (p->bSent) {
+    chansim_arrive(pS, p, p->fDistM, 1);
+    if (c->fHeightM > 0) chansim_arrive(pS, p, hypot(p->fDistM, 2 * c->fHeightM), c->fGroundGain);
+    for (uint i = 0; i < c->uPaths; i++) chansim_arrive(pS, p, p->fDistM + c->paths[i].fExtraM, c->paths[i].fGain);
+  }
+  if (pPing) *pPing = *p;
+  // the period on the tx clock is shorter for a fast crystal; the rx counts its own samples meanwhile
+  double fDtS = c->fPeriodMs * 1e-3 / (1 + p->fTxPpm * 1e-6);
+  if (c->fPpmWalk > 0) {
+    double fStep = c->fPpmWalk * sqrt(fDtS / 3600);
+    pS->fTxPpmWalk += fStep * chansim_gauss(pS);
+    pS->fRxPpmWalk += fStep * chansim_gauss(pS);
+  }
+  p->fTxIdx += fDtS * c->uSampleHz * (1 + p->fRxPpm * 1e-6);
+  p->fTxS += fDtS;
+} // end void chansim_ping(...)
+
+static void chansim_white(const chansim_t *pS, uint64_t uFrom, float *pAcc, uint uN) {
+  // pair k of samples (2k, 2k+1) is one box-muller draw
+  const uint64_t uKey = pS->cfg.uSeed * CHANSIM_GOLDEN ^ CHANSIM_TAG_WHITE;
+  const float fRms = pS->cfg.fNoiseCounts;
+  float g0, g1;
+  uint i = 0;
+  if (uFrom & 1) {
+    chansim_gauss2(chansim_mix(uKey ^ (uFrom >> 1)), &g0, &g1);
+    pAcc[i++] = fRms * g1;
+  }
+  for (; i + 1 < uN; i += 2) {
+    chansim_gauss2(chansim_mix(uKey ^ ((uFrom + i) >> 1)), &g0, &g1);
+    pAcc[i] = fRms * g0;
+    pAcc[i + 1] = fRms * g1;
+  }
+  if (i < uN) {
+    chansim_gauss2(chansim_mix(uKey ^ ((uFrom + i) >> 1)), &g0, &g1);
+    pAcc[i] = fRms * g0;
+  }
+} // end static void chansim_white(...)
+
+static void chansim_ambient(const chansim_t *pS, uint64_t uFrom, float *pAcc, uint uN) {
+  // re{(i + jq) e^(jwt)}, i and q gaussian at knots every uK samples, linear between; the lerp loses
+  // (/ 2 3.0) of the variance on average, made up in the knot rms
+  const chansim_config_t *c = &pS->cfg;
+  const uint64_t uKey = c->uSeed * CHANSIM_GOLDEN ^ CHANSIM_TAG_AMBIENT;
+  uint64_t uK = (uint64_t)(c->uSampleHz / (c->fAmbientBwHz > 1 ? c->fAmbientBwHz : 1));
+  if (uK < 1) uK = 1;
+  const float fKnot = c->fAmbientCounts * sqrtf(1.5f);
+  // carrier phase at uFrom from the integer cycle count, then a rotator
+  double fPh = 2 * M_PI * (double)((uFrom % c->uSampleHz) * BURST_CARRIER_HZ % c->uSampleHz) / c->uSampleHz;
+  double fW = 2 * M_PI * BURST_CARRIER_HZ / c->uSampleHz;
+  double fCos = cos(fPh), fSin = sin(fPh), fCw = cos(fW), fSw = sin(fW);
+  uint64_t m = uFrom / uK;
+  float i0, q0, i1, q1;
+  chansim_gauss2(chansim_mix(uKey ^ m), &i0, &q0);
+  chansim_gauss2(chansim_mix(uKey ^ (m + 1)), &i1, &q1);
+  uint64_t uIdx = uFrom;
+  for (uint i = 0; i < uN; i++, uIdx++) {
+    if (uIdx / uK != m) {
+      m = uIdx / uK;
+      i0 = i1;
+      q0 = q1;
+      chansim_gauss2(chansim_mix(uKey ^ (m + 1)), &i1, &q1);
+    }
+    float t = (float)(uIdx - m * uK) / uK;
+    float fI = i0 + (i1 - i0) * t, fQ = q0 + (q1 - q0) * t;
+    pAcc[i] += fKnot * (fI * (float)fCos - fQ * (float)fSin);
+    double fC = fCos * fCw - fSin * fSw;
+    fSin = fSin * fCw + fCos * fSw;
+    fCos = fC;
+  }
+} // end static void chansim_ambient(...)
+
+void chansim_render(chansim_t *pS, uint64_t uFrom, uint16_t *pOut, uint uN) {
+  // samples [uFrom, uFrom + uN) as adc counts; arrivals wholly before the latest span start are retired,
+  // so a span starting earlier than an earlier one misses them
+  float fAcc[CHANSIM_CHUNK];
+  if (uFrom > pS->uSpanFrom) pS->uSpanFrom = uFrom;
+  uint n = 0;
+  for (uint i = 0; i < pS->uArrivals; i++) {
+    if (pS->arrivals[i].fIdx + pS->uPulseLen >= (double)pS->uSpanFrom) pS->arrivals[n++] = pS->arrivals[i];
+  }
+  pS->uArrivals = n;
+  for (uint uDone = 0; uDone < uN; ) {
+    uint uLen = uN - uDone < CHANSIM_CHUNK ? uN - uDone : CHANSIM_CHUNK;
+    uint64_t u0 = uFrom + uDone;
+    if (pS->cfg.fNoiseCounts > 0) chansim_white(pS, u0, fAcc, uLen);
+    else memset(fAcc, 0, uLen * sizeof(float));
+    if (pS->cfg.fAmbientCounts > 0) chansim_ambient(pS, u0, fAcc, uLen);
+    for (uint a = 0; a < pS->uArrivals; a++) {
+      const chansim_arrival_t *pA = &pS->arrivals[a];
+      int64_t iStart = (int64_t)floor(pA->fIdx);
+      uint uPh = (uint)lround((pA->fIdx - iStart) * CHANSIM_OVERSAMPLE);
+      if (uPh == CHANSIM_OVERSAMPLE) {
+        uPh = 0;
+        iStart++;
+      }
+      int64_t k0 = (int64_t)u0 - iStart, k1 = k0 + uLen;
+      if (k0 < 0) k0 = 0;
+      if (k1 > pS->uPulseLen) k1 = pS->uPulseLen;
+      const float *pRow = pS->pPulse + (size_t)uPh * pS->uPulseLen;
+      float *pDst = fAcc + (iStart - (int64_t)u0);
+      for (int64_t k = k0; k < k1; k++) pDst[k] += pA->fAmp * pRow[k];
+    }
+    const float fBase = pS->cfg.uBaseline;
+    for (uint i = 0; i < uLen; i++) {
+      long v = lrintf(fBase + fAcc[i]);
+      pOut[uDone + i] = v < 0 ? 0 : v > 4095 ? 4095 : (uint16_t)v;
+    }
+    uDone += uLen;
+  } // end for (uint uDone...)
+  pS->uRendered += uN;
+} // end void chansim_render(...)
@@ -0,0 +1,106 @@
+// @file rcs-chansim-01.h
+// @date 2026.10.17
+// @info acoustic channel simulator header; the link from the rcs-tx01-02 burst to the rcs-rx04-03 adc
+// @info input as 12 bit adc counts at the receiver rate, for regression and load runs on linux
+// @info model: the pio pin pattern (burst_pattern(), plain or coded) through the tx and rx piezo (40KHz
+// @info resonators of quality fQ) is the received pulse; it arrives by the direct path and by a ground
+// @info bounce and fixed reflectors, each at its own path length over the speed of sound at the air
+// @info temperature, falling 1/r with 40KHz air absorption on top. noise is white (adc, front end) and
+// @info 40KHz band (ambient: insects, other beacons, leaves). the tx crystal follows the air
+// @info temperature, both crystals random walk; the tx emits on its clock, the rx samples on its own.
+// @info deterministic: one seed gives the same stream on any host. the noise at a sample is a hash of
+// @info the seed and the sample index (counter based), so a sample renders the same whatever the span
+// @info split, and spans may skip ahead (only windows rendered) at no cost. pings are the discrete
+// @info events: chansim_ping() takes the next one (ground truth) and queues its arrivals; spans then go
+// @info forward (each starts at or after the previous one's start).
+
+#ifndef RCS_CHANSIM_01_H
+#define RCS_CHANSIM_01_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <sys/types.h> // uint
+
+#define CHANSIM_OVERSAMPLE   16    // pulse template phases per sample; arrivals at 1/16 sample
+#define CHANSIM_PATHS_MAX    8     // fixed reflectors
+#define CHANSIM_ARRIVALS_MAX 256   // arrivals queued at once; (* 10 pings 10 paths) with margin
+#define CHANSIM_PULSE_MAX    2048  // received pulse cap, samples; coded bursts with ring-down are ~900
+#define CHANSIM_CHUNK        1024  // render chunk, samples
+
+typedef struct {
+  double fExtraM;   // path length over the direct path, m; a wall 2m behind the target is 4
+  double fGain;     // reflection coefficient; negative inverts
+} chansim_path_t;
+
+typedef struct {
+  uint64_t uSeed;
+  uint32_t uSampleHz;      // receiver adc rate, nominal
+  double   fStartS;        // first emission; a quiet lead-in for the receiver's boot baseline
+  double   fPeriodMs;      // ping period, tx clock
+  uint     uCode;          // 0 plain BURST_CYCLES burst, 1..BURST_CODES beacon code
+  double   fQ;             // tx and rx piezo quality; 0 ideal (the pin pattern itself)
+  // geometry and motion: fDistM for fHoldS, then a walk between fDistMinM and fDistMaxM
+  double   fDistM, fHoldS, fDistMinM, fDistMaxM, fSpeedMps;
+  double   fHeightM;       // tx and rx above the ground; 0 no ground bounce
+  double   fGroundGain;    // ground reflection coefficient
+  chansim_path_t paths[CHANSIM_PATHS_MAX];
+  uint     uPaths;
+  // air
+  double   fTempC;         // mean air temperature
+  double   fTempSwingC;    // +- swing over fTempPeriodS (a day)
+  double   fTempPeriodS;
+  double   fAbsorbDbPerM;  // 40KHz absorption; ~1.3 at 20C 50%RH
+  double   fAmpCounts;     // direct path pulse peak at 1m before absorption, adc counts
+  // noise
+  double   fNoiseCounts;   // white, rms
+  double   fAmbientCounts; // 40KHz band, rms
+  double   fAmbientBwHz;   // its bandwidth
+  double   fDropProb;      // pings not sent (tx busy, brown out)
+  // clocks
+  double   fTxPpm, fRxPpm; // crystal offsets at fTempC
+  double   fTxPpmPerC;     // tx crystal against the air temperature (outdoors); the rx is indoors
+  double   fPpmWalk;       // random walk of each, ppm per sqrt(hour)
+  uint16_t uBaseline;      // adc quiescent level, counts
+} chansim_config_t;
+
+typedef struct {
+  uint64_t uSeq;
+  double   fTxS;           // emission, true seconds
+  double   fTxIdx;         // emission, receiver sample index
+  double   fDistM;
+  double   fTempC;
+  double   fSoundMps;
+  double   fFlightUs;      // direct path
+  double   fAmpCounts;     // direct path pulse peak
+  double   fTxPpm, fRxPpm;
+  bool     bSent;
+} chansim_ping_t;
+
+typedef struct {
+  double fIdx;             // receiver sample index, fractional
+  float  fAmp;             // counts
+} chansim_arrival_t;
+
+typedef struct {
+  chansim_config_t cfg;
+  float   *pPulse;         // [CHANSIM_OVERSAMPLE][uPulseLen]; phase p is the pulse p/16 sample late
+  uint     uPulseLen;
+  chansim_ping_t next;     // next ping; fTxS and fTxIdx are set
+  double   fTxPpmWalk, fRxPpmWalk;
+  uint64_t uRng;           // sequential stream; drops and the walks
+  chansim_arrival_t arrivals[CHANSIM_ARRIVALS_MAX];
+  uint     uArrivals;
+  uint64_t uSpanFrom;      // last span start
+  uint64_t uPings;         // taken
+  uint64_t uRendered;      // samples
+} chansim_t;
+
+void chansim_defaults(chansim_config_t *pCfg);
+bool chansim_init(chansim_t *pS, const chansim_config_t *pCfg);
+void chansim_free(chansim_t *pS);
+void chansim_ping(chansim_t *pS, chansim_ping_t *pPing);
+void chansim_render(chansim_t *pS, uint64_t uFrom, uint16_t *pOut, uint uN);
+double chansim_sound_mps(double fTempC);
+double chansim_distance_m(const chansim_config_t *pCfg, double fS);
+
+#endif // RCS_CHANSIM_01_H
@@ -0,0 +1,300 @@
+// @file rcs-coded-bench-01.c
+// @date 2026.10.17
+// @info host benchmark of the coded burst correlator bank (../rcs-common/rcs-coded-01.c) on synthetic
+// @info mixed captures: several beacons, each sending its code (rcs-burst-01.h burst_code()), into
+// @info one receiver window
+// @info signal: the pio pin patterns (burst_pattern(), +1 phase a, -1 phase b, 0 dead) at 8x the adc
+// @info rate, through a transducer model (tx and rx piezo, each a 40KHz resonator of quality -q;
+// @info 0 ideal), decimated to 500ksps with a random delay per beacon (1/8 sample steps), peak
+// @info amplitudes -a counts less a random 0..-r dB each (near-far), gaussian noise -n counts rms,
+// @info 12 bit quantization
+// @info part 1: isolation; one beacon alone, noiseless: every correlator's window maximum against
+// @info         the sender's own correlator, dB (channel separation)
+// @info part 2: per scenario (beacons sent, -q, near-far), all BURST_CODES correlators run over each
+// @info         window: found (peak over the trigger, not at a stronger beacon's), ok (|error| <= -e us),
+// @info         wrong (found elsewhere: usually another beacon's cross correlation), rms error of the ok
+// @info         ones, and false (a correlator whose beacon did not send reports one)
+// @info presence: 1 and 2 beacons through transducers of q 8 and 16, 6dB near-far; false must stay
+// @info         under BENCH_FALSE_MAX_PCT, or the bench exits 1
+// @info part 3: ns/sample of coded_run() with 1..BURST_CODES beacons against detect_run(), over a
+// @info         long mixed stream; the M0+ budget is DETECT_CYCLE_BUDGET cycles per sample
+
+// @usage ./rcs-coded-bench-01 [-q quality] [-a counts] [-n noise_counts] [-r near_far_db] [-t trigger_counts]
+//                             [-e error_us] [-w windows] [-s seed]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <math.h>
+#include <inttypes.h> // printf("%" PRIu64/d64/x64 "\n", t)
+#include "rcs-rand-01.h"
+#include "../rcs-common/rcs-capture-01.h" // CAPTURE_SAMPLE_HZ, CAPTURE_SAMPLE_NS
+#include "../rcs-common/rcs-detect-01.h"
+#include "../rcs-common/rcs-coded-01.h"
+
+#define BENCH_OVERSAMPLE  8                    // synthesis rate, adc samples
+#define BENCH_HI_HZ       (CAPTURE_SAMPLE_HZ * BENCH_OVERSAMPLE)
+#define BENCH_RESPONSE    (BENCH_HI_HZ / 200)  // 5ms of transducer response per code
+#define BENCH_WINDOW      10000                // 20ms window, adc samples
+#define BENCH_DELAY_MIN   250                  // arrival range in the window, adc samples (0.5ms)
+#define BENCH_DELAY_MAX   8750                 // (17.5ms, ~19ft)
+#define BENCH_SAMPLES     (1u << 23)           // throughput run
+#define BENCH_BASELINE    2048
+#define BENCH_FALSE_MAX_PCT 5.0                 // presence cases: absent beacons reported, % of their windows
+
+typedef struct {
+  double fQ, fAmp, fNoise, fNearFarDb, fErrUs;
+  uint   uWindows;
+  uint64_t uTrigger;
+} bench_config_t;
+
+static float    S_fResponse[BURST_CODES][BENCH_RESPONSE]; // unit peak, per code
+static double   S_fResponseQ = -1;
+static double   S_fBiasUs[BURST_CODES];  // arrival offset per code, alone and noiseless (bench_isolation)
+static coded_t  S_Bank;
+static detect_t S_Detect;
+
+static double now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static void resonate(float *pX, uint uN, double fQ) {
+  // 2nd order bandpass at the carrier, 0dB peak (rbj cookbook), in place
+  double w = 2 * M_PI * BURST_CARRIER_HZ / BENCH_HI_HZ, alpha = sin(w) / (2 * fQ), a0 = 1 + alpha;
+  double b0 = alpha / a0, a1 = -2 * cos(w) / a0, a2 = (1 - alpha) / a0;
+  double x1 = 0, x2 = 0, y1 = 0, y2 = 0;
+  for (uint i = 0; i < uN; i++) {
+    double y = b0 * (pX[i] - x2) - a1 * y1 - a2 * y2;
+    x2 = x1;
+    x1 = pX[i];
+    y2 = y1;
+    y1 = y;
+    pX[i] = y;
+  }
+}
+
+static void make_responses(double fQ) {
+  // pin pattern drive of each code through the tx and rx transducers, normalized to unit peak
+  if (fQ == S_fResponseQ) return;
+  S_fResponseQ = fQ;
+  for (uint c = 0; c < BURST_CODES; c++) {
+    uint32_t uWords[BURST_WORDS_MAX];
+    uint uN = burst_pattern(uWords, burst_code(c + 1), BURST_CODE_CHIPS, BURST_CHIP_CYCLES);
+    float *pR = S_fResponse[c];
+    for (uint i = 0; i < BENCH_RESPONSE; i++) {
+      uint64_t uSlot = (uint64_t)i * BURST_CARRIER_HZ * BURST_SLOTS / BENCH_HI_HZ;
+      uint uHalf = uSlot / (BURST_SLOTS / 2);
+      uint32_t uPins = 0;
+      if (uHalf < uN * 32 / BURST_HALF_BITS && uSlot % (BURST_SLOTS / 2) < BURST_SLOTS_HIGH) {
+        uPins = (uWords[uHalf / (32 / BURST_HALF_BITS)] >> (BURST_HALF_BITS * (uHalf % (32 / BURST_HALF_BITS)))) & 3;
+      }
+      pR[i] = (uPins == 1) - (uPins == 2);
+    }
+    if (fQ > 0) {
+      resonate(pR, BENCH_RESPONSE, fQ);
+      resonate(pR, BENCH_RESPONSE, fQ);
+    }
+    float fMax = 0;
+    for (uint i = 0; i < BENCH_RESPONSE; i++) fMax = fabsf(pR[i]) > fMax ? fabsf(pR[i]) : fMax;
+    for (uint i = 0; i < BENCH_RESPONSE; i++) pR[i] /= fMax;
+  } // end for (uint c...)
+}
+
+static void add_beacon(double *pWin, uint uCode, uint64_t uDelayHi, double fAmp) {
+  // code uCode (1..) arriving uDelayHi synthesis samples into the window
+  const float *pR = S_fResponse[uCode - 1];
+  for (uint i = 0; i < BENCH_WINDOW; i++) {
+    int64_t j = (int64_t)i * BENCH_OVERSAMPLE - (int64_t)uDelayHi;
+    if (j >= 0 && j < BENCH_RESPONSE) pWin[i] += fAmp * pR[j];
+  }
+}
+
+static void quantize(const double *pWin, uint16_t *pOut, uint uN, double fNoise) {
+  for (uint i = 0; i < uN; i++) {
+    double v = BENCH_BASELINE + pWin[i] + fNoise * rand_gauss();
+    pOut[i] = v < 0 ? 0 : v > 4095 ? 4095 : (uint16_t)lround(v);
+  }
+}
+
+static void bench_isolation(const bench_config_t *pCfg, bool bPrint) {
+  // one code alone, noiseless, full amplitude: each correlator's maximum against the sender's, and
+  // the arrival bias per code (S_fBiasUs) for the scenarios at this q; bPrint false the bias only
+  double fWin[BENCH_WINDOW];
+  uint16_t uWin[BENCH_WINDOW];
+  coded_result_t res[BURST_CODES];
+  if (bPrint) printf("# isolation q %.0f: correlator maximum / sender correlator maximum, dB\n# sent", pCfg->fQ);
+  for (uint c = 1; c <= BURST_CODES && bPrint; c++) printf("\tcode%u", c);
+  if (bPrint) printf("\tbias_us\n");
+  for (uint s = 1; s <= BURST_CODES; s++) {
+    memset(fWin, 0, sizeof(fWin));
+    add_beacon(fWin, s, 2000 * BENCH_OVERSAMPLE, pCfg->fAmp);
+    quantize(fWin, uWin, BENCH_WINDOW, 0);
+    coded_init(&S_Bank, BURST_CODES, BENCH_BASELINE, 0, 0);
+    coded_run(&S_Bank, uWin, BENCH_WINDOW);
+    coded_results(&S_Bank, res);
+    S_fBiasUs[s - 1] = ((double)res[s - 1].iArrivalQ8 / (1 << CODED_FRAC_BITS) - 2000) * CAPTURE_SAMPLE_NS / 1000;
+    if (!bPrint) continue;
+    printf("%u", s);
+    for (uint c = 1; c <= BURST_CODES; c++) {
+      printf("\t%.1f", 10 * log10((double)res[c - 1].uPeakMag / res[s - 1].uPeakMag));
+    }
+    printf("\t%.2f\n", S_fBiasUs[s - 1]);
+  }
+} // end static void bench_isolation(...)
+
+static double bench_scenario(const bench_config_t *pCfg, uint uSent) {
+  // uSent beacons (codes 1..uSent) per window, all correlators run; one tsv line. returns false_pct
+  double fWin[BENCH_WINDOW];
+  uint16_t uWin[BENCH_WINDOW];
+  coded_result_t res[BURST_CODES];
+  uint uFound = 0, uOk = 0, uWrong = 0, uFalse = 0;
+  double fSq = 0, fMaxUs = 0;
+  for (uint w = 0; w < pCfg->uWindows; w++) {
+    uint64_t uDelayHi[BURST_CODES];
+    memset(fWin, 0, sizeof(fWin));
+    for (uint b = 0; b < uSent; b++) {
+      uDelayHi[b] = ((uint64_t)BENCH_DELAY_MIN * BENCH_OVERSAMPLE) +
+                    (uint64_t)rand() % ((BENCH_DELAY_MAX - BENCH_DELAY_MIN) * BENCH_OVERSAMPLE);
+      double fAmp = pCfg->fAmp * pow(10, -pCfg->fNearFarDb * rand() / RAND_MAX / 20);
+      add_beacon(fWin, b + 1, uDelayHi[b], fAmp);
+    }
+    quantize(fWin, uWin, BENCH_WINDOW, pCfg->fNoise);
+    coded_init(&S_Bank, BURST_CODES, BENCH_BASELINE, pCfg->uTrigger, 0);
+    coded_run(&S_Bank, uWin, BENCH_WINDOW);
+    coded_results(&S_Bank, res);
+    for (uint b = 0; b < BURST_CODES; b++) {
+      if (b >= uSent) { // not sent
+        if (res[b].bFound) uFalse++;
+        continue;
+      }
+      if (!res[b].bFound) continue;
+      uFound++;
+      // error against the first pattern edge, less the transducer delay (the receiver's reference
+      // distance capture removes it the same way)
+      double fErrUs = ((double)res[b].iArrivalQ8 / (1 << CODED_FRAC_BITS) - (double)uDelayHi[b] / BENCH_OVERSAMPLE) *
+                      CAPTURE_SAMPLE_NS / 1000 - S_fBiasUs[b];
+      if (fabs(fErrUs) <= pCfg->fErrUs) {
+        uOk++;
+        fSq += fErrUs * fErrUs;
+        if (fabs(fErrUs) > fMaxUs) fMaxUs = fabs(fErrUs);
+      } else {
+        uWrong++;
+      }
+    }
+  } // end for (uint w...)
+  uint uN = uSent * pCfg->uWindows;
+  uint uAbsent = (BURST_CODES - uSent) * pCfg->uWindows;
+  printf("%u\t%.0f\t%.0f\t%u\t%.1f\t%.1f\t%.1f\t%.2f\t%.2f\t%.1f\n", uSent, pCfg->fQ, pCfg->fNearFarDb, uN,
+         100.0 * uFound / uN, 100.0 * uOk / uN, 100.0 * uWrong / uN, uOk ? sqrt(fSq / uOk) : 0, fMaxUs,
+         uAbsent ? 100.0 * uFalse / uAbsent : 0);
+  return uAbsent ? 100.0 * uFalse / uAbsent : 0;
+} // end static double bench_scenario(...)
+
+static bool bench_presence(const bench_config_t *pCfg) {
+  // absent beacons at realistic transducer q: their correlators see only the senders' cross
+  // correlation, at 1-5dB under the sender's peak
+  const double fQs[] = { 8, 16 };
+  bench_config_t cfg = *pCfg;
+  bool bOk = true;
+  printf("# presence: false_pct under %.0f at q 8 and 16\n", BENCH_FALSE_MAX_PCT);
+  printf("# sent\tq\tnear_far_db\tarrivals\tfound_pct\tok_pct\twrong_pct\trms_us\tmax_us\tfalse_pct\n");
+  for (uint q = 0; q < 2; q++) {
+    cfg.fQ = fQs[q];
+    cfg.fNearFarDb = 6;
+    make_responses(cfg.fQ);
+    bench_isolation(&cfg, false);
+    for (uint uSent = 1; uSent <= 2; uSent++) {
+      if (bench_scenario(&cfg, uSent) > BENCH_FALSE_MAX_PCT) bOk = false;
+    }
+  }
+  printf("# presence %s\n", bOk ? "ok" : "FAIL");
+  return bOk;
+} // end static bool bench_presence(...)
+
+static void bench_throughput(const bench_config_t *pCfg) {
+  // ns/sample of the bank per beacon count and of the single burst detector, same stream
+  double *pF = calloc(BENCH_WINDOW, sizeof(double));
+  uint16_t *pStream = malloc(BENCH_SAMPLES * sizeof(uint16_t));
+  for (uint b = 0; b < BURST_CODES; b++) add_beacon(pF, b + 1, (1000 + 2000 * b) * BENCH_OVERSAMPLE, pCfg->fAmp);
+  for (size_t i = 0; i < BENCH_SAMPLES; i += BENCH_WINDOW) {
+    uint uN = BENCH_SAMPLES - i < BENCH_WINDOW ? BENCH_SAMPLES - i : BENCH_WINDOW;
+    quantize(pF, pStream + i, uN, pCfg->fNoise);
+  }
+  printf("# throughput over %u samples, %u sample windows\n# kernel\tbeacons\tns_per_sample\n", BENCH_SAMPLES, BENCH_WINDOW);
+  coded_result_t res[BURST_CODES];
+  volatile uint uSink = 0;
+  for (uint uBeacons = 1; uBeacons <= BURST_CODES; uBeacons++) {
+    double t0 = now_ns();
+    for (size_t i = 0; i < BENCH_SAMPLES; i += BENCH_WINDOW) {
+      uint uN = BENCH_SAMPLES - i < BENCH_WINDOW ? BENCH_SAMPLES - i : BENCH_WINDOW;
+      coded_init(&S_Bank, uBeacons, BENCH_BASELINE, pCfg->uTrigger, i);
+      coded_run(&S_Bank, pStream + i, uN);
+      uSink += coded_results(&S_Bank, res);
+    }
+    printf("coded_run\t%u\t%.2f\n", uBeacons, (now_ns() - t0) / BENCH_SAMPLES);
+  }
+  detect_set_rate(&S_Detect, CAPTURE_SAMPLE_HZ, DETECT_CARRIER_HZ);
+  detect_result_t result;
+  double t0 = now_ns();
+  detect_init(&S_Detect, BENCH_BASELINE, detect_mag_for_amplitude(&S_Detect, pCfg->fAmp / 4), 0);
+  for (size_t i = 0; i < BENCH_SAMPLES; ) {
+    uint64_t uIdx0 = S_Detect.uIdx;
+    detect_run(&S_Detect, pStream + i, BENCH_SAMPLES - i, &result);
+    i += S_Detect.uIdx - uIdx0;
+  }
+  printf("detect_run\t1\t%.2f\n", (now_ns() - t0) / BENCH_SAMPLES);
+  printf("# M0+ budget: %d cycles/sample (%d ns at 125MHz, %d ksps)\n",
+         DETECT_CYCLE_BUDGET, CAPTURE_SAMPLE_NS, CAPTURE_SAMPLE_HZ / 1000);
+  free(pF);
+  free(pStream);
+} // end static void bench_throughput(...)
+
+int main(int argc, char **argv) {
+  bench_config_t cfg = { .fQ = -1, .fAmp = 200, .fNoise = 10, .fNearFarDb = -1, .fErrUs = 20, .uWindows = 500 };
+  double fTrigger = 20;
+  unsigned uSeed = RAND_SEED_DEFAULT;
+  for (int i = 1; i + 1 < argc; i += 2) {
+    if (strcmp(argv[i], "-q") == 0) cfg.fQ = atof(argv[i + 1]);
+    else if (strcmp(argv[i], "-a") == 0) cfg.fAmp = atof(argv[i + 1]);
+    else if (strcmp(argv[i], "-n") == 0) cfg.fNoise = atof(argv[i + 1]);
+    else if (strcmp(argv[i], "-r") == 0) cfg.fNearFarDb = atof(argv[i + 1]);
+    else if (strcmp(argv[i], "-t") == 0) fTrigger = atof(argv[i + 1]);
+    else if (strcmp(argv[i], "-e") == 0) cfg.fErrUs = atof(argv[i + 1]);
+    else if (strcmp(argv[i], "-w") == 0) cfg.uWindows = atoi(argv[i + 1]);
+    else if (rand_seed_arg(argv[i], argv[i + 1], &uSeed)) continue;
+    else {
+      fprintf(stderr, "usage: %s [-q quality] [-a counts] [-n noise_counts] [-r near_far_db] [-t trigger_counts] "
+                      "[-e error_us] [-w windows] [-s seed]\n", argv[0]);
+      return 2;
+    }
+  }
+  srand(uSeed);
+  coded_set_rate(&S_Bank, CAPTURE_SAMPLE_HZ, BURST_CARRIER_HZ);
+  cfg.uTrigger = coded_mag_for_amplitude(&S_Bank, fTrigger);
+  printf("# codes %u chips %u cycles/chip %u (%u samples) amp %.0f noise %.1f trigger %.0f counts, ok within %.0f us\n",
+         BURST_CODES, BURST_CODE_CHIPS, BURST_CHIP_CYCLES, S_Bank.uChipLen, cfg.fAmp, cfg.fNoise, fTrigger, cfg.fErrUs);
+
+  // default sweep: ideal transducers and two resonator qualities; near-far spreads 0, 6, 12 dB
+  const double fQs[] = { 0, 8, 16 }, fNearFar[] = { 0, 6, 12 };
+  uint uQs = cfg.fQ >= 0 ? 1 : 3, uNfs = cfg.fNearFarDb >= 0 ? 1 : 3;
+  double fQ = cfg.fQ, fNf = cfg.fNearFarDb;
+  for (uint q = 0; q < uQs; q++) {
+    cfg.fQ = fQ >= 0 ? fQ : fQs[q];
+    make_responses(cfg.fQ);
+    bench_isolation(&cfg, true);
+    printf("# scenarios\n# sent\tq\tnear_far_db\tarrivals\tfound_pct\tok_pct\twrong_pct\trms_us\tmax_us\tfalse_pct\n");
+    for (uint f = 0; f < uNfs; f++) {
+      cfg.fNearFarDb = fNf >= 0 ? fNf : fNearFar[f];
+      for (uint uSent = 1; uSent <= BURST_CODES; uSent++) {
+        if (uSent == 3) continue; // 1, 2, 4 beacons
+        bench_scenario(&cfg, uSent);
+      }
+    }
+  }
+  bool bOk = bench_presence(&cfg);
+  bench_throughput(&cfg);
+  return bOk ? 0 : 1;
+} // end int main(...)
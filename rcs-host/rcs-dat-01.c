@@ -0,0 +1,100 @@
+// @file rcs-dat-01.c
+// @date 2026.10.17
+// @info host loader for minicom capture .dat files (ascii volts, one sample per line)
+// @info non-numeric lines (minicom banners, 'Baseline Samples', 'max: ...' summaries) are skipped,
+// @info so multi capture logs such as exp_dist_01/dist15.dat load as one concatenated stream
+// @info the exp_dist captures are labelled with the window their burst arrives in, read off the traces
+// @info (first carrier cycle to ~5 cycles on); rcs-scan-01 and rcs-detect-bench-01 score against them
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include "rcs-dat-01.h"
+
+size_t dat_load(const char *sPath, uint16_t **ppSamples) {
+  // load sPath into a malloc'd buffer of 12 bit adc counts; returns sample count, 0 on error
+  return dat_load_sections(sPath, ppSamples, NULL, 0, NULL);
+}
+
+size_t dat_load_sections(const char *sPath, uint16_t **ppSamples, size_t *pStarts, uint uMax, uint *puSections) {
+  // as dat_load(), and also record where each run of samples between text lines starts; used to
+  // split multi capture logs ('Baseline Samples' / 'Triggered capture') into their sections.
+  // pStarts may be NULL; at most uMax sections are recorded in *puSections.
+  uint uSections = 0;
+  bool bInRun = false;
+  FILE *f = fopen(sPath, "r");
+  if (!f) {
+    fprintf(stderr, "dat_load: cannot open %s\n", sPath);
+    return 0;
+  }
+  size_t uCap = 1024, uN = 0;
+  uint16_t *p = malloc(uCap * sizeof(uint16_t));
+  char sLine[256];
+  while (p && fgets(sLine, sizeof(sLine), f)) {
+    char *pEnd;
+    double fVolts = strtod(sLine, &pEnd);
+    if (pEnd == sLine || (*pEnd != '\n' && *pEnd != '\r' && *pEnd != 0)) { // not a sample
+      bInRun = false;
+      continue;
+    }
+    if (!bInRun) {
+      if (pStarts && uSections < uMax) pStarts[uSections++] = uN;
+      bInRun = true;
+    }
+    if (uN == uCap) {
+      uCap *= 2;
+      p = realloc(p, uCap * sizeof(uint16_t));
+      if (!p) break;
+    }
+    long iCounts = (long)(fVolts / DAT_ADC_CF + 0.5);
+    if (iCounts < 0) iCounts = 0;
+    if (iCounts > 4095) iCounts = 4095;
+    p[uN++] = (uint16_t)iCounts;
+  } // end while (fgets(...))
+  fclose(f);
+  if (!p || uN == 0) {
+    free(p);
+    fprintf(stderr, "dat_load: no samples in %s\n", sPath);
+    return 0;
+  }
+  *ppSamples = p;
+  if (puSections) *puSections = uSections;
+  return uN;
+} // end size_t dat_load_sections(...)
+
+uint16_t dat_avg(const uint16_t *pSamples, size_t uN) {
+  // true mean of uN samples, as the device adc_avg_n(); uN is not bounded here, so the sum is 64 bit
+  uint64_t uSum = 0;
+  for (size_t i = 0; i < uN; i++) uSum += pSamples[i];
+  return uN ? (uint16_t)((uSum + uN / 2) / uN) : 0;
+}
+
+const dat_label_t G_DatLabels[] = {
+  { "exp_dist_01/b1.dat",  "exp_dist_01/d1.dat",  64,  112 },
+  { "exp_dist_01/b2.dat",  "exp_dist_01/d2.dat",  100, 148 },
+  { "exp_dist_01/b3.dat",  "exp_dist_01/d3.dat",  0,   48 },
+  { "exp_dist_01/b4.dat",  "exp_dist_01/d4.dat",  -1,  -1 },
+  { "exp_dist_01/b5.dat",  "exp_dist_01/d5.dat",  0,   48 },
+  { "exp_dist_01/b6.dat",  "exp_dist_01/d6.dat",  88,  136 },
+  { "exp_dist_02/b21.dat", "exp_dist_02/d21.dat", 0,   48 },
+  { "exp_dist_02/b22.dat", "exp_dist_02/d22.dat", 64,  112 },
+  { "exp_dist_02/b23.dat", "exp_dist_02/d23.dat", 0,   48 },
+  { "exp_dist_02/b24.dat", "exp_dist_02/d24.dat", 112, 160 },
+  { "exp_dist_02/b25.dat", "exp_dist_02/d25.dat", 36,  84 },
+  { "exp_dist_02/b26.dat", "exp_dist_02/d26.dat", 36,  84 },
+  { "exp_dist_02/b27.dat", "exp_dist_02/d27.dat", 24,  72 },
+  { "exp_dist_02/b28.dat", "exp_dist_02/d28.dat", 0,   48 },
+};
+const uint G_uDatLabels = sizeof(G_DatLabels) / sizeof(G_DatLabels[0]);
+
+const dat_label_t *dat_find_label(const char *sCapture) {
+  // label whose capture path is a suffix of sCapture, NULL if unlabelled
+  size_t uLen = strlen(sCapture);
+  for (uint i = 0; i < G_uDatLabels; i++) {
+    size_t uL = strlen(G_DatLabels[i].sCapture);
+    if (uLen >= uL && strcmp(sCapture + uLen - uL, G_DatLabels[i].sCapture) == 0 &&
+        (uLen == uL || sCapture[uLen - uL - 1] == '/')) return &G_DatLabels[i];
+  }
+  return NULL;
+}
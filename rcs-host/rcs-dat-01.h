@@ -0,0 +1,26 @@
+// @file rcs-dat-01.h
+// @date 2026.10.17
+// @info host loader for minicom capture .dat files (ascii volts, one sample per line)
+
+#include <stdint.h>
+#include <stddef.h>
+#include <sys/types.h> // uint
+
+#define DAT_ADC_CF (3.3 / (1 << 12)) // 12 bit adc conversion factor; matches G_adc_cf
+#define DAT_SAMPLE_HZ 380000         // rcs-rx04-01 adc_read() loop rate; 40KHz carrier at ~0.105 cycles/sample
+
+#define DAT_SETTLE    32             // leading baseline samples skipped; bias network settling after boot
+
+typedef struct {
+  const char *sBase;    // relative to the mfiles directory
+  const char *sCapture;
+  int         iLo, iHi; // expected first crossing, capture samples; iLo < 0: no burst in the capture
+} dat_label_t;
+
+extern const dat_label_t G_DatLabels[];
+extern const uint        G_uDatLabels;
+
+size_t dat_load(const char *sPath, uint16_t **ppSamples);
+size_t dat_load_sections(const char *sPath, uint16_t **ppSamples, size_t *pStarts, uint uMax, uint *puSections);
+uint16_t dat_avg(const uint16_t *pSamples, size_t uN);
+const dat_label_t *dat_find_label(const char *sCapture);
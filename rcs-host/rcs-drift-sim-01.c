@@ -0,0 +1,161 @@
+// @file rcs-drift-sim-01.c
+// @date 2026.10.17
+// @info simulated tx/rx clock drift over long runs; drift tracker (../rcs-common/rcs-drift-01.*)
+// @info against the fixed TX_RX_SKEW per period correction it replaced
+// @info one arrival per tx period, in receiver samples: tx emission (tx period from a ppm offset, a
+// @info temperature swing and a slow random walk) + flight time of the target distance + detection
+// @info jitter, quantized to Q8 like the detector; pulses are missed at random. the target holds a
+// @info distance, then steps or walks (>1ft/min) to a new one. ranging error = reported flight time
+// @info change - true flight time change; per hour max/rms for both corrections (tsv on stdout).
+// @info -r replays a measured skew series instead (tx_rx_timing_skew_01/rx.dat: us per 4s pulse,
+// @info fixed 1ft distance, recorded with the old polled adc loop)
+
+// @usage ./rcs-drift-sim-01 [-H hours] [-p ppm] [-t swing_ppm] [-j jitter_us] [-m miss_prob] [-s seed]
+// @usage ./rcs-drift-sim-01 -r ../rcs-rx04-03/mfiles/tx_rx_timing_skew_01/rx.dat
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <inttypes.h> // printf("%" PRIu64/d64/x64 "\n", t)
+#include "rcs-rand-01.h"
+#include "../rcs-common/rcs-drift-01.h"
+
+#define SIM_SAMPLE_HZ   500000  // rcs-capture-01 CAPTURE_SAMPLE_HZ
+#define SIM_TX_PERIOD   2000    // ms; rcs-rx04-03 TX_PERIOD
+#define SIM_TX_RX_SKEW  -10     // us per period; rcs-rx04-03 TX_RX_SKEW (legacy correction, tracker prior)
+#define SIM_US_PER_FT   889     // (/ 1e6 1125.0) flight time per ft at 20C
+#define SIM_TEMP_HOURS  6.0     // temperature swing period
+
+typedef struct {
+  double fMaxTrack, fSqTrack, fMaxLegacy, fSqLegacy;
+  uint   uN;
+} sim_stat_t;
+
+static void stat_add(sim_stat_t *pS, double fTrackUs, double fLegacyUs) {
+  if (fabs(fTrackUs) > pS->fMaxTrack) pS->fMaxTrack = fabs(fTrackUs);
+  if (fabs(fLegacyUs) > pS->fMaxLegacy) pS->fMaxLegacy = fabs(fLegacyUs);
+  pS->fSqTrack += fTrackUs * fTrackUs;
+  pS->fSqLegacy += fLegacyUs * fLegacyUs;
+  pS->uN++;
+}
+
+static void stat_print(const char *sLabel, const sim_stat_t *pS) {
+  printf("%s\t%u\t%.1f\t%.1f\t%.1f\t%.1f\n", sLabel, pS->uN, pS->fMaxTrack,
+         pS->uN ? sqrt(pS->fSqTrack / pS->uN) : 0, pS->fMaxLegacy, pS->uN ? sqrt(pS->fSqLegacy / pS->uN) : 0);
+}
+
+static int replay_skew(const char *sPath) {
+  // measured skew: arrival k = k * 4s + skew_k; the legacy correction for this series was -18us
+  FILE *f = fopen(sPath, "r");
+  if (!f) {
+    perror(sPath);
+    return 1;
+  }
+  const uint32_t uNominal = 4 * SIM_SAMPLE_HZ;
+  drift_t track;
+  drift_init(&track, uNominal, 0, 1);
+  sim_stat_t all = { 0 };
+  double fSkewUs;
+  uint k = 0;
+  printf("# pulse\tskew_us\ttracked_us\tlegacy_us\tppm\n");
+  while (fscanf(f, "%lf", &fSkewUs) == 1) {
+    int64_t iArrivalQ8 = llround(((double)k * uNominal + fSkewUs * SIM_SAMPLE_HZ / 1e6) * 256);
+    int64_t iResidualQ8;
+    bool bRef;
+    drift_update(&track, true, iArrivalQ8, &iResidualQ8, &bRef);
+    double fTrackUs = iResidualQ8 / 256.0 * 1e6 / SIM_SAMPLE_HZ;
+    double fLegacyUs = fSkewUs - k * -18.0;
+    printf("%u\t%.0f\t%.1f\t%.1f\t%.2f\n", k, fSkewUs, fTrackUs, fLegacyUs, drift_ppm_q8(&track) / 256.0);
+    stat_add(&all, fTrackUs, fLegacyUs);
+    k++;
+  }
+  fclose(f);
+  printf("# summary\n# label\tpings\ttracked_max_us\ttracked_rms_us\tlegacy_max_us\tlegacy_rms_us\n");
+  stat_print("all", &all);
+  return 0;
+} // end static int replay_skew(...)
+
+int main(int argc, char **argv) {
+  double fHours = 24, fPpm = -5, fSwingPpm = 1, fJitterUs = 1, fMiss = 0.02;
+  unsigned uSeed = RAND_SEED_DEFAULT;
+  for (int i = 1; i + 1 < argc; i += 2) {
+    if (strcmp(argv[i], "-H") == 0) fHours = atof(argv[i + 1]);
+    else if (strcmp(argv[i], "-p") == 0) fPpm = atof(argv[i + 1]);
+    else if (strcmp(argv[i], "-t") == 0) fSwingPpm = atof(argv[i + 1]);
+    else if (strcmp(argv[i], "-j") == 0) fJitterUs = atof(argv[i + 1]);
+    else if (strcmp(argv[i], "-m") == 0) fMiss = atof(argv[i + 1]);
+    else if (rand_seed_arg(argv[i], argv[i + 1], &uSeed)) continue;
+    else if (strcmp(argv[i], "-r") == 0) return replay_skew(argv[i + 1]);
+    else {
+      fprintf(stderr, "usage: %s [-H hours] [-p ppm] [-t swing_ppm] [-j jitter_us] [-m miss_prob] [-s seed] | -r skew.dat\n", argv[0]);
+      return 2;
+    }
+  }
+  srand(uSeed);
+  const uint32_t uNominal = (uint32_t)SIM_TX_PERIOD * (SIM_SAMPLE_HZ / 1000);
+  const double fSamplesPerUs = SIM_SAMPLE_HZ / 1e6;
+  const uint uPings = fHours * 3600 * 1000 / SIM_TX_PERIOD;
+  const uint uPingsPerHour = 3600 * 1000 / SIM_TX_PERIOD;
+
+  drift_t track;
+  drift_init(&track, uNominal, (SIM_TX_RX_SKEW * 256) * fSamplesPerUs, 1);
+  double fTx = 0;                 // tx emission, rx samples
+  double fWalkPpm = 0;            // random walk part of the tx clock offset
+  double fFt = 1, fFtTarget = 1;  // target distance; reference at 1ft
+  double fWalkFt = 0;             // ft per ping while walking
+  double fRefFlight = 0, fLegacyRef = 0;
+  bool bRef = false;
+  sim_stat_t hour = { 0 }, all = { 0 };
+
+  printf("# hours %.1f ppm %.2f swing_ppm %.2f jitter_us %.2f miss %.3f\n", fHours, fPpm, fSwingPpm, fJitterUs, fMiss);
+  printf("# hour\tpings\ttracked_max_us\ttracked_rms_us\tlegacy_max_us\tlegacy_rms_us\n");
+  for (uint k = 0; k < uPings; k++) {
+    // tx clock: fixed offset, temperature swing, random walk
+    double fHour = (double)k / uPingsPerHour;
+    fWalkPpm += 0.002 * rand_gauss();
+    double fTxPpm = fPpm + fSwingPpm * sin(2 * M_PI * fHour / SIM_TEMP_HOURS) + fWalkPpm;
+    if (k) fTx += uNominal * (1 + fTxPpm * 1e-6);
+
+    // target: hold 10-30 min after the first 5 min, then step (half) or walk at 1-3 ft/min
+    if (fFt == fFtTarget && k > 150 && rand() % 600 == 0) {
+      fFtTarget = 1 + rand() % 15;
+      fWalkFt = (rand() % 2) ? 0 : (1 + rand() % 3) / 30.0;
+      if (fWalkFt == 0) fFt = fFtTarget;
+    }
+    if (fFt != fFtTarget) {
+      if (fabs(fFtTarget - fFt) <= fWalkFt) fFt = fFtTarget;
+      else fFt += (fFtTarget > fFt) ? fWalkFt : -fWalkFt;
+    }
+    double fFlight = fFt * SIM_US_PER_FT * fSamplesPerUs;
+    double fArrival = fTx + fFlight + fJitterUs * fSamplesPerUs * rand_gauss();
+    int64_t iArrivalQ8 = llround(fArrival * 256);
+    bool bValid = (double)rand() / RAND_MAX >= fMiss;
+
+    int64_t iResidualQ8;
+    bool bReference;
+    if (!drift_update(&track, bValid, iArrivalQ8, &iResidualQ8, &bReference)) continue;
+    if (bReference) {
+      fRefFlight = fFlight;
+      fLegacyRef = iArrivalQ8 / 256.0 - (double)k * uNominal;
+      bRef = true;
+    }
+    if (!bRef) continue;
+    double fTrueUs = (fFlight - fRefFlight) / fSamplesPerUs;
+    double fTrackUs = iResidualQ8 / 256.0 / fSamplesPerUs;
+    // legacy: windows at the rx nominal period, flight change less k * TX_RX_SKEW
+    double fLegacyUs = (iArrivalQ8 / 256.0 - (double)k * uNominal - fLegacyRef) / fSamplesPerUs - (double)k * SIM_TX_RX_SKEW;
+    stat_add(&hour, fTrackUs - fTrueUs, fLegacyUs - fTrueUs);
+    stat_add(&all, fTrackUs - fTrueUs, fLegacyUs - fTrueUs);
+    if ((k + 1) % uPingsPerHour == 0) {
+      char sLabel[16];
+      snprintf(sLabel, sizeof(sLabel), "%u", (k + 1) / uPingsPerHour);
+      stat_print(sLabel, &hour);
+      memset(&hour, 0, sizeof(hour));
+    }
+  } // end for (uint k...)
+  printf("# summary\n# label\tpings\ttracked_max_us\ttracked_rms_us\tlegacy_max_us\tlegacy_rms_us\n");
+  stat_print("all", &all);
+  printf("# tracker\tgated\t%u\tperiod_ppm\t%.3f\n", track.uGated, drift_ppm_q8(&track) / 256.0);
+  return 0;
+} // end int main(...)
@@ -0,0 +1,222 @@
+// @file rcs-dsp-check-01.c
+// @date 2026.10.17
+// @info host check and benchmark of the fixed point dsp primitives (../rcs-common/rcs-dsp-01.c)
+// @info part 1: bit-exactness; each primitive against its exact definition (integer or long double
+// @info         rational arithmetic, the rounding rule spelled out), exhaustively over 12 bit inputs and
+// @info         on random vectors elsewhere. mismatches are listed and make the exit status 1. the
+// @info         peak interpolation is also held against its real valued vertex (max_err_lsb;
+// @info         informational), and the threshold scaling against the float expression it replaced
+// @info part 2: ns per call (per sample for the block primitives) on the host, with the float form
+// @info         next to it where the receiver used one; host fpu numbers, so the float column is a
+// @info         lower bound of what the M0+ soft-float calls cost. host ns do not scale to M0+ cycles
+// @info         (other isa, caches, a hardware multiplier and divider); cycles need a target run
+
+// @usage ./rcs-dsp-check-01 [-n random_cases] [-s seed]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <math.h>
+#include <inttypes.h> // printf("%" PRIu64/d64/x64 "\n", t)
+#include "rcs-rand-01.h"
+#include "../rcs-common/rcs-dsp-01.h"
+
+#define CHECK_BLOCK 256   // samples per block primitive call
+#define CHECK_CALLS (1u << 20)
+
+typedef struct {
+  const char *sName;
+  uint64_t uCases;
+  uint64_t uMismatch;
+  double   fMaxErr;  // against the ideal real valued result, lsb; informational
+} check_t;
+
+static check_t S_Check[24];
+static uint    S_uChecks = 0;
+static volatile int64_t S_iSink;  // keeps benchmark results live
+
+static double now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static uint32_t rand32(void) {
+  return ((uint32_t)rand() << 16) ^ (uint32_t)rand();
+}
+
+static uint64_t rand64(void) {
+  return ((uint64_t)rand32() << 32) | rand32();
+}
+
+static check_t *check_begin(const char *sName) {
+  check_t *pC = &S_Check[S_uChecks++];
+  memset(pC, 0, sizeof(*pC));
+  pC->sName = sName;
+  return pC;
+}
+
+static void check_int(check_t *pC, int64_t iGot, int64_t iWant, const char *sWhat, int64_t iArg) {
+  pC->uCases++;
+  if (iGot == iWant) return;
+  if (pC->uMismatch++ < 4) {
+    printf("# mismatch %s %s(%" PRId64 "): %" PRId64 " want %" PRId64 "\n", pC->sName, sWhat, iArg, iGot, iWant);
+  }
+}
+
+static void check_err(check_t *pC, double fErr) {
+  if (fabs(fErr) > pC->fMaxErr) pC->fMaxErr = fabs(fErr);
+}
+
+static int64_t round_half_away(int64_t iNum, int64_t iDen) {
+  // reference rounding for the scalings; iDen > 0
+  int64_t q = llabs(iNum) / iDen, r = llabs(iNum) % iDen;
+  if (2 * r >= iDen) q++;
+  return iNum < 0 ? -q : q;
+}
+
+static void check_scaling(uint uRandom) {
+  check_t *pC = check_begin("dsp_mv_to_counts");
+  uint uFloatDiff = 0;
+  for (uint mv = 0; mv <= DSP_ADC_VREF_MV; mv++) {
+    check_int(pC, dsp_mv_to_counts(mv), ((int64_t)mv << DSP_ADC_BITS) / DSP_ADC_VREF_MV, "", mv);
+    // the expression it replaces: (uint16_t)(fVolts / G_adc_cf)
+    uint16_t uFloat = (float)mv / 1000.0f / (3.3f / (1 << 12));
+    if (uFloat != dsp_mv_to_counts(mv)) uFloatDiff++;
+  }
+  printf("# dsp_mv_to_counts differs from the float threshold expression at %u of %u mV values (float rounding)\n",
+         uFloatDiff, DSP_ADC_VREF_MV + 1);
+
+  pC = check_begin("dsp_div_round");
+  for (uint i = 0; i < uRandom; i++) {
+    int32_t n = (int32_t)(rand32() >> 2) - (1 << 29);
+    int32_t d = 1 + (rand32() >> (rand() % 31 + 1));
+    check_int(pC, dsp_div_round(n, d), round_half_away(n, d), "", n);
+  }
+} // end static void check_scaling(...)
+
+static void check_average(uint uRandom) {
+  check_t *pC = check_begin("dsp_mean_u16");
+  uint16_t uX[CHECK_BLOCK];
+  for (uint i = 0; i < uRandom / CHECK_BLOCK + 1; i++) {
+    uint uN = 1 + rand() % CHECK_BLOCK;
+    uint64_t uSum = 0;
+    for (uint k = 0; k < uN; k++) uSum += uX[k] = rand() & 0xFFF;
+    check_int(pC, dsp_mean_u16(uX, uN), (int64_t)((2 * uSum + uN) / (2 * uN)), "n", uN);
+  }
+}
+
+static void check_correlation(uint uRandom) {
+  check_t *pC = check_begin("dsp_mag2");
+  for (uint i = 0; i < uRandom; i++) {
+    int32_t iI = (int32_t)rand32() >> 2, iQ = (int32_t)rand32() >> 2;
+    uint s = 14 + rand() % 4;
+    int64_t ii = iI >> s, qq = iQ >> s; // arithmetic shift of the sums, as the detector does
+    check_int(pC, dsp_mag2(iI, iQ, s), ii * ii + qq * qq, "shift", s);
+  }
+
+  pC = check_begin("dsp_isqrt32");
+  for (uint i = 0; i < uRandom + 64; i++) {
+    uint32_t x = i < 32 ? i : i < 64 ? UINT32_MAX - (i - 32) : rand32() >> (rand() % 32);
+    uint64_t r = (uint64_t)sqrtl((long double)x);
+    while (r * r > x) r--;
+    while ((r + 1) * (r + 1) <= x) r++;
+    check_int(pC, dsp_isqrt32(x), r, "", x);
+  }
+
+  pC = check_begin("dsp_isqrt64");
+  for (uint i = 0; i < uRandom + 64; i++) {
+    uint64_t x = i < 32 ? i : i < 64 ? UINT64_MAX - (i - 32) : rand64() >> (rand() % 64);
+    unsigned __int128 r = (uint64_t)sqrtl((long double)x);
+    while (r * r > x) r--;
+    while ((r + 1) * (r + 1) <= x) r++;
+    check_int(pC, dsp_isqrt64(x), (int64_t)r, "", (int64_t)(x >> 1));
+  }
+} // end static void check_correlation(...)
+
+static void check_interpolation(uint uRandom) {
+  check_t *pC = check_begin("dsp_parabola_q8");
+  for (uint i = 0; i < uRandom; i++) {
+    int64_t b = rand64() >> 34, a = b - (int64_t)(rand64() >> (36 + rand() % 20)), c = b - (int64_t)(rand64() >> (36 + rand() % 20));
+    if (i & 1) a = b + (rand() % 3) - 1; // flat and non peaks too
+    int64_t iDen = 2 * (a - 2 * b + c), iWant = 0;
+    if (iDen < 0) {
+      // truncated toward zero, clamped
+      long double f = (long double)(a - c) * 256 / iDen;
+      iWant = (int64_t)f;
+      if (iWant > 128) iWant = 128;
+      if (iWant < -128) iWant = -128;
+      check_err(pC, fminl(fmaxl(f, -128), 128) - iWant);
+    }
+    check_int(pC, dsp_parabola_q8(a, b, c), iWant, "b", b);
+  }
+} // end static void check_interpolation(...)
+
+static void bench(void) {
+  // ns per call or per sample; inputs vary per call so nothing folds to a constant
+  static uint16_t uX[CHECK_BLOCK];
+  for (uint i = 0; i < CHECK_BLOCK; i++) uX[i] = rand() & 0xFFF;
+  int64_t s = 0;
+  double t0, fNs;
+  printf("# primitive\tns_per_call\tunit\tfloat_ns\n");
+
+  t0 = now_ns();
+  for (uint i = 0; i < CHECK_CALLS; i++) s += dsp_mv_to_counts(i % (DSP_ADC_VREF_MV + 1));
+  fNs = (now_ns() - t0) / CHECK_CALLS;
+  t0 = now_ns();
+  volatile float fCf = 3.3f / 4096;
+  float fSum = 0;
+  for (uint i = 0; i < CHECK_CALLS; i++) fSum += (uint16_t)((float)(i % (DSP_ADC_VREF_MV + 1)) / 1000.0f / fCf);
+  printf("dsp_mv_to_counts\t%.2f\tcall\t%.2f\n", fNs, (now_ns() - t0) / CHECK_CALLS);
+  S_iSink = (int64_t)fSum;
+
+  t0 = now_ns();
+  for (uint i = 0; i < CHECK_CALLS / CHECK_BLOCK; i++) {
+    uX[i & (CHECK_BLOCK - 1)] ^= 1;
+    s += dsp_mean_u16(uX, CHECK_BLOCK);
+  }
+  printf("dsp_mean_u16\t%.2f\tsample\t-\n", (now_ns() - t0) / CHECK_CALLS);
+
+  t0 = now_ns();
+  for (uint i = 0; i < CHECK_CALLS; i++) s += dsp_isqrt32(i * 2654435761u);
+  printf("dsp_isqrt32\t%.2f\tcall\t-\n", (now_ns() - t0) / CHECK_CALLS);
+
+  t0 = now_ns();
+  for (uint i = 0; i < CHECK_CALLS; i++) s += dsp_isqrt64((uint64_t)i * 0x9E3779B97F4A7C15ull);
+  printf("dsp_isqrt64\t%.2f\tcall\t-\n", (now_ns() - t0) / CHECK_CALLS);
+
+  t0 = now_ns();
+  for (uint i = 0; i < CHECK_CALLS; i++) s += dsp_parabola_q8(1000 + (i & 255), 1300, 1100);
+  printf("dsp_parabola_q8\t%.2f\tcall\t-\n", (now_ns() - t0) / CHECK_CALLS);
+
+  S_iSink += s;
+  printf("# host ns only, not M0+ cycles; host fpu, so the float column is a lower bound of the soft-float calls\n");
+} // end static void bench(void)
+
+int main(int argc, char **argv) {
+  uint uRandom = 1000000, uSeed = RAND_SEED_DEFAULT;
+  for (int i = 1; i + 1 < argc; i += 2) {
+    if (strcmp(argv[i], "-n") == 0) uRandom = atoi(argv[i + 1]);
+    else if (rand_seed_arg(argv[i], argv[i + 1], &uSeed)) continue;
+    else {
+      fprintf(stderr, "usage: %s [-n random_cases] [-s seed]\n", argv[0]);
+      return 2;
+    }
+  }
+  srand(uSeed);
+  check_scaling(uRandom);
+  check_average(uRandom);
+  check_correlation(uRandom);
+  check_interpolation(uRandom);
+  uint64_t uFailed = 0;
+  printf("# primitive\tcases\tmismatches\tmax_err_lsb\n");
+  for (uint i = 0; i < S_uChecks; i++) {
+    check_t *pC = &S_Check[i];
+    printf("%s\t%" PRIu64 "\t%" PRIu64 "\t%.3f\n", pC->sName, pC->uCases, pC->uMismatch, pC->fMaxErr);
+    uFailed += pC->uMismatch;
+  }
+  printf("# %s\n", uFailed ? "FAIL" : "bit-exact");
+  bench();
+  return uFailed ? 1 : 0;
+} // end int main(...)
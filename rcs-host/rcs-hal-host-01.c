@@ -0,0 +1,599 @@
+// @file rcs-hal-host-01.c
+// @date 2026.10.17
+// @info hal linux host backend (see ../rcs-common/rcs-hal-01.h, rcs-hal-host-01.h)
+// @info virtual clock: every hal call advances time by what it would cost on target (adc conversion
+// @info 2us, busy waits and sleeps their duration, time/poll reads HAL_HOST_POLL_NS). repeating
+// @info timer callbacks fire from inside those advances, never nested, like the pico timer irq.
+// @info the run ends (summary on stderr, exit 0) when the adc stream or RCS_HOST_RUN_MS runs out.
+// @info multicore: core 1 is a pthread and the only clock driver; core 0 waits on the clock, so
+// @info core 0 work (leds, printf) overlaps core 1 capture in virtual time as on target. at the end
+// @info of the run core 1 parks and core 0 exits once it next waits, after draining its work.
+// @info duty cycle: time in hal_sleep_ms/hal_sleep_until_us is counted per core as asleep, and the
+// @info capture ring's adc power (hal_host_adc_power) as adc on; the summary gives both against the
+// @info run, so a power regression shows without a meter.
+// @info a core 1 sleep steps the clock to each of core 0's wait deadlines and lets core 0 run to its
+// @info next wait first; one jump over a long sleep would make every core 0 busy wait in it
+// @info (flash_led_16hz) last the whole sleep, and core 0 would fall a ping period behind per wait.
+
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>   // pause
+#include <time.h>     // clock_gettime
+#include <inttypes.h> // printf("%" PRIu64/d64/x64 "\n", t)
+#include "../rcs-common/rcs-hal-01.h"
+#include "rcs-dat-01.h"
+#include "../rcs-common/rcs-burst-01.h"
+
+#define HAL_HOST_GPIO_N     32
+#define HAL_HOST_PWM_N      8      // slices
+#define HAL_HOST_POLL_NS    100    // cost of a time/counter read in a poll loop
+#define HAL_HOST_ADC_NS     2000   // adc conversion; 96 cycles of 48MHz
+#define HAL_HOST_ADC_IDLE   2048   // adc value with no stream attached
+#define HAL_HOST_RUN_MS     60000  // default run length
+#define HAL_HOST_ALARMS     8      // one-shot alarms pending at once
+#define HAL_HOST_YIELD_MS   20     // real time a sleeping core 1 waits for core 0 to reach a wait
+#define HAL_HOST_PIO_START  2      // pio clocks from fifo put to the first edge (pull, out)
+#define HAL_HOST_ECHO_TAPS  8      // RCS_HOST_ECHO delays
+#define HAL_HOST_ECHO_BURSTS 4     // bursts still echoing; older ones are dropped
+#define HAL_HOST_ECHO_RING_US 250  // echo ring-down after the burst ends; measured bursts are ~(* 2 130) 260us wide
+
+// virtual clock, timers
+static uint64_t     S_uNowNs = 0;
+static uint64_t     S_uEndNs = (uint64_t)HAL_HOST_RUN_MS * 1000000;
+static hal_timer_t *S_pTimers = NULL;
+static bool         S_bInCallback = false;
+// multicore
+static bool            S_bMulticore = false;
+static bool            S_bEnded = false;
+static pthread_t       S_Core1;
+static pthread_mutex_t S_Lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t  S_Cond = PTHREAD_COND_INITIALIZER;
+static uint64_t        S_uCore0WaitNs = UINT64_MAX; // core 0's wait deadline; UINT64_MAX while it runs
+// duty cycle
+static uint64_t     S_uSleepNs[2] = { 0, 0 };  // per core, in hal sleeps; to the end of the current one
+static uint64_t     S_uSleepEndNs[2] = { 0, 0 };
+static uint64_t     S_uAdcOnNs = 0;            // capture ring powered, closed spans
+static uint64_t     S_uAdcOnSinceNs = 0;
+static bool         S_bAdcOn = false;
+static bool         S_bAdcPowered = false;     // hal_host_adc_power() was ever called
+// adc stream
+static uint16_t    *S_pAdc = NULL;
+static size_t       S_uAdcLen = 0;
+static uint64_t     S_uAdcHz = 500000;
+// gpio
+static bool         S_bOut[HAL_HOST_GPIO_N];
+static bool         S_bValue[HAL_HOST_GPIO_N];
+static bool         S_bPullUp[HAL_HOST_GPIO_N];
+static int          S_iPressGp = -1;        // RCS_HOST_PRESS
+static uint64_t     S_uPressNs = 0, S_uPressEndNs = 0;
+static FILE        *S_fTrace = NULL;
+// pwm
+static bool         S_bPwmEnabled[HAL_HOST_PWM_N];
+static uint16_t     S_uPwmLevel[HAL_HOST_PWM_N];
+static bool         S_bPwmOn[HAL_HOST_PWM_N];  // last traced
+// alarms
+typedef struct {
+  hal_timer_t    timer;
+  hal_alarm_cb_t cb;
+  void          *pUser;
+  bool           bUsed;
+} hal_host_alarm_t;
+static hal_host_alarm_t S_Alarms[HAL_HOST_ALARMS];
+// pio burst
+static hal_timer_t  S_BurstTimer;
+static uint         S_uBurstGp = 0;
+static uint32_t     S_uBurstDivQ8 = 0;
+static uint64_t     S_uBurstStartNs;
+static uint32_t     S_uBurstWords[BURST_WORDS_MAX]; // pattern, copied at fire (the dma reads it)
+static uint         S_uBurstSteps = 0;     // pin updates in the burst (2 per half cycle)
+static uint         S_uBurstStep = 0;      // next update
+static const char  *S_sInput = NULL;       // RCS_HOST_INPUT; next char
+// echo emulation; RCS_HOST_ECHO
+typedef struct {
+  uint64_t uStartNs;                 // first pio edge
+  uint32_t uWords[BURST_WORDS_MAX];
+  uint     uCycles;                  // to the last non-idle cycle
+  uint32_t uCarrierHz;
+} hal_host_echo_t;
+static uint32_t     S_uEchoUs[HAL_HOST_ECHO_TAPS];
+static int32_t      S_iEchoCounts[HAL_HOST_ECHO_TAPS];
+static uint         S_uEchoTaps = 0;
+static hal_host_echo_t S_Echo[HAL_HOST_ECHO_BURSTS];
+static uint         S_uEchoBursts = 0;     // fired; slot uEchoBursts % HAL_HOST_ECHO_BURSTS next
+// flash
+static uint8_t     *S_pFlash = NULL;       // image; erased (0xff) until first use
+static const char  *S_sFlash = NULL;       // RCS_HOST_FLASH
+// statistics
+static uint64_t     S_uCallbacks = 0;
+static uint64_t     S_uCallbackNsSum = 0;
+static uint64_t     S_uCallbackNsMax = 0;
+static uint64_t     S_uAdcReads = 0;
+static uint64_t     S_uRising[HAL_HOST_GPIO_N];
+
+__attribute__((constructor)) static void hal_host_init(void) {
+  // read the environment once, before main()
+  const char *s;
+  if ((s = getenv("RCS_HOST_ADC_HZ"))) S_uAdcHz = strtoull(s, NULL, 10);
+  if ((s = getenv("RCS_HOST_RUN_MS"))) S_uEndNs = strtoull(s, NULL, 10) * 1000000;
+  if ((s = getenv("RCS_HOST_ADC"))) {
+    S_uAdcLen = dat_load(s, &S_pAdc);
+    if (!S_uAdcLen) exit(2);
+    uint64_t uStreamNs = (uint64_t)S_uAdcLen * 1000000000 / S_uAdcHz;
+    if (uStreamNs < S_uEndNs) S_uEndNs = uStreamNs;
+  }
+  if ((s = getenv("RCS_HOST_PRESS"))) {
+    unsigned uGp, uAt, uLen;
+    if (sscanf(s, "%u,%u,%u", &uGp, &uAt, &uLen) == 3 && uGp < HAL_HOST_GPIO_N) {
+      S_iPressGp = uGp;
+      S_uPressNs = (uint64_t)uAt * 1000000;
+      S_uPressEndNs = S_uPressNs + (uint64_t)uLen * 1000000;
+    }
+  }
+  if ((s = getenv("RCS_HOST_ECHO"))) {
+    unsigned uUs;
+    int iCounts, iLen;
+    while (S_uEchoTaps < HAL_HOST_ECHO_TAPS && sscanf(s, "%u:%d%n", &uUs, &iCounts, &iLen) == 2) {
+      S_uEchoUs[S_uEchoTaps] = uUs;
+      S_iEchoCounts[S_uEchoTaps++] = iCounts;
+      s += iLen;
+      if (*s++ != ',') break;
+    }
+  }
+  if ((s = getenv("RCS_HOST_GPIO_TRACE"))) S_fTrace = fopen(s, "w");
+  S_sInput = getenv("RCS_HOST_INPUT");
+  S_sFlash = getenv("RCS_HOST_FLASH");
+  // "1st 8 gpio boot 50K pull up, remainder pull down"
+  for (uint i = 0; i < HAL_HOST_GPIO_N; i++) S_bPullUp[i] = (i < 8);
+} // end static void hal_host_init(void)
+
+static bool hal_host_core1(void) {
+  return S_bMulticore && pthread_equal(pthread_self(), S_Core1);
+}
+
+static void hal_host_exit(void) {
+  // end of virtual run; summary on stderr keeps stdout for firmware output
+  if (hal_host_core1()) { // hand the exit to core 0; park
+    pthread_mutex_lock(&S_Lock);
+    S_bEnded = true;
+    pthread_cond_broadcast(&S_Cond);
+    pthread_mutex_unlock(&S_Lock);
+    for (;;) pause();
+  }
+  fflush(stdout);
+  fprintf(stderr, "# hal host summary\n");
+  fprintf(stderr, "virtual_ms\t%.3f\n", S_uNowNs / 1e6);
+  fprintf(stderr, "adc_reads\t%" PRIu64 "\n", S_uAdcReads);
+  fprintf(stderr, "timer_callbacks\t%" PRIu64 "\n", S_uCallbacks);
+  if (S_uCallbacks) {
+    fprintf(stderr, "callback_us_mean\t%.1f\n", S_uCallbackNsSum / 1e3 / S_uCallbacks);
+    fprintf(stderr, "callback_us_max\t%.1f\n", S_uCallbackNsMax / 1e3);
+  }
+  if (S_uNowNs) { // awake share of the run per core, and of the adc; permille
+    for (uint c = 0; c < 2; c++) {
+      if (c == 1 && !S_bMulticore) break;
+      uint64_t uSleepNs = S_uSleepNs[c] - (S_uSleepEndNs[c] > S_uNowNs ? S_uSleepEndNs[c] - S_uNowNs : 0);
+      fprintf(stderr, "core%u_sleep_ms\t%.3f\n", c, uSleepNs / 1e6);
+      fprintf(stderr, "core%u_awake_permille\t%.1f\n", c, 1000.0 * (S_uNowNs - uSleepNs) / S_uNowNs);
+    }
+    if (S_bAdcPowered) {
+      uint64_t uOnNs = S_uAdcOnNs + (S_bAdcOn ? S_uNowNs - S_uAdcOnSinceNs : 0);
+      fprintf(stderr, "adc_on_ms\t%.3f\n", uOnNs / 1e6);
+      fprintf(stderr, "adc_on_permille\t%.1f\n", 1000.0 * uOnNs / S_uNowNs);
+    }
+  }
+  for (uint i = 0; i < HAL_HOST_GPIO_N; i++) {
+    if (S_uRising[i]) fprintf(stderr, "gp%u_rising\t%" PRIu64 "\n", i, S_uRising[i]);
+  }
+  if (S_fTrace) fclose(S_fTrace);
+  exit(0);
+} // end static void hal_host_exit(void)
+
+static uint64_t hal_host_next_due(void) {
+  uint64_t uDue = UINT64_MAX;
+  for (hal_timer_t *p = S_pTimers; p; p = p->pNext) {
+    if (p->uNextNs < uDue) uDue = p->uNextNs;
+  }
+  return uDue;
+}
+
+static void hal_host_link(hal_timer_t *pTimer) {
+  pTimer->pNext = S_pTimers;
+  S_pTimers = pTimer;
+}
+
+static void hal_host_unlink(hal_timer_t *pTimer) {
+  for (hal_timer_t **pp = &S_pTimers; *pp; pp = &(*pp)->pNext) {
+    if (*pp == pTimer) {
+      *pp = pTimer->pNext;
+      return;
+    }
+  }
+}
+
+static void hal_host_fire(void) {
+  // run due timer callbacks; like the timer irq, a callback never preempts another
+  if (S_bInCallback) return;
+  hal_timer_t **pp = &S_pTimers;
+  while (*pp) {
+    hal_timer_t *p = *pp;
+    if (p->uNextNs > S_uNowNs) {
+      pp = &p->pNext;
+      continue;
+    }
+    uint64_t uStartNs = S_uNowNs;
+    S_bInCallback = true;
+    bool bRepeat = p->cb(p);
+    S_bInCallback = false;
+    uint64_t uNs = S_uNowNs - uStartNs;
+    if (!p->bHw) {
+      S_uCallbacks++;
+      S_uCallbackNsSum += uNs;
+      if (uNs > S_uCallbackNsMax) S_uCallbackNsMax = uNs;
+    }
+    if (!bRepeat) {
+      hal_host_unlink(p); // the callback may have linked new timers (alarms) ahead of it
+    } else if (p->iPeriodUs < 0) {
+      p->uNextNs += (uint64_t)(-p->iPeriodUs) * 1000;          // start to start
+    } else if (p->iPeriodUs > 0) {
+      p->uNextNs = S_uNowNs + (uint64_t)p->iPeriodUs * 1000;   // end to start
+    }
+    pp = &S_pTimers; // rescan; the callback may have overrun further deadlines
+  } // end while (*pp)
+} // end static void hal_host_fire(void)
+
+uint64_t hal_host_time_ns(void) {
+  if (!S_bMulticore) return S_uNowNs;
+  pthread_mutex_lock(&S_Lock);
+  uint64_t uNs = S_uNowNs;
+  pthread_mutex_unlock(&S_Lock);
+  return uNs;
+}
+
+static void hal_host_wait_until(uint64_t uTargetNs) {
+  // core 0 with core 1 running: wait for core 1 to move the clock to uTargetNs
+  pthread_mutex_lock(&S_Lock);
+  S_uCore0WaitNs = uTargetNs;
+  pthread_cond_broadcast(&S_Cond);
+  while (S_uNowNs < uTargetNs && !S_bEnded) pthread_cond_wait(&S_Cond, &S_Lock);
+  S_uCore0WaitNs = UINT64_MAX;
+  bool bEnded = S_bEnded;
+  pthread_mutex_unlock(&S_Lock);
+  if (bEnded) hal_host_exit();
+}
+
+void hal_host_tick(uint32_t uNs) {
+  // advance the virtual clock, then service due timers
+  if (S_bMulticore) {
+    if (!hal_host_core1()) {
+      hal_host_wait_until(hal_host_time_ns() + uNs);
+      return;
+    }
+    pthread_mutex_lock(&S_Lock);
+    S_uNowNs += uNs;
+    pthread_cond_broadcast(&S_Cond);
+    pthread_mutex_unlock(&S_Lock);
+  } else {
+    S_uNowNs += uNs;
+  }
+  if (S_uNowNs >= S_uEndNs) hal_host_exit();
+  hal_host_fire();
+}
+
+static void hal_host_advance_to(uint64_t uTargetNs) {
+  // advance in steps that land exactly on timer deadlines
+  if (S_bMulticore && !hal_host_core1()) {
+    hal_host_wait_until(uTargetNs);
+    return;
+  }
+  while (S_uNowNs < uTargetNs) {
+    uint64_t uDue = S_bInCallback ? UINT64_MAX : hal_host_next_due();
+    uint64_t uStep = ((uDue > S_uNowNs && uDue < uTargetNs) ? uDue : uTargetNs) - S_uNowNs;
+    hal_host_tick(uStep > UINT32_MAX ? UINT32_MAX : (uint32_t)uStep);
+  }
+}
+
+static int32_t hal_host_echo_sign(const hal_host_echo_t *pB, uint uCycle) {
+  // +1 phase a first, -1 phase b first (coded chip), 0 idle padding
+  uint32_t u = (pB->uWords[uCycle / BURST_WORD_CYCLES] >> (2 * BURST_HALF_BITS * (uCycle % BURST_WORD_CYCLES))) & 0xf;
+  return u ? ((u == 0x6) ? -1 : 1) : 0;
+}
+
+static int32_t hal_host_echo_at(uint64_t uNs) {
+  // RCS_HOST_ECHO taps of the recent bursts at virtual time uNs, adc counts; each cycle of the burst
+  // at its sign, then the last one rings down
+  static const int16_t iSin[16] = { 0, 392, 724, 946, 1024, 946, 724, 392, 0, -392, -724, -946, -1024, -946, -724, -392 };
+  int32_t iSum = 0;
+  uint uBursts = S_uEchoBursts < HAL_HOST_ECHO_BURSTS ? S_uEchoBursts : HAL_HOST_ECHO_BURSTS;
+  for (uint b = 0; b < uBursts; b++) {
+    const hal_host_echo_t *pB = &S_Echo[b];
+    uint64_t uBurstNs = (uint64_t)pB->uCycles * 1000000000 / pB->uCarrierHz;
+    uint64_t uRingNs = (uint64_t)HAL_HOST_ECHO_RING_US * 1000;
+    for (uint t = 0; t < S_uEchoTaps; t++) {
+      uint64_t uAtNs = pB->uStartNs + (uint64_t)S_uEchoUs[t] * 1000;
+      if (uNs < uAtNs || uNs - uAtNs >= uBurstNs + uRingNs) continue;
+      uint64_t uDtNs = uNs - uAtNs;
+      uint64_t uPhase = uDtNs * pB->uCarrierHz * 16 / 1000000000; // 16ths of a cycle
+      int64_t iAmp;
+      if (uPhase / 16 < pB->uCycles) {
+        iAmp = S_iEchoCounts[t] * hal_host_echo_sign(pB, uPhase / 16);
+      } else {
+        iAmp = S_iEchoCounts[t] * hal_host_echo_sign(pB, pB->uCycles - 1);
+        iAmp = iAmp * (int64_t)(uBurstNs + uRingNs - uDtNs) / (int64_t)uRingNs;
+      }
+      iSum += (int32_t)(iAmp * iSin[uPhase & 15] / 1024);
+    }
+  }
+  return iSum;
+} // end static int32_t hal_host_echo_at(...)
+
+uint16_t hal_host_adc_at(uint64_t uNs) {
+  // stream sample at virtual time uNs, plus the RCS_HOST_ECHO taps
+  int32_t iSample = HAL_HOST_ADC_IDLE;
+  if (S_uAdcLen) {
+    uint64_t uIdx = uNs * S_uAdcHz / 1000000000;
+    if (uIdx >= S_uAdcLen) hal_host_exit();
+    iSample = S_pAdc[uIdx];
+  }
+  if (!S_uEchoTaps) return iSample;
+  iSample += hal_host_echo_at(uNs);
+  return iSample < 0 ? 0 : iSample > 4095 ? 4095 : iSample;
+}
+
+// time
+uint64_t hal_time_us(void) {
+  if (S_bMulticore && !hal_host_core1()) return hal_host_time_ns() / 1000; // core 0 reads only
+  hal_host_tick(HAL_HOST_POLL_NS);
+  return S_uNowNs / 1000;
+}
+void hal_busy_wait_us(uint32_t uUs) { hal_host_advance_to(hal_host_time_ns() + (uint64_t)uUs * 1000); }
+void hal_busy_wait_ms(uint32_t uMs) { hal_host_advance_to(hal_host_time_ns() + (uint64_t)uMs * 1000000); }
+static void hal_host_sleep_to(uint64_t uTargetNs) {
+  // a low power wait; counted against the calling core
+  uint64_t uFromNs = hal_host_time_ns();
+  if (uTargetNs <= uFromNs) return;
+  S_uSleepNs[hal_host_core1()] += uTargetNs - uFromNs;
+  S_uSleepEndNs[hal_host_core1()] = uTargetNs; // the run may end first
+  if (!S_bMulticore || !hal_host_core1()) {
+    hal_host_advance_to(uTargetNs);
+    return;
+  }
+  while (hal_host_time_ns() < uTargetNs) {
+    // core 1: wait for core 0 to block on a deadline past now, then step to it. a core 0 spinning on
+    // core 1 without waiting is let go after HAL_HOST_YIELD_MS of real time
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    ts.tv_nsec += HAL_HOST_YIELD_MS * 1000000L;
+    ts.tv_sec += ts.tv_nsec / 1000000000L;
+    ts.tv_nsec %= 1000000000L;
+    pthread_mutex_lock(&S_Lock);
+    while ((S_uCore0WaitNs == UINT64_MAX || S_uCore0WaitNs <= S_uNowNs) && !S_bEnded) {
+      if (pthread_cond_timedwait(&S_Cond, &S_Lock, &ts)) break;
+    }
+    uint64_t uStepNs = S_uCore0WaitNs > S_uNowNs && S_uCore0WaitNs < uTargetNs ? S_uCore0WaitNs : uTargetNs;
+    pthread_mutex_unlock(&S_Lock);
+    hal_host_advance_to(uStepNs);
+  }
+} // end static void hal_host_sleep_to(...)
+void hal_sleep_ms(uint32_t uMs) { hal_host_sleep_to(hal_host_time_ns() + (uint64_t)uMs * 1000000); }
+void hal_sleep_until_us(uint64_t uUs) { hal_host_sleep_to(uUs * 1000); }
+
+void hal_host_adc_power(bool bOn) {
+  uint64_t uNs = hal_host_time_ns();
+  S_bAdcPowered = true;
+  if (bOn == S_bAdcOn) return;
+  if (bOn) S_uAdcOnSinceNs = uNs;
+  else S_uAdcOnNs += uNs - S_uAdcOnSinceNs;
+  S_bAdcOn = bOn;
+}
+
+// gpio
+void hal_gpio_init(uint gp) {
+  S_bOut[gp] = false;
+  S_bValue[gp] = false;
+}
+void hal_gpio_set_dir(uint gp, bool bOut) { S_bOut[gp] = bOut; }
+static void hal_host_gpio_put_at(uint gp, bool bValue, uint64_t uNs) {
+  if (S_bValue[gp] == bValue) return;
+  S_bValue[gp] = bValue;
+  if (bValue) S_uRising[gp]++;
+  if (S_fTrace) fprintf(S_fTrace, "%" PRIu64 " %u %d\n", uNs, gp, bValue);
+}
+void hal_gpio_put(uint gp, bool bValue) { hal_host_gpio_put_at(gp, bValue, S_uNowNs); }
+bool hal_gpio_get(uint gp) {
+  if ((int)gp == S_iPressGp && S_uNowNs >= S_uPressNs && S_uNowNs < S_uPressEndNs) return false;
+  if (S_bOut[gp]) return S_bValue[gp];
+  return S_bPullUp[gp];
+}
+void hal_gpio_put_masked(uint32_t uMask, uint32_t uValue) {
+  for (uint i = 0; i < HAL_HOST_GPIO_N; i++) {
+    if (uMask & (1u << i)) hal_gpio_put(i, (uValue >> i) & 1);
+  }
+}
+void hal_gpio_pull_up(uint gp) { S_bPullUp[gp] = true; }
+void hal_gpio_pull_down(uint gp) { S_bPullUp[gp] = false; }
+
+// adc
+void hal_adc_init(void) {}
+void hal_adc_gpio_init(uint gp) { (void)gp; }
+void hal_adc_select_input(uint uInput) { (void)uInput; }
+uint16_t hal_adc_read(void) {
+  hal_host_tick(HAL_HOST_ADC_NS);
+  S_uAdcReads++;
+  return hal_host_adc_at(S_uNowNs);
+}
+
+// pwm; switching on/off is traced as gpio HAL_PWM_GPIO_BASE + slice
+uint hal_pwm_init(uint gp, float fClkDiv, uint16_t uWrap, uint16_t uChanLevel) {
+  (void)fClkDiv;
+  (void)uWrap;
+  uint uSliceNum = (gp >> 1) & 7;
+  S_uPwmLevel[uSliceNum] = uChanLevel;
+  return uSliceNum;
+}
+static void hal_host_pwm_trace(uint uSliceNum) {
+  // traced value: output switching (enabled, level > 0); level 0 holds the output low
+  bool bOn = S_bPwmEnabled[uSliceNum] && S_uPwmLevel[uSliceNum] > 0;
+  if (S_fTrace && bOn != S_bPwmOn[uSliceNum]) fprintf(S_fTrace, "%" PRIu64 " %u %d\n", S_uNowNs, HAL_PWM_GPIO_BASE + uSliceNum, bOn);
+  S_bPwmOn[uSliceNum] = bOn;
+}
+void hal_pwm_set_enabled(uint uSliceNum, bool bEnabled) {
+  S_bPwmEnabled[uSliceNum] = bEnabled;
+  hal_host_pwm_trace(uSliceNum);
+}
+void hal_pwm_set_level(uint uSliceNum, uint16_t uLevel) {
+  S_uPwmLevel[uSliceNum] = uLevel;
+  hal_host_pwm_trace(uSliceNum);
+}
+
+// repeating timer
+bool hal_add_repeating_timer_ms(int32_t iMs, hal_timer_cb_t cb, void *pUser, hal_timer_t *pTimer) {
+  pTimer->iPeriodUs = (int64_t)iMs * 1000;
+  pTimer->uNextNs = S_uNowNs + (uint64_t)(iMs < 0 ? -iMs : iMs) * 1000000;
+  pTimer->cb = cb;
+  pTimer->pUser = pUser;
+  pTimer->bHw = false;
+  hal_host_link(pTimer);
+  return true;
+}
+void hal_timer_set_period_ms(hal_timer_t *pTimer, int32_t iMs) { pTimer->iPeriodUs = (int64_t)iMs * 1000; }
+
+// one-shot alarm; a fixed pool, the callback's return value (pico: reschedule) is ignored
+static bool hal_host_alarm_fire(hal_timer_t *pTimer) {
+  hal_host_alarm_t *pA = pTimer->pUser;
+  pA->cb((int32_t)(pA - S_Alarms) + 1, pA->pUser);
+  pA->bUsed = false; // after the callback, which may add alarms of its own
+  return false;
+}
+bool hal_add_alarm_in_us(uint32_t uUs, hal_alarm_cb_t cb, void *pUser) {
+  for (uint i = 0; i < HAL_HOST_ALARMS; i++) {
+    hal_host_alarm_t *pA = &S_Alarms[i];
+    if (pA->bUsed) continue;
+    pA->bUsed = true;
+    pA->cb = cb;
+    pA->pUser = pUser;
+    pA->timer.iPeriodUs = 0;
+    pA->timer.uNextNs = S_uNowNs + (uint64_t)uUs * 1000;
+    pA->timer.cb = hal_host_alarm_fire;
+    pA->timer.pUser = pA;
+    pA->timer.bHw = false;
+    hal_host_link(&pA->timer);
+    return true;
+  }
+  return false;
+}
+
+// transmit burst; pio emulation. half cycle h sets its pattern at slot 8h (out pins) and clears
+// it at 8h+7 (set pins, 0) (rcs-burst-01.pio); step 2h+0/1. unchanged pins are not traced.
+static uint64_t hal_host_burst_step_ns(uint uStep) {
+  uint64_t uSlots = HAL_HOST_PIO_START + (uint64_t)(uStep / 2) * (BURST_SLOTS / 2) + (uStep & 1) * BURST_SLOTS_HIGH;
+  return S_uBurstStartNs + burst_slot_ns(HAL_HOST_SYS_HZ, S_uBurstDivQ8, uSlots);
+}
+static bool hal_host_burst_step(hal_timer_t *pTimer) {
+  // one pin update per call, traced at its pio time (a poll tick may step past it); the timer
+  // reschedules itself (iPeriodUs 0)
+  uint uStep = S_uBurstStep++;
+  uint uHalf = uStep / 2;
+  uint32_t uPins = (uStep & 1) ? 0 : (S_uBurstWords[uHalf / (32 / BURST_HALF_BITS)] >> (BURST_HALF_BITS * (uHalf % (32 / BURST_HALF_BITS)))) & 3;
+  hal_host_gpio_put_at(S_uBurstGp, uPins & 1, pTimer->uNextNs);
+  hal_host_gpio_put_at(S_uBurstGp + 1, (uPins >> 1) & 1, pTimer->uNextNs);
+  if (S_uBurstStep == S_uBurstSteps) return false;
+  pTimer->uNextNs = hal_host_burst_step_ns(S_uBurstStep);
+  return true;
+}
+bool hal_burst_init(uint gpBase, uint32_t uCarrierHz) {
+  S_uBurstGp = gpBase;
+  S_uBurstDivQ8 = burst_clkdiv_q8(HAL_HOST_SYS_HZ, uCarrierHz);
+  for (uint gp = gpBase; gp < gpBase + 2; gp++) {
+    hal_gpio_init(gp);
+    hal_gpio_set_dir(gp, HAL_GPIO_OUT);
+  }
+  return true;
+}
+void hal_burst_set_carrier(uint32_t uCarrierHz) { S_uBurstDivQ8 = burst_clkdiv_q8(HAL_HOST_SYS_HZ, uCarrierHz); }
+void hal_burst_fire(const uint32_t *pWords, uint uWords) {
+  // a burst already running is not queued behind (the firmware never overlaps them); dropped
+  if (S_uBurstStep < S_uBurstSteps || uWords == 0 || uWords > BURST_WORDS_MAX) return;
+  memcpy(S_uBurstWords, pWords, uWords * sizeof(uint32_t));
+  S_uBurstStartNs = S_uNowNs;
+  S_uBurstSteps = 2 * (32 / BURST_HALF_BITS) * uWords;
+  S_uBurstStep = 0;
+  S_BurstTimer.iPeriodUs = 0;
+  S_BurstTimer.uNextNs = hal_host_burst_step_ns(0);
+  S_BurstTimer.cb = hal_host_burst_step;
+  S_BurstTimer.pUser = NULL;
+  S_BurstTimer.bHw = true;
+  hal_host_link(&S_BurstTimer);
+  hal_host_echo_t *pB = &S_Echo[S_uEchoBursts++ % HAL_HOST_ECHO_BURSTS];
+  pB->uStartNs = hal_host_burst_step_ns(0);
+  memcpy(pB->uWords, pWords, uWords * sizeof(uint32_t));
+  pB->uCycles = uWords * BURST_WORD_CYCLES;
+  while (pB->uCycles > 1 && !hal_host_echo_sign(pB, pB->uCycles - 1)) pB->uCycles--; // padding
+  pB->uCarrierHz = (uint32_t)(((uint64_t)HAL_HOST_SYS_HZ << 8) / ((uint64_t)S_uBurstDivQ8 * BURST_SLOTS));
+}
+
+// multicore
+static void *hal_host_core1_entry(void *pEntry) {
+  ((void (*)(void))pEntry)();
+  return NULL;
+}
+
+void hal_multicore_launch_core1(void (*fnEntry)(void)) {
+  S_bMulticore = true;
+  pthread_create(&S_Core1, NULL, hal_host_core1_entry, (void *)fnEntry);
+}
+
+// flash; erase sets bits, program can only clear them, as on the chip
+static uint8_t *hal_host_flash(void) {
+  if (!S_pFlash) {
+    S_pFlash = malloc(HAL_FLASH_SIZE);
+    memset(S_pFlash, 0xff, HAL_FLASH_SIZE);
+    FILE *f = S_sFlash ? fopen(S_sFlash, "rb") : NULL;
+    if (f) {
+      if (fread(S_pFlash, 1, HAL_FLASH_SIZE, f) != HAL_FLASH_SIZE) memset(S_pFlash, 0xff, HAL_FLASH_SIZE);
+      fclose(f);
+    }
+  }
+  return S_pFlash;
+}
+static void hal_host_flash_sync(void) {
+  FILE *f = S_sFlash ? fopen(S_sFlash, "wb") : NULL;
+  if (!f) return;
+  fwrite(S_pFlash, 1, HAL_FLASH_SIZE, f);
+  fclose(f);
+}
+void hal_flash_core_init(void) {}
+void hal_flash_read(uint32_t uOffset, void *p, uint uN) {
+  if (uOffset + uN <= HAL_FLASH_SIZE) memcpy(p, hal_host_flash() + uOffset, uN);
+}
+bool hal_flash_erase(uint32_t uOffset) {
+  if (uOffset % HAL_FLASH_SECTOR || uOffset >= HAL_FLASH_SIZE) return false;
+  memset(hal_host_flash() + uOffset, 0xff, HAL_FLASH_SECTOR);
+  hal_host_flash_sync();
+  return true;
+}
+bool hal_flash_program(uint32_t uOffset, const void *p, uint uN) {
+  if (uOffset % HAL_FLASH_PAGE || uN % HAL_FLASH_PAGE || uOffset + uN > HAL_FLASH_SIZE) return false;
+  uint8_t *pF = hal_host_flash() + uOffset;
+  for (uint i = 0; i < uN; i++) pF[i] &= ((const uint8_t *)p)[i];
+  hal_host_flash_sync();
+  return true;
+}
+
+// stdio
+void hal_stdio_init(void) {}
+bool hal_usb_connected(void) { return true; }
+int hal_getchar_timeout_us(uint32_t uUs) {
+  if (S_sInput && *S_sInput == '{') { // '{<ms>}' holds the rest of the input until virtual time ms
+    char *pEnd;
+    uint64_t uAtNs = strtoull(S_sInput + 1, &pEnd, 10) * 1000000;
+    if (S_uNowNs >= uAtNs) S_sInput = (*pEnd == '}') ? pEnd + 1 : pEnd;
+  }
+  if (S_sInput && *S_sInput && *S_sInput != '{') return (unsigned char)*S_sInput++;
+  hal_host_tick(uUs ? uUs * 1000 : HAL_HOST_POLL_NS);
+  return HAL_NO_CHAR;
+}
+void hal_stdio_write(const void *p, uint uN) {
+  fwrite(p, 1, uN, stdout);
+  fflush(stdout);
+}
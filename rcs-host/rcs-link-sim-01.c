@@ -0,0 +1,431 @@
+// @file rcs-link-sim-01.c
+// @date 2026.10.17
+// @info tx -> rx link simulator over the acoustic channel model (rcs-chansim-01); seeded, so a scenario
+// @info is a command line and reruns bit for bit
+// @info stream (-o): -T seconds of receiver adc input to a .dat (ascii volts; RCS_HOST_ADC for
+// @info rcs-rx04-03-host, which is sent the period with 'p<ms>') or a .rcb (rcs-analyze-01), with the
+// @info ground truth per ping as tsv on stdout
+// @info stress (no -o): -N pings through the receiver's detection, ADAPTIVE_THRESHOLD with MATCHED_FILTER
+// @info as in rcs-rx04-03: the cfar estimator is warmed over the lead-in, then fed a LINK_LEAD quiet lead
+// @info before each window (the low power receiver's wake lead) and the window block by block; the matched
+// @info filter runs on each block, the first pulse ends the window. windows are [emission - WINDOW_PRE_US,
+// @info + WINDOW_RANGE_US) from the true emission (ideal sync; window placement is rcs-drift-sim-01's and
+// @info rcs-rate-bench-01's), and only lead and window are rendered. the range bias is taken once from a
+// @info noiseless ping at CAL_FT, as the receiver's reference. ok: |error| <= LINK_OK_MM with the true speed
+// @info of sound; disp_bias_mm is the mean error of the receiver's fixed 1125ft/s (temperature). per row:
+// @info detection counts, errors, and ns per sample of rendering and of detection, stream seconds per
+// @info wall second (x_realtime). -S sweeps one parameter, a row per value, each from the same seed
+// @info parameters: -x name=value, any number; 'path=extra_m:gain' adds a reflector; -x help lists them
+// @info -k N,...: multi-ping stacking as rcs-rx04-03 STACK (../rcs-common/rcs-stack-01.*), a table per N
+// @info (N 1 unstacked); the detector runs on the stack and every window is scanned to its end. the first
+// @info STACK_WARM * N pings of a run build up the stack and are not scored. with a sweep, '# reach'
+// @info per N is the last value before the first under LINK_REACH_OK ok_rate: range against N over dist_m.
+// @info past_window counts sent pings whose burst ends after the window (WINDOW_RANGE_US, (* 20e-3 343)
+// @info 6.9m); they are missed at any N, and a reach they end is marked 'window', not 'signal'
+
+// @usage ./rcs-link-sim-01 [-N pings] [-s seed] [-x name=value ...] [-S name=v1,v2,...]
+// @usage ./rcs-link-sim-01 -T seconds -o stream.dat|stream.rcb [-s seed] [-x name=value ...]
+// @usage e.g. range: -S dist_m=1,2,4,6,8,10; heat: -x temp_swing_c=15 -x temp_period_s=600 -N 6000
+// @usage range against stacking (a pulse whose knee falls inside the window; the default 212 counts reaches
+// @usage the window end from N 2): -k 1,2,4,8,16 -x amp_counts=80 -x dist_max_m=20
+// @usage                          -S dist_m=1,1.5,2,2.5,3,3.5,4,4.5,5,5.5,6,6.5,7
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include <time.h>
+#include <math.h>
+#include <inttypes.h> // printf("%" PRIu64/d64/x64 "\n", t)
+#include "rcs-chansim-01.h"
+#include "rcs-dat-01.h"     // DAT_ADC_CF
+#include "rcs-archive-01.h" // .rcb header
+#include "../rcs-common/rcs-capture-01.h" // CAPTURE_BLOCK_LEN
+#include "../rcs-common/rcs-detect-01.h"
+#include "../rcs-common/rcs-cfar-01.h"
+#include "../rcs-common/rcs-stack-01.h"
+
+#define LINK_WINDOW_PRE_US   1500   // rcs-rx04-03 WINDOW_PRE_US
+#define LINK_WINDOW_RANGE_US 20000  // rcs-rx04-03 WINDOW_RANGE_US
+#define LINK_LEAD            512    // quiet samples before a window; rcs-rx04-03 DUTY_WAKE_US at 500ksps
+#define LINK_CAL_M           0.3048 // rcs-rx04-03 CAL_FT
+#define LINK_DISP_MPS        342.9  // (* 1125 0.3048) receiver distance conversion
+#define LINK_OK_MM           100    // (/ 100 0.3429) ~290us; rcs-rate-bench-01 BENCH_OK_US
+#define LINK_STREAM_BLOCK    65536
+#define LINK_VALUES_MAX      32
+#define LINK_REACH_OK        0.9    // ok_rate of a swept value within reach
+
+typedef struct {
+  const char *sName;
+  size_t      uOff;
+  char        cType; // d double, u uint, U uint32, L uint64, h uint16
+} link_param_t;
+
+#define LINK_P(name, field, type) { name, offsetof(chansim_config_t, field), type }
+static const link_param_t S_Params[] = {
+  LINK_P("seed", uSeed, 'L'),             LINK_P("rate_hz", uSampleHz, 'U'),
+  LINK_P("start_s", fStartS, 'd'),        LINK_P("period_ms", fPeriodMs, 'd'),
+  LINK_P("code", uCode, 'u'),             LINK_P("q", fQ, 'd'),
+  LINK_P("dist_m", fDistM, 'd'),          LINK_P("hold_s", fHoldS, 'd'),
+  LINK_P("dist_min_m", fDistMinM, 'd'),   LINK_P("dist_max_m", fDistMaxM, 'd'),
+  LINK_P("speed_mps", fSpeedMps, 'd'),    LINK_P("height_m", fHeightM, 'd'),
+  LINK_P("ground_gain", fGroundGain, 'd'), LINK_P("temp_c", fTempC, 'd'),
+  LINK_P("temp_swing_c", fTempSwingC, 'd'), LINK_P("temp_period_s", fTempPeriodS, 'd'),
+  LINK_P("absorb_db_per_m", fAbsorbDbPerM, 'd'), LINK_P("amp_counts", fAmpCounts, 'd'),
+  LINK_P("noise_counts", fNoiseCounts, 'd'), LINK_P("ambient_counts", fAmbientCounts, 'd'),
+  LINK_P("ambient_bw_hz", fAmbientBwHz, 'd'), LINK_P("drop", fDropProb, 'd'),
+  LINK_P("tx_ppm", fTxPpm, 'd'),          LINK_P("rx_ppm", fRxPpm, 'd'),
+  LINK_P("tx_ppm_per_c", fTxPpmPerC, 'd'), LINK_P("ppm_walk", fPpmWalk, 'd'),
+  LINK_P("baseline", uBaseline, 'h'),
+};
+#define LINK_PARAMS (sizeof(S_Params) / sizeof(S_Params[0]))
+
+typedef struct {
+  uint64_t uPings, uSent, uFound, uOk, uWrong, uMissed, uFalse;
+  uint64_t uPast; // sent pings whose burst ends past the window; missed whatever the signal
+  double   fSqMm, fMaxMm, fDispSumMm, fAmpSum;
+  double   fRenderNs, fDetectNs, fStreamS;
+  uint64_t uSamples;
+} link_stats_t;
+
+static double now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static const link_param_t *param_find(const char *sName, size_t uLen) {
+  for (uint i = 0; i < LINK_PARAMS; i++) {
+    if (strlen(S_Params[i].sName) == uLen && strncmp(S_Params[i].sName, sName, uLen) == 0) return &S_Params[i];
+  }
+  return NULL;
+}
+
+static void param_set(chansim_config_t *pCfg, const link_param_t *pP, double fV) {
+  void *p = (char *)pCfg + pP->uOff;
+  switch (pP->cType) {
+    case 'd': *(double *)p = fV; break;
+    case 'u': *(uint *)p = (uint)fV; break;
+    case 'U': *(uint32_t *)p = (uint32_t)fV; break;
+    case 'L': *(uint64_t *)p = (uint64_t)fV; break;
+    case 'h': *(uint16_t *)p = (uint16_t)fV; break;
+  }
+}
+
+static bool param_assign(chansim_config_t *pCfg, const char *sArg) {
+  // 'name=value', or 'path=extra_m:gain'
+  const char *sEq = strchr(sArg, '=');
+  if (!sEq) return false;
+  if (strncmp(sArg, "path=", 5) == 0) {
+    double fExtra, fGain;
+    if (sscanf(sEq + 1, "%lf:%lf", &fExtra, &fGain) != 2 || pCfg->uPaths == CHANSIM_PATHS_MAX) return false;
+    pCfg->paths[pCfg->uPaths].fExtraM = fExtra;
+    pCfg->paths[pCfg->uPaths++].fGain = fGain;
+    return true;
+  }
+  const link_param_t *pP = param_find(sArg, sEq - sArg);
+  if (!pP) return false;
+  param_set(pCfg, pP, atof(sEq + 1));
+  return true;
+}
+
+static void param_list(const chansim_config_t *pCfg) {
+  fprintf(stderr, "parameters (default):");
+  for (uint i = 0; i < LINK_PARAMS; i++) {
+    const void *p = (const char *)pCfg + S_Params[i].uOff;
+    double fV = S_Params[i].cType == 'd' ? *(const double *)p : S_Params[i].cType == 'u' ? *(const uint *)p :
+                S_Params[i].cType == 'U' ? *(const uint32_t *)p : S_Params[i].cType == 'L' ? *(const uint64_t *)p :
+                *(const uint16_t *)p;
+    fprintf(stderr, "%s %s=%g", i % 4 ? "" : "\n ", S_Params[i].sName, fV);
+  }
+  fprintf(stderr, "\n path=extra_m:gain (up to %d)\n", CHANSIM_PATHS_MAX);
+}
+
+static void cfar_warm(chansim_t *pSim, cfar_t *pCfar, uint64_t uTo, link_stats_t *pSt) {
+  // boot: the receiver's fixed levels, then the lead-in as the estimator sees it
+  uint16_t uBuf[CAPTURE_BLOCK_LEN];
+  cfar_init(pCfar, pSim->cfg.uBaseline, 5 * (pSim->cfg.fNoiseCounts > 2 ? pSim->cfg.fNoiseCounts : 2));
+  for (uint64_t u = 0; u + CAPTURE_BLOCK_LEN <= uTo; u += CAPTURE_BLOCK_LEN) {
+    double t0 = now_ns();
+    chansim_render(pSim, u, uBuf, CAPTURE_BLOCK_LEN);
+    double t1 = now_ns();
+    cfar_update(pCfar, uBuf, CAPTURE_BLOCK_LEN);
+    if (pSt) {
+      pSt->fRenderNs += t1 - t0;
+      pSt->fDetectNs += now_ns() - t1;
+      pSt->uSamples += CAPTURE_BLOCK_LEN;
+    }
+  }
+}
+
+static bool window_detect(chansim_t *pSim, cfar_t *pCfar, detect_t *pDet, stack_acc_t *pStack, uint64_t uLeadFrom,
+                          uint64_t uFrom, uint64_t uTo, detect_result_t *pRes, link_stats_t *pSt) {
+  // lead [uLeadFrom, uFrom) to the estimator, then the window: estimator, trigger, matched filter per block.
+  // pStack: the window into the stack to its end, the matched filter on the stacked blocks to the first pulse
+  uint16_t uBuf[CAPTURE_BLOCK_LEN], uStacked[CAPTURE_BLOCK_LEN];
+  bool bHit = false;
+  for (uint64_t u = uLeadFrom; u < uFrom; ) {
+    uint uN = uFrom - u < CAPTURE_BLOCK_LEN ? uFrom - u : CAPTURE_BLOCK_LEN;
+    double t0 = now_ns();
+    chansim_render(pSim, u, uBuf, uN);
+    double t1 = now_ns();
+    cfar_update(pCfar, uBuf, uN);
+    pSt->fRenderNs += t1 - t0;
+    pSt->fDetectNs += now_ns() - t1;
+    pSt->uSamples += uN;
+    u += uN;
+  }
+  detect_init(pDet, cfar_mean(pCfar), detect_mag_for_threshold(pDet, pCfar->uThreshold), uFrom);
+  if (pStack) stack_window(pStack, uFrom, cfar_mean(pCfar));
+  for (uint64_t u = uFrom; u < uTo; ) {
+    uint uN = uTo - u < CAPTURE_BLOCK_LEN ? uTo - u : CAPTURE_BLOCK_LEN;
+    double t0 = now_ns();
+    chansim_render(pSim, u, uBuf, uN);
+    double t1 = now_ns();
+    cfar_update(pCfar, uBuf, uN);
+    pDet->uMagTrigger = detect_mag_for_threshold(pDet, pCfar->uThreshold);
+    if (pStack) stack_add(pStack, u, uBuf, uStacked, uN);
+    if (!bHit) bHit = detect_run(pDet, pStack ? uStacked : uBuf, uN, pRes);
+    pSt->fRenderNs += t1 - t0;
+    pSt->fDetectNs += now_ns() - t1;
+    pSt->uSamples += uN;
+    if (bHit && !pStack) return true;
+    u += uN;
+  }
+  return bHit;
+} // end static bool window_detect(...)
+
+static double calibrate_us(const chansim_config_t *pCfg, detect_t *pDet) {
+  // reported flight less true flight of a noiseless single ping at LINK_CAL_M; the receiver's reference
+  chansim_config_t cal = *pCfg;
+  cal.fNoiseCounts = cal.fAmbientCounts = cal.fDropProb = 0;
+  cal.fDistM = LINK_CAL_M;
+  cal.fSpeedMps = cal.fTempSwingC = cal.fPpmWalk = 0;
+  chansim_t sim;
+  if (!chansim_init(&sim, &cal)) return 0;
+  chansim_ping_t ping;
+  chansim_ping(&sim, &ping);
+  cfar_t cfar;
+  link_stats_t st = { 0 };
+  detect_result_t res;
+  uint64_t uPre = (uint64_t)LINK_WINDOW_PRE_US * cal.uSampleHz / 1000000;
+  uint64_t uFrom = (uint64_t)ping.fTxIdx - uPre;
+  cfar_init(&cfar, cal.uBaseline, CFAR_FLOOR);
+  bool bHit = window_detect(&sim, &cfar, pDet, NULL, uFrom - LINK_LEAD, uFrom, uFrom + 2 * uPre, &res, &st);
+  chansim_free(&sim);
+  if (!bHit) return 0;
+  return ((double)res.iArrivalQ8 / (1 << DETECT_FRAC_BITS) - ping.fTxIdx) * 1e6 / cal.uSampleHz - ping.fFlightUs;
+}
+
+static bool run_stress(const chansim_config_t *pCfg, uint64_t uPings, uint uStackShift, link_stats_t *pSt) {
+  static stack_acc_t S_Stack;
+  chansim_t sim;
+  cfar_t cfar;
+  detect_t det;
+  memset(pSt, 0, sizeof(*pSt));
+  if (!chansim_init(&sim, pCfg)) return false;
+  detect_set_rate(&det, pCfg->uSampleHz, DETECT_CARRIER_HZ);
+  const double fBiasUs = calibrate_us(pCfg, &det);
+  const uint64_t uPre = (uint64_t)LINK_WINDOW_PRE_US * pCfg->uSampleHz / 1000000;
+  uint64_t uLen = uPre + (uint64_t)LINK_WINDOW_RANGE_US * pCfg->uSampleHz / 1000000;
+  uint64_t uPeriod = (uint64_t)(pCfg->fPeriodMs * 1e-3 * pCfg->uSampleHz);
+  if (uLen > uPeriod) uLen = uPeriod;
+  stack_acc_t *pStack = uStackShift ? &S_Stack : NULL;
+  if (pStack) stack_init(pStack, uStackShift, uLen);
+  const uint64_t uWarm = uStackShift ? (uint64_t)STACK_WARM << uStackShift : 0;
+  double t0 = now_ns();
+  cfar_warm(&sim, &cfar, (uint64_t)sim.next.fTxIdx - uPre, pSt);
+  uint64_t uLast = 0; // end of the last window
+  for (uint64_t p = 0; p < uPings; p++) {
+    chansim_ping_t ping;
+    chansim_ping(&sim, &ping);
+    uint64_t uFrom = (uint64_t)ping.fTxIdx > uPre ? (uint64_t)ping.fTxIdx - uPre : 0;
+    if (uFrom < uLast) uFrom = uLast;
+    uint64_t uLead = uFrom > uLast + LINK_LEAD ? uFrom - LINK_LEAD : uLast;
+    detect_result_t res;
+    bool bHit = window_detect(&sim, &cfar, &det, pStack, uLead, uFrom, uFrom + uLen, &res, pSt);
+    uLast = bHit && !pStack ? (uint64_t)(res.iArrivalQ8 >> DETECT_FRAC_BITS) : uFrom + uLen; // the rest is not fed
+    if (p < uWarm) continue;
+    pSt->uPings++;
+    pSt->uSent += ping.bSent;
+    pSt->fAmpSum += ping.fAmpCounts;
+    if (!ping.bSent) {
+      pSt->uFalse += bHit;
+      continue;
+    }
+    pSt->uPast += ping.fFlightUs + 1e6 * DETECT_BURST_CYCLES / DETECT_CARRIER_HZ > (double)(uLen - uPre) * 1e6 / pCfg->uSampleHz;
+    if (!bHit) {
+      pSt->uMissed++;
+      continue;
+    }
+    pSt->uFound++;
+    double fFlightUs = ((double)res.iArrivalQ8 / (1 << DETECT_FRAC_BITS) - ping.fTxIdx) * 1e6 / pCfg->uSampleHz - fBiasUs;
+    double fErrMm = (fFlightUs - ping.fFlightUs) * ping.fSoundMps * 1e-3;
+    if (fabs(fErrMm) > LINK_OK_MM) {
+      pSt->uWrong++;
+      continue;
+    }
+    pSt->uOk++;
+    pSt->fSqMm += fErrMm * fErrMm;
+    if (fabs(fErrMm) > pSt->fMaxMm) pSt->fMaxMm = fabs(fErrMm);
+    pSt->fDispSumMm += (fFlightUs * LINK_DISP_MPS * 1e-3) - ping.fDistM * 1e3;
+  } // end for (uint64_t p...)
+  pSt->fStreamS = (sim.next.fTxIdx) / pCfg->uSampleHz;
+  double fWallS = (now_ns() - t0) * 1e-9;
+  pSt->fStreamS = fWallS > 0 ? pSt->fStreamS / fWallS : 0; // x real time
+  chansim_free(&sim);
+  return true;
+} // end static bool run_stress(...)
+
+static void print_row(const char *sValue, const link_stats_t *pSt) {
+  double fSent = pSt->uSent ? pSt->uSent : 1;
+  printf("%s\t%" PRIu64 "\t%" PRIu64 "\t%.1f\t%.4f\t%.4f\t%.4f\t%" PRIu64 "\t%" PRIu64 "\t%.1f\t%.1f\t%.1f\t%.1f\t%.1f\t%.0f\n",
+         sValue, pSt->uPings, pSt->uSent, pSt->uPings ? pSt->fAmpSum / pSt->uPings : 0, pSt->uOk / fSent,
+         pSt->uWrong / fSent, pSt->uMissed / fSent, pSt->uFalse, pSt->uPast, pSt->uOk ? sqrt(pSt->fSqMm / pSt->uOk) : 0,
+         pSt->fMaxMm, pSt->uOk ? pSt->fDispSumMm / pSt->uOk : 0,
+         pSt->uSamples ? pSt->fRenderNs / pSt->uSamples : 0, pSt->uSamples ? pSt->fDetectNs / pSt->uSamples : 0,
+         pSt->fStreamS);
+}
+
+static int run_stream(chansim_config_t *pCfg, double fSeconds, const char *sPath) {
+  // the stream to sPath, truth to stdout
+  chansim_t sim;
+  if (!chansim_init(&sim, pCfg)) return 2;
+  size_t uLen = strlen(sPath);
+  bool bRcb = uLen > 4 && strcmp(sPath + uLen - 4, ".rcb") == 0;
+  FILE *f = fopen(sPath, bRcb ? "wb" : "w");
+  if (!f) {
+    perror(sPath);
+    return 1;
+  }
+  uint64_t uN = (uint64_t)(fSeconds * pCfg->uSampleHz);
+  if (bRcb) {
+    archive_header_t h = { .uSampleHz = pCfg->uSampleHz, .uSamples = uN, .uSections = 1 };
+    memcpy(h.sMagic, ARCHIVE_MAGIC, 4);
+    uint64_t uStart = 0;
+    fwrite(&h, sizeof(h), 1, f);
+    fwrite(&uStart, sizeof(uStart), 1, f);
+  }
+  printf("# seq\ttx_s\ttx_idx\tdist_m\ttemp_c\tsound_mps\tflight_us\tamp_counts\ttx_ppm\trx_ppm\tsent\n");
+  static uint16_t uBuf[LINK_STREAM_BLOCK];
+  double t0 = now_ns();
+  for (uint64_t u = 0; u < uN; u += LINK_STREAM_BLOCK) {
+    uint uLen = uN - u < LINK_STREAM_BLOCK ? uN - u : LINK_STREAM_BLOCK;
+    while (sim.next.fTxIdx < (double)(u + uLen)) { // pings before rendering any sample they reach
+      chansim_ping_t p;
+      chansim_ping(&sim, &p);
+      printf("%" PRIu64 "\t%.6f\t%.3f\t%.4f\t%.2f\t%.2f\t%.2f\t%.1f\t%.3f\t%.3f\t%d\n", p.uSeq, p.fTxS, p.fTxIdx,
+             p.fDistM, p.fTempC, p.fSoundMps, p.fFlightUs, p.fAmpCounts, p.fTxPpm, p.fRxPpm, p.bSent);
+    }
+    chansim_render(&sim, u, uBuf, uLen);
+    if (bRcb) fwrite(uBuf, sizeof(uint16_t), uLen, f);
+    else for (uint i = 0; i < uLen; i++) fprintf(f, "%.5f\n", uBuf[i] * DAT_ADC_CF);
+  }
+  bool bOk = fclose(f) == 0;
+  fprintf(stderr, "%s: %" PRIu64 " samples, %" PRIu64 " pings, %.1fx real time\n", sPath, uN, sim.uPings,
+          fSeconds / ((now_ns() - t0) * 1e-9));
+  chansim_free(&sim);
+  return bOk ? 0 : 1;
+} // end static int run_stream(...)
+
+int main(int argc, char **argv) {
+  chansim_config_t cfg;
+  chansim_defaults(&cfg);
+  uint64_t uPings = 10000;
+  double fSeconds = 10;
+  const char *sOut = NULL, *sSweep = NULL, *sStack = "1";
+  for (int i = 1; i + 1 < argc; i += 2) {
+    if (strcmp(argv[i], "-N") == 0) uPings = strtoull(argv[i + 1], NULL, 10);
+    else if (strcmp(argv[i], "-T") == 0) fSeconds = atof(argv[i + 1]);
+    else if (strcmp(argv[i], "-o") == 0) sOut = argv[i + 1];
+    else if (strcmp(argv[i], "-s") == 0) cfg.uSeed = strtoull(argv[i + 1], NULL, 10);
+    else if (strcmp(argv[i], "-S") == 0) sSweep = argv[i + 1];
+    else if (strcmp(argv[i], "-k") == 0) sStack = argv[i + 1];
+    else if (strcmp(argv[i], "-x") == 0 && param_assign(&cfg, argv[i + 1])) continue;
+    else {
+      fprintf(stderr, "usage: %s [-N pings] [-s seed] [-x name=value ...] [-S name=v1,v2,...] [-k N,...]\n"
+                      "       %s -T seconds -o stream.dat|stream.rcb [-s seed] [-x name=value ...]\n", argv[0], argv[0]);
+      chansim_config_t def;
+      chansim_defaults(&def);
+      param_list(&def);
+      return 2;
+    }
+  }
+  if (sOut) return run_stream(&cfg, fSeconds, sOut);
+  if (cfg.uCode) {
+    fprintf(stderr, "stress runs the plain burst detector; coded streams with -o (rcs-coded-bench-01 for the bank)\n");
+    return 2;
+  }
+
+  // sweep values; the parameter unchanged if none
+  const link_param_t *pSweep = NULL;
+  double fValues[LINK_VALUES_MAX];
+  uint uValues = 0;
+  if (sSweep) {
+    const char *sEq = strchr(sSweep, '=');
+    pSweep = sEq ? param_find(sSweep, sEq - sSweep) : NULL;
+    if (!pSweep) {
+      fprintf(stderr, "-S %s: unknown parameter\n", sSweep);
+      return 2;
+    }
+    for (const char *s = sEq + 1; *s && uValues < LINK_VALUES_MAX; ) {
+      char *pEnd;
+      fValues[uValues++] = strtod(s, &pEnd);
+      if (pEnd == s) break;
+      s = *pEnd == ',' ? pEnd + 1 : pEnd;
+    }
+  }
+  // stacking depths, powers of 2
+  uint uShifts[STACK_SHIFT_MAX + 1], uStacks = 0;
+  for (const char *s = sStack; *s && uStacks <= STACK_SHIFT_MAX; ) {
+    char *pEnd;
+    unsigned long uN = strtoul(s, &pEnd, 10);
+    uint uShift = 0;
+    while (uShift < STACK_SHIFT_MAX && (1ul << uShift) < uN) uShift++;
+    if (pEnd == s || (1ul << uShift) != uN) {
+      fprintf(stderr, "-k %s: N 1..%d, powers of 2\n", sStack, 1 << STACK_SHIFT_MAX);
+      return 2;
+    }
+    uShifts[uStacks++] = uShift;
+    s = *pEnd == ',' ? pEnd + 1 : pEnd;
+  }
+  printf("# pings %" PRIu64 " seed %" PRIu64 " period_ms %.0f dist_m %.2f temp_c %.1f noise %.1f ambient %.1f q %.0f "
+         "ground %.2fm %.2f paths %u\n", uPings, cfg.uSeed, cfg.fPeriodMs, cfg.fDistM, cfg.fTempC, cfg.fNoiseCounts,
+         cfg.fAmbientCounts, cfg.fQ, cfg.fHeightM, cfg.fGroundGain, cfg.uPaths);
+  double fReach[STACK_SHIFT_MAX + 1];
+  const char *sLimit[STACK_SHIFT_MAX + 1]; // what ends the reach: signal, the window end, or the sweep
+  for (uint k = 0; k < uStacks; k++) {
+    fReach[k] = NAN;
+    sLimit[k] = "sweep";
+    bool bReach = true;
+    printf("# stack %u\n", 1u << uShifts[k]);
+    printf("# %s\tpings\tsent\tamp_counts\tok_rate\twrong_rate\tmiss_rate\tfalse\tpast_window\terr_rms_mm\terr_max_mm\tdisp_bias_mm"
+           "\trender_ns_per_sample\tdetect_ns_per_sample\tx_realtime\n", pSweep ? pSweep->sName : "run");
+    for (uint v = 0; v < (pSweep ? uValues : 1); v++) {
+      chansim_config_t c = cfg;
+      char sValue[32] = "-";
+      if (pSweep) {
+        param_set(&c, pSweep, fValues[v]);
+        snprintf(sValue, sizeof(sValue), "%g", fValues[v]);
+      }
+      link_stats_t st;
+      if (!run_stress(&c, uPings, uShifts[k], &st)) {
+        fprintf(stderr, "%s %s: bad configuration\n", pSweep ? pSweep->sName : "run", sValue);
+        return 2;
+      }
+      print_row(sValue, &st);
+      fflush(stdout);
+      bool bIn = st.uSent && (double)st.uOk / st.uSent >= LINK_REACH_OK;
+      if (bReach && !bIn) sLimit[k] = st.uPast ? "window" : "signal";
+      bReach = bReach && bIn;
+      if (bReach && pSweep) fReach[k] = fValues[v];
+    }
+  } // end for (uint k...)
+  if (pSweep) { // range (or whatever the sweep) against N
+    printf("# reach\tstack\t%s\tlimit\n", pSweep->sName);
+    for (uint k = 0; k < uStacks; k++) {
+      printf("# reach\t%u\t%g\t%s\n", 1u << uShifts[k], fReach[k], sLimit[k]);
+    }
+  }
+  return 0;
+} // end int main(...)
@@ -0,0 +1,311 @@
+// @file rcs-locate-bench-01.c
+// @date 2026.10.17
+// @info host benchmark of the position solver (../rcs-common/rcs-locate-01.c) on simulated mower runs
+// @info yard -x by -y m with beacons on its corners (-b 3: two corners and the far side middle);
+// @info trajectories: stripes (lanes 0.5m apart at 0.5m/s, half circle turns), random (straight
+// @info legs between random points, 0.3-1m/s), circle (5m radius, 0.5m/s) and still.
+// @info ranges every -p ms: round (one beacon per ping, in turn) or all (every beacon per ping, the
+// @info coded bursts of rcs-coded-01); true range + gaussian -n mm rms, missed with probability -m,
+// @info and with probability -o an echo or cross talk pick 0.3-3m long.
+// @info the solver starts at the beacon centroid, knowing only that the mower is in the yard.
+// @info per trajectory and schedule, after -c s of convergence: rms, 95th percentile and max
+// @info position error at each ping, the fraction inside the 2 sigma covariance ellipse (86% if
+// @info the covariance is honest), gated ranges; against a re-solve from scratch each ping (float
+// @info gauss-newton from the centroid, no gate), the approach the incremental filter replaces. all
+// @info re-solves this ping's ranges only (no fix under 3); round has one range per ping, so it
+// @info re-solves the latest range of every beacon, a missed or echo range staying in until that
+// @info beacon's next one. then ns per call of each on this host.
+
+// @usage ./rcs-locate-bench-01 [-x m] [-y m] [-b beacons] [-p ms] [-n mm] [-m miss_prob] [-o outlier_prob]
+//                              [-T s] [-c s] [-s seed]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <math.h>
+#include <inttypes.h> // printf("%" PRIu64/d64/x64 "\n", t)
+#include "rcs-rand-01.h"
+#include "../rcs-common/rcs-locate-01.h"
+
+#define BENCH_STEP_MM     50      // trajectory polyline resolution
+#define BENCH_POINTS_MAX  (1 << 20)
+#define BENCH_GN_ITER     10      // gauss-newton iterations per re-solve
+#define BENCH_CALLS       1000000 // throughput run
+
+typedef struct {
+  double fX, fY, fT; // mm, s at the point
+} bench_point_t;
+
+typedef struct {
+  bench_point_t *pPoint;
+  uint uN, uCursor;
+} bench_path_t;
+
+typedef struct {
+  double fYardX, fYardY, fPeriodMs, fNoiseMm, fMiss, fOutlier, fSeconds, fConverge;
+  uint   uBeacons;
+} bench_config_t;
+
+typedef struct {
+  double *pErr;
+  uint   uN, uInside;
+} bench_stat_t;
+
+static locate_beacon_t S_Beacon[LOCATE_BEACONS_MAX];
+
+static double now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static void path_add(bench_path_t *pP, double fX, double fY, double fSpeed) {
+  // straight line from the last point at fSpeed mm/s, in BENCH_STEP_MM steps
+  if (!pP->uN) {
+    pP->pPoint[pP->uN++] = (bench_point_t){ fX, fY, 0 };
+    return;
+  }
+  bench_point_t a = pP->pPoint[pP->uN - 1];
+  double fLen = hypot(fX - a.fX, fY - a.fY);
+  uint uSteps = (uint)ceil(fLen / BENCH_STEP_MM);
+  for (uint k = 1; k <= uSteps && pP->uN < BENCH_POINTS_MAX; k++) {
+    double f = (double)k / uSteps;
+    pP->pPoint[pP->uN++] = (bench_point_t){ a.fX + f * (fX - a.fX), a.fY + f * (fY - a.fY), a.fT + f * fLen / fSpeed };
+  }
+}
+
+static void path_make(bench_path_t *pP, const char *sName, const bench_config_t *pCfg) {
+  // polyline until pCfg->fSeconds; the mower keeps 1m off the yard edge
+  const double fW = pCfg->fYardX * 1000, fH = pCfg->fYardY * 1000, fM = 1000;
+  pP->uN = pP->uCursor = 0;
+  if (strcmp(sName, "stripes") == 0) {
+    const double fLane = 500, fSpeed = 500;
+    double fY = fM;
+    bool bRight = true;
+    path_add(pP, fM, fY, fSpeed);
+    while (pP->pPoint[pP->uN - 1].fT < pCfg->fSeconds) {
+      path_add(pP, bRight ? fW - fM : fM, fY, fSpeed);
+      if (fY + fLane > fH - fM) fY = fM - fLane; // back to the first lane
+      for (uint k = 1; k <= 8; k++) { // half circle turn, lane / 2 radius
+        double fA = M_PI * k / 8, fR = fLane / 2;
+        if (fY < fM) { // return leg straight down the edge
+          path_add(pP, bRight ? fW - fM : fM, fM, fSpeed);
+          break;
+        }
+        double fCx = bRight ? fW - fM : fM;
+        path_add(pP, fCx + (bRight ? 1 : -1) * fR * sin(fA), fY + fR - fR * cos(fA), fSpeed);
+      }
+      fY += fLane;
+      bRight = !bRight;
+    }
+  } else if (strcmp(sName, "random") == 0) {
+    path_add(pP, rand_uniform(fM, fW - fM), rand_uniform(fM, fH - fM), 1);
+    while (pP->pPoint[pP->uN - 1].fT < pCfg->fSeconds) {
+      path_add(pP, rand_uniform(fM, fW - fM), rand_uniform(fM, fH - fM), rand_uniform(300, 1000));
+    }
+  } else if (strcmp(sName, "circle") == 0) {
+    const double fR = fmin(5000, fmin(fW, fH) / 2 - fM), fSpeed = 500;
+    for (uint k = 0; pP->uN == 0 || pP->pPoint[pP->uN - 1].fT < pCfg->fSeconds; k++) {
+      double fA = 2 * M_PI * k / 128;
+      path_add(pP, fW / 2 + fR * cos(fA), fH / 2 + fR * sin(fA), fSpeed);
+    }
+  } else { // still
+    path_add(pP, fW / 3, fH / 3, 1);
+    pP->pPoint[pP->uN++] = (bench_point_t){ fW / 3, fH / 3, pCfg->fSeconds + 1 };
+  }
+} // end static void path_make(...)
+
+static void path_at(bench_path_t *pP, double fT, double *pfX, double *pfY) {
+  // position at fT; calls come in time order
+  while (pP->uCursor + 2 < pP->uN && pP->pPoint[pP->uCursor + 1].fT <= fT) pP->uCursor++;
+  const bench_point_t *a = &pP->pPoint[pP->uCursor], *b = &pP->pPoint[pP->uCursor + 1];
+  double f = (b->fT > a->fT) ? (fT - a->fT) / (b->fT - a->fT) : 0;
+  if (f > 1) f = 1;
+  *pfX = a->fX + f * (b->fX - a->fX);
+  *pfY = a->fY + f * (b->fY - a->fY);
+}
+
+static bool gauss_newton(const double *pfRange, const bool *pbHave, uint uBeacons, double fX0, double fY0,
+                         double *pfX, double *pfY) {
+  // least squares position from one range per beacon, from (fX0, fY0); false under 3 ranges
+  uint uHave = 0;
+  for (uint b = 0; b < uBeacons; b++) uHave += pbHave[b];
+  if (uHave < 3) return false;
+  double fX = fX0, fY = fY0;
+  for (uint it = 0; it < BENCH_GN_ITER; it++) {
+    double a = 0, b2 = 0, c = 0, gx = 0, gy = 0; // normal equations [a b2; b2 c] d = g
+    for (uint b = 0; b < uBeacons; b++) {
+      if (!pbHave[b]) continue;
+      double fDx = fX - S_Beacon[b].iX, fDy = fY - S_Beacon[b].iY, fR = hypot(fDx, fDy);
+      if (fR < 1) continue;
+      double hx = fDx / fR, hy = fDy / fR, fNu = pfRange[b] - fR;
+      a += hx * hx;
+      b2 += hx * hy;
+      c += hy * hy;
+      gx += hx * fNu;
+      gy += hy * fNu;
+    }
+    double fDet = a * c - b2 * b2;
+    if (fabs(fDet) < 1e-9) return false;
+    fX += (c * gx - b2 * gy) / fDet;
+    fY += (a * gy - b2 * gx) / fDet;
+  }
+  *pfX = fX;
+  *pfY = fY;
+  return true;
+} // end static bool gauss_newton(...)
+
+static int cmp_double(const void *a, const void *b) {
+  double x = *(const double *)a, y = *(const double *)b;
+  return (x > y) - (x < y);
+}
+
+static void stat_print(bench_stat_t *pS, bool bInside) {
+  // rms, p95, max mm; inside pct (solver only)
+  double fSq = 0;
+  for (uint i = 0; i < pS->uN; i++) fSq += pS->pErr[i] * pS->pErr[i];
+  qsort(pS->pErr, pS->uN, sizeof(double), cmp_double);
+  if (!pS->uN) {
+    printf("\t0\t-\t-\t-\t-");
+    return;
+  }
+  printf("\t%u\t%.1f\t%.1f\t%.1f", pS->uN, sqrt(fSq / pS->uN), pS->pErr[(uint)(0.95 * (pS->uN - 1))], pS->pErr[pS->uN - 1]);
+  if (bInside) printf("\t%.1f", 100.0 * pS->uInside / pS->uN);
+  else printf("\t-");
+}
+
+static void bench_run(const bench_config_t *pCfg, bench_path_t *pPath, const char *sPath, bool bAll) {
+  // one trajectory, one schedule; a tsv row each for the solver and the re-solve
+  const double fCx = pCfg->fYardX * 500, fCy = pCfg->fYardY * 500; // centroid of the yard, mm
+  const uint uPings = (uint)(pCfg->fSeconds * 1000 / pCfg->fPeriodMs);
+  bench_stat_t ekf = { .pErr = malloc(uPings * sizeof(double)) }, gn = { .pErr = malloc(uPings * sizeof(double)) };
+  double fRange[LOCATE_BEACONS_MAX];
+  bool bHave[LOCATE_BEACONS_MAX] = { 0 };
+  uint uRanges = 0;
+  const uint32_t uVarQ8 = (uint32_t)(pCfg->fNoiseMm * pCfg->fNoiseMm * (1 << LOCATE_Q)) + 1;
+  locate_t loc;
+  locate_init(&loc, S_Beacon, pCfg->uBeacons, fCx, fCy, hypot(fCx, fCy), 0);
+  path_make(pPath, sPath, pCfg);
+
+  for (uint k = 0; k < uPings; k++) {
+    double fT = k * pCfg->fPeriodMs / 1000, fX, fY;
+    uint64_t uTimeUs = (uint64_t)(fT * 1e6);
+    path_at(pPath, fT, &fX, &fY);
+    if (bAll) memset(bHave, 0, sizeof(bHave)); // this ping's ranges only; round keeps each beacon's latest
+    for (uint b = 0; b < pCfg->uBeacons; b++) {
+      if (!bAll && b != k % pCfg->uBeacons) continue;
+      if (rand_uniform(0, 1) < pCfg->fMiss) continue;
+      double fR = hypot(fX - S_Beacon[b].iX, fY - S_Beacon[b].iY) + pCfg->fNoiseMm * rand_gauss();
+      if (rand_uniform(0, 1) < pCfg->fOutlier) fR += rand_uniform(300, 3000);
+      fRange[b] = fR;
+      bHave[b] = true;
+      uRanges++;
+      locate_update(&loc, b, (int32_t)lround(fR * (1 << LOCATE_Q)), uVarQ8, uTimeUs);
+    }
+    locate_predict(&loc, uTimeUs);
+    if (fT < pCfg->fConverge) continue;
+
+    locate_fix_t fix;
+    locate_fix(&loc, &fix);
+    double fEx = fix.iXQ8 / 256.0 - fX, fEy = fix.iYQ8 / 256.0 - fY;
+    double sxx = fix.iCovXX / 256.0, sxy = fix.iCovXY / 256.0, syy = fix.iCovYY / 256.0;
+    double fDet = sxx * syy - sxy * sxy;
+    double fD2 = fDet > 0 ? (syy * fEx * fEx - 2 * sxy * fEx * fEy + sxx * fEy * fEy) / fDet : INFINITY;
+    ekf.pErr[ekf.uN++] = hypot(fEx, fEy);
+    if (fD2 <= 4) ekf.uInside++;
+    double fGx, fGy;
+    if (gauss_newton(fRange, bHave, pCfg->uBeacons, fCx, fCy, &fGx, &fGy)) gn.pErr[gn.uN++] = hypot(fGx - fX, fGy - fY);
+  } // end for (uint k...)
+  printf("%s\t%s\tlocate", sPath, bAll ? "all" : "round");
+  stat_print(&ekf, true);
+  printf("\t%.1f\n", uRanges ? 100.0 * loc.uGated / uRanges : 0);
+  printf("%s\t%s\tresolve", sPath, bAll ? "all" : "round");
+  stat_print(&gn, false);
+  printf("\t-\n");
+  free(ekf.pErr);
+  free(gn.pErr);
+} // end static void bench_run(...)
+
+static void bench_throughput(const bench_config_t *pCfg) {
+  // ns per range update (predict included) and per re-solve, round robin over the beacons
+  const double fCx = pCfg->fYardX * 500, fCy = pCfg->fYardY * 500;
+  static int32_t iRange[BENCH_CALLS];
+  double fRange[LOCATE_BEACONS_MAX];
+  bool bHave[LOCATE_BEACONS_MAX];
+  for (uint b = 0; b < pCfg->uBeacons; b++) {
+    fRange[b] = hypot(fCx / 2 - S_Beacon[b].iX, fCy / 2 - S_Beacon[b].iY);
+    bHave[b] = true;
+  }
+  for (uint i = 0; i < BENCH_CALLS; i++) {
+    iRange[i] = (int32_t)lround((fRange[i % pCfg->uBeacons] + pCfg->fNoiseMm * rand_gauss()) * (1 << LOCATE_Q));
+  }
+  const uint32_t uVarQ8 = (uint32_t)(pCfg->fNoiseMm * pCfg->fNoiseMm * (1 << LOCATE_Q)) + 1;
+  locate_t loc;
+  locate_init(&loc, S_Beacon, pCfg->uBeacons, fCx, fCy, hypot(fCx, fCy), 0);
+  double t0 = now_ns();
+  for (uint i = 0; i < BENCH_CALLS; i++) locate_update(&loc, i % pCfg->uBeacons, iRange[i], uVarQ8, (uint64_t)i * 25000);
+  double fUpdateNs = (now_ns() - t0) / BENCH_CALLS;
+  double fX, fY, fSum = 0;
+  const uint uSolves = BENCH_CALLS / 10;
+  t0 = now_ns();
+  for (uint i = 0; i < uSolves; i++) {
+    fRange[i % pCfg->uBeacons] = iRange[i] / 256.0;
+    if (gauss_newton(fRange, bHave, pCfg->uBeacons, fCx, fCy, &fX, &fY)) fSum += fX;
+  }
+  double fSolveNs = (now_ns() - t0) / uSolves;
+  printf("# throughput, %u calls\n# kernel\tns_per_call\n", BENCH_CALLS);
+  printf("locate_update\t%.1f\nresolve_%u_iter\t%.1f\n", fUpdateNs, BENCH_GN_ITER, fSolveNs);
+  if (fSum == 12345) printf("#\n"); // keep the solves
+} // end static void bench_throughput(...)
+
+int main(int argc, char **argv) {
+  bench_config_t cfg = { .fYardX = 20, .fYardY = 15, .uBeacons = 4, .fPeriodMs = 100, .fNoiseMm = 10,
+                         .fMiss = 0.05, .fOutlier = 0.02, .fSeconds = 1200, .fConverge = 10 };
+  unsigned uSeed = RAND_SEED_DEFAULT;
+  for (int i = 1; i + 1 < argc; i += 2) {
+    if (strcmp(argv[i], "-x") == 0) cfg.fYardX = atof(argv[i + 1]);
+    else if (strcmp(argv[i], "-y") == 0) cfg.fYardY = atof(argv[i + 1]);
+    else if (strcmp(argv[i], "-b") == 0) cfg.uBeacons = atoi(argv[i + 1]);
+    else if (strcmp(argv[i], "-p") == 0) cfg.fPeriodMs = atof(argv[i + 1]);
+    else if (strcmp(argv[i], "-n") == 0) cfg.fNoiseMm = atof(argv[i + 1]);
+    else if (strcmp(argv[i], "-m") == 0) cfg.fMiss = atof(argv[i + 1]);
+    else if (strcmp(argv[i], "-o") == 0) cfg.fOutlier = atof(argv[i + 1]);
+    else if (strcmp(argv[i], "-T") == 0) cfg.fSeconds = atof(argv[i + 1]);
+    else if (strcmp(argv[i], "-c") == 0) cfg.fConverge = atof(argv[i + 1]);
+    else if (rand_seed_arg(argv[i], argv[i + 1], &uSeed)) continue;
+    else {
+      fprintf(stderr, "usage: %s [-x m] [-y m] [-b beacons] [-p ms] [-n mm] [-m miss_prob] [-o outlier_prob] "
+                      "[-T s] [-c s] [-s seed]\n", argv[0]);
+      return 2;
+    }
+  }
+  if (cfg.uBeacons < 3 || cfg.uBeacons > 4) {
+    fprintf(stderr, "%s: -b 3 or 4\n", argv[0]);
+    return 2;
+  }
+  srand(uSeed);
+  const int32_t iW = cfg.fYardX * 1000, iH = cfg.fYardY * 1000;
+  if (cfg.uBeacons == 4) {
+    S_Beacon[0] = (locate_beacon_t){ 0, 0 };
+    S_Beacon[1] = (locate_beacon_t){ iW, 0 };
+    S_Beacon[2] = (locate_beacon_t){ iW, iH };
+    S_Beacon[3] = (locate_beacon_t){ 0, iH };
+  } else {
+    S_Beacon[0] = (locate_beacon_t){ 0, 0 };
+    S_Beacon[1] = (locate_beacon_t){ iW, 0 };
+    S_Beacon[2] = (locate_beacon_t){ iW / 2, iH };
+  }
+  printf("# yard %.0f x %.0f m, %u beacons, ping %.0f ms, noise %.1f mm, miss %.2f, outlier %.2f, %.0f s, converge %.0f s\n",
+         cfg.fYardX, cfg.fYardY, cfg.uBeacons, cfg.fPeriodMs, cfg.fNoiseMm, cfg.fMiss, cfg.fOutlier, cfg.fSeconds, cfg.fConverge);
+  printf("# path\tschedule\tsolver\tfixes\trms_mm\tp95_mm\tmax_mm\tinside_2sigma_pct\tgated_pct\n");
+  bench_path_t path = { .pPoint = malloc(BENCH_POINTS_MAX * sizeof(bench_point_t)) };
+  const char *sPaths[] = { "still", "stripes", "circle", "random" };
+  for (uint p = 0; p < sizeof(sPaths) / sizeof(sPaths[0]); p++) {
+    bench_run(&cfg, &path, sPaths[p], false);
+    bench_run(&cfg, &path, sPaths[p], true);
+  }
+  free(path.pPoint);
+  bench_throughput(&cfg);
+  return 0;
+} // end int main(...)
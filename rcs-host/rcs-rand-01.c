@@ -0,0 +1,26 @@
+// @file rcs-rand-01.c
+// @date 2026.10.17
+// @info seeded random numbers for the host benches and simulators (rcs-rand-01.h)
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "rcs-rand-01.h"
+
+double rand_gauss(void) {
+  // standard normal; box-muller, rand() is enough for a simulation
+  double u1 = (rand() + 1.0) / (RAND_MAX + 2.0), u2 = (rand() + 1.0) / (RAND_MAX + 2.0);
+  return sqrt(-2 * log(u1)) * cos(2 * M_PI * u2);
+}
+
+double rand_uniform(double fLo, double fHi) {
+  // uniform on [fLo, fHi]
+  return fLo + (fHi - fLo) * rand() / (double)RAND_MAX;
+}
+
+bool rand_seed_arg(const char *sOpt, const char *sValue, unsigned *puSeed) {
+  // '-s <seed>' from a bench's option loop; true if sOpt was -s and *puSeed is set
+  if (strcmp(sOpt, "-s") != 0) return false;
+  *puSeed = strtoul(sValue, NULL, 10);
+  return true;
+}
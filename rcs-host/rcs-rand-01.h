@@ -0,0 +1,12 @@
+// @file rcs-rand-01.h
+// @date 2026.10.17
+// @info seeded random numbers for the host benches and simulators; rand() based, so a seed repeats a
+// @info run on the same libc. the benches take the seed as '-s <seed>', RAND_SEED_DEFAULT without it
+
+#include <stdbool.h>
+
+#define RAND_SEED_DEFAULT 1
+
+double rand_gauss(void);
+double rand_uniform(double fLo, double fHi);
+bool rand_seed_arg(const char *sOpt, const char *sValue, unsigned *puSeed);
@@ -0,0 +1,257 @@
+// @file rcs-rate-bench-01.c
+// @date 2026.10.17
+// @info high-rate ranging bench; receiver throughput and miss rate per ping period
+// @info for each period: synthesize the receiver adc stream of a transmitter pinging at that period
+// @info (ascii volts at 500ksps, like a minicom .dat): the target holds at the 1ft reference, then
+// @info walks between 1 and 15ft; burst amplitude falls with distance, every ping has a late
+// @info multipath echo, pings are dropped at random. the host receiver (rcs-rx04-03-telemetry-host,
+// @info period set with RCS_HOST_INPUT 'p<ms>') runs on the stream, its telemetry is decoded here and
+// @info each report is scored against the generated flight times (tsv on stdout).
+// @info ok: |error| <= BENCH_OK_US. wrong: a larger error, or a range for a dropped ping (an echo or
+// @info noise taken for the pulse). miss rate counts windows without a pulse; dropped pings included.
+// @info power: core 1 awake and adc on, permille of the run, from the host summary; -l 1 runs the
+// @info receiver in low power mode ('l1', DUTY_CYCLE), so a duty cycle regression shows as a number.
+// @info with the defaults (3 ft/s walk, 6ms echo, 2% drops, -5 ppm, seed 1) every period reports at its
+// @info ping rate with err_rms 16-61 us, largest at 2000ms: the threshold crossing moves later in the
+// @info ring-up as the burst weakens with distance, and a longer period walks further between pings.
+// @info the high-rate commit gave 1 wrong report of 237 at 40ms; 0 wrong at every period since.
+
+// @usage ./rcs-rate-bench-01 [-r 2000,500,100,50,40,25] [-T seconds] [-v ft_per_s] [-e echo_ms] [-g echo_gain]
+//                            [-n noise_v] [-m drop_prob] [-p ppm] [-s seed] [-l low_power] [-x rx_host]
+// @usage run from the build directory; -x defaults to ./rcs-rx04-03-telemetry-host
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <math.h>
+#include <unistd.h>
+#include <inttypes.h> // printf("%" PRIu64/d64/x64 "\n", t)
+#include "rcs-rand-01.h"
+#include "../rcs-common/rcs-telemetry-01.h"
+
+#define BENCH_SAMPLE_HZ  500000 // rcs-capture-01 CAPTURE_SAMPLE_HZ
+#define BENCH_BASELINE_V 2.33   // receiver quiescent level
+#define BENCH_START_S    0.5    // quiet lead-in; receiver boot baseline
+#define BENCH_HOLD_S     3.0    // target at the reference distance; sync, reference, drift acquisition
+#define BENCH_US_PER_FT  889    // (/ 1e6 1125.0) flight time per ft at 20C
+#define BENCH_BURST_LEN  300    // samples; rcs-tx01-02 8 cycle burst with piezo ring up/down
+#define BENCH_MIN_PINGS  16     // after the hold; long periods run longer than -T
+#define BENCH_OK_US      300    // (/ 300 889.0) 1/3 ft
+#define BENCH_RATES_MAX  16
+
+typedef struct {
+  double  fTxS;      // emission, stream seconds
+  double  fFlightUs; // true flight time
+  bool    bSent;     // false: dropped ping
+} bench_ping_t;
+
+typedef struct {
+  report_t *pReports;
+  uint      uN, uMax;
+  double    fCoreAwake, fAdcOn; // permille of the run, host summary; NAN if not reported
+} bench_reports_t;
+
+static double distance_ft(double fS, double fFtPerS) {
+  // hold at 1ft, then walk 1 -> 15 -> 1ft ...
+  if (fS < BENCH_START_S + BENCH_HOLD_S) return 1;
+  double fWalk = fmod((fS - BENCH_START_S - BENCH_HOLD_S) * fFtPerS, 28);
+  return 1 + (fWalk < 14 ? fWalk : 28 - fWalk);
+}
+
+static void add_burst(float *pV, size_t uN, double fStart, double fAmp) {
+  // 40KHz burst from sample position fStart (fractional); piezo ring up over 60 samples, hold, decay
+  size_t i0 = (size_t)ceil(fStart);
+  for (size_t i = i0; i < i0 + BENCH_BURST_LEN && i < uN; i++) {
+    double n = i - fStart;
+    double fEnv = (n < 60 ? n / 60 : 1) * exp(-(n > 100 ? n - 100 : 0) / 60);
+    pV[i] += fAmp * fEnv * sin(2 * M_PI * 40000 * n / BENCH_SAMPLE_HZ);
+  }
+}
+
+static uint generate(const char *sPath, uint uPeriodMs, double fSeconds, double fFtPerS, double fEchoMs,
+                     double fEchoGain, double fNoiseV, double fDrop, double fPpm, bench_ping_t *pPings, uint uMax) {
+  // write the stream to sPath, the ground truth to pPings; returns pings
+  size_t uN = fSeconds * BENCH_SAMPLE_HZ;
+  float *pV = malloc(uN * sizeof(float));
+  for (size_t i = 0; i < uN; i++) pV[i] = BENCH_BASELINE_V + fNoiseV * rand_gauss();
+  uint uPings = 0;
+  for (; uPings < uMax; uPings++) {
+    bench_ping_t *p = &pPings[uPings];
+    p->fTxS = BENCH_START_S + uPings * uPeriodMs * 1e-3 * (1 + fPpm * 1e-6);
+    if (p->fTxS >= fSeconds) break;
+    double fFt = distance_ft(p->fTxS, fFtPerS);
+    p->fFlightUs = fFt * BENCH_US_PER_FT;
+    p->bSent = (double)rand() / RAND_MAX >= fDrop;
+    if (!p->bSent) continue;
+    double fAmp = 0.3 * (fFt < 3 ? 1 : 3 / fFt);
+    double fArrival = (p->fTxS + p->fFlightUs * 1e-6) * BENCH_SAMPLE_HZ;
+    add_burst(pV, uN, fArrival, fAmp);
+    add_burst(pV, uN, fArrival + fEchoMs * 1e-3 * BENCH_SAMPLE_HZ, fAmp * fEchoGain);
+  }
+  FILE *f = fopen(sPath, "w");
+  if (!f) {
+    perror(sPath);
+    exit(1);
+  }
+  for (size_t i = 0; i < uN; i++) fprintf(f, "%.5f\n", pV[i]);
+  fclose(f);
+  free(pV);
+  return uPings;
+} // end static uint generate(...)
+
+static void collect(const report_t *pR, void *pUser) {
+  bench_reports_t *pC = pUser;
+  if (pC->uN == pC->uMax) {
+    pC->uMax = pC->uMax ? 2 * pC->uMax : 1024;
+    pC->pReports = realloc(pC->pReports, pC->uMax * sizeof(report_t));
+  }
+  pC->pReports[pC->uN++] = *pR;
+}
+
+static void run_rx(const char *sRx, const char *sDat, uint uPeriodMs, bool bLowPower, bench_reports_t *pC) {
+  // host receiver on the stream; binary telemetry on its stdout, the hal summary on stderr
+  char sInput[16], sCmd[1024], sLog[] = "/tmp/rcs-rate-bench-log-XXXXXX";
+  int fd = mkstemp(sLog);
+  if (fd < 0) {
+    perror(sLog);
+    exit(1);
+  }
+  close(fd);
+  snprintf(sInput, sizeof(sInput), "p%u\r%s", uPeriodMs, bLowPower ? "l1\r" : "");
+  setenv("RCS_HOST_ADC", sDat, 1);
+  setenv("RCS_HOST_ADC_HZ", "500000", 1);
+  setenv("RCS_HOST_INPUT", sInput, 1);
+  unsetenv("RCS_HOST_RUN_MS");
+  snprintf(sCmd, sizeof(sCmd), "%s 2>%s", sRx, sLog);
+  FILE *f = popen(sCmd, "r");
+  if (!f) {
+    perror(sRx);
+    exit(1);
+  }
+  telemetry_decoder_t dec;
+  telemetry_decoder_init(&dec);
+  uint8_t uBuf[4096];
+  size_t uN;
+  while ((uN = fread(uBuf, 1, sizeof(uBuf), f)) > 0) telemetry_decode(&dec, uBuf, uN, collect, pC);
+  pclose(f);
+  pC->fCoreAwake = pC->fAdcOn = NAN;
+  FILE *fLog = fopen(sLog, "r");
+  char sLine[256];
+  while (fLog && fgets(sLine, sizeof(sLine), fLog)) {
+    sscanf(sLine, "core1_awake_permille\t%lf", &pC->fCoreAwake);
+    sscanf(sLine, "adc_on_permille\t%lf", &pC->fAdcOn);
+  }
+  if (fLog) fclose(fLog);
+  unlink(sLog);
+} // end static void run_rx(...)
+
+static void score(uint uPeriodMs, const bench_ping_t *pPings, uint uPings, const bench_reports_t *pC) {
+  // match each report to its ping by window start; the capture clock offset comes from the last sync
+  const double fPeriodUs = uPeriodMs * 1000.0;
+  double fOffsetUs = 0;
+  int iRef = -1;
+  uint uReports = 0, uMiss = 0, uOk = 0, uWrong = 0, uDropped = 0;
+  double fSq = 0, fMax = 0;
+  uint64_t uFirstUs = 0, uLastUs = 0;
+  for (uint i = 0; i < pC->uN; i++) {
+    const report_t *pR = &pC->pReports[i];
+    if (pR->uFlags & REPORT_SYNC) { // sync pulse is the first sent ping's arrival at 1ft
+      int k = llround((pR->uTimeUs - BENCH_US_PER_FT - BENCH_START_S * 1e6) / fPeriodUs);
+      if (k < 0) k = 0;
+      if (k < (int)uPings) fOffsetUs = pR->uTimeUs - (pPings[k].fTxS * 1e6 + pPings[k].fFlightUs);
+      iRef = -1;
+      continue;
+    }
+    int k = llround((pR->uTimeUs - fOffsetUs - BENCH_START_S * 1e6) / fPeriodUs);
+    if (k < 0 || k >= (int)uPings) continue;
+    if (pR->uFlags & REPORT_REFERENCE) {
+      iRef = k;
+      uReports = uMiss = uOk = uWrong = uDropped = 0; // score from the reference on
+      fSq = fMax = 0;
+      uFirstUs = pR->uTimeUs;
+    }
+    if (iRef < 0) continue;
+    uReports++;
+    uLastUs = pR->uTimeUs;
+    if (!pPings[k].bSent) uDropped++;
+    if (pR->uFlags & REPORT_MISS) {
+      uMiss++;
+      continue;
+    }
+    double fErr = pR->iFlightUs - (pPings[k].fFlightUs - pPings[iRef].fFlightUs);
+    if (pPings[k].bSent && fabs(fErr) <= BENCH_OK_US) {
+      uOk++;
+      fSq += fErr * fErr;
+      if (fabs(fErr) > fMax) fMax = fabs(fErr);
+    } else {
+      uWrong++;
+    }
+  } // end for (uint i...)
+  double fSpanS = (uLastUs - uFirstUs) / 1e6 + uPeriodMs * 1e-3;
+  printf("%u\t%.1f\t%u\t%u\t%.2f\t%.2f\t%.4f\t%u\t%u\t%.1f\t%.1f\t%.1f\t%.1f\n", uPeriodMs, fSpanS, uReports, uDropped,
+         uReports / fSpanS, uOk / fSpanS, uReports ? (double)uMiss / uReports : 0, uOk, uWrong,
+         uOk ? sqrt(fSq / uOk) : 0, fMax, pC->fCoreAwake, pC->fAdcOn);
+} // end static void score(...)
+
+int main(int argc, char **argv) {
+  uint uRates[BENCH_RATES_MAX] = { 2000, 500, 100, 50, 40, 25 };
+  uint uNRates = 6;
+  double fSeconds = 10, fFtPerS = 3, fEchoMs = 6, fEchoGain = 0.5, fNoiseV = 0.005, fDrop = 0.02, fPpm = -5;
+  unsigned uSeed = RAND_SEED_DEFAULT;
+  bool bLowPower = false;
+  const char *sRx = "./rcs-rx04-03-telemetry-host";
+  for (int i = 1; i + 1 < argc; i += 2) {
+    if (strcmp(argv[i], "-r") == 0) {
+      uNRates = 0;
+      for (char *s = strtok(argv[i + 1], ","); s && uNRates < BENCH_RATES_MAX; s = strtok(NULL, ","))
+        uRates[uNRates++] = atoi(s);
+    }
+    else if (strcmp(argv[i], "-T") == 0) fSeconds = atof(argv[i + 1]);
+    else if (strcmp(argv[i], "-v") == 0) fFtPerS = atof(argv[i + 1]);
+    else if (strcmp(argv[i], "-e") == 0) fEchoMs = atof(argv[i + 1]);
+    else if (strcmp(argv[i], "-g") == 0) fEchoGain = atof(argv[i + 1]);
+    else if (strcmp(argv[i], "-n") == 0) fNoiseV = atof(argv[i + 1]);
+    else if (strcmp(argv[i], "-m") == 0) fDrop = atof(argv[i + 1]);
+    else if (strcmp(argv[i], "-p") == 0) fPpm = atof(argv[i + 1]);
+    else if (rand_seed_arg(argv[i], argv[i + 1], &uSeed)) continue;
+    else if (strcmp(argv[i], "-l") == 0) bLowPower = atoi(argv[i + 1]) != 0;
+    else if (strcmp(argv[i], "-x") == 0) sRx = argv[i + 1];
+    else {
+      fprintf(stderr, "usage: %s [-r ms,ms,..] [-T seconds] [-v ft_per_s] [-e echo_ms] [-g echo_gain] [-n noise_v] "
+                      "[-m drop_prob] [-p ppm] [-s seed] [-l low_power] [-x rx_host]\n", argv[0]);
+      return 2;
+    }
+  }
+  if (access(sRx, X_OK) != 0) {
+    perror(sRx);
+    return 1;
+  }
+  printf("# seconds %.1f walk_ft_per_s %.1f echo_ms %.1f echo_gain %.2f noise_v %.4f drop %.3f ppm %.1f low_power %d\n",
+         fSeconds, fFtPerS, fEchoMs, fEchoGain, fNoiseV, fDrop, fPpm, bLowPower);
+  printf("# period_ms\tseconds\treports\tdropped\treports_per_s\tok_per_s\tmiss_rate\tok\twrong\terr_rms_us\terr_max_us"
+         "\tcore1_awake_permille\tadc_on_permille\n");
+  for (uint r = 0; r < uNRates; r++) {
+    srand(uSeed);
+    double fRun = BENCH_START_S + BENCH_HOLD_S + BENCH_MIN_PINGS * uRates[r] * 1e-3;
+    if (fRun < fSeconds) fRun = fSeconds;
+    uint uMax = fRun * 1000 / uRates[r] + 1;
+    bench_ping_t *pPings = malloc(uMax * sizeof(bench_ping_t));
+    char sDat[] = "/tmp/rcs-rate-bench-XXXXXX";
+    int fd = mkstemp(sDat);
+    if (fd < 0) {
+      perror(sDat);
+      return 1;
+    }
+    close(fd);
+    uint uPings = generate(sDat, uRates[r], fRun, fFtPerS, fEchoMs, fEchoGain, fNoiseV, fDrop, fPpm, pPings, uMax);
+    bench_reports_t reports = { 0 };
+    run_rx(sRx, sDat, uRates[r], bLowPower, &reports);
+    unlink(sDat);
+    score(uRates[r], pPings, uPings, &reports);
+    fflush(stdout);
+    free(reports.pReports);
+    free(pPings);
+  } // end for (uint r...)
+  return 0;
+} // end int main(...)
@@ -0,0 +1,805 @@
+// @file rcs-replay-bench-01.c
+// @date 2026.10.17
+// @info replay benchmark of the receiver detection path over the recorded distance experiments
+// @info every labelled capture is placed in a synthetic ping window at its known distance: quiet
+// @info lead-in (its own baseline, tiled) for the flight time, the capture, then quiet again. the
+// @info window is streamed block by block through the capture ring stand-in, exactly as
+// @info get_flight_time() scans it, once per detector.
+// @info reported per detector: ns/sample, detection latency, ranging error per known distance, and
+// @info false/missed trigger counts, plus false triggers over full quiet TX_PERIOD windows built
+// @info from the b*.dat baselines. results go to stdout (tsv) and optionally json (-j).
+// @info matched_echo (rcs-rx04-03 MULTI_ECHO) scans every window to its end and ranges the direct path
+// @info of its echo list; its ns/sample is the full window scan cost. the echo table adds a copy of
+// @info each capture (-g gain, delayed by multiples of the burst length) and reports how many pairs
+// @info are resolved, the separation error, and how far the echo pulls the direct path arrival.
+// @info the gating table runs a ping sequence (seeded) through rcs-rx04-03's range tracker
+// @info (rcs-track-01): the captures in turn, placed in receiver windows along a target walking
+// @info between 3 and 18ft, some pings blocked, some with an interfering burst (another capture)
+// @info anywhere in the window. reported per mode, window (the whole window, first pulse), tracked
+// @info (the whole window, off-track arrivals rejected) and gated (TRACK_GATE): samples scanned per
+// @info ping, ranges reported, outliers among them (off the true arrival, or a range for a blocked
+// @info ping) and misses.
+
+// @info labelled data (../rcs-rx04-03/mfiles)
+//   exp_dist_01/dist15.dat  baseline/triggered section pairs at 1,2,3,4,5,5 ft (exp_dist_01.m)
+//   exp_dist_02/b2N,d2N     N=1..8 at 3,6,9,12,15,18,18,18 ft (exp_dist_02.m)
+// @info ranging uses the receiver's method: the first (closest) capture of each experiment is the
+// @info reference distance, others are ranged from their flight time difference to it
+
+// @info the *_cfar detectors (rcs-rx04-03 ADAPTIVE_THRESHOLD) warm their estimator on the quiet samples
+// @info before each window (untimed); the cfar table gives the per sample false alarm rate of the
+// @info tracked threshold on each b*.dat against the fixed one (-k sets the threshold in sigmas). the
+// @info cfar step table steps the level of seeded white noise (rcs-chansim-01) under a warmed estimator
+// @info and reports how long the mean takes to follow, what it censors meanwhile, the highest threshold
+// @info and the samples beyond it after the step (each a threshold crossing trigger). the b*.dat files
+// @info are 96-224 samples each, too few to see a rate; the cfar table totals them and adds a long
+// @info seeded white noise run (BENCH_NOISE_LEN samples) for the tracked and fixed false alarm rates
+
+// @usage ./rcs-replay-bench-01 [-m mfiles_dir] [-t volts] [-k sigmas] [-g echo_gain] [-j results.json]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <math.h>
+#include <inttypes.h> // printf("%" PRIu64/d64/x64 "\n", t)
+#include "rcs-dat-01.h"
+#include "rcs-capture-host-01.h"
+#include "rcs-chansim-01.h"
+#include "../rcs-common/rcs-detect-01.h"
+#include "../rcs-common/rcs-cfar-01.h"
+#include "../rcs-common/rcs-echo-01.h"
+#include "../rcs-common/rcs-track-01.h"
+
+#define BENCH_US_PER_FT    889     // (/ 1e6 1125.0) flight time per ft at 20C
+#define BENCH_TX_PERIOD_MS 2000    // rcs-rx04-03 TX_PERIOD; quiet window length
+#define BENCH_TAIL         1024    // quiet samples after the capture
+#define BENCH_FALSE_TOL    64      // samples before the true arrival still counted as the pulse
+#define BENCH_REPEAT       16      // timing repeats per window
+#define BENCH_MAX_CASES    32
+#define BENCH_MAX_QUIET    32
+#define BENCH_WARM         (4 << CFAR_SHIFT) // quiet samples fed to the cfar estimator before a window
+#define BENCH_ECHO_GAIN    0.5     // -g; synthetic echo amplitude against the capture
+#define BENCH_GATE_PINGS   1000    // gating table: pings in the sequence
+#define BENCH_GATE_PERIOD_MS 100   // ping period; rcs-rx04-03 'p100'
+#define BENCH_GATE_FT_PER_PING 0.1 // target walk, (/ 0.1 0.1) 1ft/s, turning at 3 and 18ft
+#define BENCH_GATE_SPURIOUS 0.25   // fraction of pings with an interfering burst
+#define BENCH_GATE_BLOCKED 0.05    // fraction of pings without their pulse
+#define BENCH_GATE_TOL     128     // samples off the true arrival (less the capture's own offset) for an outlier
+#define BENCH_GATE_SEED    1
+#define BENCH_STEP_SIGMA   5       // step table: white noise rms, counts; seeded at BENCH_STEP_BASE and 5 sigma
+#define BENCH_STEP_BASE    2000
+#define BENCH_STEP_MS      2000    // tracked after each step
+#define BENCH_STEP_SETTLE  2       // counts off the new level for settled
+#define BENCH_STEP_OK_MS   50      // every step settles within, or the bench exits 1
+#define BENCH_STEP_OVER_MAX (CFAR_LOCKOUT + 64) // and has at most this many samples beyond the threshold
+#define BENCH_NOISE_SIGMA  11      // cfar noise run: white noise rms, counts; the b*.dat sigmas are 9-12
+#define BENCH_NOISE_LEN    (1u << 24) // samples, (/ 16777216 500000.0) 34s
+
+typedef struct {
+  const char *sSet;     // experiment
+  char        sLabel[32];
+  double      fFt;      // known distance
+  uint16_t   *pBase;    // baseline section (settling skipped)
+  size_t      uBase;
+  uint16_t   *pCap;     // triggered capture
+  size_t      uCap;
+} bench_case_t;
+
+typedef struct {
+  const uint16_t *pStream; // window samples; index 0 is the tx tick
+  size_t          uN;
+  uint16_t        uBaseline;
+  uint16_t        uThreshold; // counts over/under baseline
+  const uint16_t *pWarm;      // quiet samples preceding the window (cfar detectors), tiled
+  size_t          uWarm;
+} bench_window_t;
+
+typedef struct {
+  bool     bFound;
+  int64_t  iArrivalQ8;   // detected arrival, Q8 samples from window start
+  uint64_t uReportIdx;   // ring samples done when the detection was available
+  uint64_t uScanned;     // samples processed
+} bench_hit_t;
+
+typedef struct {
+  const char *sName;
+  void (*fnWindow)(const bench_window_t *pW, bench_hit_t *pHit);
+  void (*fnPrepare)(const bench_window_t *pW); // optional, untimed; state carried into the window
+  // accumulated results
+  double   fNs;
+  uint64_t uSamples;
+  double   fErrSum, fErrMax, fLatencySum;
+  uint     uOk, uFalse, uMissed, uQuietFalse, uQuietWindows;
+} bench_detector_t;
+
+static detect_t S_Detect;
+static cfar_t   S_Cfar;
+static cfar_t   S_CfarWarm;
+static echo_list_t S_Echo;
+static uint     S_uCfarScaleQ4 = CFAR_SCALE_Q4; // -k
+static char     S_sQuietName[BENCH_MAX_QUIET][32];
+
+static double now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// detectors; each streams one window through the ring stand-in and stops at the first detection
+static void window_threshold(const bench_window_t *pW, bench_hit_t *pHit) {
+  capture_host_source(pW->pStream, pW->uN, pW->uBaseline);
+  capture_init(0);
+  capture_start();
+  uint64_t uScanned = 0;
+  pHit->bFound = false;
+  while (capture_host_advance(CAPTURE_BLOCK_LEN)) {
+    uint64_t uDone = capture_samples_done();
+    uint64_t uHit = capture_scan(uScanned, uDone, pW->uBaseline + pW->uThreshold, pW->uBaseline - pW->uThreshold);
+    if (uHit != CAPTURE_NONE) {
+      pHit->bFound = true;
+      pHit->iArrivalQ8 = (int64_t)uHit << DETECT_FRAC_BITS;
+      pHit->uReportIdx = uDone;
+      pHit->uScanned = uHit + 1;
+      break;
+    }
+    uScanned = uDone;
+  }
+  if (!pHit->bFound) pHit->uScanned = uScanned;
+  capture_stop();
+} // end static void window_threshold(...)
+
+static void window_matched(const bench_window_t *pW, bench_hit_t *pHit) {
+  detect_result_t result;
+  capture_host_source(pW->pStream, pW->uN, pW->uBaseline);
+  capture_init(0);
+  capture_start();
+  detect_set_rate(&S_Detect, DAT_SAMPLE_HZ, DETECT_CARRIER_HZ);
+  detect_init(&S_Detect, pW->uBaseline, detect_mag_for_threshold(&S_Detect, pW->uThreshold), 0);
+  pHit->bFound = false;
+  while (capture_host_advance(CAPTURE_BLOCK_LEN)) {
+    uint64_t uDone = capture_samples_done();
+    if (detect_scan_ring(&S_Detect, S_Detect.uIdx, uDone, &result)) {
+      pHit->bFound = true;
+      pHit->iArrivalQ8 = result.iArrivalQ8;
+      pHit->uReportIdx = uDone;
+      break;
+    }
+  }
+  pHit->uScanned = S_Detect.uIdx;
+  capture_stop();
+} // end static void window_matched(...)
+
+static void window_matched_echo(const bench_window_t *pW, bench_hit_t *pHit) {
+  // rcs-rx04-03 MULTI_ECHO; the whole window into the echo list, ranged on its direct path
+  capture_host_source(pW->pStream, pW->uN, pW->uBaseline);
+  capture_init(0);
+  capture_start();
+  detect_set_rate(&S_Detect, DAT_SAMPLE_HZ, DETECT_CARRIER_HZ);
+  detect_init(&S_Detect, pW->uBaseline, detect_mag_for_threshold(&S_Detect, pW->uThreshold), 0);
+  echo_init(&S_Echo);
+  while (capture_host_advance(CAPTURE_BLOCK_LEN)) echo_scan_ring(&S_Echo, &S_Detect, S_Detect.uIdx, capture_samples_done());
+  int iDirect = echo_direct(&S_Echo);
+  pHit->bFound = iDirect >= 0;
+  if (pHit->bFound) pHit->iArrivalQ8 = S_Echo.echo[iDirect].iArrivalQ8;
+  pHit->uReportIdx = S_Detect.uIdx; // the window end
+  pHit->uScanned = S_Detect.uIdx;
+  capture_stop();
+} // end static void window_matched_echo(...)
+
+static void cfar_warm(const bench_window_t *pW) {
+  // seed from the boot levels and track BENCH_WARM quiet samples, as the receiver has before a window
+  uint16_t uBuf[CAPTURE_BLOCK_LEN];
+  cfar_init(&S_CfarWarm, pW->uBaseline, pW->uThreshold);
+  S_CfarWarm.uScaleQ4 = S_uCfarScaleQ4;
+  for (size_t i = 0; i < BENCH_WARM; i += CAPTURE_BLOCK_LEN) {
+    for (uint k = 0; k < CAPTURE_BLOCK_LEN; k++) uBuf[k] = pW->pWarm[(i + k) % pW->uWarm];
+    cfar_update(&S_CfarWarm, uBuf, CAPTURE_BLOCK_LEN);
+  }
+}
+
+static void window_threshold_cfar(const bench_window_t *pW, bench_hit_t *pHit) {
+  // rcs-rx04-03 ADAPTIVE_THRESHOLD without MATCHED_FILTER; levels follow the estimator per block
+  S_Cfar = S_CfarWarm;
+  capture_host_source(pW->pStream, pW->uN, pW->uBaseline);
+  capture_init(0);
+  capture_start();
+  uint64_t uScanned = 0;
+  pHit->bFound = false;
+  while (capture_host_advance(CAPTURE_BLOCK_LEN)) {
+    uint64_t uDone = capture_samples_done();
+    cfar_update_ring(&S_Cfar, uScanned, uDone);
+    uint16_t uMean = cfar_mean(&S_Cfar);
+    uint64_t uHit = capture_scan(uScanned, uDone, uMean + S_Cfar.uThreshold, uMean - S_Cfar.uThreshold);
+    if (uHit != CAPTURE_NONE) {
+      pHit->bFound = true;
+      pHit->iArrivalQ8 = (int64_t)uHit << DETECT_FRAC_BITS;
+      pHit->uReportIdx = uDone;
+      pHit->uScanned = uHit + 1;
+      break;
+    }
+    uScanned = uDone;
+  }
+  if (!pHit->bFound) pHit->uScanned = uScanned;
+  capture_stop();
+} // end static void window_threshold_cfar(...)
+
+static void window_matched_cfar(const bench_window_t *pW, bench_hit_t *pHit) {
+  // rcs-rx04-03 ADAPTIVE_THRESHOLD with MATCHED_FILTER; dc reference fixed for the window
+  detect_result_t result;
+  S_Cfar = S_CfarWarm;
+  capture_host_source(pW->pStream, pW->uN, pW->uBaseline);
+  capture_init(0);
+  capture_start();
+  detect_set_rate(&S_Detect, DAT_SAMPLE_HZ, DETECT_CARRIER_HZ);
+  detect_init(&S_Detect, cfar_mean(&S_Cfar), detect_mag_for_threshold(&S_Detect, S_Cfar.uThreshold), 0);
+  pHit->bFound = false;
+  while (capture_host_advance(CAPTURE_BLOCK_LEN)) {
+    uint64_t uDone = capture_samples_done();
+    cfar_update_ring(&S_Cfar, S_Detect.uIdx, uDone);
+    S_Detect.uMagTrigger = detect_mag_for_threshold(&S_Detect, S_Cfar.uThreshold);
+    if (detect_scan_ring(&S_Detect, S_Detect.uIdx, uDone, &result)) {
+      pHit->bFound = true;
+      pHit->iArrivalQ8 = result.iArrivalQ8;
+      pHit->uReportIdx = uDone;
+      break;
+    }
+  }
+  pHit->uScanned = S_Detect.uIdx;
+  capture_stop();
+} // end static void window_matched_cfar(...)
+
+static bench_detector_t S_Detectors[] = {
+  { "threshold",      window_threshold },
+  { "matched",        window_matched },
+  { "threshold_cfar", window_threshold_cfar, cfar_warm },
+  { "matched_cfar",   window_matched_cfar,   cfar_warm },
+  { "matched_echo",   window_matched_echo },
+};
+#define BENCH_DETECTORS (sizeof(S_Detectors) / sizeof(S_Detectors[0]))
+
+static double samples_per_ft(void) {
+  return (double)BENCH_US_PER_FT * DAT_SAMPLE_HZ / 1e6;
+}
+
+static size_t build_window(const bench_case_t *pC, uint16_t **ppStream, size_t *puLead) {
+  // quiet lead-in for the flight time, capture, quiet tail; returns window length
+  size_t uLead = (size_t)(pC->fFt * samples_per_ft() + 0.5);
+  size_t uN = uLead + pC->uCap + BENCH_TAIL;
+  uint16_t *p = malloc(uN * sizeof(uint16_t));
+  for (size_t i = 0; i < uLead; i++) p[i] = pC->pBase[i % pC->uBase];
+  memcpy(p + uLead, pC->pCap, pC->uCap * sizeof(uint16_t));
+  for (size_t i = 0; i < BENCH_TAIL; i++) p[uLead + pC->uCap + i] = pC->pBase[i % pC->uBase];
+  *ppStream = p;
+  *puLead = uLead;
+  return uN;
+}
+
+static void run_window(bench_detector_t *pD, const bench_window_t *pW, bench_hit_t *pHit) {
+  // time BENCH_REPEAT runs; the result of the last one is kept
+  if (pD->fnPrepare) pD->fnPrepare(pW);
+  double t0 = now_ns();
+  for (uint r = 0; r < BENCH_REPEAT; r++) pD->fnWindow(pW, pHit);
+  pD->fNs += (now_ns() - t0) / BENCH_REPEAT;
+  pD->uSamples += pHit->uScanned;
+}
+
+static void echo_separation(const bench_case_t *pCases, uint uCases, uint16_t uThreshold, double fGain, FILE *fJson) {
+  // each capture plus a copy of itself fGain as strong, delayed by a fraction or multiple of the burst
+  // length. cases: captures found alone whose echo is over the trigger (far ones are not at 0.5).
+  // resolved: an arrival within a quarter burst of both the direct and the echo position;
+  // separation error is the measured minus the true delay, shift how far the echo moved the direct
+  // path from where it is found alone. width is the direct path's, samples
+  static const double fDelays[] = { 0.25, 0.5, 0.75, 1, 1.5, 2, 4, 8 }; // burst lengths
+  const uint uDelays = sizeof(fDelays) / sizeof(fDelays[0]);
+  double fTemplate = (double)DETECT_BURST_CYCLES * DAT_SAMPLE_HZ / DETECT_CARRIER_HZ;
+  double fUsPerSample = 1e6 / DAT_SAMPLE_HZ;
+  printf("# echo separation, gain %.2f, burst %.0f samples\n# delay_bursts\tdelay_us\tcases\tresolved\tsep_err_rms_us"
+         "\tsep_err_max_us\tdirect_shift_rms_us\tdirect_width\n", fGain, fTemplate);
+  if (fJson) fprintf(fJson, "\n  ],\n  \"echo\": [");
+  for (uint d = 0; d < uDelays; d++) {
+    size_t uDelay = (size_t)(fDelays[d] * fTemplate + 0.5);
+    uint uN = 0, uResolved = 0;
+    double fSepSum2 = 0, fSepMax = 0, fShiftSum2 = 0, fWidthSum = 0;
+    for (uint c = 0; c < uCases; c++) {
+      const bench_case_t *pC = &pCases[c];
+      uint16_t *pStream;
+      size_t uLead;
+      bench_window_t w;
+      bench_hit_t hit;
+      w.uN = build_window(pC, &pStream, &uLead);
+      w.pStream = pStream;
+      w.uBaseline = dat_avg(pC->pBase, pC->uBase);
+      w.uThreshold = uThreshold;
+      window_matched_echo(&w, &hit); // alone
+      int iAlone = echo_direct(&S_Echo);
+      if (!hit.bFound || hit.iArrivalQ8 < ((int64_t)uLead - BENCH_FALSE_TOL) << DETECT_FRAC_BITS ||
+          fGain * S_Echo.echo[iAlone].uAmplitude < uThreshold) { // missed alone, or the echo would be under the trigger
+        free(pStream);
+        continue;
+      }
+      double fAlone = (double)hit.iArrivalQ8 / (1 << DETECT_FRAC_BITS);
+      for (size_t i = uDelay; i < pC->uCap + uDelay && uLead + i < w.uN; i++) {
+        int iEcho = (int)(fGain * ((double)pC->pCap[i - uDelay < pC->uCap ? i - uDelay : 0] - w.uBaseline));
+        int iV = pStream[uLead + i] + iEcho;
+        pStream[uLead + i] = iV < 0 ? 0 : (iV > 4095 ? 4095 : iV);
+      }
+      window_matched_echo(&w, &hit);
+      uN++;
+      int iDirect = -1, iEcho = -1;
+      for (uint e = 0; e < S_Echo.uCount; e++) {
+        double fT = (double)S_Echo.echo[e].iArrivalQ8 / (1 << DETECT_FRAC_BITS);
+        if (fabs(fT - fAlone) < fTemplate / 4 && iDirect < 0) iDirect = e;
+        else if (fabs(fT - fAlone - uDelay) < fTemplate / 4 && iEcho < 0) iEcho = e;
+      }
+      if (iDirect >= 0 && iEcho >= 0) {
+        double fDirect = (double)S_Echo.echo[iDirect].iArrivalQ8 / (1 << DETECT_FRAC_BITS);
+        double fSep = ((double)S_Echo.echo[iEcho].iArrivalQ8 / (1 << DETECT_FRAC_BITS) - fDirect - uDelay) * fUsPerSample;
+        double fShift = (fDirect - fAlone) * fUsPerSample;
+        uResolved++;
+        fSepSum2 += fSep * fSep;
+        if (fabs(fSep) > fSepMax) fSepMax = fabs(fSep);
+        fShiftSum2 += fShift * fShift;
+        fWidthSum += S_Echo.echo[iDirect].uWidth;
+      }
+      free(pStream);
+    } // end for (uint c...)
+    double fSepRms = uResolved ? sqrt(fSepSum2 / uResolved) : NAN;
+    double fShiftRms = uResolved ? sqrt(fShiftSum2 / uResolved) : NAN;
+    double fWidth = uResolved ? fWidthSum / uResolved : NAN;
+    printf("%.2f\t%.0f\t%u\t%u\t%.1f\t%.1f\t%.1f\t%.0f\n", fDelays[d], uDelay * fUsPerSample, uN, uResolved,
+           fSepRms, fSepMax, fShiftRms, fWidth);
+    if (fJson) {
+      fprintf(fJson, "%s\n    {\"delay_bursts\": %.2f, \"cases\": %u, \"resolved\": %u, \"sep_err_rms_us\": %.2f, "
+              "\"sep_err_max_us\": %.2f, \"direct_shift_rms_us\": %.2f}", d ? "," : "", fDelays[d], uN, uResolved,
+              isnan(fSepRms) ? 0 : fSepRms, fSepMax, isnan(fShiftRms) ? 0 : fShiftRms);
+    }
+  } // end for (uint d...)
+} // end static void echo_separation(...)
+
+static void gate_add(uint16_t *pStream, size_t uN, size_t uAt, const bench_case_t *pC) {
+  // capture pC, less its own baseline, added into the stream from uAt
+  uint16_t uCapBase = dat_avg(pC->pBase, pC->uBase);
+  for (size_t i = 0; i < pC->uCap && uAt + i < uN; i++) {
+    int iV = pStream[uAt + i] + (int)pC->pCap[i] - uCapBase;
+    pStream[uAt + i] = iV < 0 ? 0 : (iV > 4095 ? 4095 : iV);
+  }
+}
+
+static void track_gating(const bench_case_t *pCases, uint uCases, uint16_t uThreshold, FILE *fJson) {
+  // rcs-rx04-03 window, tracker and gate over a seeded ping sequence; see the header. the residual
+  // is the arrival against the window's reference position, uPre in (the drift tracker is taken as
+  // exact); each capture's own arrival offset is measured alone first, so errors are the tracker's
+  static const char *sModes[] = { "window", "tracked", "gated" };
+  const uint uModes = sizeof(sModes) / sizeof(sModes[0]);
+  const size_t uPre = (size_t)1500 * DAT_SAMPLE_HZ / 1000000;       // rcs-rx04-03 WINDOW_PRE_US
+  const size_t uN = uPre + (size_t)20000 * DAT_SAMPLE_HZ / 1000000; // WINDOW_RANGE_US
+  const uint32_t uGateMin = (uint64_t)(250 + 3 * BENCH_GATE_PERIOD_MS) * DAT_SAMPLE_HZ / 1000000; // GATE_MIN_US, GATE_US_PER_MS
+  uint16_t *pStream = malloc(uN * sizeof(uint16_t));
+  double fOffset[BENCH_MAX_CASES];
+  detect_result_t result;
+  detect_set_rate(&S_Detect, DAT_SAMPLE_HZ, DETECT_CARRIER_HZ);
+  const uint uTail = 2 * S_Detect.uTemplateLen;
+  for (uint c = 0; c < uCases; c++) { // arrival alone, against its placement
+    const bench_case_t *pC = &pCases[c];
+    for (size_t i = 0; i < uN; i++) pStream[i] = pC->pBase[i % pC->uBase];
+    gate_add(pStream, uN, uPre, pC);
+    detect_init(&S_Detect, dat_avg(pC->pBase, pC->uBase), detect_mag_for_threshold(&S_Detect, uThreshold), 0);
+    fOffset[c] = detect_run(&S_Detect, pStream, uN, &result) ? (double)result.iArrivalQ8 / (1 << DETECT_FRAC_BITS) - uPre : NAN;
+  }
+  printf("# gating, %u pings at %ums, %.0f%% interfered, %.0f%% blocked, gate %u samples\n# mode\tpings\tpulses\t"
+         "scanned_per_ping\tns_per_ping\tranges\tok\toutliers\tmissed\trejected\toutlier_rate\terr_rms_us\n",
+         BENCH_GATE_PINGS, BENCH_GATE_PERIOD_MS, BENCH_GATE_SPURIOUS * 100, BENCH_GATE_BLOCKED * 100, uGateMin);
+  if (fJson) fprintf(fJson, "\n  ],\n  \"gating\": [");
+  for (uint m = 0; m < uModes; m++) {
+    track_t track;
+    track_init(&track, uGateMin, uN);
+    srand(BENCH_GATE_SEED); // the same sequence for every mode
+    double fFt = 3, fStep = BENCH_GATE_FT_PER_PING, fNs = 0, fErr2 = 0;
+    uint64_t uScannedSum = 0;
+    uint uPulses = 0, uRanges = 0, uOk = 0, uOutliers = 0, uMissed = 0, uRejected = 0;
+    for (uint k = 0; k < BENCH_GATE_PINGS; k++) {
+      uint c = k % uCases;
+      const bench_case_t *pC = &pCases[c];
+      bool bBlocked = rand() < BENCH_GATE_BLOCKED * RAND_MAX || isnan(fOffset[c]);
+      bool bSpurious = rand() < BENCH_GATE_SPURIOUS * RAND_MAX;
+      size_t uSpurAt = (size_t)rand() % uN;
+      const bench_case_t *pSpur = &pCases[(size_t)rand() % uCases];
+      size_t uLead = uPre + (size_t)(fFt * samples_per_ft() + 0.5);
+      for (size_t i = 0; i < uN; i++) pStream[i] = pC->pBase[i % pC->uBase];
+      if (!bBlocked) gate_add(pStream, uN, uLead, pC);
+      if (bSpurious) gate_add(pStream, uN, uSpurAt, pSpur);
+      uPulses += !bBlocked;
+
+      size_t uScanStart = 0, uScanEnd = uN;
+      if (m == 2 && track.bLocked) { // gated; as rcs-rx04-03 core1_capture_main()
+        int64_t iCenter = (((int64_t)uPre << DETECT_FRAC_BITS) + track.iRangeQ8) >> DETECT_FRAC_BITS;
+        int64_t iGate = track_gate(&track);
+        if (iCenter - iGate > (int64_t)uScanStart) uScanStart = iCenter - iGate;
+        if (iCenter + iGate + uTail < (int64_t)uScanEnd) uScanEnd = iCenter + iGate + uTail;
+        if (uScanEnd < uScanStart) uScanEnd = uScanStart;
+      }
+      double t0 = now_ns();
+      detect_init(&S_Detect, dat_avg(pC->pBase, pC->uBase), detect_mag_for_threshold(&S_Detect, uThreshold), uScanStart);
+      bool bHit = uScanEnd > uScanStart && detect_run(&S_Detect, pStream + uScanStart, uScanEnd - uScanStart, &result);
+      fNs += now_ns() - t0;
+      uScannedSum += (bHit ? S_Detect.uIdx : uScanEnd) - uScanStart;
+      int32_t iResidualQ8 = bHit ? result.iArrivalQ8 - ((int64_t)uPre << DETECT_FRAC_BITS) : 0;
+      if (m > 0 && !track_update(&track, bHit, iResidualQ8) && bHit) {
+        bHit = false; // off the track
+        uRejected++;
+      }
+      if (bHit) {
+        uRanges++;
+        double fErr = (double)iResidualQ8 / (1 << DETECT_FRAC_BITS) - (uLead - uPre) - fOffset[c];
+        if (bBlocked || fabs(fErr) > BENCH_GATE_TOL) {
+          uOutliers++;
+        } else {
+          uOk++;
+          fErr2 += fErr * fErr;
+        }
+      } else if (!bBlocked) {
+        uMissed++;
+      }
+      fFt += fStep; // walk, turning at the ends
+      if (fFt >= 18 || fFt <= 3) fStep = -fStep;
+    } // end for (uint k...)
+    double fRate = uRanges ? (double)uOutliers / uRanges : 0;
+    double fErrRms = uOk ? sqrt(fErr2 / uOk) * 1e6 / DAT_SAMPLE_HZ : 0;
+    printf("%s\t%u\t%u\t%.0f\t%.0f\t%u\t%u\t%u\t%u\t%u\t%.4f\t%.1f\n", sModes[m], BENCH_GATE_PINGS, uPulses,
+           (double)uScannedSum / BENCH_GATE_PINGS, fNs / BENCH_GATE_PINGS, uRanges, uOk, uOutliers, uMissed, uRejected,
+           fRate, fErrRms);
+    if (fJson) {
+      fprintf(fJson, "%s\n    {\"mode\": \"%s\", \"pings\": %u, \"scanned_per_ping\": %.1f, \"ns_per_ping\": %.0f, "
+              "\"ranges\": %u, \"ok\": %u, \"outliers\": %u, \"missed\": %u, \"rejected\": %u, \"outlier_rate\": %.5f}",
+              m ? "," : "", sModes[m], BENCH_GATE_PINGS, (double)uScannedSum / BENCH_GATE_PINGS,
+              fNs / BENCH_GATE_PINGS, uRanges, uOk, uOutliers, uMissed, uRejected, fRate);
+    }
+  } // end for (uint m...)
+  free(pStream);
+} // end static void track_gating(...)
+
+static uint load_cases(const char *sDir, bench_case_t *pCases, uint16_t **ppQuiet, size_t *puQuietLen, uint *puQuiet) {
+  // load the manifest; returns the number of labelled cases, fills the quiet baseline list
+  static const double fDist01[] = { 1, 2, 3, 4, 5, 5 };
+  static const double fDist02[] = { 3, 6, 9, 12, 15, 18, 18, 18 };
+  char sPath[512];
+  uint uCases = 0, uQuiet = 0;
+
+  // exp_dist_01: dist15.dat is the raw log of b1..b6/d1..d6; baseline and triggered sections alternate
+  uint16_t *pLog = NULL;
+  size_t uStarts[16];
+  uint uSections = 0;
+  snprintf(sPath, sizeof(sPath), "%s/exp_dist_01/dist15.dat", sDir);
+  size_t uLog = dat_load_sections(sPath, &pLog, uStarts, 16, &uSections);
+  for (uint i = 0; uLog && i + 1 < uSections && i / 2 < 6; i += 2) {
+    size_t uEnd = (i + 2 < uSections) ? uStarts[i + 2] : uLog;
+    bench_case_t *pC = &pCases[uCases++];
+    pC->sSet = "exp_dist_01";
+    snprintf(pC->sLabel, sizeof(pC->sLabel), "dist15.dat#%u", i / 2 + 1);
+    pC->fFt = fDist01[i / 2];
+    pC->pBase = pLog + uStarts[i] + DAT_SETTLE;
+    pC->uBase = uStarts[i + 1] - uStarts[i] - DAT_SETTLE;
+    pC->pCap = pLog + uStarts[i + 1];
+    pC->uCap = uEnd - uStarts[i + 1];
+  }
+  // exp_dist_02 pairs
+  for (uint n = 1; n <= 8; n++) {
+    bench_case_t *pC = &pCases[uCases];
+    uint16_t *pBase = NULL;
+    snprintf(sPath, sizeof(sPath), "%s/exp_dist_02/b2%u.dat", sDir, n);
+    size_t uBase = dat_load(sPath, &pBase);
+    snprintf(sPath, sizeof(sPath), "%s/exp_dist_02/d2%u.dat", sDir, n);
+    pC->uCap = dat_load(sPath, &pC->pCap);
+    if (uBase <= DAT_SETTLE || !pC->uCap) continue;
+    pC->sSet = "exp_dist_02";
+    snprintf(pC->sLabel, sizeof(pC->sLabel), "d2%u.dat", n);
+    pC->fFt = fDist02[n - 1];
+    pC->pBase = pBase + DAT_SETTLE;
+    pC->uBase = uBase - DAT_SETTLE;
+    uCases++;
+  }
+  // quiet baselines
+  for (uint n = 1; n <= 9 && uQuiet < BENCH_MAX_QUIET; n++) {
+    for (uint e = 1; e <= 2; e++) {
+      uint16_t *p = NULL;
+      if (e == 1) snprintf(sPath, sizeof(sPath), "%s/exp_dist_01/b%u.dat", sDir, n);
+      else snprintf(sPath, sizeof(sPath), "%s/exp_dist_02/b2%u.dat", sDir, n);
+      FILE *f = fopen(sPath, "r");
+      if (!f) continue;
+      fclose(f);
+      size_t uN = dat_load(sPath, &p);
+      if (uN <= DAT_SETTLE) continue;
+      snprintf(S_sQuietName[uQuiet], sizeof(S_sQuietName[0]), "%s", strrchr(sPath, '/') + 1);
+      ppQuiet[uQuiet] = p + DAT_SETTLE;
+      puQuietLen[uQuiet++] = uN - DAT_SETTLE;
+    }
+  }
+  *puQuiet = uQuiet;
+  return uCases;
+} // end static uint load_cases(...)
+
+static void cfar_noise(const uint16_t uFixed, FILE *fJson) {
+  // false alarm rate over a long seeded white noise run; tracked threshold against the fixed one
+  chansim_config_t cfg;
+  chansim_defaults(&cfg);
+  cfg.fNoiseCounts = BENCH_NOISE_SIGMA;
+  cfg.fAmbientCounts = 0;
+  cfg.uBaseline = BENCH_STEP_BASE;
+  chansim_t sim;
+  if (!chansim_init(&sim, &cfg)) return;
+  cfar_t c;
+  cfar_init(&c, BENCH_STEP_BASE, uFixed);
+  c.uScaleQ4 = S_uCfarScaleQ4;
+  uint16_t uBuf[CAPTURE_BLOCK_LEN];
+  uint64_t uIdx = 0, uFalse = 0, uFixedFalse = 0;
+  for (; uIdx < BENCH_WARM; uIdx += CAPTURE_BLOCK_LEN) {
+    chansim_render(&sim, uIdx, uBuf, CAPTURE_BLOCK_LEN);
+    cfar_update(&c, uBuf, CAPTURE_BLOCK_LEN);
+  }
+  for (uint64_t u = 0; u < BENCH_NOISE_LEN; u += CAPTURE_BLOCK_LEN, uIdx += CAPTURE_BLOCK_LEN) {
+    chansim_render(&sim, uIdx, uBuf, CAPTURE_BLOCK_LEN);
+    cfar_update(&c, uBuf, CAPTURE_BLOCK_LEN);
+    int iMean = cfar_mean(&c);
+    for (uint k = 0; k < CAPTURE_BLOCK_LEN; k++) {
+      int iDev = (int)uBuf[k] - iMean;
+      int iFixedDev = (int)uBuf[k] - BENCH_STEP_BASE;
+      if (iDev >= c.uThreshold || iDev <= -(int)c.uThreshold) uFalse++;
+      if (iFixedDev >= uFixed || iFixedDev <= -(int)uFixed) uFixedFalse++;
+    }
+  }
+  chansim_free(&sim);
+  double fSigma = cfar_sigma_q4(&c) / 16.0;
+  printf("noise\t%u\t%u\t%.2f\t%u\t%.4f\t%.2e\t%.2e\n", BENCH_NOISE_LEN, cfar_mean(&c), fSigma, c.uThreshold,
+         c.uThreshold * DAT_ADC_CF, (double)uFalse / BENCH_NOISE_LEN, (double)uFixedFalse / BENCH_NOISE_LEN);
+  if (fJson) {
+    fprintf(fJson, ",\n    {\"baseline\": \"noise\", \"samples\": %u, \"mean\": %u, \"sigma\": %.3f, "
+            "\"threshold\": %u, \"false_per_sample\": %.3e, \"fixed_false_per_sample\": %.3e}", BENCH_NOISE_LEN,
+            cfar_mean(&c), fSigma, c.uThreshold, (double)uFalse / BENCH_NOISE_LEN,
+            (double)uFixedFalse / BENCH_NOISE_LEN);
+  }
+} // end static void cfar_noise(...)
+
+static bool cfar_step(FILE *fJson) {
+  // baseline step response; false if a step does not settle within BENCH_STEP_OK_MS, or leaves more
+  // than BENCH_STEP_OVER_MAX samples beyond the threshold
+  static const int iSteps[] = { 20, 40, 100, -100, 400 };
+  const uint uSteps = sizeof(iSteps) / sizeof(iSteps[0]);
+  const uint64_t uAfter = (uint64_t)BENCH_STEP_MS * CAPTURE_SAMPLE_HZ / 1000;
+  chansim_config_t cfg;
+  chansim_defaults(&cfg);
+  cfg.fNoiseCounts = BENCH_STEP_SIGMA;
+  cfg.fAmbientCounts = 0;
+  cfg.uBaseline = BENCH_STEP_BASE;
+  chansim_t sim;
+  if (!chansim_init(&sim, &cfg)) return false;
+  bool bOk = true;
+  uint64_t uIdx = 0; // rendered, no pings: noise only
+  uint16_t uBuf[CAPTURE_BLOCK_LEN];
+  printf("# cfar step, white noise %d counts rms at %d, seeded threshold %d counts\n"
+         "# step\tsettle_ms\tcensored\tthreshold_max\tover_threshold\tlast_over_ms\n",
+         BENCH_STEP_SIGMA, BENCH_STEP_BASE, BENCH_STEP_SIGMA * S_uCfarScaleQ4 / 16);
+  if (fJson) fprintf(fJson, "\n  ],\n  \"cfar_step\": [");
+  for (uint s = 0; s < uSteps; s++) {
+    cfar_t c;
+    cfar_init(&c, BENCH_STEP_BASE, BENCH_STEP_SIGMA * S_uCfarScaleQ4 / 16);
+    c.uScaleQ4 = S_uCfarScaleQ4;
+    for (uint64_t u = 0; u < BENCH_WARM; u += CAPTURE_BLOCK_LEN, uIdx += CAPTURE_BLOCK_LEN) {
+      chansim_render(&sim, uIdx, uBuf, CAPTURE_BLOCK_LEN);
+      cfar_update(&c, uBuf, CAPTURE_BLOCK_LEN);
+    }
+    const int iLevel = BENCH_STEP_BASE + iSteps[s];
+    const uint64_t uCensored0 = c.uCensored;
+    uint64_t uSettle = UINT64_MAX, uOver = 0, uLastOver = 0;
+    uint16_t uThresholdMax = c.uThreshold;
+    for (uint64_t u = 0; u < uAfter; u += CAPTURE_BLOCK_LEN, uIdx += CAPTURE_BLOCK_LEN) {
+      chansim_render(&sim, uIdx, uBuf, CAPTURE_BLOCK_LEN);
+      for (uint k = 0; k < CAPTURE_BLOCK_LEN; k++) {
+        int v = uBuf[k] + iSteps[s];
+        uBuf[k] = v < 0 ? 0 : v > 4095 ? 4095 : v;
+      }
+      // as the receiver: estimator first, then the block against its levels
+      cfar_update(&c, uBuf, CAPTURE_BLOCK_LEN);
+      int iMean = cfar_mean(&c);
+      for (uint k = 0; k < CAPTURE_BLOCK_LEN; k++) {
+        int iDev = (int)uBuf[k] - iMean;
+        if (iDev >= c.uThreshold || iDev <= -(int)c.uThreshold) {
+          uOver++;
+          uLastOver = u + k + 1;
+        }
+      }
+      if (c.uThreshold > uThresholdMax) uThresholdMax = c.uThreshold;
+      if (abs(iMean - iLevel) > BENCH_STEP_SETTLE) uSettle = UINT64_MAX;
+      else if (uSettle == UINT64_MAX) uSettle = u + CAPTURE_BLOCK_LEN;
+    }
+    double fSettleMs = uSettle == UINT64_MAX ? NAN : uSettle * 1e3 / CAPTURE_SAMPLE_HZ;
+    double fLastOverMs = uLastOver * 1e3 / CAPTURE_SAMPLE_HZ;
+    bOk = bOk && fSettleMs <= BENCH_STEP_OK_MS && uOver <= BENCH_STEP_OVER_MAX;
+    printf("%+d\t%.1f\t%" PRIu64 "\t%u\t%" PRIu64 "\t%.1f\n", iSteps[s], fSettleMs, c.uCensored - uCensored0,
+           uThresholdMax, uOver, fLastOverMs);
+    if (fJson) {
+      fprintf(fJson, "%s\n    {\"step\": %d, \"settle_ms\": %.2f, \"censored\": %" PRIu64 ", \"threshold_max\": %u, "
+              "\"over_threshold\": %" PRIu64 ", \"last_over_ms\": %.2f}", s ? "," : "", iSteps[s],
+              isnan(fSettleMs) ? -1 : fSettleMs, c.uCensored - uCensored0, uThresholdMax, uOver, fLastOverMs);
+    }
+  } // end for (uint s...)
+  chansim_free(&sim);
+  printf("# step %s: settled within %d ms, at most %d samples over threshold\n", bOk ? "ok" : "FAILED",
+         BENCH_STEP_OK_MS, BENCH_STEP_OVER_MAX);
+  return bOk;
+} // end static bool cfar_step(...)
+
+int main(int argc, char **argv) {
+  const char *sDir = "../rcs-rx04-03/mfiles";
+  const char *sJson = NULL;
+  double fThreshold = 0.05; // matches rcs-rx04-03 uAdcThresholdMv, 50 mV through dsp_mv_to_counts()
+  double fEchoGain = BENCH_ECHO_GAIN;
+  for (int i = 1; i + 1 < argc; i += 2) {
+    if (strcmp(argv[i], "-m") == 0) sDir = argv[i + 1];
+    else if (strcmp(argv[i], "-t") == 0) fThreshold = atof(argv[i + 1]);
+    else if (strcmp(argv[i], "-j") == 0) sJson = argv[i + 1];
+    else if (strcmp(argv[i], "-k") == 0) S_uCfarScaleQ4 = atof(argv[i + 1]) * 16 + 0.5;
+    else if (strcmp(argv[i], "-g") == 0) fEchoGain = atof(argv[i + 1]);
+    else {
+      fprintf(stderr, "usage: %s [-m mfiles_dir] [-t volts] [-k sigmas] [-g echo_gain] [-j results.json]\n", argv[0]);
+      return 2;
+    }
+  }
+  bench_case_t cases[BENCH_MAX_CASES];
+  uint16_t *pQuiet[BENCH_MAX_QUIET];
+  size_t uQuietLen[BENCH_MAX_QUIET];
+  uint uQuiet = 0;
+  uint uCases = load_cases(sDir, cases, pQuiet, uQuietLen, &uQuiet);
+  if (!uCases) {
+    fprintf(stderr, "no labelled captures under %s\n", sDir);
+    return 1;
+  }
+  uint16_t uThreshold = fThreshold / DAT_ADC_CF;
+  FILE *fJson = sJson ? fopen(sJson, "w") : NULL;
+  if (fJson) fprintf(fJson, "{\n  \"sample_hz\": %d,\n  \"threshold_v\": %.4f,\n  \"cases\": [", DAT_SAMPLE_HZ, fThreshold);
+
+  printf("# set\tcapture\tdist_ft\tdetector\test_ft\terr_ft\tlatency_us\tresult\n");
+  bool bFirstJson = true;
+  for (uint d = 0; d < BENCH_DETECTORS; d++) {
+    bench_detector_t *pD = &S_Detectors[d];
+    const char *sRefSet = NULL;
+    double fRefFt = 0, fRefFlight = 0;
+    for (uint c = 0; c < uCases; c++) {
+      bench_case_t *pC = &cases[c];
+      uint16_t *pStream;
+      size_t uLead;
+      bench_window_t w;
+      bench_hit_t hit;
+      w.uN = build_window(pC, &pStream, &uLead);
+      w.pStream = pStream;
+      w.uBaseline = dat_avg(pC->pBase, pC->uBase);
+      w.uThreshold = uThreshold;
+      w.pWarm = pC->pBase;
+      w.uWarm = pC->uBase;
+      run_window(pD, &w, &hit);
+
+      const char *sResult = "ok";
+      double fEst = NAN, fErr = NAN, fLatency = NAN;
+      double fFlight = (double)hit.iArrivalQ8 / (1 << DETECT_FRAC_BITS);
+      if (!hit.bFound) {
+        sResult = "missed";
+        pD->uMissed++;
+      } else if (fFlight < (double)uLead - BENCH_FALSE_TOL) {
+        sResult = "false";
+        pD->uFalse++;
+      } else {
+        if (!sRefSet || strcmp(sRefSet, pC->sSet) != 0) { // first capture of an experiment is the reference
+          sRefSet = pC->sSet;
+          fRefFt = pC->fFt;
+          fRefFlight = fFlight;
+        }
+        fEst = fRefFt + (fFlight - fRefFlight) / samples_per_ft();
+        fErr = fEst - pC->fFt;
+        fLatency = ((double)hit.uReportIdx - uLead) * 1e6 / DAT_SAMPLE_HZ;
+        pD->uOk++;
+        pD->fErrSum += fabs(fErr);
+        if (fabs(fErr) > pD->fErrMax) pD->fErrMax = fabs(fErr);
+        pD->fLatencySum += fLatency;
+      }
+      printf("%s\t%s\t%.0f\t%s\t%.3f\t%.3f\t%.0f\t%s\n", pC->sSet, pC->sLabel, pC->fFt, pD->sName,
+             fEst, fErr, fLatency, sResult);
+      if (fJson) {
+        fprintf(fJson, "%s\n    {\"set\": \"%s\", \"capture\": \"%s\", \"dist_ft\": %.1f, \"detector\": \"%s\", "
+                "\"result\": \"%s\"", bFirstJson ? "" : ",", pC->sSet, pC->sLabel, pC->fFt, pD->sName, sResult);
+        if (!isnan(fEst)) fprintf(fJson, ", \"est_ft\": %.4f, \"err_ft\": %.4f, \"latency_us\": %.1f", fEst, fErr, fLatency);
+        fprintf(fJson, "}");
+        bFirstJson = false;
+      }
+      free(pStream);
+    } // end for (uint c...)
+
+    // quiet windows: a full TX_PERIOD of each baseline, tiled; any detection is a false trigger
+    size_t uQuietN = (size_t)BENCH_TX_PERIOD_MS * DAT_SAMPLE_HZ / 1000;
+    uint16_t *pStream = malloc(uQuietN * sizeof(uint16_t));
+    for (uint q = 0; q < uQuiet; q++) {
+      bench_window_t w;
+      bench_hit_t hit;
+      for (size_t i = 0; i < uQuietN; i++) pStream[i] = pQuiet[q][i % uQuietLen[q]];
+      w.pStream = pStream;
+      w.uN = uQuietN;
+      w.uBaseline = dat_avg(pQuiet[q], uQuietLen[q]);
+      w.uThreshold = uThreshold;
+      w.pWarm = pQuiet[q];
+      w.uWarm = uQuietLen[q];
+      if (pD->fnPrepare) pD->fnPrepare(&w);
+      pD->fnWindow(&w, &hit);
+      pD->uQuietWindows++;
+      if (hit.bFound) pD->uQuietFalse++;
+    }
+    free(pStream);
+  } // end for (uint d...)
+
+  printf("# summary\n# detector\tns_per_sample\tmean_abs_err_ft\tmax_abs_err_ft\tmean_latency_us\tok\tfalse\tmissed\tquiet_false\tquiet_windows\n");
+  if (fJson) fprintf(fJson, "\n  ],\n  \"summary\": [");
+  for (uint d = 0; d < BENCH_DETECTORS; d++) {
+    bench_detector_t *pD = &S_Detectors[d];
+    double fNsPerSample = pD->uSamples ? pD->fNs / pD->uSamples : 0;
+    double fErrMean = pD->uOk ? pD->fErrSum / pD->uOk : NAN;
+    double fLatMean = pD->uOk ? pD->fLatencySum / pD->uOk : NAN;
+    printf("%s\t%.2f\t%.3f\t%.3f\t%.0f\t%u\t%u\t%u\t%u\t%u\n", pD->sName, fNsPerSample, fErrMean, pD->fErrMax,
+           fLatMean, pD->uOk, pD->uFalse, pD->uMissed, pD->uQuietFalse, pD->uQuietWindows);
+    if (fJson) {
+      fprintf(fJson, "%s\n    {\"detector\": \"%s\", \"ns_per_sample\": %.3f, \"mean_abs_err_ft\": %.4f, "
+              "\"max_abs_err_ft\": %.4f, \"mean_latency_us\": %.1f, \"ok\": %u, \"false\": %u, \"missed\": %u, "
+              "\"quiet_false\": %u, \"quiet_windows\": %u}", d ? "," : "", pD->sName, fNsPerSample,
+              isnan(fErrMean) ? 0 : fErrMean, pD->fErrMax, isnan(fLatMean) ? 0 : fLatMean, pD->uOk, pD->uFalse,
+              pD->uMissed, pD->uQuietFalse, pD->uQuietWindows);
+    }
+  }
+
+  echo_separation(cases, uCases, uThreshold, fEchoGain, fJson);
+  track_gating(cases, uCases, uThreshold, fJson);
+
+  // cfar on the quiet baselines: estimator state after warm up, and the fraction of samples beyond
+  // the tracked and the fixed threshold (per sample false alarm rate of the threshold detector)
+  printf("# cfar\n# baseline\tsamples\tmean\tsigma\tthreshold\tthreshold_v\tfalse_per_sample\tfixed_false_per_sample\n");
+  if (fJson) fprintf(fJson, "\n  ],\n  \"cfar\": [");
+  size_t uQuietTotal = 0;
+  uint uFalseTotal = 0, uFixedFalseTotal = 0;
+  for (uint q = 0; q < uQuiet; q++) {
+    bench_window_t w = { .uBaseline = dat_avg(pQuiet[q], uQuietLen[q]), .uThreshold = uThreshold,
+                         .pWarm = pQuiet[q], .uWarm = uQuietLen[q] };
+    cfar_warm(&w);
+    uint16_t uMean = cfar_mean(&S_CfarWarm);
+    uint uFalse = 0, uFixedFalse = 0;
+    uQuietTotal += uQuietLen[q];
+    for (size_t i = 0; i < uQuietLen[q]; i++) {
+      int iDev = (int)pQuiet[q][i] - uMean;
+      int iFixedDev = (int)pQuiet[q][i] - w.uBaseline;
+      if (iDev >= S_CfarWarm.uThreshold || iDev <= -(int)S_CfarWarm.uThreshold) uFalse++;
+      if (iFixedDev >= uThreshold || iFixedDev <= -(int)uThreshold) uFixedFalse++;
+    }
+    uFalseTotal += uFalse;
+    uFixedFalseTotal += uFixedFalse;
+    double fSigma = cfar_sigma_q4(&S_CfarWarm) / 16.0;
+    printf("%s\t%zu\t%u\t%.2f\t%u\t%.4f\t%.4f\t%.4f\n", S_sQuietName[q], uQuietLen[q], uMean, fSigma,
+           S_CfarWarm.uThreshold, S_CfarWarm.uThreshold * DAT_ADC_CF, (double)uFalse / uQuietLen[q],
+           (double)uFixedFalse / uQuietLen[q]);
+    if (fJson) {
+      fprintf(fJson, "%s\n    {\"baseline\": \"%s\", \"samples\": %zu, \"mean\": %u, \"sigma\": %.3f, "
+              "\"threshold\": %u, \"false_per_sample\": %.5f, \"fixed_false_per_sample\": %.5f}", q ? "," : "",
+              S_sQuietName[q], uQuietLen[q], uMean, fSigma, S_CfarWarm.uThreshold,
+              (double)uFalse / uQuietLen[q], (double)uFixedFalse / uQuietLen[q]);
+    }
+  }
+  // per file rows are too short for a rate; all of them, then the long noise run
+  printf("b*.dat\t%zu\t-\t-\t-\t-\t%.4f\t%.4f\n", uQuietTotal, (double)uFalseTotal / uQuietTotal,
+         (double)uFixedFalseTotal / uQuietTotal);
+  if (fJson) {
+    fprintf(fJson, ",\n    {\"baseline\": \"b*.dat\", \"samples\": %zu, \"false_per_sample\": %.5f, "
+            "\"fixed_false_per_sample\": %.5f}", uQuietTotal, (double)uFalseTotal / uQuietTotal,
+            (double)uFixedFalseTotal / uQuietTotal);
+  }
+  cfar_noise(uThreshold, fJson);
+  bool bStepOk = cfar_step(fJson);
+  if (fJson) {
+    fprintf(fJson, "\n  ]\n}\n");
+    fclose(fJson);
+  }
+  return bStepOk ? 0 : 1;
+} // end int main(...)
@@ -0,0 +1,98 @@
+// @file rcs-scan-01.c
+// @date 2026.10.17
+// @info host replay of .dat captures through the capture ring block scanner
+// @info each capture is streamed after its baseline file (settling skipped), block by block, exactly as
+// @info the receiver sees the dma ring; reports the first threshold crossing relative to the capture start
+// @info the exp_dist captures are labelled (rcs-dat-01.c G_DatLabels); a crossing outside its window, or
+// @info a crossing on a capture without a burst (exp_dist_01/d4.dat), is a FAIL and the scanner exits 1
+
+// @build mkdir build; cd build; cmake ..; make -j4
+// @usage ./rcs-scan-01 [-t volts] -m mfiles_dir
+// @usage ./rcs-scan-01 [-t volts] <baseline.dat> <capture.dat> [<baseline.dat> <capture.dat> ...]
+// @usage e.g. ./rcs-scan-01 ../../rcs-rx04-03/mfiles/exp_dist_02/b2{1,2}.dat ... (pairs b2N d2N)
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h> // printf("%" PRIu64/d64/x64 "\n", t)
+#include "rcs-dat-01.h"
+#include "rcs-capture-host-01.h"
+
+static int scan_pair(const char *sBase, const char *sCapture, double fThreshold) {
+  // stream baseline then capture through the ring; returns 0 on success, 1 on a load error or a
+  // crossing outside the capture's label
+  uint16_t *pBase = NULL, *pCap = NULL;
+  size_t uBase = dat_load(sBase, &pBase);
+  size_t uCap = dat_load(sCapture, &pCap);
+  if (uBase <= DAT_SETTLE || !uCap) {
+    free(pBase);
+    free(pCap);
+    return 1;
+  }
+  uBase -= DAT_SETTLE; // bias network settling; the receiver baselines after it
+  uint16_t uAvg = dat_avg(pBase + DAT_SETTLE, uBase);
+  uint16_t uThreshold = fThreshold / DAT_ADC_CF;
+  uint16_t uTrigPos = uAvg + uThreshold;
+  uint16_t uTrigNeg = uAvg - uThreshold;
+
+  // one stream: baseline lead-in, capture, then idle at the baseline average
+  size_t uN = uBase + uCap;
+  uint16_t *pStream = malloc(uN * sizeof(uint16_t));
+  memcpy(pStream, pBase + DAT_SETTLE, uBase * sizeof(uint16_t));
+  memcpy(pStream + uBase, pCap, uCap * sizeof(uint16_t));
+
+  capture_host_source(pStream, uN, uAvg);
+  capture_init(0);
+  capture_start();
+  uint64_t uScanned = 0, uHit = CAPTURE_NONE;
+  while (uHit == CAPTURE_NONE && capture_host_advance(CAPTURE_BLOCK_LEN)) {
+    uint64_t uDone = capture_samples_done();
+    uHit = capture_scan(uScanned, uDone, uTrigPos, uTrigNeg);
+    uScanned = uDone;
+  }
+  capture_stop();
+
+  const dat_label_t *pL = dat_find_label(sCapture);
+  const char *sResult = "-";
+  int64_t iRel = (int64_t)uHit - (int64_t)uBase; // negative: false trigger in baseline
+  if (pL && pL->iLo < 0) sResult = uHit == CAPTURE_NONE ? "ok" : "FAIL";
+  else if (pL) sResult = (uHit != CAPTURE_NONE && iRel >= pL->iLo && iRel <= pL->iHi) ? "ok" : "FAIL";
+
+  printf("%s\t%zu\t%u\t", sCapture, uCap, uAvg);
+  if (uHit == CAPTURE_NONE) printf("none\t-\t");
+  else printf("%" PRId64 "\t%" PRId64 "\t", iRel, capture_samples_to_us(iRel));
+  if (!pL) printf("-\t%s\n", sResult);
+  else if (pL->iLo < 0) printf("none\t%s\n", sResult);
+  else printf("%d-%d\t%s\n", pL->iLo, pL->iHi, sResult);
+  free(pStream);
+  free(pBase);
+  free(pCap);
+  return sResult[0] == 'F';
+} // end static int scan_pair(...)
+
+int main(int argc, char **argv) {
+  double fThreshold = 0.05; // matches rcs-rx04-03 uAdcThresholdMv, 50 mV through dsp_mv_to_counts()
+  const char *sDir = NULL;
+  int i = 1;
+  for (; i + 1 < argc && argv[i][0] == '-'; i += 2) {
+    if (strcmp(argv[i], "-t") == 0) fThreshold = atof(argv[i + 1]);
+    else if (strcmp(argv[i], "-m") == 0) sDir = argv[i + 1];
+    else break;
+  }
+  if (sDir ? (argc != i) : ((argc - i) < 2 || (argc - i) % 2)) {
+    fprintf(stderr, "usage: %s [-t volts] -m mfiles_dir | <baseline.dat> <capture.dat> [...]\n", argv[0]);
+    return 2;
+  }
+  printf("# file\tsamples\tbaseline\tfirst_crossing_sample\tfirst_crossing_us\texpected\tresult\n");
+  int iErr = 0;
+  if (sDir) {
+    char sBase[512], sCapture[512];
+    for (uint n = 0; n < G_uDatLabels; n++) {
+      snprintf(sBase, sizeof(sBase), "%s/%s", sDir, G_DatLabels[n].sBase);
+      snprintf(sCapture, sizeof(sCapture), "%s/%s", sDir, G_DatLabels[n].sCapture);
+      iErr |= scan_pair(sBase, sCapture, fThreshold);
+    }
+  }
+  for (; !sDir && i + 1 < argc; i += 2) iErr |= scan_pair(argv[i], argv[i + 1], fThreshold);
+  return iErr;
+}
@@ -0,0 +1,89 @@
+// @file rcs-snap-dec-01.c
+// @date 2026.10.17
+// @info decode the rcs-rx04-03 SNAPSHOT stream (../rcs-common/rcs-snap-01.h) into .rcb archives
+// @info every complete snapshot is written to <dir>/snap-<seq>.rcb at the capture rate, in two
+// @info sections: pre trigger and from the trigger on (the baseline/triggered pair of a .dat), so
+// @info rcs-analyze-01 takes them as they are. one tsv line per snapshot on stdout; input is a capture
+// @info file, stdin, or the receiver's tty (set raw, read live). text and telemetry frames are skipped.
+
+// @usage ./rcs-snap-dec-01 [-d dir] [file | /dev/ttyACM0 | -]
+// @usage e.g. RCS_HOST_ADC=pings.dat RCS_HOST_INPUT=$'p100\rwb\r' ./rcs-rx04-03-host | ./rcs-snap-dec-01 -d /tmp
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <termios.h>
+#include <inttypes.h> // printf("%" PRIu64/d64/x64 "\n", t)
+#include "rcs-archive-01.h"
+#include "../rcs-common/rcs-snap-01.h"
+#include "../rcs-common/rcs-capture-01.h"
+
+static const char *S_sDir = ".";
+
+static const char *reason_name(uint8_t uReason) {
+  switch (uReason) {
+    case SNAP_PULSE:  return "pulse";
+    case SNAP_MISS:   return "miss";
+    case SNAP_MANUAL: return "manual";
+  }
+  return "?";
+}
+
+static void write_snapshot(const snap_header_t *pH, const uint16_t *pSamples, void *pUser) {
+  FILE *f = pUser;
+  char sPath[4096];
+  snprintf(sPath, sizeof(sPath), "%s/snap-%" PRIu32 ".rcb", S_sDir, pH->uSeq);
+  archive_t a = { .pSamples = pSamples, .uSamples = pH->uTotal, .uSampleHz = CAPTURE_SAMPLE_HZ };
+  uint64_t uPre = (pH->uTrigger > pH->uStart) ? pH->uTrigger - pH->uStart : 0;
+  if (uPre > pH->uTotal) uPre = pH->uTotal;
+  a.uStarts[a.uSections++] = 0;
+  if (uPre > 0 && uPre < pH->uTotal) a.uStarts[a.uSections++] = uPre;
+  bool bOk = archive_write(sPath, &a);
+  fprintf(f, "%" PRIu32 "\t%s\t%" PRIu64 "\t%" PRIu64 "\t%u\t%" PRIu64 "\t%s\n", pH->uSeq, reason_name(pH->uReason),
+          (uint64_t)capture_samples_to_us(pH->uTrigger), (uint64_t)capture_samples_to_us(pH->uStart), pH->uTotal, uPre,
+          bOk ? sPath : "-");
+  fflush(f); // live feed
+} // end static void write_snapshot(...)
+
+static void tty_raw(int fd) {
+  // cdc ignores the baud rate; raw mode keeps the line discipline from eating bytes
+  struct termios t;
+  if (tcgetattr(fd, &t) != 0) return;
+  cfmakeraw(&t);
+  t.c_cc[VMIN] = 1;
+  t.c_cc[VTIME] = 0;
+  tcsetattr(fd, TCSANOW, &t);
+}
+
+int main(int argc, char **argv) {
+  const char *sIn = "-";
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "-d") == 0 && i + 1 < argc) {
+      S_sDir = argv[++i];
+    } else if (argv[i][0] == '-' && argv[i][1]) {
+      fprintf(stderr, "usage: %s [-d dir] [file | /dev/ttyACM0 | -]\n", argv[0]);
+      return 2;
+    } else {
+      sIn = argv[i];
+    }
+  }
+  int fd = strcmp(sIn, "-") == 0 ? STDIN_FILENO : open(sIn, O_RDONLY | O_NOCTTY);
+  if (fd < 0) {
+    perror(sIn);
+    return 1;
+  }
+  if (isatty(fd)) tty_raw(fd);
+
+  static snap_decoder_t dec; // a snapshot's worth of samples; off the stack
+  snap_decoder_init(&dec);
+  printf("seq\treason\ttrigger_us\tstart_us\tsamples\tpre_samples\tfile\n");
+  uint8_t uBuf[4096];
+  ssize_t iN;
+  while ((iN = read(fd, uBuf, sizeof(uBuf))) > 0) snap_decode(&dec, uBuf, iN, write_snapshot, stdout);
+
+  fprintf(stderr, "# snapshots %" PRIu32 " frames %" PRIu32 " bad_crc %" PRIu32 " broken %" PRIu32 " skipped_bytes %" PRIu32 "\n",
+          dec.uSnaps, dec.uFrames, dec.uBadCrc, dec.uBroken, dec.uSkipped);
+  return 0;
+}
@@ -0,0 +1,257 @@
+// @file rcs-tdoa-bench-01.c
+// @date 2026.10.17
+// @info host benchmark of round robin capture and per channel detection (../rcs-common/rcs-tdoa-01.c)
+// @info on synthetic multi channel pings: a line of 1..CAPTURE_CHANNELS_MAX receivers -d mm apart, one
+// @info transmitter at a random bearing (+-60 deg from broadside) and range (1-6m). each receiver's
+// @info signal is evaluated at its own conversion slot (channel k of n at ring index i*n + k), so the
+// @info interleaved stream is what the adc fifo would deliver; 40KHz burst through a transducer
+// @info envelope of quality -q (0 ideal), amplitude -a counts less a random 0..-1dB per channel, a
+// @info random +-30 count baseline per channel, gaussian noise -n counts rms, 12 bit quantization
+// @info part 1: per channel count: windows with every channel found, arrival jitter (rms about the
+// @info         mean bias, us), outer pair path difference error (mm) and bearing error (deg), with
+// @info         the conversion slot correction and without it
+// @info part 2: ns per ring sample of tdoa_scan_ring() at 1..CAPTURE_CHANNELS_MAX channels against
+// @info         detect_scan_ring() on the same ring, with pings and without (worst: every sample
+// @info         scanned); the M0+ budget is DETECT_CYCLE_BUDGET cycles
+
+// @usage ./rcs-tdoa-bench-01 [-d spacing_mm] [-q quality] [-a counts] [-n noise_counts] [-t trigger_counts]
+//                            [-w windows] [-s seed]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <math.h>
+#include <inttypes.h> // printf("%" PRIu64/d64/x64 "\n", t)
+#include "rcs-rand-01.h"
+#include "rcs-capture-host-01.h"
+#include "../rcs-common/rcs-tdoa-01.h"
+
+#define BENCH_WINDOW     10000     // 20ms window, ring samples
+#define BENCH_RANGE_MIN  1000.0    // mm
+#define BENCH_RANGE_MAX  6000.0
+#define BENCH_BEARING    60.0      // deg either side of broadside
+#define BENCH_BASELINE   2048
+#define BENCH_SAMPLES    (1u << 22) // throughput run, ring samples
+
+typedef struct {
+  double fSpacing, fQ, fAmp, fNoise;
+  uint   uTrigger, uWindows;
+} bench_config_t;
+
+typedef struct {
+  uint   uFound;
+  double fJitter2, fBias;          // arrival error about its mean; sums
+  double fPath2, fPathMax;         // corrected outer pair path difference error, mm
+  double fBear2, fBearMax;         // corrected bearing error, deg
+  double fRawPath2, fRawBear2;     // slot offset left in
+} bench_stats_t;
+
+static tdoa_t S_Tdoa;
+
+static double now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static double burst(double fT, double fQ) {
+  // received burst at fT seconds after its arrival, unit peak; 8 carrier cycles, the transducer
+  // envelope rising and ringing down with time constant q / (pi f)
+  const double fLen = (double)DETECT_BURST_CYCLES / DETECT_CARRIER_HZ;
+  if (fT < 0) return 0;
+  double fEnv;
+  if (fQ <= 0) {
+    fEnv = fT < fLen ? 1 : 0;
+  } else {
+    double fTau = fQ / (M_PI * DETECT_CARRIER_HZ);
+    double fPeak = 1 - exp(-fLen / fTau);
+    fEnv = fT < fLen ? (1 - exp(-fT / fTau)) / fPeak : exp(-(fT - fLen) / fTau);
+  }
+  return fEnv * sin(2 * M_PI * DETECT_CARRIER_HZ * fT);
+}
+
+static void make_window(const bench_config_t *pCfg, uint uChannels, double fArrival[], uint16_t uBase[],
+                        uint16_t *pRing) {
+  // interleaved ring samples of one ping; fArrival[] is each receiver's true arrival in seconds
+  double fGain[CAPTURE_CHANNELS_MAX];
+  for (uint c = 0; c < uChannels; c++) {
+    fGain[c] = pCfg->fAmp * pow(10, -rand_uniform(0, 1) / 20);
+    uBase[c] = BENCH_BASELINE + (int)lround(rand_uniform(-30, 30));
+  }
+  for (uint i = 0; i < BENCH_WINDOW; i++) {
+    uint c = i % uChannels;
+    double fT = (double)i * CAPTURE_SAMPLE_NS * 1e-9;
+    double v = uBase[c] + fGain[c] * burst(fT - fArrival[c], pCfg->fQ) + pCfg->fNoise * rand_gauss();
+    pRing[i] = v < 0 ? 0 : v > 4095 ? 4095 : (uint16_t)lround(v);
+  }
+}
+
+static bool run_window(const bench_config_t *pCfg, const uint16_t *pBase) {
+  // window through the ring stand-in a block at a time, as core 1 scans it; flush with idle
+  // samples so a burst at the end completes
+  uint uMask = (1u << G_uCaptureChannels) - 1;
+  capture_start();
+  tdoa_init(&S_Tdoa, pBase, pCfg->uTrigger, 0);
+  for (uint i = 0; i < BENCH_WINDOW / CAPTURE_BLOCK_LEN + 2 && S_Tdoa.uFound != uMask; i++) {
+    capture_host_advance(CAPTURE_BLOCK_LEN);
+    tdoa_scan_ring(&S_Tdoa, capture_samples_done());
+  }
+  capture_stop();
+  return S_Tdoa.uFound == uMask;
+}
+
+static void bench_accuracy(const bench_config_t *pCfg, uint uChannels) {
+  uint16_t *pRing = malloc(BENCH_WINDOW * sizeof(uint16_t));
+  uint16_t uBase[CAPTURE_CHANNELS_MAX];
+  double fArrival[CAPTURE_CHANNELS_MAX], fErr[CAPTURE_CHANNELS_MAX];
+  double fMic[CAPTURE_CHANNELS_MAX];
+  double *pErr = malloc(pCfg->uWindows * CAPTURE_CHANNELS_MAX * sizeof(double));
+  uint uErr = 0;
+  bench_stats_t s = { 0 };
+  const double fOuter = (uChannels - 1) * pCfg->fSpacing;
+  for (uint c = 0; c < uChannels; c++) fMic[c] = (c - (uChannels - 1) / 2.0) * pCfg->fSpacing;
+  capture_host_source(pRing, BENCH_WINDOW, BENCH_BASELINE); // before init; no source is the hal clock
+  capture_init_round_robin((1u << uChannels) - 1);
+
+  for (uint w = 0; w < pCfg->uWindows; w++) {
+    double fBearing = rand_uniform(-BENCH_BEARING, BENCH_BEARING) * M_PI / 180;
+    double fRange = rand_uniform(BENCH_RANGE_MIN, BENCH_RANGE_MAX);
+    double fX = fRange * sin(fBearing), fY = fRange * cos(fBearing);
+    for (uint c = 0; c < uChannels; c++) fArrival[c] = hypot(fX - fMic[c], fY) / TDOA_SOUND_MM_S;
+    make_window(pCfg, uChannels, fArrival, uBase, pRing);
+    if (!run_window(pCfg, uBase)) continue;
+    s.uFound++;
+    for (uint c = 0; c < uChannels; c++) {
+      double fUs = (double)S_Tdoa.result[c].iArrivalQ8 / (1 << DETECT_FRAC_BITS) * CAPTURE_SAMPLE_NS / 1000;
+      fErr[c] = fUs - fArrival[c] * 1e6;
+      pErr[uErr++] = fErr[c];
+    }
+    if (uChannels < 2) continue;
+    // outer pair: path to channel 0 over the last one, positive towards the last (+x)
+    uint uLast = uChannels - 1;
+    double fTruePath = (fArrival[0] - fArrival[uLast]) * TDOA_SOUND_MM_S;
+    double fPath = tdoa_path_q8(&S_Tdoa, uLast, 0) / 256.0;
+    double fBear = asin(tdoa_sin_q14(tdoa_path_q8(&S_Tdoa, uLast, 0), lround(fOuter)) / 16384.0) * 180 / M_PI;
+    double fTrueBear = fBearing * 180 / M_PI;
+    s.fPath2 += (fPath - fTruePath) * (fPath - fTruePath);
+    s.fPathMax = fmax(s.fPathMax, fabs(fPath - fTruePath));
+    s.fBear2 += (fBear - fTrueBear) * (fBear - fTrueBear);
+    s.fBearMax = fmax(s.fBearMax, fabs(fBear - fTrueBear));
+    // without the slot correction the last channel reads uLast conversion slots early
+    double fRawPath = fPath + uLast * (double)CAPTURE_SAMPLE_NS * 1e-9 * TDOA_SOUND_MM_S;
+    double fRawSin = fmax(-1, fmin(1, fRawPath / fOuter));
+    double fRawBear = asin(fRawSin) * 180 / M_PI;
+    s.fRawPath2 += (fRawPath - fTruePath) * (fRawPath - fTruePath);
+    s.fRawBear2 += (fRawBear - fTrueBear) * (fRawBear - fTrueBear);
+  } // end for (uint w...)
+
+  for (uint i = 0; i < uErr; i++) s.fBias += pErr[i];
+  if (uErr) s.fBias /= uErr;
+  for (uint i = 0; i < uErr; i++) s.fJitter2 += (pErr[i] - s.fBias) * (pErr[i] - s.fBias);
+  double n = s.uFound ? s.uFound : 1;
+  printf("%u\t%u\t%.1f\t%.2f\t%.2f", uChannels, CAPTURE_SAMPLE_HZ / uChannels / 1000,
+         100.0 * s.uFound / pCfg->uWindows, uErr ? sqrt(s.fJitter2 / uErr) : 0, s.fBias);
+  if (uChannels < 2) printf("\t-\t-\t-\t-\t-\t-\n");
+  else printf("\t%.2f\t%.2f\t%.2f\t%.2f\t%.2f\t%.2f\n", sqrt(s.fPath2 / n), s.fPathMax, sqrt(s.fBear2 / n),
+              s.fBearMax, sqrt(s.fRawPath2 / n), sqrt(s.fRawBear2 / n));
+  free(pErr);
+  free(pRing);
+} // end static void bench_accuracy(...)
+
+static double bench_kernel(const bench_config_t *pCfg, const uint16_t *pStream, uint n, uint *pBursts) {
+  // ns per ring sample of one kernel over pStream; n == 0 the single channel detector directly on the
+  // ring, else tdoa over n channels. both re-arm at each window, as the receiver does, and run on past
+  // a burst only as far as the receiver would: the single channel detector to the window end, a tdoa
+  // channel not at all
+  uint16_t uBase[CAPTURE_CHANNELS_MAX] = { BENCH_BASELINE, BENCH_BASELINE, BENCH_BASELINE };
+  capture_host_source(pStream, BENCH_SAMPLES, BENCH_BASELINE);
+  capture_init_round_robin((1u << (n ? n : 1)) - 1);
+  capture_start();
+  detect_t detect;
+  detect_result_t result;
+  detect_set_rate(&detect, CAPTURE_SAMPLE_HZ, DETECT_CARRIER_HZ);
+  uint32_t uMagTrigger = detect_mag_for_amplitude(&detect, pCfg->uTrigger);
+  detect_init(&detect, BENCH_BASELINE, uMagTrigger, 0);
+  tdoa_init(&S_Tdoa, uBase, pCfg->uTrigger, 0);
+  uint uBursts = 0;
+  uint64_t uRearm = 2 * BENCH_WINDOW;
+  double fNs = 0;
+  while (capture_host_advance(CAPTURE_BLOCK_LEN)) {
+    uint64_t uDone = capture_samples_done();
+    double t0 = now_ns();
+    if (n == 0) {
+      while (detect_scan_ring(&detect, detect.uIdx, uDone, &result)) uBursts++;
+    } else {
+      tdoa_scan_ring(&S_Tdoa, uDone);
+    }
+    fNs += now_ns() - t0;
+    if (uDone >= uRearm) { // next window
+      if (n) uBursts += __builtin_popcount(S_Tdoa.uFound);
+      if (n) tdoa_init(&S_Tdoa, uBase, pCfg->uTrigger, uDone);
+      uRearm += 2 * BENCH_WINDOW;
+    }
+  }
+  capture_stop();
+  *pBursts = uBursts;
+  return fNs / BENCH_SAMPLES;
+} // end static double bench_kernel(...)
+
+static void bench_throughput(const bench_config_t *pCfg) {
+  // ns per ring sample over a stream of pings every 2 windows, and over the same stream without the
+  // pings. a tdoa channel stops at its burst (~5ms into each 40ms), so the ping stream times it on a
+  // fraction of its samples; without bursts every kernel scans every sample, the worst case the
+  // budget must hold
+  uint16_t *pPings = malloc(BENCH_SAMPLES * sizeof(uint16_t));
+  uint16_t *pQuiet = malloc(BENCH_SAMPLES * sizeof(uint16_t));
+  for (uint i = 0; i < BENCH_SAMPLES; i++) {
+    double fT = (double)(i % (2 * BENCH_WINDOW)) * CAPTURE_SAMPLE_NS * 1e-9;
+    double fNoise = pCfg->fNoise * rand_gauss();
+    double v = BENCH_BASELINE + pCfg->fAmp * burst(fT - 0.005, pCfg->fQ) + fNoise;
+    pPings[i] = v < 0 ? 0 : v > 4095 ? 4095 : (uint16_t)lround(v);
+    v = BENCH_BASELINE + fNoise;
+    pQuiet[i] = v < 0 ? 0 : v > 4095 ? 4095 : (uint16_t)lround(v);
+  }
+  printf("# throughput over %u ring samples; worst: no burst, every sample scanned\n", BENCH_SAMPLES);
+  printf("# kernel\tchannels\tns_per_ring_sample\tbursts\tworst_ns_per_ring_sample\n");
+  double fWorst = 0;
+  for (uint n = 0; n <= CAPTURE_CHANNELS_MAX; n++) {
+    uint uBursts, uQuiet;
+    double fNs = bench_kernel(pCfg, pPings, n, &uBursts);
+    double fNsWorst = bench_kernel(pCfg, pQuiet, n, &uQuiet);
+    if (fNsWorst > fWorst) fWorst = fNsWorst;
+    printf("%s\t%u\t%.2f\t%u\t%.2f\n", n ? "tdoa_scan_ring" : "detect_scan_ring", n ? n : 1, fNs, uBursts,
+           fNsWorst);
+  }
+  printf("# worst case %.2f ns/ring sample (host); M0+ budget: %d cycles/sample (%d ns at 125MHz, %d ksps)\n",
+         fWorst, DETECT_CYCLE_BUDGET, CAPTURE_SAMPLE_NS, CAPTURE_SAMPLE_HZ / 1000);
+  free(pPings);
+  free(pQuiet);
+} // end static void bench_throughput(...)
+
+int main(int argc, char **argv) {
+  bench_config_t cfg = { .fSpacing = 100, .fQ = 10, .fAmp = 400, .fNoise = 10, .uTrigger = 100, .uWindows = 500 };
+  unsigned uSeed = RAND_SEED_DEFAULT;
+  for (int i = 1; i + 1 < argc; i += 2) {
+    if (strcmp(argv[i], "-d") == 0) cfg.fSpacing = atof(argv[i + 1]);
+    else if (strcmp(argv[i], "-q") == 0) cfg.fQ = atof(argv[i + 1]);
+    else if (strcmp(argv[i], "-a") == 0) cfg.fAmp = atof(argv[i + 1]);
+    else if (strcmp(argv[i], "-n") == 0) cfg.fNoise = atof(argv[i + 1]);
+    else if (strcmp(argv[i], "-t") == 0) cfg.uTrigger = atoi(argv[i + 1]);
+    else if (strcmp(argv[i], "-w") == 0) cfg.uWindows = atoi(argv[i + 1]);
+    else if (rand_seed_arg(argv[i], argv[i + 1], &uSeed)) continue;
+    else {
+      fprintf(stderr, "usage: %s [-d spacing_mm] [-q quality] [-a counts] [-n noise_counts] [-t trigger_counts]"
+              " [-w windows] [-s seed]\n", argv[0]);
+      return 2;
+    }
+  }
+  srand(uSeed);
+  printf("# spacing %.0fmm q %.0f amplitude %.0f noise %.0f trigger %u windows %u\n",
+         cfg.fSpacing, cfg.fQ, cfg.fAmp, cfg.fNoise, cfg.uTrigger, cfg.uWindows);
+  printf("# channels\tksps\tfound%%\tjitter_us\tbias_us\tpath_rms_mm\tpath_max_mm\tbearing_rms_deg"
+         "\tbearing_max_deg\tuncorrected_path_rms_mm\tuncorrected_bearing_rms_deg\n");
+  for (uint n = 1; n <= CAPTURE_CHANNELS_MAX; n++) bench_accuracy(&cfg, n);
+  bench_throughput(&cfg);
+  return 0;
+} // end int main(...)
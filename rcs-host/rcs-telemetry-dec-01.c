@@ -0,0 +1,86 @@
+// @file rcs-telemetry-dec-01.c
+// @date 2026.10.17
+// @info decode the rcs-rx04-03 TELEMETRY_BINARY stream to csv (../rcs-common/rcs-telemetry-01.h)
+// @info input is a capture file, stdin, or the receiver's tty; a tty is set raw and read live, one
+// @info csv line per record as it arrives. decoder counters go to stderr at the end of input.
+// @info distance_ft is from the frame's ref_us, the receiver's reference distance (CAL_FT, 'c<ft>' or
+// @info the flash record), at the receiver's 1ms/ft; ref_us is its own column.
+
+// @usage ./rcs-telemetry-dec-01 [-o out.csv] [file | /dev/ttyACM0 | -]
+// @usage e.g. RCS_HOST_ADC=rx.dat ./rcs-rx04-03-telemetry-host | ./rcs-telemetry-dec-01
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <termios.h>
+#include <inttypes.h> // printf("%" PRIu64/d64/x64 "\n", t)
+#include "../rcs-common/rcs-telemetry-01.h"
+
+#define DEC_US_PER_FT  1000  // rcs-rx04-03 US_PER_FT approximation: 1ms/ft
+
+typedef struct {
+  FILE                *f;
+  telemetry_decoder_t *pDec; // ref_us of the record's frame
+} dec_csv_t;
+
+static void csv_record(const report_t *pR, void *pUser) {
+  dec_csv_t *pCsv = pUser;
+  FILE *f = pCsv->f;
+  int32_t iRefUs = pCsv->pDec->iRefFlightUs;
+  fprintf(f, "%" PRIu32 ",%" PRIu64 ",", pR->uSeq, pR->uTimeUs);
+  if (pR->uFlags & (REPORT_MISS | REPORT_SYNC)) fprintf(f, ",,");
+  else fprintf(f, "%" PRId64 ",%.3f,", pR->iFlightUs, (double)(pR->iFlightUs + iRefUs) / DEC_US_PER_FT);
+  fprintf(f, "%" PRId32 ",", iRefUs);
+  fprintf(f, "%u,%u,%d,%d,%d\n", pR->uBaseline, pR->uConfidence, !!(pR->uFlags & REPORT_MISS),
+          !!(pR->uFlags & REPORT_REFERENCE), !!(pR->uFlags & REPORT_SYNC));
+  fflush(f); // live feed
+}
+
+static void tty_raw(int fd) {
+  // cdc ignores the baud rate; raw mode keeps the line discipline from eating bytes
+  struct termios t;
+  if (tcgetattr(fd, &t) != 0) return;
+  cfmakeraw(&t);
+  t.c_cc[VMIN] = 1;
+  t.c_cc[VTIME] = 0;
+  tcsetattr(fd, TCSANOW, &t);
+}
+
+int main(int argc, char **argv) {
+  const char *sIn = "-";
+  FILE *fOut = stdout;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+      if (!(fOut = fopen(argv[++i], "w"))) {
+        perror(argv[i]);
+        return 1;
+      }
+    } else if (argv[i][0] == '-' && argv[i][1]) {
+      fprintf(stderr, "usage: %s [-o out.csv] [file | /dev/ttyACM0 | -]\n", argv[0]);
+      return 2;
+    } else {
+      sIn = argv[i];
+    }
+  }
+  int fd = strcmp(sIn, "-") == 0 ? STDIN_FILENO : open(sIn, O_RDONLY | O_NOCTTY);
+  if (fd < 0) {
+    perror(sIn);
+    return 1;
+  }
+  if (isatty(fd)) tty_raw(fd);
+
+  telemetry_decoder_t dec;
+  telemetry_decoder_init(&dec);
+  dec_csv_t csv = { fOut, &dec };
+  fprintf(fOut, "seq,time_us,flight_us,distance_ft,ref_us,baseline,confidence,miss,reference,sync\n");
+  uint8_t uBuf[4096];
+  ssize_t iN;
+  while ((iN = read(fd, uBuf, sizeof(uBuf))) > 0) telemetry_decode(&dec, uBuf, iN, csv_record, &csv);
+
+  fprintf(stderr, "# telemetry frames %" PRIu32 " records %" PRIu32 " bad_crc %" PRIu32 " skipped_bytes %" PRIu32 "\n",
+          dec.uFrames, dec.uRecords, dec.uBadCrc, dec.uSkipped);
+  if (fOut != stdout) fclose(fOut);
+  return 0;
+}
@@ -0,0 +1,192 @@
+// @file rcs-tx-timing-01.c
+// @date 2026.10.17
+// @info transmit waveform timing check over a host gpio trace (RCS_HOST_GPIO_TRACE of rcs-tx01-02-host)
+// @info per burst: carrier (mean over the rising edges of both phases, a half cycle apart), cycles,
+// @info phase high times, minimum dead time between the phases (negative: overlap, both driver legs
+// @info on), edge jitter against the mean carrier grid, the cycle polarities (hex, bit k set when
+// @info cycle k starts with phase b: bpsk coded bursts), pump pre-charge before the burst and pump
+// @info run on after it, and the ping period. exits 1 if a burst is off the expected carrier (-f,
+// @info -t ppm), cycle count (-n) or code (-c, rcs-burst-01.h burst_code(); sets the cycles), the
+// @info phases overlap, or the pump is off before the burst ends.
+
+// @usage RCS_HOST_GPIO_TRACE=tx.trace RCS_HOST_PRESS=5,100,400 RCS_HOST_RUN_MS=10000 ./rcs-tx01-02-host
+// @usage ./rcs-tx-timing-01 [-a gp] [-b gp] [-f hz] [-n cycles] [-c code] [-t ppm] tx.trace
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <math.h>
+#include <inttypes.h> // printf("%" PRIu64/d64/x64 "\n", t)
+#include "../rcs-common/rcs-burst-01.h"
+
+#define TIMING_PWM_ID    0x100 // rcs-hal-host-01.h HAL_PWM_GPIO_BASE + slice 0 (G_GP0)
+
+typedef struct {
+  uint64_t uRise[2 * BURST_CYCLES_MAX]; // rising edges of either phase, one per half cycle
+  uint     uRises;
+  uint32_t uPolarity[BURST_CYCLES_MAX / 32]; // bit k: cycle k starts with phase b
+  uint64_t uLastNs;      // last edge of either phase
+  uint64_t uHighA, uHighB; // summed high time
+  uint     uHighAN, uHighBN;
+  int64_t  iDeadMinNs;
+  uint64_t uChargeOnNs;  // pump on before the burst
+  bool     bCharging;    // pump on at the first edge
+} timing_burst_t;
+
+typedef struct {
+  uint32_t uCarrierHz, uCycles;
+  uint32_t uPolarity[BURST_CYCLES_MAX / 32]; // expected
+  double   fTolPpm;
+  uint     uBursts, uFailed;
+  uint64_t uLastStartNs;
+  double   fCarrierMin, fCarrierMax, fJitterMaxNs;
+  int64_t  iDeadMinNs;
+} timing_check_t;
+
+static void burst_report(timing_check_t *pC, const timing_burst_t *pB, uint64_t uPumpOffNs) {
+  // one tsv line per burst; updates the summary
+  double fCarrier = 0, fJitter = 0;
+  uint uRises = pB->uRises < 2 * BURST_CYCLES_MAX ? pB->uRises : 2 * BURST_CYCLES_MAX;
+  uint uCycles = pB->uRises / 2;
+  if (uRises > 2) {
+    double fHalf = (double)(pB->uRise[uRises - 1] - pB->uRise[0]) / (uRises - 1);
+    fCarrier = 1e9 / (2 * fHalf);
+    for (uint k = 0; k < uRises; k++) {
+      double fDev = fabs(pB->uRise[k] - (pB->uRise[0] + k * fHalf));
+      if (fDev > fJitter) fJitter = fDev;
+    }
+  }
+  double fChargeMs = pB->bCharging ? (pB->uRise[0] - pB->uChargeOnNs) / 1e6 : 0;
+  double fTailUs = ((double)uPumpOffNs - (double)pB->uLastNs) / 1e3;
+  if (uPumpOffNs == UINT64_MAX) fTailUs = NAN; // pump left on
+  double fPeriodMs = pC->uBursts ? (pB->uRise[0] - pC->uLastStartNs) / 1e6 : 0;
+  double fErrPpm = fCarrier ? (fCarrier - pC->uCarrierHz) / pC->uCarrierHz * 1e6 : 0;
+  bool bCode = memcmp(pB->uPolarity, pC->uPolarity, sizeof(pC->uPolarity)) == 0;
+  bool bOk = uCycles == pC->uCycles && !(pB->uRises & 1) && bCode && fabs(fErrPpm) <= pC->fTolPpm &&
+             pB->iDeadMinNs > 0 && pB->bCharging && fTailUs >= 0;
+  printf("%u\t%.6f\t%.3f\t%.1f\t%u\t%.3f\t%.3f\t%" PRId64 "\t%.0f\t", pC->uBursts,
+         pB->uRise[0] / 1e9, fPeriodMs, fCarrier, uCycles,
+         pB->uHighAN ? pB->uHighA / 1e3 / pB->uHighAN : 0, pB->uHighBN ? pB->uHighB / 1e3 / pB->uHighBN : 0,
+         pB->iDeadMinNs, fJitter);
+  int iTop = uCycles ? (uCycles - 1) / 32 : 0;
+  printf("%" PRIx32, pB->uPolarity[iTop]);
+  for (int w = iTop - 1; w >= 0; w--) printf("%08" PRIx32, pB->uPolarity[w]);
+  printf("\t%.3f\t%.1f\t%s\n", fChargeMs, fTailUs, bOk ? "ok" : "FAIL");
+  if (!pC->uBursts || fCarrier < pC->fCarrierMin) pC->fCarrierMin = fCarrier;
+  if (!pC->uBursts || fCarrier > pC->fCarrierMax) pC->fCarrierMax = fCarrier;
+  if (!pC->uBursts || pB->iDeadMinNs < pC->iDeadMinNs) pC->iDeadMinNs = pB->iDeadMinNs;
+  if (fJitter > pC->fJitterMaxNs) pC->fJitterMaxNs = fJitter;
+  pC->uLastStartNs = pB->uRise[0];
+  pC->uBursts++;
+  if (!bOk) pC->uFailed++;
+} // end static void burst_report(...)
+
+static void burst_rise(timing_burst_t *pB, uint64_t uNs, bool bPhaseB) {
+  // a half cycle starts; the first half of cycle k on phase b sets polarity bit k
+  uint uHalf = pB->uRises++;
+  if (uHalf >= 2 * BURST_CYCLES_MAX) return;
+  pB->uRise[uHalf] = uNs;
+  if (!(uHalf & 1) && bPhaseB) pB->uPolarity[uHalf / 64] |= 1u << ((uHalf / 2) % 32);
+}
+
+int main(int argc, char **argv) {
+  uint uGpA = 10, uGpB = 11; // rcs-tx01-02 G_GP10, G_GP11
+  uint uCode = 0;
+  timing_check_t check = { .uCarrierHz = BURST_CARRIER_HZ, .uCycles = BURST_CYCLES, .fTolPpm = 100 };
+  int i = 1;
+  for (; i + 1 < argc; i += 2) {
+    if (strcmp(argv[i], "-a") == 0) uGpA = atoi(argv[i + 1]);
+    else if (strcmp(argv[i], "-b") == 0) uGpB = atoi(argv[i + 1]);
+    else if (strcmp(argv[i], "-f") == 0) check.uCarrierHz = atoi(argv[i + 1]);
+    else if (strcmp(argv[i], "-n") == 0) check.uCycles = atoi(argv[i + 1]);
+    else if (strcmp(argv[i], "-c") == 0) uCode = atoi(argv[i + 1]);
+    else if (strcmp(argv[i], "-t") == 0) check.fTolPpm = atof(argv[i + 1]);
+    else break;
+  }
+  if (i != argc - 1) {
+    fprintf(stderr, "usage: %s [-a gp] [-b gp] [-f hz] [-n cycles] [-c code] [-t ppm] tx.trace\n", argv[0]);
+    return 2;
+  }
+  if (uCode) { // coded burst; expected polarity per cycle
+    check.uCycles = BURST_CODE_CHIPS * BURST_CHIP_CYCLES;
+    for (uint k = 0; k < check.uCycles; k++) {
+      if ((burst_code(uCode) >> (k / BURST_CHIP_CYCLES)) & 1) check.uPolarity[k / 32] |= 1u << (k % 32);
+    }
+  }
+  FILE *f = fopen(argv[i], "r");
+  if (!f) {
+    perror(argv[i]);
+    return 1;
+  }
+
+  // a burst ends when no phase edge follows within 4 carrier periods
+  const uint64_t uGapNs = 4 * 1000000000ull / check.uCarrierHz;
+  timing_burst_t burst = { 0 };
+  bool bInBurst = false, bHighA = false, bHighB = false, bPump = false;
+  uint64_t uFallA = 0, uFallB = 0, uRiseANs = 0, uRiseBNs = 0, uPumpOnNs = 0, uPumpOffNs = 0;
+  uint64_t uNs;
+  uint uGp;
+  int iValue;
+  printf("# expected carrier %" PRIu32 " Hz cycles %" PRIu32 " code %u tolerance %.0f ppm\n", check.uCarrierHz, check.uCycles, uCode, check.fTolPpm);
+  printf("# burst\tstart_s\tperiod_ms\tcarrier_hz\tcycles\ta_high_us\tb_high_us\tdead_min_ns\tjitter_ns\tpolarity\tcharge_ms\ttail_us\tcheck\n");
+  while (fscanf(f, "%" SCNu64 " %u %d", &uNs, &uGp, &iValue) == 3) {
+    if (uGp == TIMING_PWM_ID && !iValue) { // before the burst end check; the pump off may be what ends it
+      bPump = false;
+      uPumpOffNs = uNs;
+    }
+    if (bInBurst && uNs > burst.uLastNs + uGapNs && (uGp == uGpA || uGp == uGpB || uGp == TIMING_PWM_ID)) {
+      burst_report(&check, &burst, bPump ? UINT64_MAX : uPumpOffNs);
+      bInBurst = false;
+    }
+    if (uGp == TIMING_PWM_ID) {
+      if (iValue) {
+        bPump = true;
+        uPumpOnNs = uNs;
+      }
+      continue;
+    }
+    if (uGp != uGpA && uGp != uGpB) continue;
+    if (!bInBurst) {
+      if (!iValue) continue; // bursts start on a rising edge
+      memset(&burst, 0, sizeof(burst));
+      burst.iDeadMinNs = INT64_MAX;
+      burst.bCharging = bPump;
+      burst.uChargeOnNs = uPumpOnNs;
+      uFallB = 0;
+      bInBurst = true;
+    }
+    burst.uLastNs = uNs;
+    if (uGp == uGpA) {
+      if (iValue) {
+        burst_rise(&burst, uNs, false);
+        if (bHighB) burst.iDeadMinNs = -(int64_t)(uNs - uRiseBNs); // overlap
+        else if (uFallB && (int64_t)(uNs - uFallB) < burst.iDeadMinNs) burst.iDeadMinNs = uNs - uFallB;
+        uRiseANs = uNs;
+      } else {
+        burst.uHighA += uNs - uRiseANs;
+        burst.uHighAN++;
+        uFallA = uNs;
+      }
+      bHighA = iValue;
+    } else {
+      if (iValue) {
+        burst_rise(&burst, uNs, true);
+        if (bHighA) burst.iDeadMinNs = -(int64_t)(uNs - uRiseANs);
+        else if ((int64_t)(uNs - uFallA) < burst.iDeadMinNs) burst.iDeadMinNs = uNs - uFallA;
+        uRiseBNs = uNs;
+      } else {
+        burst.uHighB += uNs - uRiseBNs;
+        burst.uHighBN++;
+        uFallB = uNs;
+      }
+      bHighB = iValue;
+    }
+  } // end while (fscanf(...
+  if (bInBurst) burst_report(&check, &burst, bPump ? UINT64_MAX : uPumpOffNs);
+  fclose(f);
+  printf("# summary\n# bursts\tfailed\tcarrier_min_hz\tcarrier_max_hz\tdead_min_ns\tjitter_max_ns\n");
+  printf("%u\t%u\t%.1f\t%.1f\t%" PRId64 "\t%.0f\n", check.uBursts, check.uFailed, check.fCarrierMin,
+         check.fCarrierMax, check.iDeadMinNs, check.fJitterMaxNs);
+  return (check.uFailed || !check.uBursts) ? 1 : 0;
+} // end int main(...)
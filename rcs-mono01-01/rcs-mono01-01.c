@@ -0,0 +1,274 @@
+// @file rcs-mono01-01.c
+// @date 2026.10.17
+
+// @info ultrasound-rangefinder, single board echo ranging (monostatic)
+// @info one pico drives the tx-01 switch pump and burst and captures the echo through the rx-04
+// @info amplifier; flight time is the echo's sample index against the sample the burst was fired at,
+// @info on the same crystal, so there is no tx/rx clock skew to track, no sync pulse and no reference
+// @info capture at a known distance. range is half the round trip at the speed of sound.
+// @info each ping: pump pre-charge (not scanned; the switcher couples into the amplifier, and the last
+// @info ping's reverberation dies meanwhile), burst, blanking of the transducer ring-down, then a
+// @info listening window out to the maximum range; the next ping follows the window at once, so the
+// @info ping rate is set by the range: (+ 10 0.2 (* 2 16 0.889)) 38.6ms, ~26 pings/s at 16ft.
+
+// Copyright 2022 RC Schuler. All rights reserved.
+// Use of this source code is governed by a GNU V3
+// license that can be found in the LICENSE file.
+
+// @build cd build; make -j4 ;# init with mkdir build; cd build; cmake ..
+// @build xfr firmware: boot w/boot_sel, cp -rp <outfile>.uf2 /media/pi/RPI_RP2
+
+// @date 2026.10.17 from rcs-tx01-02 (switch pump, pio burst; ../rcs-common/rcs-pump-01.*) and rcs-rx04-03
+//                  (bias network, capture ring, matched filter, cfar, report queue)
+
+// @require raspi pico (2020); tx-01 and rx-04 circuits on one board, transducers side by side
+// @require pwm output G_GP0 (pin 1) switch pump
+// @require gpio outputs G_GP6, G_GP7 (pins 9, 10) burst clocks; the tx-01 G_GP10/G_GP11 would take
+//          GP11, an rx-04 bias pull down
+// @require adc input GP26_ADC0 (pin 31); gpio 11-13, 18-21 rx-04 bias network (config_rx04_bias())
+// @require leds: 4 bit distance GP2..GP5 (no tx-01 start switch; GP5 is a led), missed echo GP15
+// @require minicom -b 115200 -o -D /dev/ttyACM0 ;# monitor serial i/o; r<ft> range, b<us> blanking,
+//          c<ft> speed of sound from a target at a known distance
+
+// #define MC // mincom support; enables stdio; gates program start prior to mc connection
+#define MONO_RANGE_FT    16     // boot maximum range, ft; the listening window, so the ping rate
+#define MONO_RANGE_MIN   2      // 'r<ft>' limits
+#define MONO_RANGE_MAX   40
+#define MONO_CHARGE_US   10000  // switch pump pre-charge per ping; --dev-- burst amplitude at short charge not measured
+#define MONO_BLANK_US    1500   // after the burst, boot: transducer and amplifier ring-down; 'b<us>'
+#define MONO_BLANK_MAX   10000
+#define MONO_SOUND_MIN   300000 // 'c<ft>' limits, mm/s; (-40C..60C)
+#define MONO_SOUND_MAX   380000
+#define MONO_FT_UM       304800 // micrometres per ft
+#define MISSED_PULSE -9999
+#define ADAPTIVE_THRESHOLD // track baseline and noise, cfar trigger levels (rcs-cfar-01.h); undefine for the fixed boot levels
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <inttypes.h> // printf("%" PRIu64/d64/x64 "\n", t)
+#include "../rcs-common/rcs-hal-01.h"     // pico sdk or host backend; gpio, adc, pwm, pio burst, usb
+#include "../rcs-common/rcs-utils-01.h"   // global extern: G_LED_PIN, G_uBuf, G_uBufCt; bias network
+#include "../rcs-common/rcs-capture-01.h" // adc/dma capture ring, block scanner
+#include "../rcs-common/rcs-detect-01.h"  // matched filter burst detector
+#include "../rcs-common/rcs-dsp-01.h"     // fixed point scaling, DSP_SOUND_MM_S
+#include "../rcs-common/rcs-cfar-01.h"    // adaptive baseline, cfar threshold
+#include "../rcs-common/rcs-report-01.h"  // core 1 -> core 0 report queue
+#include "../rcs-common/rcs-pump-01.h"    // switch pump pwm and pio burst
+
+// globals
+// - core 1 ping, capture and detection
+pump_t   G_Pump;           // pump and burst pattern; core 1 only after boot
+uint16_t G_uAdcBaseline;   // matched filter dc reference
+uint32_t G_uMagTrigger;    // matched filter magnitude equivalent of threshold
+uint8_t  G_uDetectConfidence; // 0-255 confidence of the last echo
+cfar_t   G_Cfar;           // running baseline/noise estimate; core 1 only
+detect_t G_Detect;         // matched filter state; core 1 only
+volatile uint32_t G_uRangeFt = MONO_RANGE_FT; // set by core 0 ('r<ft>'), taken at the next ping
+volatile uint32_t G_uBlankUs = MONO_BLANK_US; // set by core 0 ('b<us>')
+volatile uint32_t G_uSoundMmS = DSP_SOUND_MM_S; // set by core 0 ('c<ft>'); range to window length
+// - core 1 -> core 0 reports
+report_queue_t G_ReportQueue; // lock-free spsc; core 1 pushes, core 0 pops
+// - core 0 reporting
+int64_t G_iRoundTripUs = MISSED_PULSE; // last echo
+// gpio general; 4 bit led distance display in ../rcs-common/rcs-utils-01.* (as rcs-rx04-03)
+const uint G_GP15_MISS   = 15; // pin 20 // missed echo
+// transmitter
+const uint G_GP0 = 0;   // pin 1 pwm out chan A
+const uint G_GP6 = 6;   // pin 9 vin clock
+const uint G_GP7 = 7;   // pin 10 vinb clock
+
+// functions
+static inline uint64_t us_to_samples(uint64_t uUs) {
+  return uUs * 1000 / CAPTURE_SAMPLE_NS;
+}
+
+static inline uint64_t round_trip_us(uint64_t uUm, uint32_t uSoundMmS) {
+  // there and back over uUm micrometres
+  return 2 * uUm * 1000 / uSoundMmS;
+}
+
+void update_triggers(uint64_t uFrom, uint64_t uTo) {
+  // core 1; feed capture range [uFrom, uTo) to the baseline/noise estimator and move the trigger
+  // level with it; the matched filter dc reference is taken up at the next window (rcs-rx04-03)
+  #if defined(ADAPTIVE_THRESHOLD)
+  cfar_update_ring(&G_Cfar, uFrom, uTo);
+  G_uAdcBaseline = cfar_mean(&G_Cfar);
+  G_uMagTrigger = detect_mag_for_threshold(&G_Detect, G_Cfar.uThreshold);
+  G_Detect.uMagTrigger = G_uMagTrigger;
+  #endif
+} // end void update_triggers(...)
+
+void wait_samples(uint64_t uIdx) {
+  // core 1; spin until the capture ring has written sample uIdx
+  while ( capture_samples_now() <= uIdx ) ;
+}
+
+int64_t get_echo_arrival(uint64_t uBlankFrom, uint64_t uStartSample, uint64_t uEndSample) {
+  // first echo in the window [uStartSample, uEndSample). the filter runs over the end of the
+  // blanking, [uBlankFrom, uStartSample), so its boxcar is full at the window start, and holds off
+  // on what is left of the ring-down (detect_blank). the trigger levels are fed from the window
+  // only: the pre-charge and burst samples are pump and transmit noise. returns the absolute
+  // arrival sample, Q8, or -1 if there is none or the ring was overrun
+  detect_result_t result;
+  detect_init(&G_Detect, G_uAdcBaseline, G_uMagTrigger, uBlankFrom);
+  while ( capture_samples_done() < uStartSample ) ; // blanking tail complete
+  if ( capture_overrun(uBlankFrom, capture_samples_done()) ) return -1;
+  detect_blank(&G_Detect, uBlankFrom, uStartSample);
+  uint64_t uScanned = uStartSample;
+  while ( uScanned < uEndSample ) {
+    uint64_t uDone = capture_samples_done();
+    if ( uDone > uEndSample ) uDone = uEndSample;
+    if ( uDone <= uScanned ) continue;      // block in progress
+    if ( capture_overrun(uScanned, uDone) ) return -1; // scanner lapped by dma; samples lost
+    update_triggers(uScanned, uDone);
+    while ( uScanned < uDone && detect_scan_ring(&G_Detect, uScanned, uDone, &result) ) {
+      if ( result.iArrivalQ8 >= (int64_t)uStartSample << DETECT_FRAC_BITS ) { // echo received
+        G_uDetectConfidence = result.uConfidence;
+        return result.iArrivalQ8;
+      }
+      uScanned = G_Detect.uIdx; // starts in the blanking: the tail of an echo under it; on past its peak
+    }
+    uScanned = uDone;
+  }
+  return -1;
+} // end int64_t get_echo_arrival(...)
+
+void core1_ping_main() {
+  // core 1: sends each ping and listens for its echo; one report per ping. the burst is fired
+  // from here and timestamped on the capture sample clock, so the round trip is a sample index
+  // difference like the rx04 flight time. never touches stdio; the leds are core 0's
+  report_t report = { 0 };
+  pump_set_burst(&G_Pump, BURST_CARRIER_HZ, BURST_CYCLES, 0);
+
+  while (true) {
+    const uint32_t uRangeFt = G_uRangeFt, uBlankUs = G_uBlankUs;
+    // pre-charge; pump on, nothing scanned
+    pump_charge(&G_Pump, true);
+    wait_samples(capture_samples_now() + us_to_samples(MONO_CHARGE_US));
+    uint64_t uFire = capture_samples_now();  // burst start; the pio starts within a few clocks
+    uint32_t uBurstUs = pump_fire(&G_Pump);
+    wait_samples(uFire + us_to_samples(uBurstUs + PUMP_BURST_TAIL_US));
+    pump_charge(&G_Pump, false);
+    // listen from the end of the blanking to the round trip at uRangeFt, plus the burst so an echo
+    // at the maximum range completes. the detector starts a burst length ahead, in the blanking
+    uint64_t uStart = uFire + us_to_samples(uBurstUs + uBlankUs);
+    uint64_t uEnd = uFire + us_to_samples(round_trip_us((uint64_t)uRangeFt * MONO_FT_UM, G_uSoundMmS) + uBurstUs);
+    int64_t iArrivalQ8 = -1;
+    if ( uEnd > uStart ) iArrivalQ8 = get_echo_arrival(uStart - G_Detect.uTemplateLen, uStart, uEnd);
+    report.uSeq++;
+    report.uTimeUs = capture_samples_to_us(uFire);
+    report.uBaseline = G_uAdcBaseline;
+    if ( iArrivalQ8 < 0 ) {
+      report.uFlags = REPORT_MISS;
+      report.uConfidence = 0;
+      report.iFlightUs = MISSED_PULSE;
+    } else { // round trip; the fire sample is exact, the burst start is not interpolated
+      report.uFlags = 0;
+      report.uConfidence = G_uDetectConfidence;
+      report.iFlightUs = ((iArrivalQ8 - ((int64_t)uFire << DETECT_FRAC_BITS)) * CAPTURE_SAMPLE_NS / 1000) >> DETECT_FRAC_BITS;
+    }
+    report_queue_push(&G_ReportQueue, &report);
+  } // end while (true)
+} // end void core1_ping_main()
+
+void report_range(const report_t *pReport) {
+  // core 0: leds and serial output for one report; range is half the round trip
+  hal_gpio_put(G_GP15_MISS, (pReport->uFlags & REPORT_MISS) != 0);
+  if ( pReport->uFlags & REPORT_MISS ) return;
+  G_iRoundTripUs = pReport->iFlightUs;
+  int32_t iMm = (int32_t)(G_iRoundTripUs * G_uSoundMmS / 2000000);
+  int iDistance = dsp_div_round(iMm * 1000, MONO_FT_UM); // nearest ft
+  gpio_led_int_to_bin4(iDistance);
+  #if defined(MC)
+  printf("Distance:\t%3d ft\t%5" PRId32 " mm\t%" PRId64 " uSec round trip\tconf %u\n", iDistance, iMm,
+         G_iRoundTripUs, pReport->uConfidence);
+  #endif
+} // end void report_range(...)
+
+void print_settings() {
+  // core 0; the minimum range is the burst and the blanking
+  #if defined(MC)
+  uint32_t uMinUs = (uint32_t)BURST_CYCLES * 1000000 / BURST_CARRIER_HZ + G_uBlankUs;
+  printf("range:\t%" PRIu32 " ft\tblank %" PRIu32 " us\tsound %" PRIu32 " mm/s\tmin range %" PRIu32 " mm\tping %" PRIu64
+         " us\n", G_uRangeFt, G_uBlankUs, G_uSoundMmS, (uint32_t)((uint64_t)uMinUs * G_uSoundMmS / 2000000),
+         MONO_CHARGE_US + round_trip_us((uint64_t)G_uRangeFt * MONO_FT_UM, G_uSoundMmS) + (uMinUs - G_uBlankUs));
+  #endif
+}
+
+void mono_command(const char *sLine) {
+  // core 0 serial commands: r<ft> maximum range (ping rate), b<us> blanking after the burst, c<ft> the
+  // last echo is from a target at <ft>: speed of sound from its round trip (temperature)
+  long lValue = strtol(sLine + 1, NULL, 10);
+  if ( sLine[0] == 'r' && lValue >= MONO_RANGE_MIN && lValue <= MONO_RANGE_MAX ) {
+    G_uRangeFt = lValue;
+  } else if ( sLine[0] == 'b' && lValue >= 0 && lValue <= MONO_BLANK_MAX ) {
+    G_uBlankUs = lValue;
+  } else if ( sLine[0] == 'c' && lValue > 0 && G_iRoundTripUs > 0 ) {
+    int64_t iMmS = (int64_t)lValue * 2 * MONO_FT_UM * 1000 / G_iRoundTripUs;
+    if ( iMmS < MONO_SOUND_MIN || iMmS > MONO_SOUND_MAX ) return;
+    G_uSoundMmS = iMmS;
+  } else {
+    return;
+  }
+  print_settings();
+} // end void mono_command(...)
+
+int main() {
+#ifndef PICO_DEFAULT_LED_PIN
+#warning Error: requires board with integrated LED defined as PICO_DEFAULT_LED_PIN
+#else
+  const uint uAdcThresholdMv = 50; // boot trigger level over the average; cfar takes over
+  const uint GP26_ADC0 = 26;       // pin 31
+  const uint uNsettle = 128;       // 1/2 length of initial ADC settling capture
+  const char *sLine;               // serial command line
+
+  // initialize board LED as progress indicator; lit while the pump charges from here on
+  hal_gpio_init(G_LED_PIN);
+  hal_gpio_set_dir(G_LED_PIN, HAL_GPIO_OUT);
+  hal_gpio_put(G_LED_PIN, 1);
+  hal_gpio_init(G_GP15_MISS);
+  hal_gpio_set_dir(G_GP15_MISS, HAL_GPIO_OUT);
+  hal_gpio_put(G_GP15_MISS, 0);
+  gpio_led_bin4_init();
+
+  hal_stdio_init();
+  #if defined(MC)
+  tusb_wait_for_connection();
+  printf("rcs-mono01-01 single board echo ranging\n");
+  #endif
+
+  // transmitter first: the pump pwm is held low from here
+  if ( !pump_init(&G_Pump, G_GP0, G_GP6, G_LED_PIN) ) {
+    #if defined(MC)
+    printf("--error-- no pio state machine for the burst\n");
+    #endif
+    while (true) flash_led_16hz();
+  }
+
+  // receiver: adc, bias network, baseline with the pump quiet (rcs-rx04-03)
+  hal_adc_init();
+  hal_adc_gpio_init(GP26_ADC0);
+  capture_init(0);
+  config_rx04_bias();
+  adc_avg_n(uNsettle); // settle
+  uint16_t adc_avg = adc_avg_n(uNsettle);
+  uint16_t adc_threshold = dsp_mv_to_counts(uAdcThresholdMv);
+  capture_start();
+  G_uAdcBaseline = adc_avg;
+  detect_set_rate(&G_Detect, CAPTURE_SAMPLE_HZ, DETECT_CARRIER_HZ);
+  G_uMagTrigger = detect_mag_for_threshold(&G_Detect, adc_threshold);
+  cfar_init(&G_Cfar, adc_avg, adc_threshold);
+  hal_gpio_put(G_LED_PIN, 0);
+  print_settings();
+
+  // core 1 pings and listens from here
+  hal_multicore_launch_core1(core1_ping_main);
+
+  while (true) {
+    report_t report;
+    while ( report_queue_pop(&G_ReportQueue, &report) ) report_range(&report);
+    if ( (sLine = get_serial_line()) ) mono_command(sLine);
+    hal_sleep_ms(1);
+  }
+#endif // end #ifndef PICO_DEFAULT_LED_PIN
+}
@@ -23,6 +23,66 @@
 //                  reduced TX_PERIOD from 4000 to 2000 (tx and rx); moved G_bFlightTimeBusySemaphore reset (false) inside get_flight_time()
 //                  added ( uLocalFlightTimeSemaphore != G_uFlightTimeSemaphore ) test before processing valid pulse;
 //                  changed busy_wait_ms() to sleep_ms() in infinte while loop
+// @date 2026.10.17 replaced polled adc_read()/time_us_64() with the free-running dma capture ring
+//                  (../rcs-common/rcs-capture-01.*); flight time is now a sample index difference
+// @date 2026.10.17 added MATCHED_FILTER burst detection (../rcs-common/rcs-detect-01.*); sub-sample
+//                  flight time and G_uDetectConfidence. off by default: on the recorded captures it finds
+//                  no echo first threshold crossing misses (neither finds the weak 4ft exp_dist_01 #4)
+// @date 2026.10.17 pico sdk calls moved behind ../rcs-common/rcs-hal-01.h; builds natively in ../rcs-host
+// @date 2026.10.17 dual core: core 1 captures and detects, paced by the capture sample clock; reports
+//                  go to core 0 through a spsc queue (rcs-report-01.h) for leds and serial. the
+//                  repeating timer irq and G_bFlightTimeBusySemaphore/G_uFlightTimeSemaphore are gone
+// @date 2026.10.17 TELEMETRY_BINARY: framed binary reports (../rcs-common/rcs-telemetry-01.*), decode on
+//                  the host with ../rcs-host/rcs-telemetry-dec-01
+// @date 2026.10.17 ADAPTIVE_THRESHOLD: baseline and trigger levels track the quiet signal (cfar,
+//                  ../rcs-common/rcs-cfar-01.*) instead of being fixed at boot; adc_avg_n() is a true mean.
+//                  with it first threshold crossing finds every recorded echo (../rcs-host/rcs-replay-bench-01:
+//                  threshold_cfar 14 of 14, matched_cfar 13), so MATCHED_FILTER stays off
+// @date 2026.10.17 fixed TX_RX_SKEW per period correction (error grew with run length) replaced by the
+//                  drift tracker (../rcs-common/rcs-drift-01.*), TX_RX_SKEW is its prior; windows
+//                  follow the tracked tx period
+// @date 2026.10.17 high-rate mode: ping period set at runtime ('p<ms>' on serial, TX_PERIOD_MIN..TX_PERIOD_MAX,
+//                  send the same to rcs-tx01-02); windows are gated per ping, [predicted - WINDOW_PRE_US,
+//                  predicted + WINDOW_RANGE_US), so late echoes fall outside; a period change re-syncs,
+//                  as does a sync pulse not followed by a reference (SYNC_LOST); sync uses the matched filter
+//                  and the estimator keeps tracking between windows; drift updates stay ~TX_PERIOD apart (stride)
+// @date 2026.10.17 no float math left on the receive path: threshold in mV through dsp_mv_to_counts(), led and
+//                  serial distance rounded in integer feet (../rcs-common/rcs-dsp-01.*)
+// @date 2026.10.17 INSTR: core 1 hot path histograms (window start latency, scan backlog against the ring,
+//                  processing time, samples scanned, idle polls) and outcome counters (pulse, timeout,
+//                  overrun, resync); 's' on serial dumps them from core 0, 's0' dumps and clears
+//                  (../rcs-common/rcs-instr-01.*)
+// @date 2026.10.17 fast lock: trigger level, tx/rx clock offset and reference distance kept in a flash record
+//                  (../rcs-common/rcs-calib-01.*). restored at boot, the drift tracker starts tracking
+//                  without the acquisition hold, the reference need not be at CAL_FT ('c<ft>' sets its
+//                  distance) and the reference led flashes are skipped; saved by 'c' on serial and
+//                  unasked at most once per boot, when the first acquired clock offset is off the record.
+//                  the first valid range time is reported
+// @date 2026.10.17 MULTI_ECHO: the matched filter scans the whole window and keeps every arrival, ranked, with
+//                  amplitude and width (../rcs-common/rcs-echo-01.*); the range is the direct path
+//                  (echo_direct), the other arrivals ride along in the report ("Echoes:" on serial)
+// @date 2026.10.17 SNAPSHOT: raw adc windows around a pulse, a miss or a request, from a history ring core 1
+//                  fills as it scans (../rcs-common/rcs-snap-01.*); core 0 streams them as binary frames
+//                  between reports, decode on the host with ../rcs-host/rcs-snap-dec-01. 'w' on serial
+//                  takes one now, 'wd'/'wm'/'wb'/'w0' trigger on pulses/misses/both/off, 'wl<pre_us>,<post_us>'
+// @date 2026.10.17 TRACK_GATE: alpha-beta range tracker on the flight residual (../rcs-common/rcs-track-01.*);
+//                  once locked the detector scans a gate around the predicted arrival, not the window,
+//                  widened per miss and while the target turns, dropped after TRACK_LOST; arrivals off
+//                  the track are rejected as misses before they reach the drift tracker. INSTR counts
+//                  them ('outliers'); MULTI_ECHO keeps its whole window and only the rejection applies
+// @date 2026.10.17 DUTY_CYCLE: low power receive ('l1' on serial, 'l0' off): between windows core 1 powers the
+//                  adc down and sleeps (wfe) until DUTY_WAKE_US before the next scan, the sample index carried
+//                  on the timer (../rcs-common/rcs-capture-01.*); the estimator, drift and range trackers keep
+//                  their state, no re-baseline; a gate scanned after a sleep does not feed the cfar estimator
+//                  (its ring-down would outweigh the lead). awake and asleep time per ping (../rcs-common/
+//                  rcs-duty-01.*) dumped with 's'; the host build reports core and adc duty in its summary
+// @date 2026.10.17 STACK: coherent multi-ping stacking ('n<N>' on serial, N 1..32 a power of 2, 'n1' off at boot):
+//                  each window is added into a per position exponential sum of the last N windows, placed on
+//                  the tx clock, and the threshold scan (or the matched filter) runs on the stack, scaled to one
+//                  ping's noise so the cfar trigger holds (../rcs-common/rcs-stack-01.*); (sqrt 15) 3.9x the
+//                  amplitude at N 8 for a stationary target. the whole window is scanned while stacking, no
+//                  track gate. from a sync the first STACK_WARM * N windows are misses (the gain still builds
+//                  and the crossing moves with it), and N misses in a row on a warm stack re-sync
 
 // @require raspi pico (2020)
 // @require hardware: subject: "rx-04 layout design 2021.08.06" https://mail.google.com/mail/u/1/#label/design...
@@ -39,206 +99,755 @@
 
 // @info see s*r*.txt for dev info
 // #define MC // mincom support; enables stdio; gates program start prior to mc connection; see also ../rcs-common sources
-#define TX_PERIOD 2000 // mus match rcs-tx01-xx.c (original was 4000)
+#define TX_PERIOD 2000 // mus match rcs-tx01-xx.c (original was 4000); boot ping period, ms
+#define TX_PERIOD_MIN 25    // ms; 'p<ms>' limits, match rcs-tx01-02
+#define TX_PERIOD_MAX 10000
+#define TX_PERIOD_LEDS 250  // ms; shorter periods skip the 16Hz led flash sequences (~190ms each)
+#define WINDOW_PRE_US 1500    // window opens this long before the predicted reference arrival (capped at period/3)
+#define WINDOW_RANGE_US 20000 // and extends this far past it; (* 20 889) 17.8ms flight at 20ft, plus margin
+#define SYNC_LOST 3           // windows without a pulse before the reference; the sync pulse was noise, re-sync
 #define MISSED_PULSE -9999
-#define TX_RX_SKEW -10 // --20211018-- was TX_RX_SKEW -16
+#define US_PER_FT 1000 // approx 1ms/ft sound in air; distance display
+#define CAL_FT 1       // distance of the reference (first) capture, ft; without a flash record
+#define CALIB_PPM_SAVE 1 // ppm; the boot's first acquired clock offset this far from the flash record is saved
+#define TX_RX_SKEW -10 // us per period; drift tracker prior (rcs-drift-01.h), was a fixed correction; --20211018-- was -16
+// #define MATCHED_FILTER // correlate against the tx burst; off: first threshold crossing (best on the recorded data)
+#define ADAPTIVE_THRESHOLD // track baseline and noise, cfar trigger levels (rcs-cfar-01.h); undefine for the fixed boot levels
+// #define TELEMETRY_BINARY // framed binary reports on usb (rcs-telemetry-01.h) instead of Distance text; independent of MC
+#define INSTR // hot path histograms and counters (rcs-instr-01.h); 's' on serial dumps them
+// #define MULTI_ECHO // every arrival in the window, not the first (rcs-echo-01.h); needs MATCHED_FILTER
+#define SNAPSHOT // pre/post trigger adc snapshots streamed on usb (rcs-snap-01.h); 'w' on serial, none until asked
+#define SNAP_FRAMES_PER_PASS 4 // snapshot frames per core 0 pass; (* 4 223) ~0.9KB per ms, reports go between
+#define TRACK_GATE // scan a gate around the tracked arrival (rcs-track-01.h); undefine for the whole window
+#define GATE_MIN_US 250    // gate half width once locked, plus GATE_US_PER_MS per ms of period (speed change)
+#define GATE_US_PER_MS 3   // (* 3 100) 300us more at p100, 6ms at 2000ms; (/ 3e-3 2.9e-3) 1.0m/s (3.4ft/s) per ping
+#define DUTY_CYCLE // low power between windows (rcs-duty-01.h); 'l1'/'l0' on serial, off at boot
+#define DUTY_WAKE_US 1000      // wake before the scan: adc power up, 2 ring blocks of noise for the estimator
+#define DUTY_MIN_SLEEP_US 2000 // shorter gaps stay awake; 25ms periods have (- 25 21.5) 3.5ms
+#define STACK // multi-ping stacking (rcs-stack-01.h); 'n<N>' on serial, off at boot; not with MULTI_ECHO
 
-#include "pico/stdlib.h"
 #include <stdio.h>
 #include <stdlib.h>
-#include "hardware/gpio.h"
-#include "hardware/adc.h"
 #include <inttypes.h> // printf("%" PRIu64/d64/x64 "\n", t)
+#include "../rcs-common/rcs-hal-01.h"   // pico sdk or host backend; gpio, adc, timer, usb
 #include "../rcs-common/rcs-utils-01.h" // global extern: G_LED_PIN, G_uBuf, G_uBufCt
+#include "../rcs-common/rcs-capture-01.h" // adc/dma capture ring, block scanner
+#include "../rcs-common/rcs-detect-01.h"  // matched filter burst detector
+#include "../rcs-common/rcs-dsp-01.h"     // fixed point scaling
+#include "../rcs-common/rcs-cfar-01.h"    // adaptive baseline, cfar threshold
+#include "../rcs-common/rcs-drift-01.h"   // tx/rx clock drift tracker
+#include "../rcs-common/rcs-report-01.h"  // core 1 -> core 0 report queue
+#include "../rcs-common/rcs-telemetry-01.h" // binary report frames
+#include "../rcs-common/rcs-instr-01.h"   // hot path histograms
+#include "../rcs-common/rcs-calib-01.h"   // calibration record in flash
+#include "../rcs-common/rcs-echo-01.h"    // multi-echo list
+#include "../rcs-common/rcs-snap-01.h"    // triggered adc snapshots
+#include "../rcs-common/rcs-track-01.h"   // range tracker, search gate
+#include "../rcs-common/rcs-duty-01.h"    // awake/asleep accounting
+#include "../rcs-common/rcs-stack-01.h"   // multi-ping stacking
 
 // globals
-// - repeating timer params; gloals avoid passed args
+// - core 1 capture/detection params; globals avoid passed args
 uint16_t G_uAdcTriggerPos; // positive trigger: baseline_avg+threshold
 uint16_t G_uAdcTriggerNeg; // negative trigger: baseline_avg-threshold
-volatile uint64_t G_uFlightTimeSemaphore = 0;     // updated by main and hw timer callback
-volatile bool G_bFlightTimeBusySemaphore = false; // updated by hw timer callback
-// - main sleep loop reporting
+uint16_t G_uAdcBaseline;   // baseline_avg; matched filter dc reference
+uint32_t G_uMagTrigger;    // matched filter magnitude equivalent of threshold
+cfar_t   G_Cfar;           // running baseline/noise estimate; core 1 only
+drift_t  G_Drift;          // tx period and reference arrival prediction; core 1 only
+detect_t G_Detect;         // matched filter state; core 1 only
+track_t  G_Track;          // flight residual track, search gate; core 1 only
+#if defined(MULTI_ECHO)
+echo_list_t G_Echo;        // arrivals in the last window; core 1 only
+#endif
+volatile uint8_t G_uDetectConfidence = 0; // 0-255 confidence of the last flight time
+volatile uint32_t G_uPingPeriodMs = TX_PERIOD; // set by core 0 ('p<ms>'); core 1 re-syncs on a change
+// - calibration record; core 0 loads and saves it, core 1 takes the drift seed from it at a sync
+calib_t G_Calib;
+bool G_bCalibRestored = false;           // boot levels and reference from flash, not measured
+int32_t G_iRefFlightUs = CAL_FT * US_PER_FT; // core 0: reference distance this run; the record's if restored
+volatile int32_t G_iDriftPpmQ8 = 0;      // core 1: tracked tx/rx clock offset, ppm Q8
+volatile bool G_bDriftLocked = false;    // core 1: drift acquired (or seeded) since the last sync
+uint64_t G_uFirstRangeUs = 0;            // core 0: boot to the first valid range
+// - core 1 -> core 0 reports
+report_queue_t G_ReportQueue; // lock-free spsc; core 1 pushes, core 0 pops
+// - core 0 reporting
 volatile int64_t G_FlightTimeReport;
-// gpio binary led distance display 0-15 -> (0000 - 1111)
-const uint G_GP2_BIT0    =  2; // pin 4
-const uint G_GP3_BIT1    =  3; // pin 5
-const uint G_GP4_BIT2    =  4; // pin 6
-const uint G_GP5_BIT3    =  5; // pin 7
-// gpio general
+#if defined(TELEMETRY_BINARY)
+telemetry_frame_t G_Telemetry; // reports batched per usb write
+#endif
+// - core 1 instrumentation; core 1 writes, core 0 dumps
+#if defined(INSTR)
+typedef struct {
+  instr_hist_t start;   // window scan start after the window's first sample, us (was timer callback entry latency)
+  instr_hist_t lag;     // worst backlog per window, capture head - scan position, us; overrun past (* 1792 2) 3584
+  instr_hist_t busy;    // estimator + detector time per window, us of sample clock
+  instr_hist_t scanned; // samples scanned per window, to the pulse or the window end
+  instr_hist_t polls;   // idle polls (block in progress) per window; few means little headroom
+  volatile uint32_t uWindows;
+  volatile uint32_t uPulses;   // pulse found
+  volatile uint32_t uTimeouts; // window ended without one
+  volatile uint32_t uOverruns; // scanner lapped by the dma; window abandoned
+  volatile uint32_t uResyncs;  // back to wait_for_pulse(): period change or SYNC_LOST
+  volatile uint32_t uGated;    // windows scanned over the track gate only
+  volatile uint32_t uOutliers; // arrivals off the track, rejected
+} rx_instr_t;
+rx_instr_t G_Instr;
+volatile bool G_bInstrReset = false; // set by core 0; core 1 clears G_Instr at the next window
+#endif
+// - snapshots; core 1 records and triggers, core 0 streams
+#if defined(SNAPSHOT)
+snap_t G_Snap;
+volatile uint8_t G_uSnapMode = 0;      // SNAP_PULSE | SNAP_MISS; set by core 0
+volatile bool G_bSnapNow = false;      // set by core 0; core 1 triggers at its scan position
+#endif
+// - low power receive; core 1 sleeps and accounts, core 0 switches and dumps
+#if defined(DUTY_CYCLE)
+duty_t G_Duty;
+volatile bool G_bLowPower = false;     // set by core 0 ('l1'/'l0')
+volatile bool G_bDutyReset = false;    // set by core 0; core 1 clears G_Duty at the next window
+bool G_bTriggersHeld = false;          // core 1; scanning a gate after a sleep, the estimator is not fed
+#endif
+// - multi-ping stacking; core 1 stacks, core 0 sets N
+#if defined(STACK) && !defined(MULTI_ECHO)
+#define STACKING
+stack_acc_t G_Stack;                   // core 1 only; (* 11008 4) 43KB
+volatile uint G_uStackShift = 0;       // log2 N; set by core 0 ('n<N>'), core 1 restarts the stack on a change
+#endif
+// gpio general; 4 bit led distance display in ../rcs-common/rcs-utils-01.*
 const uint G_GP15_MISS   = 15; // pin 20 // missed pulse
 
 // functions
-void gpio_out_bit(uint GPX, uint v) {
-  // configure GPX as output, set to LSB of v
-  v = v & 0x01; // isolate LSB
-  gpio_init(GPX);
-  gpio_set_dir(GPX, GPIO_OUT);
-  gpio_put(GPX, v);
-}
-
-void gpio_led_float_to_bin4(float f) {
-  // round float f to int and display as binary on 4 led display
-  uint uValue = f+0.5;
-  uint bit0 = uValue & 1;
-  uint bit1 = (uValue >> 1) & 1;
-  uint bit2 = (uValue >> 2) & 1;
-  uint bit3 = (uValue >> 3) & 1;
-  #if defined(MC)
-  // printf("--debug-- uValue: %d  %u%u%u%u\n", uValue, bit3, bit2, bit1, bit0);
+void update_triggers(uint64_t uFrom, uint64_t uTo) {
+  // core 1; feed capture range [uFrom, uTo) to the baseline/noise estimator and move the trigger
+  // levels with it. the matched filter dc reference (G_uAdcBaseline) is only taken up by
+  // detect_init() at the next window; a mid-window step would look like signal to the correlator.
+  // every scanned sample passes here, so the snapshot history is fed here too
+  #if defined(SNAPSHOT)
+  snap_feed_ring(&G_Snap, uFrom, uTo);
+  if ( G_bSnapNow ) {
+    G_bSnapNow = false;
+    snap_trigger(&G_Snap, uTo, SNAP_MANUAL);
+  }
   #endif
-  // output to 4 bit led display
-  gpio_out_bit(G_GP5_BIT3, bit3);
-  gpio_out_bit(G_GP4_BIT2, bit2);
-  gpio_out_bit(G_GP3_BIT1, bit1);
-  gpio_out_bit(G_GP2_BIT0, bit0);
-}
+  #if defined(ADAPTIVE_THRESHOLD)
+  #if defined(DUTY_CYCLE) // a gate is the pulse and its ring-down; against a 1ms lead it would own the estimate
+  if ( G_bTriggersHeld ) return;
+  #endif
+  cfar_update_ring(&G_Cfar, uFrom, uTo);
+  uint16_t uMean = cfar_mean(&G_Cfar);
+  G_uAdcTriggerPos = uMean + G_Cfar.uThreshold;
+  G_uAdcTriggerNeg = uMean - G_Cfar.uThreshold;
+  G_uAdcBaseline = uMean;
+  G_uMagTrigger = detect_mag_for_threshold(&G_Detect, G_Cfar.uThreshold);
+  G_Detect.uMagTrigger = G_uMagTrigger;
+  #endif
+} // end void update_triggers(...)
 
-bool wait_for_pulse() {
-  // poll forever; adc_read() until threshold values are exceeded, or timeout received
-  // via global semaphore; used to detect first tx pulse and kick off the
-  // flight time measurement process;  returns true on pulse, or false on timeout.
-  // note the visual indicator flash_led_16hz() could become timing issue in some use cases.
-  // @todo the trigger condition can become a function if call overhead is not an issue
-  uint64_t uLocalFlightTimeSemaphore = G_uFlightTimeSemaphore; // potential timeout
-  while ( uLocalFlightTimeSemaphore == G_uFlightTimeSemaphore ) {
-    uint16_t adc_sample = adc_read();
-    if ((adc_sample >= G_uAdcTriggerPos) || (adc_sample <= G_uAdcTriggerNeg)) {
-      // pulse received
-      flash_led_16hz();
-      return true;
+uint64_t wait_for_pulse() {
+  // scan completed capture blocks until threshold values are exceeded; used to detect first tx
+  // pulse and kick off the flight time measurement process. core 1; blocks until a pulse,
+  // returns its sample index. with MATCHED_FILTER the burst detector is used here too: windows
+  // are placed from this pulse, and over a long wait a single noise sample over the threshold
+  // is likely enough to mis-place them
+  uint64_t uScanned = capture_samples_done();
+  #if defined(MATCHED_FILTER)
+  detect_result_t result;
+  detect_init(&G_Detect, G_uAdcBaseline, G_uMagTrigger, uScanned);
+  #endif
+  while ( true ) {
+    uint64_t uDone = capture_samples_done();
+    if ( uDone <= uScanned ) continue;      // block in progress
+    if ( capture_overrun(uScanned, uDone) ) { // fell behind; skip ahead
+      uScanned = uDone - CAPTURE_BLOCK_LEN;
+      #if defined(MATCHED_FILTER)
+      detect_init(&G_Detect, G_uAdcBaseline, G_uMagTrigger, uScanned);
+      #endif
     }
-  } // end while ( uLocalFlightTimeSemaphore == G_uFlightTimeSemaphore )
-  return false; // timeout condition
-} // end bool wait_for_pulse() 
+    update_triggers(uScanned, uDone);
+    #if defined(MATCHED_FILTER)
+    if ( detect_scan_ring(&G_Detect, uScanned, uDone, &result) ) return result.iArrivalQ8 >> DETECT_FRAC_BITS;
+    #else
+    uint64_t uHit = capture_scan(uScanned, uDone, G_uAdcTriggerPos, G_uAdcTriggerNeg);
+    if ( uHit != CAPTURE_NONE ) return uHit; // pulse received
+    #endif
+    uScanned = uDone;
+  } // end while ( true )
+} // end uint64_t wait_for_pulse() 
     
-int64_t get_flight_time() {
-  // determine flight time of latest pulse by comparing to a reference flight time determined
-  // by the first get_flight_time call. this function is called at a fixed timer interval by
-  // the hardware timer (TX_PERIOD). flight time of the current pulse is returned. on the first
-  // call to this function, the reference time is determined and a calculated zero is returned.
-  // at function start, a local copy of a global semephore is set. if the global semaphore
-  // changes before a pulse is captured, the function is returned as MISSED_PULSE.
-  if ( G_bFlightTimeBusySemaphore ) { // another instance of get_flight_time() is running
-    gpio_put(G_GP15_MISS, 1); 
-    return MISSED_PULSE;
+void track_until(uint64_t uFrom, uint64_t uTo) {
+  // core 1, between windows: keep feeding the baseline/noise estimator over the gap [uFrom, uTo),
+  // so a window opens with current trigger levels however short it is against the period
+  while ( uFrom < uTo ) {
+    uint64_t uDone = capture_samples_done();
+    if ( uDone > uTo ) uDone = uTo;
+    if ( uDone <= uFrom ) continue;         // block in progress
+    if ( capture_overrun(uFrom, uDone) ) uFrom = uDone - CAPTURE_BLOCK_LEN; // fell behind; skip ahead
+    update_triggers(uFrom, uDone);
+    uFrom = uDone;
   }
+} // end void track_until(...)
+
+int64_t get_pulse_arrival(uint64_t uStartSample, uint64_t uLength, uint64_t *puScanned) {
+  // find the pulse in the window [uStartSample, uStartSample+uLength), placed by core 1 from the
+  // drift tracker. the detector state is per window: re-armed at the window start, and the first
+  // pulse ends the window, so later echoes of the same ping are never seen. with MULTI_ECHO the
+  // window is scanned to its end into G_Echo, and the pulse is its direct path. returns the absolute
+  // arrival sample, Q8, or -1 if no pulse is found in the window or the ring was overrun.
+  // *puScanned is the end of the samples fed to update_triggers(); the caller feeds on from there
+  uint64_t uEndSample = uStartSample + uLength;
 
-  G_bFlightTimeBusySemaphore = true;        // notify function is active
-  uint64_t uFuncStartTime = time_us_64();   // function start time
-  uint64_t uFuncTimeoutTime = uFuncStartTime + TX_PERIOD*1E3;
-  static bool bFirstCall = true;            // determine uRefTime on first call
-  static uint64_t uRefTime;                 // flight time  of reference distance
-  int64_t iDeltaFlightTime = 0LL;           // difference of current flight time and reference
-  uint16_t uAdcSample;
-
-  // wait for pulse or the next hw timer callback (timeout)
-  uint64_t uPulseTime = 0LL;                // time of received pulse
-  uint64_t uLocalFlightTimeSemaphore = G_uFlightTimeSemaphore; // detect missed pulses
-  while ( uLocalFlightTimeSemaphore == G_uFlightTimeSemaphore ) {
-    uAdcSample = adc_read();
-    if ((uAdcSample >= G_uAdcTriggerPos) || (uAdcSample <= G_uAdcTriggerNeg)) {
-	uPulseTime = time_us_64(); // pulse received
-	break;
+  // scan completed blocks for a pulse until the window ends (timeout)
+  int64_t iPulseQ8 = -1;                    // sample index of received pulse, Q8; -1 none
+  #if defined(MULTI_ECHO)
+  detect_init(&G_Detect, G_uAdcBaseline, G_uMagTrigger, uStartSample);
+  echo_init(&G_Echo);
+  #elif defined(MATCHED_FILTER)
+  detect_result_t result;
+  detect_init(&G_Detect, G_uAdcBaseline, G_uMagTrigger, uStartSample);
+  #endif
+  uint64_t uScanned = uStartSample;         // next sample to scan
+  *puScanned = uStartSample;
+  #if defined(INSTR)
+  uint64_t uEntry = capture_samples_now();
+  uint64_t uNow = uEntry;                   // sample clock; processing time is its advance
+  uint64_t uLagMax = 0, uBusy = 0;
+  uint32_t uPolls = 0;
+  bool bOverrun = false;
+  instr_hist_add(&G_Instr.start, uEntry > uStartSample ? capture_samples_to_us(uEntry - uStartSample) : 0);
+  #endif
+  while ( uScanned < uEndSample ) {
+    uint64_t uDone = capture_samples_done();
+    if ( uDone > uEndSample ) uDone = uEndSample;
+    #if defined(INSTR)
+    if ( uDone <= uScanned ) uPolls++;
+    uNow = capture_samples_now();
+    if ( uNow - uScanned > uLagMax ) uLagMax = uNow - uScanned;
+    #endif
+    if ( uDone <= uScanned ) continue;      // block in progress
+    if ( capture_overrun(uScanned, uDone) ) { // scanner lapped by dma; samples lost
+      #if defined(INSTR)
+      bOverrun = true;
+      #endif
+      #if defined(MULTI_ECHO)
+      echo_init(&G_Echo);
+      #endif
+      break;
+    }
+    update_triggers(uScanned, uDone);
+    *puScanned = uDone;
+    #if defined(MULTI_ECHO)
+    echo_scan_ring(&G_Echo, &G_Detect, uScanned, uDone); // on to the window end; ranked as it goes
+    #elif defined(STACKING)
+    if ( G_Stack.uShift ) { // on to the window end, every position stacked; the scan to its first pulse
+      #if defined(MATCHED_FILTER)
+      if ( stack_scan_ring(&G_Stack, iPulseQ8 < 0 ? &G_Detect : NULL, uScanned, uDone, &result) ) {
+        iPulseQ8 = result.iArrivalQ8;
+        G_uDetectConfidence = result.uConfidence;
+      }
+      #else
+      uint64_t uHit = stack_scan_threshold(&G_Stack, iPulseQ8 < 0, uScanned, uDone, G_uAdcTriggerPos, G_uAdcTriggerNeg);
+      if ( uHit != CAPTURE_NONE ) {
+        iPulseQ8 = (int64_t)uHit << DETECT_FRAC_BITS;
+        G_uDetectConfidence = 255;
+      }
+      #endif
+    }
+    #if defined(MATCHED_FILTER)
+    else if ( detect_scan_ring(&G_Detect, uScanned, uDone, &result) ) { // pulse received
+      iPulseQ8 = result.iArrivalQ8;
+      G_uDetectConfidence = result.uConfidence;
+      break;
+    }
+    #else
+    else {
+      uint64_t uHit = capture_scan(uScanned, uDone, G_uAdcTriggerPos, G_uAdcTriggerNeg);
+      if ( uHit != CAPTURE_NONE ) { // pulse received
+        iPulseQ8 = (int64_t)uHit << DETECT_FRAC_BITS;
+        G_uDetectConfidence = 255;
+        break;
+      }
     }
-    if ( time_us_64() >= uFuncTimeoutTime ) { // timeout
-      G_bFlightTimeBusySemaphore = false;
-      gpio_put(G_GP15_MISS, 1); 
-      return MISSED_PULSE;
+    #endif
+    #elif defined(MATCHED_FILTER)
+    if ( detect_scan_ring(&G_Detect, uScanned, uDone, &result) ) { // pulse received
+      iPulseQ8 = result.iArrivalQ8;
+      G_uDetectConfidence = result.uConfidence;
+      break;
     }
-  } // end while ( uLocalFlightTimeSemaphore == G_uFlightTimeSemaphore ) 
-  if ( uLocalFlightTimeSemaphore != G_uFlightTimeSemaphore ) return MISSED_PULSE;
-      
-  // process the valid pulse
-  gpio_put(G_GP15_MISS, 0); // clear missed pulse indicator
-  if ( bFirstCall ) {
-    uRefTime = uPulseTime-uFuncStartTime;
-    bFirstCall = false;
-    gpio_led_float_to_bin4(15.0); // flash 4 bit display to indicate capture
+    #else
+    uint64_t uHit = capture_scan(uScanned, uDone, G_uAdcTriggerPos, G_uAdcTriggerNeg);
+    if ( uHit != CAPTURE_NONE ) { // pulse received
+      iPulseQ8 = (int64_t)uHit << DETECT_FRAC_BITS;
+      G_uDetectConfidence = 255;
+      break;
+    }
+    #endif
+    #if defined(INSTR)
+    uBusy += capture_samples_now() - uNow;
+    #endif
+    uScanned = uDone;
+  } // end while ( uScanned < uEndSample ) 
+  #if defined(MULTI_ECHO)
+  int iDirect = echo_direct(&G_Echo);
+  if ( iDirect >= 0 ) {
+    iPulseQ8 = G_Echo.echo[iDirect].iArrivalQ8;
+    G_uDetectConfidence = G_Echo.echo[iDirect].uConfidence;
+  }
+  #endif
+  #if defined(INSTR)
+  if ( iPulseQ8 >= 0 && uScanned < uEndSample ) uBusy += capture_samples_now() - uNow; // the chunk holding the pulse
+  instr_hist_add(&G_Instr.lag, capture_samples_to_us(uLagMax));
+  instr_hist_add(&G_Instr.busy, capture_samples_to_us(uBusy));
+  instr_hist_add(&G_Instr.scanned, (iPulseQ8 >= 0 ? (uint64_t)(iPulseQ8 >> DETECT_FRAC_BITS) : uScanned) - uStartSample);
+  instr_hist_add(&G_Instr.polls, uPolls);
+  G_Instr.uWindows++;
+  if ( iPulseQ8 >= 0 ) G_Instr.uPulses++;
+  else if ( bOverrun ) G_Instr.uOverruns++;
+  else G_Instr.uTimeouts++;
+  #endif
+  return iPulseQ8; // -1 on timeout or overrun
+} // end int64_t get_pulse_arrival(...) 
+
+#if defined(INSTR)
+void instr_reset() {
+  // core 1, between windows; on core 0's request
+  instr_hist_reset(&G_Instr.start);
+  instr_hist_reset(&G_Instr.lag);
+  instr_hist_reset(&G_Instr.busy);
+  instr_hist_reset(&G_Instr.scanned);
+  instr_hist_reset(&G_Instr.polls);
+  G_Instr.uWindows = G_Instr.uPulses = G_Instr.uTimeouts = G_Instr.uOverruns = G_Instr.uResyncs = 0;
+  G_Instr.uGated = G_Instr.uOutliers = 0;
+  G_bInstrReset = false;
+}
+#endif
+
+#if defined(MULTI_ECHO)
+void report_echoes(report_t *pReport, int64_t iDirectQ8) {
+  // core 1; the strongest arrivals other than the direct path, as delays after it
+  pReport->uEchoes = 0;
+  for (uint i = 0; i < G_Echo.uCount && pReport->uEchoes < REPORT_ECHOES; i++) {
+    const echo_t *pEcho = &G_Echo.echo[i];
+    if ( iDirectQ8 < 0 || pEcho->iArrivalQ8 == iDirectQ8 ) continue;
+    report_echo_t *p = &pReport->echo[pReport->uEchoes++];
+    p->iDelayUs = ((pEcho->iArrivalQ8 - iDirectQ8) * CAPTURE_SAMPLE_NS / 1000) >> DETECT_FRAC_BITS;
+    p->uAmplitude = pEcho->uAmplitude;
+    p->uWidth = pEcho->uWidth;
+  }
+}
+#endif
+
+void core1_capture_main() {
+  // core 1: owns the capture ring and detection. finds the first pulse, then measures one window
+  // per ping and queues a report per window. windows are placed from the drift tracker's
+  // predicted arrival, so they follow the transmitter clock rather than the rx crystal. never
+  // touches gpio or stdio, so reporting on core 0 cannot delay or mask a window.
+  report_t report = { 0 };
+  hal_flash_core_init(); // core 0 may pause this core to save G_Calib
+  #if defined(DUTY_CYCLE)
+  duty_init(&G_Duty, hal_time_us());
+  const uint64_t uWakeLead = (uint64_t)DUTY_WAKE_US * 1000 / CAPTURE_SAMPLE_NS;
+  const uint64_t uMinSleep = (uint64_t)DUTY_MIN_SLEEP_US * 1000 / CAPTURE_SAMPLE_NS;
+  #endif
+
+  while (true) { // (re)sync; the ping period only changes here
+    // remain in loop waiting on first pulse, no timeouts processed
+    uint64_t uWindowStart = wait_for_pulse();
+    const uint32_t uPeriodMs = G_uPingPeriodMs;
+    const uint64_t uPeriodSamples = (uint64_t)uPeriodMs * (CAPTURE_SAMPLE_HZ / 1000);
+    // per ping window: a little before the predicted reference arrival (closer target, jitter) to
+    // the maximum range after it; never longer than the period, so consecutive windows do not
+    // overlap, and echoes later than WINDOW_RANGE_US fall in the gap before the next one
+    uint64_t uPre = (uint64_t)WINDOW_PRE_US * 1000 / CAPTURE_SAMPLE_NS;
+    if ( uPre > uPeriodSamples / 3 ) uPre = uPeriodSamples / 3;
+    uint64_t uLength = uPre + (uint64_t)WINDOW_RANGE_US * 1000 / CAPTURE_SAMPLE_NS;
+    if ( uLength > uPeriodSamples ) uLength = uPeriodSamples;
+    report.uFlags = REPORT_SYNC;
+    report.uTimeUs = capture_samples_to_us(uWindowStart);
+    report_queue_push(&G_ReportQueue, &report);
+    // first window: the sync pulse is taken as this ping's reference distance arrival
+    uint64_t uTracked = uWindowStart;       // estimator fed up to here
+    uWindowStart += uPeriodSamples - uPre;
+    // TX_RX_SKEW is per TX_PERIOD; scale the prior to this period. the period is learned from
+    // arrivals about TX_PERIOD apart whatever the ping rate (stride), so the motion gate holds
+    uint32_t uStride = (TX_PERIOD + uPeriodMs / 2) / uPeriodMs;
+    drift_init(&G_Drift, uPeriodSamples, (int64_t)TX_RX_SKEW * 1000 * 256 / CAPTURE_SAMPLE_NS * uPeriodMs / TX_PERIOD, uStride);
+    if ( G_Calib.uFlags & CALIB_DRIFT ) drift_seed(&G_Drift, G_Calib.iDriftPpmQ8); // no acquisition hold
+    G_bDriftLocked = false;
+    // gate half width from the speed change a period allows, capped at the window
+    track_init(&G_Track, (uint64_t)(GATE_MIN_US + GATE_US_PER_MS * uPeriodMs) * 1000 / CAPTURE_SAMPLE_NS, uLength);
+    #if defined(STACKING)
+    stack_init(&G_Stack, G_uStackShift, uLength); // a new period is a new alignment
+    #endif
+
+    uint uUnreferenced = 0; // windows since sync without a reference
+    uint uSyncLost = SYNC_LOST;
+    #if defined(STACKING)
+    uint uStackMisses = 0; // windows in a row a warm stack found nothing in
+    #endif
+    while ( uPeriodMs == G_uPingPeriodMs && uUnreferenced < uSyncLost ) {
+      bool bReference;
+      int64_t iResidualQ8;
+      #if defined(INSTR)
+      if ( G_bInstrReset ) instr_reset();
+      #endif
+      // scan [uScanStart, uScanEnd) of the window; the track gate once locked, the burst after it
+      // included. the window itself still places the report and the next ping
+      uint64_t uScanStart = uWindowStart, uScanEnd = uWindowStart + uLength;
+      #if defined(TRACK_GATE) || defined(SNAPSHOT)
+      const int64_t iPredictQ8 = (int64_t)(uWindowStart + uPre) << DETECT_FRAC_BITS; // reference arrival
+      #endif
+      #if (defined(TRACK_GATE) && !defined(MULTI_ECHO)) || defined(SNAPSHOT)
+      const int64_t iExpectQ8 = iPredictQ8 + G_Track.iRangeQ8; // this ping's arrival, as tracked
+      #endif
+      #if defined(STACKING)
+      if ( G_Stack.uShift != G_uStackShift ) stack_init(&G_Stack, G_uStackShift, uLength);
+      uSyncLost = G_Stack.uShift ? SYNC_LOST + (STACK_WARM << G_Stack.uShift) : SYNC_LOST; // no reference while warming
+      #endif
+      #if defined(TRACK_GATE) && !defined(MULTI_ECHO)
+      #if defined(STACKING)
+      if ( G_Track.bLocked && !G_Stack.uShift ) { // stacking adds every position of every window
+      #else
+      if ( G_Track.bLocked ) {
+      #endif
+        int64_t iCenter = iExpectQ8 >> DETECT_FRAC_BITS;
+        int64_t iGate = track_gate(&G_Track);
+        if ( iCenter - iGate > (int64_t)uScanStart ) uScanStart = iCenter - iGate;
+        if ( iCenter + iGate + 2 * G_Detect.uTemplateLen < (int64_t)uScanEnd ) uScanEnd = iCenter + iGate + 2 * G_Detect.uTemplateLen;
+        if ( uScanEnd < uScanStart ) uScanEnd = uScanStart; // predicted off the window; a miss
+        #if defined(INSTR)
+        G_Instr.uGated++;
+        #endif
+      }
+      #endif
+      #if defined(DUTY_CYCLE)
+      // low power up to the wake lead before the scan; the gap goes untracked, the estimator keeps its
+      // state and takes the lead as its noise sample. a late wake only shortens the scan
+      if ( G_bDutyReset ) {
+        duty_init(&G_Duty, hal_time_us());
+        G_bDutyReset = false;
+      }
+      if ( G_bLowPower && uScanStart > capture_samples_now() + uWakeLead + uMinSleep ) {
+        duty_sleep(&G_Duty, hal_time_us());
+        uint64_t uWoke = capture_sleep_until(uScanStart - uWakeLead);
+        duty_wake(&G_Duty, hal_time_us());
+        if ( uTracked < uWoke ) uTracked = uWoke;
+        if ( uScanStart < uWoke ) uScanStart = uWoke;
+        if ( uScanEnd < uScanStart ) uScanEnd = uScanStart;
+        G_bTriggersHeld = uScanEnd - uScanStart < uLength; // gated; a whole window is mostly noise
+      }
+      #endif
+      track_until(uTracked, uScanStart);
+      #if defined(STACKING)
+      stack_window(&G_Stack, uWindowStart, G_uAdcBaseline); // the detector's dc reference for this window
+      #endif
+      int64_t iArrivalQ8 = get_pulse_arrival(uScanStart, uScanEnd - uScanStart, &uTracked);
+      #if defined(DUTY_CYCLE)
+      G_bTriggersHeld = false;
+      #endif
+      #if defined(STACKING) // a warming stack's crossing moves with its gain; the drift tracker would take it as clock drift
+      if ( G_Stack.uShift && !stack_warm(&G_Stack) ) iArrivalQ8 = -1;
+      #endif
+      #if defined(TRACK_GATE)
+      if ( !track_update(&G_Track, iArrivalQ8 >= 0, iArrivalQ8 - iPredictQ8) && iArrivalQ8 >= 0 ) {
+        iArrivalQ8 = -1; // off the track; the drift tracker sees a miss
+        #if defined(INSTR)
+        G_Instr.uOutliers++;
+        #endif
+      }
+      #endif
+      bool bArrival = drift_update(&G_Drift, iArrivalQ8 >= 0, iArrivalQ8, &iResidualQ8, &bReference);
+      if ( G_Drift.uIntervals >= DRIFT_ACQUIRE ) { // for the flash record
+        G_iDriftPpmQ8 = drift_ppm_q8(&G_Drift);
+        G_bDriftLocked = true;
+      }
+      report.uSeq++;
+      report.uTimeUs = capture_samples_to_us(uWindowStart);
+      report.uBaseline = G_uAdcBaseline;
+      report.uConfidence = G_uDetectConfidence;
+      report.uFlags = bReference ? REPORT_REFERENCE : 0;
+      #if defined(MULTI_ECHO)
+      report_echoes(&report, iArrivalQ8);
+      #endif
+      #if defined(SNAPSHOT) // a miss is taken around its tracked arrival; the window is already in history
+      if ( G_uSnapMode & (bArrival ? SNAP_PULSE : SNAP_MISS) ) {
+        snap_trigger(&G_Snap, (uint64_t)((bArrival ? iArrivalQ8 : iExpectQ8) >> DETECT_FRAC_BITS),
+                     bArrival ? SNAP_PULSE : SNAP_MISS);
+      }
+      #endif
+      #if defined(STACKING) // N in a row: the stack has turned over without the pulse, its alignment is lost
+      uStackMisses = G_Stack.uShift && stack_warm(&G_Stack) && !bArrival ? uStackMisses + 1 : 0;
+      #endif
+      if ( !bArrival ) {
+        report.uFlags |= REPORT_MISS;
+        report.uConfidence = 0;
+        report.iFlightUs = MISSED_PULSE;
+      } else { // flight time change against the reference, tx/rx clock drift removed
+        report.iFlightUs = (iResidualQ8 * CAPTURE_SAMPLE_NS / 1000) >> DETECT_FRAC_BITS;
+      }
+      report_queue_push(&G_ReportQueue, &report);
+      #if defined(DUTY_CYCLE)
+      duty_ping(&G_Duty, hal_time_us());
+      #endif
+      if ( G_Drift.bReferenced ) { // next window from the predicted reference arrival
+        uWindowStart = (drift_next_arrival_q8(&G_Drift) >> DETECT_FRAC_BITS) - uPre;
+      } else {
+        uWindowStart += uPeriodSamples;
+        uUnreferenced++;
+      }
+      #if defined(STACKING)
+      if ( uStackMisses >= (1u << G_Stack.uShift) ) break; // re-sync; the stack restarts with it
+      #endif
+    } // end while ( uPeriodMs == G_uPingPeriodMs ...)
+    #if defined(INSTR)
+    G_Instr.uResyncs++;
+    #endif
+  } // end while (true)
+} // end void core1_capture_main()
+
+void report_range(const report_t *pReport) {
+  // core 0: leds and serial output for one report. the 16Hz flashes busy wait ~190ms each, so
+  // they are skipped at high ping rates; core 0 would fall behind and the report queue overflow.
+  const bool bFlash = G_uPingPeriodMs >= TX_PERIOD_LEDS;
+  if ( pReport->uFlags & REPORT_SYNC ) { // first pulse
+    if ( bFlash ) flash_led_16hz();
+    return;
+  }
+  if ( pReport->uFlags & REPORT_MISS ) {
+    hal_gpio_put(G_GP15_MISS, 1); 
+  } else {
+    hal_gpio_put(G_GP15_MISS, 0); // clear missed pulse indicator
+  }
+  if ( !G_uFirstRangeUs && !(pReport->uFlags & REPORT_MISS) ) {
+    G_uFirstRangeUs = hal_time_us();
+    #if defined(MC) && !defined(TELEMETRY_BINARY)
+    printf("first range:\t%" PRIu64 " ms\t%s\n", G_uFirstRangeUs / 1000, G_bCalibRestored ? "restored" : "boot levels");
+    #endif
+  }
+  if ( (pReport->uFlags & REPORT_REFERENCE) && bFlash && !G_bCalibRestored ) { // at CAL_FT; not from flash
+    gpio_led_int_to_bin4(15); // flash 4 bit display to indicate capture
     flash_led_16hz();
-    gpio_led_float_to_bin4(0.0);
+    gpio_led_int_to_bin4(0);
     flash_led_16hz();
-    gpio_led_float_to_bin4(15.0); // flash 4 bit display to indicate capture
+    gpio_led_int_to_bin4(15); // flash 4 bit display to indicate capture
     flash_led_16hz();
-    gpio_led_float_to_bin4(0.0);
-    // flash_led_16hz(); --20211018-- removed; potential timing error
-  } 
-  iDeltaFlightTime = (uPulseTime-uFuncStartTime) - uRefTime; // calculates to zero on bFirstCall
-  G_bFlightTimeBusySemaphore = false; 
-  return iDeltaFlightTime;
-} // end int64_t get_flight_time() 
-
-bool repeating_timer_callback(struct repeating_timer *t) {
-  static uint64_t uPulseCount = 0LL;
-  G_uFlightTimeSemaphore = time_us_64(); 
-  G_FlightTimeReport = get_flight_time()-(uPulseCount++ * TX_RX_SKEW); // tweek tx/rx clock skew
-  // --20211018-- G_bFlightTimeBusySemaphore = false; // set true at start of get_flight_time(); moved into get_flight_time()
-  flash_led_16hz();
-  // approx 'fDistance' based on 1ms/ft sound in air, 1.0 is initial calibration distance
-  float fDistance = (float)G_FlightTimeReport/1000.0 + 1.0; 
-  gpio_led_float_to_bin4(fDistance);
-  #if defined(MC)
-  printf("Distance:\t%3.0f ft\t%" PRId64 " uSec     \n", fDistance,G_FlightTimeReport);
+    gpio_led_int_to_bin4(0);
+  }
+  G_FlightTimeReport = pReport->iFlightUs;
+  if ( bFlash ) flash_led_16hz();
+  // approx distance based on 1ms/ft sound in air, from the reference distance (CAL_FT or flash); rounded
+  int iDistance = dsp_div_round((int32_t)G_FlightTimeReport + G_iRefFlightUs, US_PER_FT);
+  gpio_led_int_to_bin4(iDistance);
+  #if defined(MC) && !defined(TELEMETRY_BINARY)
+  printf("Distance:\t%3d ft\t%" PRId64 " uSec     \n", iDistance,G_FlightTimeReport);
+  if ( pReport->uEchoes ) { // MULTI_ECHO; delay us, amplitude counts, width samples
+    printf("Echoes:\t%u", pReport->uEchoes);
+    for (uint i = 0; i < pReport->uEchoes; i++) {
+      printf("\t%+" PRId32 " us %u %u", pReport->echo[i].iDelayUs, pReport->echo[i].uAmplitude, pReport->echo[i].uWidth);
+    }
+    printf("\n");
+  }
   #endif
-  return true;
-}
+} // end void report_range(...)
+
+void set_ping_period(const char *sLine) {
+  // core 0: 'p<ms>' sets the ping period; core 1 re-syncs on the next pulse. the transmitter
+  // must be given the same period
+  if ( sLine[0] != 'p' ) return;
+  long lMs = strtol(sLine + 1, NULL, 10);
+  if ( lMs < TX_PERIOD_MIN || lMs > TX_PERIOD_MAX ) return;
+  G_uPingPeriodMs = lMs;
+  #if defined(MC) && !defined(TELEMETRY_BINARY)
+  printf("ping period:\t%ld ms\n", lMs);
+  #endif
+} // end void set_ping_period(...)
+
+void save_calib(const char *sLine) {
+  // core 0: 'c' saves the calibration record, 'c<ft>' with the distance the first pulse after a sync
+  // is at from the next boot (the receiver's place at power up, e.g. a dock). saved unasked at most once
+  // per boot: the first time the drift tracker has acquired a clock offset, if it is CALIB_PPM_SAVE off
+  // the record's (first run, temperature). later wander (and every re-sync) waits for a 'c'; a save
+  // pauses core 1 for up to an erase (~50ms), the window in progress is lost to an overrun, and each
+  // one wears the flash sector
+  static bool S_bDriftChecked = false; // the unasked save has been considered this boot
+  bool bSave = false;
+  if ( sLine && sLine[0] == 'c' ) {
+    if ( sLine[1] ) G_Calib.iRefFlightUs = strtol(sLine + 1, NULL, 10) * US_PER_FT;
+    bSave = true;
+  }
+  int32_t iPpmQ8 = G_iDriftPpmQ8;
+  if ( G_bDriftLocked && (bSave || !S_bDriftChecked) ) {
+    S_bDriftChecked = true;
+    if ( bSave || !(G_Calib.uFlags & CALIB_DRIFT && abs(iPpmQ8 - G_Calib.iDriftPpmQ8) < CALIB_PPM_SAVE * 256) ) {
+      G_Calib.iDriftPpmQ8 = iPpmQ8; // asked: the current offset whatever its distance
+      G_Calib.uFlags |= CALIB_DRIFT;
+      bSave = true;
+    }
+  }
+  if ( !bSave ) return;
+  G_Calib.uBaseline = G_uAdcBaseline;
+  G_Calib.uThreshold = G_Cfar.uThreshold; // the boot level without ADAPTIVE_THRESHOLD
+  bool bOk = calib_save(&G_Calib);
+  #if defined(MC) && !defined(TELEMETRY_BINARY)
+  printf("calib:\t%s\tseq %" PRIu32 "\tbaseline %u\tthreshold %u\tdrift %" PRId32 " ppm/256\tref %" PRId32 " us\n",
+         bOk ? "saved" : "failed", G_Calib.uSeq, G_Calib.uBaseline, G_Calib.uThreshold, G_Calib.iDriftPpmQ8,
+         G_Calib.iRefFlightUs);
+  #else
+  (void)bOk;
+  #endif
+} // end void save_calib(...)
+
+void set_snapshot(const char *sLine) {
+  // core 0: 'w' takes a snapshot now, 'wd'/'wm'/'wb'/'w0' trigger on pulses, misses, both or nothing,
+  // 'wl<pre_us>,<post_us>' sets the window around the trigger (together up to SNAP_RING_LEN samples)
+  #if defined(SNAPSHOT)
+  if ( sLine[0] != 'w' ) return;
+  switch ( sLine[1] ) {
+    case 0:   G_bSnapNow = true; break;
+    case 'd': G_uSnapMode = SNAP_PULSE; break;
+    case 'm': G_uSnapMode = SNAP_MISS; break;
+    case 'b': G_uSnapMode = SNAP_PULSE | SNAP_MISS; break;
+    case '0': G_uSnapMode = 0; break;
+    case 'l': {
+      // us, each clamped to the history before scaling so neither the scale nor the sum can wrap
+      const unsigned long ulMaxUs = (unsigned long)SNAP_RING_LEN * CAPTURE_SAMPLE_NS / 1000;
+      char *sEnd;
+      unsigned long ulPre = strtoul(sLine + 2, &sEnd, 10);
+      unsigned long ulPost = (*sEnd == ',') ? strtoul(sEnd + 1, NULL, 10) : ulMaxUs;
+      if (ulPre > ulMaxUs) ulPre = ulMaxUs;
+      if (ulPost > ulMaxUs) ulPost = ulMaxUs;
+      uint32_t uPre = ulPre * 1000 / CAPTURE_SAMPLE_NS;
+      uint32_t uPost = (*sEnd == ',') ? ulPost * 1000 / CAPTURE_SAMPLE_NS : G_Snap.uPost;
+      if ( uPre + uPost > SNAP_RING_LEN || uPost == 0 ) return;
+      G_Snap.uPre = uPre;
+      G_Snap.uPost = uPost;
+      break;
+    }
+    default: return;
+  }
+  #if defined(MC) && !defined(TELEMETRY_BINARY)
+  printf("snap:\ttrigger%s%s%s\tpre %" PRIu32 " us\tpost %" PRIu32 " us\tsent %" PRIu32 "\tdropped %" PRIu32 "\n",
+         G_uSnapMode & SNAP_PULSE ? " pulse" : "", G_uSnapMode & SNAP_MISS ? " miss" : "", G_uSnapMode ? "" : " none",
+         G_Snap.uPre * CAPTURE_SAMPLE_NS / 1000, G_Snap.uPost * CAPTURE_SAMPLE_NS / 1000, G_Snap.uSeq, G_Snap.uDropped);
+  #endif
+  #else
+  (void)sLine;
+  #endif
+} // end void set_snapshot(...)
+
+void set_low_power(const char *sLine) {
+  // core 0: 'l1' low power receive between windows, 'l0' awake throughout; core 1 takes it at its
+  // next window. 'l' alone shows the mode
+  #if defined(DUTY_CYCLE)
+  if ( sLine[0] != 'l' ) return;
+  if ( sLine[1] == '1' ) G_bLowPower = true;
+  else if ( sLine[1] == '0' ) G_bLowPower = false;
+  #if defined(MC) && !defined(TELEMETRY_BINARY)
+  printf("low power:\t%s\n", G_bLowPower ? "on" : "off");
+  #endif
+  #else
+  (void)sLine;
+  #endif
+} // end void set_low_power(...)
+
+void set_stacking(const char *sLine) {
+  // core 0: 'n<N>' stacks the last N windows (N a power of 2 up to 1 << STACK_SHIFT_MAX), 'n1' off;
+  // core 1 restarts the stack at its next window. 'n' alone shows N
+  #if defined(STACKING)
+  if ( sLine[0] != 'n' ) return;
+  if ( sLine[1] ) {
+    long lN = strtol(sLine + 1, NULL, 10);
+    uint uShift = 0;
+    while ( uShift < STACK_SHIFT_MAX && (1L << uShift) < lN ) uShift++;
+    if ( lN < 1 || (1L << uShift) != lN ) return;
+    G_uStackShift = uShift;
+  }
+  #if defined(MC) && !defined(TELEMETRY_BINARY)
+  printf("stack:\t%u pings\n", 1u << G_uStackShift);
+  #endif
+  #else
+  #if defined(MC) && !defined(TELEMETRY_BINARY)
+  if ( sLine[0] == 'n' ) printf("stack:\tunavailable\n"); // not built in (MULTI_ECHO)
+  #endif
+  (void)sLine;
+  #endif
+} // end void set_stacking(...)
+
+void dump_instr(const char *sLine) {
+  // core 0: 's' dumps the core 1 instrumentation and duty cycle, 's0' also clears them (done by
+  // core 1 at its next window). printed whatever the output mode; the telemetry decoder skips text
+  // between frames
+  if ( sLine[0] != 's' ) return;
+  #if defined(DUTY_CYCLE)
+  uint32_t uPings = G_Duty.uPings;
+  printf("duty\tlow_power\t%d\tpings\t%" PRIu32 "\tsleeps\t%" PRIu32 "\tawake_ms\t%" PRIu32 "\tasleep_ms\t%" PRIu32
+         "\tawake_permille\t%" PRIu32 "\tawake_kcycles_per_ping\t%" PRIu32 "\tasleep_kcycles_per_ping\t%" PRIu32 "\n",
+         G_bLowPower, uPings, G_Duty.uSleeps, G_Duty.uAwakeMs, G_Duty.uAsleepMs, duty_awake_permille(&G_Duty),
+         uPings ? (uint32_t)((uint64_t)G_Duty.uAwakeMs * DUTY_SYS_MHZ / uPings) : 0,
+         uPings ? (uint32_t)((uint64_t)G_Duty.uAsleepMs * DUTY_SYS_MHZ / uPings) : 0);
+  if ( sLine[1] == '0' ) G_bDutyReset = true;
+  #endif
+  #if defined(INSTR)
+  instr_hist_print_header();
+  instr_hist_print("start_us", &G_Instr.start);
+  instr_hist_print("lag_us", &G_Instr.lag);
+  instr_hist_print("busy_us", &G_Instr.busy);
+  instr_hist_print("scanned", &G_Instr.scanned);
+  instr_hist_print("polls", &G_Instr.polls);
+  printf("instr\tfirst_range_ms\t%" PRIu64 "\trestored\t%d\n", G_uFirstRangeUs / 1000, G_bCalibRestored);
+  printf("instr\twindows\t%" PRIu32 "\tpulses\t%" PRIu32 "\ttimeouts\t%" PRIu32 "\toverruns\t%" PRIu32
+         "\tresyncs\t%" PRIu32 "\tdropped\t%" PRIu32 "\tgated\t%" PRIu32 "\toutliers\t%" PRIu32 "\n",
+         G_Instr.uWindows, G_Instr.uPulses, G_Instr.uTimeouts, G_Instr.uOverruns, G_Instr.uResyncs,
+         G_ReportQueue.uDropped, G_Instr.uGated, G_Instr.uOutliers);
+  if ( sLine[1] == '0' ) G_bInstrReset = true;
+  #endif
+} // end void dump_instr(...)
 
 int main() {
 #ifndef PICO_DEFAULT_LED_PIN
 #warning Error: requires board with integrated LED defined as PICO_DEFAULT_LED_PIN
 #else
   // fixed vars
-  const float fAdcThreshold = 0.05; // fAdcThreshold over average triggers a capture
+  const uint uAdcThresholdMv = 50; // uAdcThresholdMv over average triggers a capture
 
   // gpio resources (also see globals)
   const uint GP26_ADC0   = 26; // pin 31
-  // gpio are used for transistor biasing
-  const uint GP21_IREF   = 21; // iref mirror master pullup
-  const uint GP19_INP    = 19; // diff pair in plus pull up
-  const uint GP12_INM    = 12; // diff pair in minus pull up
-  const uint GP18_LOADP  = 18; // diff pair plus leg load pull up
-  const uint GP13_LOADM  = 13; // diff pair minus leg load  pull up
-  const uint GP20_INPLO  = 20; // diff pair in plus low res pull down
-  const uint GP11_INMLO  = 11; // diff pair in minus low res pull down
+  // gpio 11-13, 18-21 are used for transistor biasing (config_rx04_bias())
   // rx vars
   const uint uNsettle = 128;   // 1/2 length of initial ADC settling capture
   // state vars
   uint16_t adc_avg;
-  uint16_t adc_dat;
-
-  int ch; // future use; serial input data
+  const char *sLine; // serial command line
 
   // initialize board LED as progress indicator
-  gpio_init(G_LED_PIN);
-  gpio_set_dir(G_LED_PIN, GPIO_OUT);
-  gpio_put(G_LED_PIN, 1); // initially lit to verify firmware start
+  hal_gpio_init(G_LED_PIN);
+  hal_gpio_set_dir(G_LED_PIN, HAL_GPIO_OUT);
+  hal_gpio_put(G_LED_PIN, 1); // initially lit to verify firmware start
 
   // initialize missed pulse indicator
-  gpio_init(G_GP15_MISS);
-  gpio_set_dir(G_GP15_MISS, GPIO_OUT);
-  gpio_put(G_GP15_MISS, 0); 
+  hal_gpio_init(G_GP15_MISS);
+  hal_gpio_set_dir(G_GP15_MISS, HAL_GPIO_OUT);
+  hal_gpio_put(G_GP15_MISS, 0); 
+
+  // initialize 4 bit distance display
+  gpio_led_bin4_init();
   
   // begin usb serial comms
-  stdio_init_all();
+  hal_stdio_init();
   #if defined(MC)
   tusb_wait_for_connection();  // optionally wait for 'mc' before capturing data
   printf("rcs-rx04-03 tx -> rx pulse capture\n");
   #endif
-  const uint16_t adc_threshold = fAdcThreshold / G_adc_cf;
+  uint16_t adc_threshold = dsp_mv_to_counts(uAdcThresholdMv); // or the flash record's
   //  printf("--debug-- sanity check adc_threshold: %7.5f\n", adc_threshold * G_adc_cf);
 
   // configure adc
-  adc_init();
-  adc_gpio_init(GP26_ADC0);
-  adc_select_input(0);
+  hal_adc_init();
+  hal_adc_gpio_init(GP26_ADC0);
+  capture_init(0);  // adc input 0; free-running into the dma ring
 
   // configure gpio transistor bias network
-  config_gpio_pullup(GP21_IREF); // pull up
-  config_gpio_pullup(GP19_INP);
-  config_gpio_pullup(GP12_INM);
-  config_gpio_pullup(GP18_LOADP);
-  config_gpio_pullup(GP13_LOADM);
-  config_gpio_pulldown(GP20_INPLO); // pull down
-  config_gpio_pulldown(GP11_INMLO);
+  config_rx04_bias();
 
   // initial adc vaules are high; this could just be settling time of the bias network; if so,
   // sleep would do, but read the adc uNsettle times instead, and use the returned average to
@@ -247,33 +856,82 @@ int main() {
   #if defined(MC)
   // printf("--debug-- capturing baseline adc_avg\n");
   #endif
+  adc_avg_n(uNsettle); // settle; discarded now that adc_avg_n() is a true mean
   adc_avg = adc_avg_n(uNsettle); 
+  capture_start(); // baseline done with adc_read(); hand the adc to the dma ring
 
-  // define triggers for this capture; global for access from hw timer callbacks without args
+  // flash record: the trigger level learned on an earlier run, instead of the fixed boot level. the
+  // baseline is still measured (~0.5ms); a record whose baseline is off it by more than its
+  // threshold is from other hardware or another setup and is not used
+  G_Calib.iRefFlightUs = CAL_FT * US_PER_FT;
+  calib_t calib;
+  if ( calib_load(&calib) && abs((int)adc_avg - (int)calib.uBaseline) <= calib.uThreshold ) {
+    G_Calib = calib;
+    G_bCalibRestored = true;
+    G_iRefFlightUs = G_Calib.iRefFlightUs;
+    adc_threshold = G_Calib.uThreshold;
+  }
+  #if defined(MC) && !defined(TELEMETRY_BINARY)
+  printf("calib:\t%s\n", G_bCalibRestored ? "restored" : "none; reference at CAL_FT");
+  #endif
+
+  // define triggers for this capture; global for access from core 1 without args
   G_uAdcTriggerPos = adc_avg + adc_threshold;
   G_uAdcTriggerNeg = adc_avg - adc_threshold; 
+  G_uAdcBaseline = adc_avg;
+  detect_set_rate(&G_Detect, CAPTURE_SAMPLE_HZ, DETECT_CARRIER_HZ);
+  G_uMagTrigger = detect_mag_for_threshold(&G_Detect, adc_threshold);
+  cfar_init(&G_Cfar, adc_avg, adc_threshold); // tracking starts from the boot levels
+  #if defined(SNAPSHOT)
+  snap_init(&G_Snap, SNAP_PRE_US * 1000 / CAPTURE_SAMPLE_NS, SNAP_POST_US * 1000 / CAPTURE_SAMPLE_NS);
+  #endif
 
-  gpio_put(G_LED_PIN, 0); // indicates baseline complete, waiting for trigger
+  hal_gpio_put(G_LED_PIN, 0); // indicates baseline complete, waiting for trigger
 
   #if defined(MC)
   // printf("--debug-- wait for first pulse\n");
   #endif
 
-  // remain in loop waiting on first pulse, no timeouts processed
-  G_uFlightTimeSemaphore = time_us_64();
-  wait_for_pulse(); 
+  // core 1 owns capture and detection from here
+  hal_multicore_launch_core1(core1_capture_main);
 
-  struct repeating_timer timer;
-  // --20211018-- sleep_ms was fixed 2000, assuming 4000ms TX_PERIOD
-  sleep_ms(TX_PERIOD/3); // delay fraction of tx01 TX_PERIODms pulse interval
-  // minus '-TX_PERIOD' repeat time makes it not relative to prevous calls; fixed period of TX_PERIODms
-  add_repeating_timer_ms(-TX_PERIOD, repeating_timer_callback, NULL, &timer);
-  // printf("--debug-- repating hw timer is set\n");
-
-  // sleep forever; work is all done inside hw timer callback
+  // core 0: drain reports; leds and serial never hold up a measurement window
+  #if defined(TELEMETRY_BINARY)
+  telemetry_frame_reset(&G_Telemetry, G_iRefFlightUs);
+  #endif
   while (true) {
-    // busy_wait_ms(TX_PERIOD); // --20211018-- convert to sleep; time should be irrelavant
-    sleep_ms(TX_PERIOD);
+    report_t report;
+    while ( report_queue_pop(&G_ReportQueue, &report) ) {
+      #if defined(TELEMETRY_BINARY)
+      if ( telemetry_frame_add(&G_Telemetry, &report) ) { // batch full
+        hal_stdio_write(G_Telemetry.uBuf, telemetry_frame_finish(&G_Telemetry));
+        telemetry_frame_reset(&G_Telemetry, G_iRefFlightUs);
+      }
+      #endif
+      report_range(&report);
+    }
+    #if defined(TELEMETRY_BINARY)
+    if ( G_Telemetry.uCount ) { // queue drained; send the partial batch
+      hal_stdio_write(G_Telemetry.uBuf, telemetry_frame_finish(&G_Telemetry));
+      telemetry_frame_reset(&G_Telemetry, G_iRefFlightUs);
+    }
+    #endif
+    #if defined(SNAPSHOT)
+    uint8_t uSnapFrame[SNAP_FRAME_MAX];
+    uint uSnapLen;
+    for (uint i = 0; i < SNAP_FRAMES_PER_PASS && (uSnapLen = snap_frame(&G_Snap, uSnapFrame)); i++) {
+      hal_stdio_write(uSnapFrame, uSnapLen);
+    }
+    #endif
+    if ( (sLine = get_serial_line()) ) {
+      set_ping_period(sLine);
+      dump_instr(sLine);
+      set_snapshot(sLine);
+      set_low_power(sLine);
+      set_stacking(sLine);
+    }
+    save_calib(sLine); // every pass: the unasked save, once per boot
+    hal_sleep_ms(1);
   }
 
 #endif // end #ifndef PICO_DEFAULT_LED_PIN
@@ -25,24 +25,45 @@
 // @info "1st 8 gpio boot 50K pull up, remainder pull down; all programmable"
 
 // @issue first pulses measures long; skipping first pulse in calculation; search 'first gpio pulse'
+//        (bit-banged burst; resolved by the pio burst, check with ../rcs-host/rcs-tx-timing-01)
 
 // @date 2021.08.27 fork from rcs-switch-pump-01
 // @date 2021.08.30 added repeating timer callback; busy_wait* since sleep* not allowed in timer callbacks
 // @date 2021.09.10 fixed switcher pwm bug; pwm enable in in timer_callback was not sufficient; need to re-init each
 //                  callback because GP0 is re-asign to low after pulse.
 // @date 2021.10.12 increase duty cycle from ( / 499.0 999) 0.499 to (/ 549.0 949) 0.578
+// @date 2026.10.17 pico sdk calls moved behind ../rcs-common/rcs-hal-01.h; builds natively in ../rcs-host
+// @date 2026.10.17 high-rate mode: ping period set at runtime with 'p<ms>' on serial (TIME_PERIOD_MIN..
+//                  TIME_PERIOD_MAX, match rcs-rx04-03); pre-charge shortened to TIME_CHARGE_PCT of short periods
+// @date 2026.10.17 burst from a pio state machine (../rcs-common/rcs-burst-01.*): exact carrier from the first
+//                  cycle, 1 clock dead time between phases; carrier 'f<hz>' and cycles 'n<count>' set on serial.
+//                  the ping is alarm sequenced (charge on, burst, charge off), no busy waits in irq context;
+//                  the pwm slice is set up once and held low at level 0 between pings
+// @date 2026.10.17 coded bursts for several beacons to one receiver: 'c<code>' sends bpsk code 1..BURST_CODES
+//                  (rcs-burst-01.h, receiver ../rcs-common/rcs-coded-01.*) instead of the plain burst (c0);
+//                  the pio takes burst pattern words by dma
+// @date 2026.10.17 switch pump and burst sequencing moved to ../rcs-common/rcs-pump-01.* (shared with the
+//                  single board echo ranger ../rcs-mono01-01); waveform unchanged
 
 #define TIME_CHARGE 500   // switch pump pre-charge up time in ms (--dev-- prod: 500)
 #define TIME_DELAY  -2000 // timer period in ms; TIME_DELAY > TIME_CHARGE+numPulses*25us+callback_overhead
                           // negative sign: TIME_DELAY between callbacks indepencent of callback time
+                          // boot period; 'p<ms>' changes it at runtime
+#define TIME_PERIOD_MIN 25    // ms; 'p<ms>' limits
+#define TIME_PERIOD_MAX 10000
+#define TIME_CHARGE_PCT 40    // max pre-charge, percent of the period
+#define TIME_CARRIER_MIN 30000 // 'f<hz>' limits; piezo bandwidth is a few KHz around 40KHz
+#define TIME_CARRIER_MAX 50000
+                              // --dev-- pump voltage (burst amplitude) at short charge times not yet measured
 // #define MC                // allow mincom serial comm stdout
 
-#include "pico/stdlib.h"
 #include <stdio.h>
-#include "hardware/gpio.h"
-#include "hardware/clocks.h"
-#include "hardware/pwm.h"
-#include "tusb.h"  // tusb_wait_for_connection()
+#include <stdlib.h>
+#include <inttypes.h> // printf("%" PRIu64/d64/x64 "\n", t)
+#include "../rcs-common/rcs-hal-01.h" // pico sdk or host backend; gpio, pwm, timer, pio burst, usb
+#include "../rcs-common/rcs-utils-01.h" // global extern: G_LED_PIN; get_serial_line()
+#include "../rcs-common/rcs-burst-01.h" // burst carrier and length defaults
+#include "../rcs-common/rcs-pump-01.h"  // switch pump pwm and pio burst, ping sequencing
 
 // globals
 uint64_t G_time_us_last = 0L; // initial value
@@ -51,144 +72,124 @@ const uint G_GP0 = 0;   // pin 1 pwm out chan A
 const uint G_GP10 = 10; // pin 14 vin clock
 const uint G_GP11 = 11; // pin 15 vinb clock
 const uint G_GP5 = 5;   // pin 7 sw1
-const float G_fClkDiv = 2;  // pwm params
-// --rcs-- org pwm 50%
-// const uint16_t G_uWrap = 999;
-// const uint16_t G_uChanLevel = 499;
-// new pwm 2021.10.12
-const uint16_t G_uWrap = 949;
-const uint16_t G_uChanLevel = 549;
-uint G_uSliceNum;
-
-// intentional compile error if PICO_DEFAULT_LED_PIN is not defined by sdk
-const uint G_LED_PIN = PICO_DEFAULT_LED_PIN;
-
-void tusb_wait_for_connection(void) {
-  // blocks until minicom connection; MC is assumed defined before call
-  while (!tud_cdc_connected()) {
-    printf(".");
-    sleep_ms(300);
+pump_t G_Pump; // pwm params (PUMP_*), burst pattern; rcs-pump-01.h
+// ping period; main sets it from serial, the timer callback applies it
+volatile int32_t G_iPeriodMs = -TIME_DELAY;
+int32_t G_iTimerPeriodMs = -TIME_DELAY; // period the timer runs at; callback only
+volatile uint32_t G_uCarrierHz = BURST_CARRIER_HZ; // 'f<hz>'; must match rx DETECT_CARRIER_HZ
+volatile uint G_uBurstCycles = BURST_CYCLES;        // 'n<count>'; must match rx DETECT_BURST_CYCLES
+volatile uint G_uBurstCode = 0;                     // 'c<code>'; 0 plain burst, 1..BURST_CODES beacon code
+
+bool repeating_timer_callback(hal_timer_t *t) {
+  // ping start: pump pwm on for the pre-charge; alarms fire the burst and stop the pump, so the
+  // cpu is free between the edges (was busy_wait TIME_CHARGE plus a bit-banged burst, here in irq).
+  // the led is lit from pre-charge to burst end (pump_t gpLed)
+  #if defined(MC)
+  uint64_t time_us_now = hal_time_us(); //--dev--
+  printf("tx pulse repeating_timer_callback delta time: %" PRId64 "\n", time_us_now-G_time_us_last);
+  G_time_us_last = time_us_now;
+  #endif
+  pump_set_burst(&G_Pump, G_uCarrierHz, G_uBurstCycles, G_uBurstCode); // pio idle, last burst is out
+  // pre-charge; short periods cannot afford TIME_CHARGE
+  int32_t iPeriodMs = G_iPeriodMs;
+  int32_t iChargeMs = iPeriodMs * TIME_CHARGE_PCT / 100;
+  pump_ping(&G_Pump, (iChargeMs < TIME_CHARGE ? iChargeMs : TIME_CHARGE) * 1000);
+  if (iPeriodMs != G_iTimerPeriodMs) { // new period from the next ping on
+    hal_timer_set_period_ms(t, -iPeriodMs);
+    G_iTimerPeriodMs = iPeriodMs;
   }
-  printf("\ntusb connection established\n");
-  printf("c-a x exits minicom\n");
+  return true;
 }
 
-uint set_pwm(uint uGpNum, float fClkDiv, uint16_t uWrap, uint16_t uChanLevel)
-{
-  // uGpNum valid gpio num
-  // fClkDiv clock divider; e.g. 125Mhz / fClkDiv = pwm clock freq
-  // uWrap pwm clock segmentation; freq_pwm = 125MHz / (uWrap+1); e.g. 125Mhz / (3+1) -> 32.5MHz
-  //   with fClkDiv=2, uWrap=999 -> freq_pwm = (125MHz/2) / (999+1) -> 62Khz
-  // uChanLevel sets number of 'high' cycles; uWrap/2 -> 50%
-  // returns (uint)G_uSliceNum
-  gpio_set_function(uGpNum, GPIO_FUNC_PWM);
-  uint G_uSliceNum = pwm_gpio_to_slice_num(uGpNum);
-  pwm_set_clkdiv(G_uSliceNum, fClkDiv);
-  pwm_set_wrap(G_uSliceNum, uWrap);
-  // @todo How is CHAN_A, CHAN_B associated with a PWM set gpio?  Order of gpio_set_function() calls?
-  pwm_set_chan_level(G_uSliceNum, PWM_CHAN_A, uChanLevel);
-  return G_uSliceNum;
+void flash_led_error(void) {
+  // fast 3 flashes, pause; init failure
+  for (int i = 0; i < 3; i++) {
+    hal_gpio_put(G_LED_PIN, 1);
+    hal_sleep_ms(50);
+    hal_gpio_put(G_LED_PIN, 0);
+    hal_sleep_ms(50);
+  }
+  hal_sleep_ms(500);
 }
 
-bool repeating_timer_callback(struct repeating_timer *t) {
+void tx_command(const char *sLine) {
+  // serial commands: p<ms> ping period, f<hz> burst carrier, n<count> burst cycles, c<code> beacon
+  // code (0 plain burst of n cycles)
+  long lValue = strtol(sLine + 1, NULL, 10);
+  if (sLine[0] == 'p' && lValue >= TIME_PERIOD_MIN && lValue <= TIME_PERIOD_MAX) {
+    G_iPeriodMs = lValue;
+  } else if (sLine[0] == 'f' && lValue >= TIME_CARRIER_MIN && lValue <= TIME_CARRIER_MAX) {
+    G_uCarrierHz = lValue;
+  } else if (sLine[0] == 'n' && lValue >= 1 && lValue <= BURST_CYCLES_MAX) {
+    G_uBurstCycles = lValue;
+  } else if (sLine[0] == 'c' && lValue >= 0 && lValue <= BURST_CODES) {
+    G_uBurstCode = lValue;
+  } else {
+    return;
+  }
   #if defined(MC)
-  uint64_t time_us_now = time_us_64(); //--dev--
-  printf("tx pulse repeating_timer_callback delta time: %lld\n", time_us_now-G_time_us_last);
-  G_time_us_last = time_us_now;
+  printf("ping period: %" PRId32 " ms carrier: %" PRIu32 " Hz cycles: %u code: %u\n", G_iPeriodMs, G_uCarrierHz,
+         G_uBurstCycles, G_uBurstCode);
   #endif
-  G_uSliceNum = set_pwm(G_GP0, G_fClkDiv, G_uWrap, G_uChanLevel);   // pwm init
-  gpio_put(G_LED_PIN, 1); // LED high, start pre-charge
-  pwm_set_enabled(G_uSliceNum, true);
-  // printf("--debug-- post pwm enable\n");
-  // --dev-- sleep_ms(TIME_CHARGE); --bug-- cannot sleep in timer callback?
-  busy_wait_ms(TIME_CHARGE);
-  // printf("--debug-- post TIME_CHARGE busy_wait\n");
-  // enable gpio clocks for 8 pulses
-  // 11,x,10,x = 48Khz (x== no trailing sleep for non-overlap)
-  // 11,x,11,x = 41Khz
-  // 12,x,12,x = ??Khz --dev-- --todo-- need scope measurment
-  for ( int i=0; i<8; i++) {
-    gpio_put(G_GP10, 1);
-    //    sleep_us(12); // --dev-- --bug-- sleeps crash repeating_timer_callback?
-    busy_wait_us(12);
-    gpio_put(G_GP10, 0); // skip trailing sleep
-    gpio_put(G_GP11, 1);
-    //    sleep_us(12); // --dev-- --bug-- sleeps crash repeating_timer_callback?
-    busy_wait_us(12);
-    gpio_put(G_GP11, 0); // skip trailing sleep
-  }
-  // stop pwm
-  pwm_set_enabled(G_uSliceNum, false);
-  // printf("--debug-- post pwm disable\n");
-  gpio_put(G_LED_PIN, 0); // LED low, pulse complete
-  // remove pwm, re-init pin as output, low
-  gpio_init(G_GP0);
-  gpio_set_dir(G_GP0, GPIO_OUT);
-  gpio_put(G_GP0, 0);
-  return true;
-}
+} // end void tx_command(...)
 
 int main() {
   // LED to indicate loaded/running firmware; pulse freq may determine parameters
-  gpio_init(G_LED_PIN);
-  gpio_set_dir(G_LED_PIN, GPIO_OUT);
-  gpio_put(G_LED_PIN, 1);
+  hal_gpio_init(G_LED_PIN);
+  hal_gpio_set_dir(G_LED_PIN, HAL_GPIO_OUT);
+  hal_gpio_put(G_LED_PIN, 1);
 
   // begin usb serial comms
-  stdio_init_all();
+  hal_stdio_init();
   #if defined(MC)
   tusb_wait_for_connection();  // optionally wait for 'mc' before capturing data
   printf("rcs-tx01-02 loop switch-pump pulses to piezo tx\n");
   #endif
 
   // define switch between pull up gpio and gnd
-  gpio_init(G_GP5);
-  gpio_set_dir(G_GP5, GPIO_IN);
-  gpio_pull_up(G_GP5); // redundant for reference; G_GP5 boots pull up
-
-  // define clock phases, initialize low
-  gpio_init(G_GP10);
-  gpio_set_dir(G_GP10, GPIO_OUT);
-  gpio_put(G_GP10, 0);
-  gpio_init(G_GP11);
-  gpio_set_dir(G_GP11, GPIO_OUT);
-  gpio_put(G_GP11, 0);
-
-  // first gpio pulse train is long on first use, causing the string to measure 36Khz, instead
-  // of 41Khz of subsequent pulse trains. 
-  
-  // initalize G_GP0 pwm clock: 125MHz/2/1000 -> 62.5Khz, 50% duty cycle
-  G_uSliceNum = set_pwm(G_GP0, G_fClkDiv, G_uWrap, G_uChanLevel);
-  #if defined(MC)
-  // printf("--debug-- G_uSliceNum: %d\n", G_uSliceNum);
-  #endif
-  // pre-pwm, init pin as output, low
-  gpio_init(G_GP0);
-  gpio_set_dir(G_GP0, GPIO_OUT);
-  gpio_put(G_GP0, 0);
+  hal_gpio_init(G_GP5);
+  hal_gpio_set_dir(G_GP5, HAL_GPIO_IN);
+  hal_gpio_pull_up(G_GP5); // redundant for reference; G_GP5 boots pull up
+
+  // define clock phases; pio pins G_GP10, G_GP11 (consecutive), idle low
+  // (the bit-banged pulse train was long on first use, measuring 36Khz instead of the 41Khz of
+  // subsequent pulse trains; the pio carrier is exact from the first cycle)
+  // initalize G_GP0 pwm clock once, 125MHz/2/950 -> 65.8Khz; level 0 between pings holds the
+  // output low with the slice running (disabling the slice could stop it high)
+  if (!pump_init(&G_Pump, G_GP0, G_GP10, G_LED_PIN)) {
+    #if defined(MC)
+    printf("--error-- no pio state machine for the burst\n");
+    #endif
+    while (true) flash_led_error();
+  }
 
   #if defined(MC)
   printf("--debug-- waiting on switch press/release\n");
   #endif
   // gate process start until switch is pressed and released
-  while (!gpio_get(G_GP5)) { // wait until button high via pull up; LED is high
-    sleep_ms(200);
+  while (!hal_gpio_get(G_GP5)) { // wait until button high via pull up; LED is high
+    hal_sleep_ms(200);
   }
-  while (gpio_get(G_GP5)) { // pull up and button not pressed
-    gpio_put(G_LED_PIN, 1); // 4Hz LED flash (pulse armed)
-    sleep_ms(125);
-    gpio_put(G_LED_PIN, 0);
-    sleep_ms(125);
+  while (hal_gpio_get(G_GP5)) { // pull up and button not pressed
+    hal_gpio_put(G_LED_PIN, 1); // 4Hz LED flash (pulse armed)
+    hal_sleep_ms(125);
+    hal_gpio_put(G_LED_PIN, 0);
+    hal_sleep_ms(125);
   } // end while (gpio_get(
-  gpio_put(G_LED_PIN, 0);
-  while (!gpio_get(G_GP5)) { // wait until button high via pullup; LED is low
-    sleep_ms(20);
+  hal_gpio_put(G_LED_PIN, 0);
+  while (!hal_gpio_get(G_GP5)) { // wait until button high via pullup; LED is low
+    hal_sleep_ms(20);
   }
 
   // button pressed and relased, create repeating hw timer
-  struct repeating_timer timer;
-  add_repeating_timer_ms(TIME_DELAY, repeating_timer_callback, NULL, &timer);
+  hal_timer_t timer;
+  hal_add_repeating_timer_ms(TIME_DELAY, repeating_timer_callback, NULL, &timer);
 
+  // work is all done by the hw timer, alarms and pio; main only takes serial commands. sleep
+  // rather than spin so the host build's virtual clock advances
   while (true) {
+    const char *sLine = get_serial_line();
+    if (sLine) tx_command(sLine);
+    hal_sleep_ms(10);
   } // end while (true) 
 }